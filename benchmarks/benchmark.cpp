@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <json/json.h>
+
+#include "benchmark.h"
+
+namespace ETJump {
+namespace Benchmark {
+struct Registration {
+  std::string name;
+  Function fn;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double nsPerIteration;
+  double itemsPerSecond;
+  double bytesPerSecond;
+};
+
+static std::vector<Registration> &registry() {
+  static std::vector<Registration> benchmarks;
+  return benchmarks;
+}
+
+bool registerBenchmark(const std::string &name, Function fn) {
+  registry().push_back({name, std::move(fn)});
+  return true;
+}
+
+State::State(uint64_t iterations)
+    : maxIterations(iterations), remaining(iterations) {}
+
+uint64_t State::iterations() const { return maxIterations; }
+
+void State::setItemsProcessed(uint64_t count) { items = count; }
+
+void State::setBytesProcessed(uint64_t count) { bytes = count; }
+
+uint64_t State::itemsProcessed() const { return items; }
+
+uint64_t State::bytesProcessed() const { return bytes; }
+
+double State::elapsedNanoseconds() const {
+  if (!started) {
+    return 0;
+  }
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+          .count());
+}
+
+// grows the iteration count until a run takes at least minTime
+static Result run(const Registration &benchmark, double minTimeNs) {
+  static const uint64_t maxIterations = 1000000000;
+  uint64_t iterations = 1;
+
+  while (true) {
+    State state(iterations);
+    benchmark.fn(state);
+    const double elapsed = std::max(state.elapsedNanoseconds(), 1.0);
+
+    if (elapsed >= minTimeNs || iterations >= maxIterations) {
+      const double seconds = elapsed / 1e9;
+      return {benchmark.name, iterations, elapsed / iterations,
+              state.itemsProcessed() / seconds,
+              state.bytesProcessed() / seconds};
+    }
+
+    // aim slightly over the target, but never more than 10x per step
+    const double scale = std::min(10.0, std::max(2.0, minTimeNs * 1.4 / elapsed));
+    iterations = std::min(maxIterations,
+                          static_cast<uint64_t>(iterations * scale));
+  }
+}
+
+static Json::Value toJson(const std::vector<Result> &results) {
+  Json::Value root;
+  root["context"]["executable"] = "benchmarks";
+  root["context"]["date"] = static_cast<Json::Int64>(
+      std::chrono::duration_cast<std::chrono::seconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+
+  root["benchmarks"] = Json::arrayValue;
+  for (const auto &result : results) {
+    Json::Value entry;
+    entry["name"] = result.name;
+    entry["iterations"] = static_cast<Json::UInt64>(result.iterations);
+    entry["ns_per_iteration"] = result.nsPerIteration;
+    entry["items_per_second"] = result.itemsPerSecond;
+    entry["bytes_per_second"] = result.bytesPerSecond;
+    root["benchmarks"].append(entry);
+  }
+
+  return root;
+}
+} // namespace Benchmark
+} // namespace ETJump
+
+static void printUsage() {
+  std::cout << "usage: benchmarks [--filter <substring>] [--json <file|->] "
+               "[--min-time <ms>] [--list]\n";
+}
+
+int main(int argc, char **argv) {
+  using namespace ETJump::Benchmark;
+
+  std::string filter;
+  std::string jsonPath;
+  double minTimeMs = 200;
+  bool listOnly = false;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--filter" && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (arg == "--json" && i + 1 < argc) {
+      jsonPath = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      minTimeMs = std::atof(argv[++i]);
+    } else if (arg == "--list") {
+      listOnly = true;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  auto benchmarks = registry();
+  std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const Registration &lhs, const Registration &rhs) {
+              return lhs.name < rhs.name;
+            });
+
+  std::vector<Result> results;
+  for (const auto &benchmark : benchmarks) {
+    if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+      continue;
+    }
+
+    if (listOnly) {
+      std::cout << benchmark.name << '\n';
+      continue;
+    }
+
+    const auto result = run(benchmark, minTimeMs * 1e6);
+    std::printf("%-48s %12llu iterations %14.1f ns/iter", result.name.c_str(),
+                static_cast<unsigned long long>(result.iterations),
+                result.nsPerIteration);
+    if (result.itemsPerSecond > 0) {
+      std::printf(" %14.0f items/s", result.itemsPerSecond);
+    }
+    if (result.bytesPerSecond > 0) {
+      std::printf(" %10.2f MB/s", result.bytesPerSecond / (1024 * 1024));
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+    results.push_back(result);
+  }
+
+  if (!jsonPath.empty() && !listOnly) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    const auto output = Json::writeString(builder, toJson(results));
+
+    if (jsonPath == "-") {
+      std::cout << output << '\n';
+    } else {
+      std::ofstream file(jsonPath);
+      if (!file) {
+        std::cerr << "Could not open " << jsonPath << " for writing\n";
+        return 1;
+      }
+      file << output << '\n';
+    }
+  }
+
+  return 0;
+}
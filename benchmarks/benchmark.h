@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ETJump {
+namespace Benchmark {
+// Passed to each benchmark, only the time spent inside the
+// keepRunning() loop is measured, so setup can be done before it:
+//
+//   ETJ_BENCHMARK(MyBenchmark) {
+//     auto data = createData();
+//     while (state.keepRunning()) {
+//       Benchmark::doNotOptimize(process(data));
+//     }
+//     state.setItemsProcessed(state.iterations() * data.size());
+//   }
+class State {
+  uint64_t maxIterations;
+  uint64_t remaining;
+  uint64_t items{0};
+  uint64_t bytes{0};
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point end;
+  bool started{false};
+
+public:
+  explicit State(uint64_t iterations);
+
+  bool keepRunning() {
+    if (!started) {
+      started = true;
+      start = std::chrono::steady_clock::now();
+    }
+    if (remaining == 0) {
+      end = std::chrono::steady_clock::now();
+      return false;
+    }
+    remaining--;
+    return true;
+  }
+
+  uint64_t iterations() const;
+  void setItemsProcessed(uint64_t count);
+  void setBytesProcessed(uint64_t count);
+  uint64_t itemsProcessed() const;
+  uint64_t bytesProcessed() const;
+  double elapsedNanoseconds() const;
+};
+
+using Function = std::function<void(State &)>;
+
+bool registerBenchmark(const std::string &name, Function fn);
+
+// prevents the compiler from optimizing away a computed value
+template <typename T>
+inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+} // namespace Benchmark
+} // namespace ETJump
+
+#define ETJ_BENCHMARK(name)                                                    \
+  static void name(ETJump::Benchmark::State &state);                          \
+  static const bool name##Registered =                                         \
+      ETJump::Benchmark::registerBenchmark(#name, name);                       \
+  static void name(ETJump::Benchmark::State &state)
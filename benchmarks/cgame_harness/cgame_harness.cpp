@@ -0,0 +1,590 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ftw.h>
+#include <iostream>
+#include <json/json.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../harness_common/stand_in_assets.h"
+#include "stub_engine.h"
+#include "../../src/cgame/etj_irenderable.h"
+#include "../../src/cgame/etj_profiler.h"
+
+// Runs the cgame headless against StubEngine: feeds scripted snapshots
+// of a strafe jumping local player and a number of other players, and
+// draws frames on a virtual clock. Every renderable in
+// ETJump::renderables is wrapped so the renderer, collision and cvar
+// calls it makes are counted separately from the rest of the frame.
+//
+// The cgame exports nothing but dllEntry and vmMain, so instead of
+// loading the module the cgame sources are compiled into the harness.
+
+#ifndef ETJ_ASSETS_PATH
+  #define ETJ_ASSETS_PATH "assets"
+#endif
+
+extern "C" void dllEntry(intptr_t(QDECL *syscallptr)(intptr_t arg, ...));
+extern "C" intptr_t vmMain(int command, intptr_t arg0, intptr_t arg1,
+                           intptr_t arg2, intptr_t arg3, intptr_t arg4,
+                           intptr_t arg5, intptr_t arg6);
+
+using namespace ETJump::CgameHarness;
+using ETJump::Harness::Box;
+using ETJump::Harness::BoxWorld;
+
+struct Options {
+  int frames = 1000;
+  int players = 8;
+  int frameMsec = 8;
+  bool verify = false;
+  bool verbose = false;
+  std::string jsonPath;
+  std::vector<std::pair<std::string, std::string>> cvars;
+};
+
+struct RunResult {
+  std::vector<double> frameNs;
+  std::vector<std::string> scopes;
+  std::vector<StubEngine::Counters> counters;
+  uint64_t unhandled{0};
+  uint32_t checksum{0};
+};
+
+static const char *MAP_NAME = "harness";
+static const int SNAPSHOT_MSEC = 50;
+// usercmds reach the server one snapshot interval plus ping late
+static const int COMMAND_DELAY = 100;
+static const int WARMUP_FRAMES = 50;
+static const float PATH_RADIUS = 800;
+static const float PATH_SPEED = 450;
+
+// the HUD components under test, all of them off by default
+static const std::vector<std::pair<std::string, std::string>> HUD_CVARS{
+    {"etj_drawCGaz", "1"},
+    {"etj_drawSnapHUD", "1"},
+    {"etj_drawKeys", "1"},
+    {"etj_drawSpeed2", "1"},
+    {"etj_drawAccel", "1"},
+    {"etj_drawMaxSpeed", "1"},
+    {"etj_drawOB", "1"},
+    {"etj_drawJumpSpeeds", "1"},
+    {"etj_drawStrafeQuality", "1"},
+    {"etj_drawUpmoveMeter", "1"},
+    {"etj_tjlEnableLine", "1"},
+    {"etj_tjlEnableMarker", "1"},
+    {"etj_tjlNearestInterval", "1"},
+};
+
+// flat 4096 unit arena with a ring of crates around the running path
+static void buildWorld(BoxWorld &world) {
+  const auto addBox = [&world](float x1, float y1, float z1, float x2,
+                               float y2, float z2) {
+    Box box{{x1, y1, z1}, {x2, y2, z2}, CONTENTS_SOLID, 0};
+    world.add(box);
+  };
+
+  addBox(-2048, -2048, -64, 2048, 2048, 0);
+  addBox(-2048, -2048, 1024, 2048, 2048, 1088);
+  addBox(-2112, -2048, 0, -2048, 2048, 1024);
+  addBox(2048, -2048, 0, 2112, 2048, 1024);
+  addBox(-2048, -2112, 0, 2048, -2048, 1024);
+  addBox(-2048, 2048, 0, 2048, 2112, 1024);
+
+  for (int i = 0; i < 16; i++) {
+    const float angle = static_cast<float>(i) * 2 * M_PI / 16;
+    const float x = std::cos(angle) * (PATH_RADIUS + 160);
+    const float y = std::sin(angle) * (PATH_RADIUS + 160);
+    addBox(x - 32, y - 32, 0, x + 32, y + 32, 48.0f + 16.0f * (i % 4));
+  }
+}
+
+// a single mapper route along the running path, so trickjump lines
+// have something to draw
+static std::string trickjumpRoute() {
+  Json::Value trail(Json::arrayValue);
+  for (int i = 0; i <= 64; i++) {
+    const float angle = static_cast<float>(i) * 2 * M_PI / 64;
+    Json::Value node;
+    node["coordinates"].append(std::to_string(std::cos(angle) * PATH_RADIUS));
+    node["coordinates"].append(std::to_string(std::sin(angle) * PATH_RADIUS));
+    node["coordinates"].append("0");
+    node["speed"] = PATH_SPEED;
+    trail.append(node);
+  }
+
+  Json::Value route;
+  route["name"] = "harness";
+  route["width"] = 2.0;
+  for (const auto component : {"0", "255", "0", "255"}) {
+    route["color"].append(component);
+  }
+  route["trails"].append(trail);
+
+  Json::Value root(Json::arrayValue);
+  root.append(route);
+  return Json::FastWriter().write(root);
+}
+
+static std::string playerConfigstring(int clientNum) {
+  const int team = clientNum % 2 == 0 ? TEAM_AXIS : TEAM_ALLIES;
+  return "n\\player" + std::to_string(clientNum) + "\\t\\" +
+         std::to_string(team) + "\\c\\" + std::to_string(clientNum % 5) +
+         "\\r\\0\\m\\0000000\\s\\0000000\\dn\\\\dr\\0\\w\\" +
+         std::to_string(WP_KNIFE) + "\\lw\\" + std::to_string(WP_KNIFE) +
+         "\\sw\\0\\mu\\0\\pm\\1\\fps\\125\\cgaz\\0\\h\\0\\sl\\0\\tr\\0"
+         "\\vs\\0\\i\\0";
+}
+
+static void setConfigstrings(StubEngine &engine, const Options &options) {
+  engine.setConfigstring(CS_SERVERINFO,
+                         "\\g_gametype\\" + std::to_string(ETJUMP_GAMETYPE) +
+                             "\\sv_maxclients\\" +
+                             std::to_string(MAX_CLIENTS) + "\\mapname\\" +
+                             MAP_NAME + "\\timelimit\\0\\g_antilag\\1"
+                             "\\sv_hostname\\harness\\protocol\\84");
+  engine.setConfigstring(CS_SYSTEMINFO,
+                         "\\sv_serverid\\1\\sv_fps\\20\\pmove_msec\\8"
+                         "\\sv_cheats\\0");
+  engine.setConfigstring(CS_GAME_VERSION, GAME_NAME);
+  engine.setConfigstring(CS_LEVEL_START_TIME, "1000");
+  engine.setConfigstring(CS_MOTD, "");
+
+  for (int i = 0; i <= options.players; i++) {
+    engine.setConfigstring(CS_PLAYERS + i, playerConfigstring(i));
+  }
+}
+
+// position along the running path at the given time, players are
+// spread out evenly behind the local one
+static void pathState(int clientNum, int players, int time, vec3_t origin,
+                      vec3_t velocity, float &yaw) {
+  const float offset = static_cast<float>(clientNum) * 2 * M_PI / (players + 1);
+  const float angle = time * 0.001f * PATH_SPEED / PATH_RADIUS - offset;
+
+  origin[0] = std::cos(angle) * PATH_RADIUS;
+  origin[1] = std::sin(angle) * PATH_RADIUS;
+  origin[2] = 24;
+  velocity[0] = -std::sin(angle) * PATH_SPEED;
+  velocity[1] = std::cos(angle) * PATH_SPEED;
+  velocity[2] = 0;
+
+  // swing around the direction of travel like a strafe jumper
+  const float swing = std::sin(time * 0.004f) * 25.0f;
+  yaw = RAD2DEG(angle) + 90.0f + swing;
+}
+
+static usercmd_t scriptedCmd(int serverTime) {
+  usercmd_t cmd{};
+  cmd.serverTime = serverTime;
+
+  vec3_t origin;
+  vec3_t velocity;
+  float yaw;
+  pathState(0, 0, serverTime, origin, velocity, yaw);
+
+  cmd.angles[YAW] = ANGLE2SHORT(yaw);
+  cmd.forwardmove = 127;
+  cmd.rightmove = std::sin(serverTime * 0.004f) > 0 ? 127 : -128;
+  cmd.upmove = (serverTime / 150) % 4 == 0 ? 127 : 0;
+  cmd.weapon = WP_KNIFE;
+  return cmd;
+}
+
+static snapshot_t scriptedSnapshot(int serverTime, const Options &options) {
+  // snapshot_t carries a full entity array, too large for the stack
+  static snapshot_t snapshot;
+  std::memset(&snapshot, 0, sizeof(snapshot));
+  snapshot.serverTime = serverTime;
+  snapshot.ping = 50;
+  std::memset(snapshot.areamask, 0xff, sizeof(snapshot.areamask));
+
+  auto &ps = snapshot.ps;
+  ps.commandTime = serverTime - COMMAND_DELAY;
+  ps.clientNum = 0;
+  ps.pm_type = PM_NORMAL;
+  ps.groundEntityNum = ENTITYNUM_WORLD;
+  ps.gravity = 800;
+  ps.speed = 320;
+  ps.runSpeedScale = 0.8f;
+  ps.sprintSpeedScale = 1.1f;
+  ps.crouchSpeedScale = 0.25f;
+  ps.friction = 1.0f;
+  VectorSet(ps.mins, -18, -18, -24);
+  VectorSet(ps.maxs, 18, 18, 48);
+  ps.standViewHeight = DEFAULT_VIEWHEIGHT;
+  ps.crouchViewHeight = CROUCH_VIEWHEIGHT;
+  ps.deadViewHeight = DEAD_VIEWHEIGHT;
+  ps.crouchMaxZ = ps.maxs[2] - (ps.standViewHeight - ps.crouchViewHeight);
+  ps.viewheight = DEFAULT_VIEWHEIGHT;
+  ps.stats[STAT_HEALTH] = 100;
+  ps.stats[STAT_MAX_HEALTH] = 100;
+  ps.persistant[PERS_TEAM] = TEAM_AXIS;
+  ps.teamNum = TEAM_AXIS;
+  ps.weapon = WP_KNIFE;
+  COM_BitSet(ps.weapons, WP_KNIFE);
+
+  float yaw;
+  pathState(0, options.players, ps.commandTime, ps.origin, ps.velocity, yaw);
+  ps.viewangles[YAW] = yaw;
+  ps.delta_angles[YAW] = 0;
+
+  for (int i = 1; i <= options.players; i++) {
+    auto &es = snapshot.entities[snapshot.numEntities++];
+    es.number = i;
+    es.clientNum = i;
+    es.eType = ET_PLAYER;
+    es.weapon = WP_KNIFE;
+    es.teamNum = i % 2 == 0 ? TEAM_AXIS : TEAM_ALLIES;
+    es.groundEntityNum = ENTITYNUM_WORLD;
+    es.pos.trType = TR_INTERPOLATE;
+    es.apos.trType = TR_INTERPOLATE;
+
+    vec3_t velocity;
+    pathState(i, options.players, serverTime, es.pos.trBase, velocity, yaw);
+    VectorCopy(velocity, es.pos.trDelta);
+    es.apos.trBase[YAW] = yaw;
+  }
+  return snapshot;
+}
+
+// counts everything a renderable submits against its own scope
+class CountedRenderable : public ETJump::IRenderable {
+public:
+  CountedRenderable(std::shared_ptr<ETJump::IRenderable> renderable,
+                    int scope)
+      : renderable(std::move(renderable)), scope(scope) {}
+
+  bool beforeRender() override {
+    ScopeGuard guard(scope);
+    return renderable->beforeRender();
+  }
+
+  void render() const override {
+    ScopeGuard guard(scope);
+    renderable->render();
+  }
+
+private:
+  std::shared_ptr<ETJump::IRenderable> renderable;
+  int scope;
+};
+
+static void wrapRenderables(StubEngine &engine) {
+  const auto stats = ETJump::profiler->getStats();
+  for (size_t i = 0; i < ETJump::renderables.size(); i++) {
+    const auto &name = stats[ETJump::renderableProfilerSections[i]].name;
+    ETJump::renderables[i] = std::make_shared<CountedRenderable>(
+        ETJump::renderables[i], engine.addScope(name));
+  }
+}
+
+static uint32_t hashBytes(uint32_t hash, const void *data, size_t size) {
+  const auto bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static RunResult run(const Options &options, const std::string &homePath) {
+  auto &engine = StubEngine::instance();
+  engine.reset(homePath, MAP_NAME, {ETJ_ASSETS_PATH});
+  engine.setVerbose(options.verbose);
+  buildWorld(engine.world());
+  ETJump::Harness::addStandInAssets(engine.fileSystem(), MAP_NAME);
+  engine.fileSystem().addFile(std::string("tjllines/mapper/") + MAP_NAME +
+                                  ".tjl",
+                              trickjumpRoute());
+  engine.setEntityString("{\n\"classname\" \"worldspawn\"\n}\n");
+  setConfigstrings(engine, options);
+
+  for (const auto &cvar : HUD_CVARS) {
+    engine.cvars().set(cvar.first, cvar.second);
+  }
+  for (const auto &cvar : options.cvars) {
+    engine.cvars().set(cvar.first, cvar.second);
+  }
+
+  dllEntry(&StubEngine::syscall);
+
+  int time = 1000;
+  engine.setTime(time);
+  vmMain(CG_INIT, 0, 0, 0, qfalse, 0, 0, 0);
+  wrapRenderables(engine);
+
+  int nextSnapshotTime = time - time % SNAPSHOT_MSEC;
+  RunResult result;
+  result.frameNs.reserve(options.frames);
+
+  for (int frame = 0; frame < WARMUP_FRAMES + options.frames; frame++) {
+    if (frame == WARMUP_FRAMES) {
+      engine.clearCounters();
+    }
+
+    time += options.frameMsec;
+    engine.setTime(time);
+
+    // the client renders between the last two snapshots it received
+    while (nextSnapshotTime <= time + SNAPSHOT_MSEC) {
+      engine.addSnapshot(scriptedSnapshot(nextSnapshotTime, options));
+      nextSnapshotTime += SNAPSHOT_MSEC;
+    }
+    engine.addUsercmd(scriptedCmd(time));
+
+    const auto frameStart = std::chrono::steady_clock::now();
+    vmMain(CG_DRAW_ACTIVE_FRAME, time, 0, qfalse, 0, 0, 0, 0);
+    const auto frameEnd = std::chrono::steady_clock::now();
+
+    if (frame >= WARMUP_FRAMES) {
+      result.frameNs.push_back(
+          std::chrono::duration<double, std::nano>(frameEnd - frameStart)
+              .count());
+    }
+  }
+
+  vmMain(CG_SHUTDOWN, 0, 0, 0, 0, 0, 0, 0);
+
+  result.scopes = engine.scopeNames();
+  uint32_t checksum = 2166136261u;
+  for (size_t i = 0; i < result.scopes.size(); i++) {
+    const auto &counters = engine.counters(static_cast<int>(i));
+    result.counters.push_back(counters);
+    checksum = hashBytes(checksum, counters.data(),
+                         counters.size() * sizeof(counters[0]));
+  }
+  result.unhandled = engine.unhandled();
+  result.checksum = checksum;
+  return result;
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = static_cast<size_t>(fraction * (values.size() - 1));
+  return values[index];
+}
+
+static Json::Value report(const Options &options, const RunResult &result) {
+  double total = 0;
+  for (const auto ns : result.frameNs) {
+    total += ns;
+  }
+  const auto frames = static_cast<double>(result.frameNs.size());
+
+  Json::Value root;
+  root["frames"] = options.frames;
+  root["players"] = options.players;
+  root["frame_msec"] = options.frameMsec;
+  root["frame_ns_mean"] = frames > 0 ? total / frames : 0;
+  root["frame_ns_p50"] = percentile(result.frameNs, 0.5);
+  root["frame_ns_p95"] = percentile(result.frameNs, 0.95);
+  root["frame_ns_max"] = percentile(result.frameNs, 1.0);
+
+  // per frame averages of every counted syscall, by scope
+  root["scopes"] = Json::arrayValue;
+  for (size_t i = 0; i < result.scopes.size(); i++) {
+    Json::Value scope;
+    scope["name"] = result.scopes[i];
+    scope["syscalls"] = Json::objectValue;
+
+    for (int command = 0; command < StubEngine::MAX_SYSCALLS; command++) {
+      const auto &counter = result.counters[i][command];
+      const char *name = StubEngine::syscallName(command);
+      if (!name || counter.calls == 0) {
+        continue;
+      }
+      Json::Value value;
+      value["calls_per_frame"] = static_cast<double>(counter.calls) / frames;
+      value["bytes_per_frame"] = static_cast<double>(counter.bytes) / frames;
+      scope["syscalls"][name] = value;
+    }
+    root["scopes"].append(scope);
+  }
+
+  root["unhandled_syscalls"] = static_cast<Json::UInt64>(result.unhandled);
+  root["checksum"] = result.checksum;
+  return root;
+}
+
+static void printReport(const Json::Value &report) {
+  std::printf("%d frames, %d msec frames, %d other players\n",
+              report["frames"].asInt(), report["frame_msec"].asInt(),
+              report["players"].asInt());
+  std::printf("frame time    mean %10.1f us  p50 %10.1f us  p95 %10.1f us  "
+              "max %10.1f us\n",
+              report["frame_ns_mean"].asDouble() / 1000,
+              report["frame_ns_p50"].asDouble() / 1000,
+              report["frame_ns_p95"].asDouble() / 1000,
+              report["frame_ns_max"].asDouble() / 1000);
+  std::printf("\n%-22s %-28s %12s %12s\n", "scope", "syscall", "calls/frame",
+              "bytes/frame");
+
+  for (const auto &scope : report["scopes"]) {
+    const auto &syscalls = scope["syscalls"];
+    for (const auto &name : syscalls.getMemberNames()) {
+      std::printf("%-22s %-28s %12.2f %12.1f\n",
+                  scope["name"].asCString(), name.c_str(),
+                  syscalls[name]["calls_per_frame"].asDouble(),
+                  syscalls[name]["bytes_per_frame"].asDouble());
+    }
+  }
+
+  std::printf("\nunhandled syscalls %llu\n",
+              static_cast<unsigned long long>(
+                  report["unhandled_syscalls"].asUInt64()));
+  std::printf("checksum %08x\n", report["checksum"].asUInt());
+}
+
+static int removeEntry(const char *path, const struct stat *, int,
+                       struct FTW *) {
+  return std::remove(path);
+}
+
+static void removeTree(const std::string &path) {
+  nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+// The cgame keeps file scope state that CG_Shutdown does not reset, the
+// engine reloads the module instead. Verify runs therefore happen in a
+// child forked before the cgame is first touched, so both runs start
+// from the same static state. Returns false if the child failed.
+static bool runInChild(const Options &options, const std::string &homePath,
+                       uint32_t *checksum) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+
+  const pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+
+  if (pid == 0) {
+    close(fds[0]);
+    int status = 1;
+    try {
+      const auto result = run(options, homePath);
+      if (write(fds[1], &result.checksum, sizeof(result.checksum)) ==
+          sizeof(result.checksum)) {
+        status = 0;
+      }
+    } catch (const CgameError &error) {
+      std::cerr << "Cgame error: " << error.what() << '\n';
+    }
+    std::fflush(stdout);
+    std::_Exit(status);
+  }
+
+  close(fds[1]);
+  const bool received = read(fds[0], checksum, sizeof(*checksum)) ==
+                        static_cast<ssize_t>(sizeof(*checksum));
+  close(fds[0]);
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return received && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void printUsage() {
+  std::cout << "usage: cgame_harness [--frames <n>] [--players <n>] "
+               "[--frame-msec <n>] [--set <cvar> <value>]... "
+               "[--json <file|->] [--verify] [--verbose]\n";
+}
+
+int main(int argc, char **argv) {
+  Options options;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--frames" && i + 1 < argc) {
+      options.frames = std::atoi(argv[++i]);
+    } else if (arg == "--players" && i + 1 < argc) {
+      options.players = std::atoi(argv[++i]);
+    } else if (arg == "--frame-msec" && i + 1 < argc) {
+      options.frameMsec = std::atoi(argv[++i]);
+    } else if (arg == "--set" && i + 2 < argc) {
+      options.cvars.emplace_back(argv[i + 1], argv[i + 2]);
+      i += 2;
+    } else if (arg == "--json" && i + 1 < argc) {
+      options.jsonPath = argv[++i];
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (arg == "--verbose") {
+      options.verbose = true;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if (options.frames < 1 || options.players < 0 ||
+      options.players >= MAX_CLIENTS || options.frameMsec < 1) {
+    printUsage();
+    return 1;
+  }
+
+  char tempPath[] = "/tmp/etjump-cgame-harness-XXXXXX";
+  if (!mkdtemp(tempPath)) {
+    std::cerr << "Could not create a temporary directory\n";
+    return 1;
+  }
+
+  int status = 0;
+  uint32_t verifyChecksum = 0;
+  const bool verifyRan =
+      options.verify &&
+      runInChild(options, std::string(tempPath) + "/run1", &verifyChecksum);
+
+  try {
+    const auto result = run(options, std::string(tempPath) + "/run0");
+    const auto json = report(options, result);
+    printReport(json);
+
+    // an identical run in a fresh cgame must submit exactly the same
+    // calls
+    if (options.verify) {
+      if (!verifyRan) {
+        std::printf("verify failed: verify run did not complete\n");
+        status = 1;
+      } else if (verifyChecksum != result.checksum) {
+        std::printf("verify failed: checksum %08x != %08x\n", verifyChecksum,
+                    result.checksum);
+        status = 1;
+      } else {
+        std::printf("verify passed\n");
+      }
+    }
+
+    if (!options.jsonPath.empty()) {
+      Json::StreamWriterBuilder builder;
+      builder["indentation"] = "  ";
+      const auto output = Json::writeString(builder, json);
+      if (options.jsonPath == "-") {
+        std::cout << output << '\n';
+      } else {
+        std::ofstream file(options.jsonPath);
+        file << output << '\n';
+      }
+    }
+  } catch (const CgameError &error) {
+    std::cerr << "Cgame error: " << error.what() << '\n';
+    // like the engine, never touch the cgame again after trap_Error,
+    // its static destructors would run on half initialized state
+    removeTree(tempPath);
+    std::fflush(stdout);
+    std::_Exit(1);
+  }
+
+  removeTree(tempPath);
+  return status;
+}
@@ -0,0 +1,709 @@
+#include <cstring>
+
+#include "../harness_common/syscall_args.h"
+#include "stub_engine.h"
+
+namespace ETJump {
+namespace CgameHarness {
+using namespace Harness;
+
+// handles the engine's collision model hands out for temporary models
+static const clipHandle_t CAPSULE_MODEL_HANDLE = 254;
+static const clipHandle_t BOX_MODEL_HANDLE = 255;
+
+static const int VID_WIDTH = 1920;
+static const int VID_HEIGHT = 1080;
+
+StubEngine &StubEngine::instance() {
+  static StubEngine engine;
+  return engine;
+}
+
+intptr_t QDECL StubEngine::syscall(intptr_t command, ...) {
+  intptr_t args[MAX_SYSCALL_ARGS]{};
+
+  va_list ap;
+  va_start(ap, command);
+  readSyscallArgs(ap, args);
+  va_end(ap);
+
+  return instance().dispatch(command, args);
+}
+
+const char *StubEngine::syscallName(int command) {
+  switch (command) {
+    case CG_CVAR_REGISTER:
+      return "Cvar_Register";
+    case CG_CVAR_UPDATE:
+      return "Cvar_Update";
+    case CG_CVAR_SET:
+      return "Cvar_Set";
+    case CG_CVAR_VARIABLESTRINGBUFFER:
+      return "Cvar_VariableStringBuffer";
+    case CG_CVAR_LATCHEDVARIABLESTRINGBUFFER:
+      return "Cvar_LatchedVariableStringBuffer";
+    case CG_CM_NUMINLINEMODELS:
+      return "CM_NumInlineModels";
+    case CG_CM_INLINEMODEL:
+      return "CM_InlineModel";
+    case CG_CM_TEMPBOXMODEL:
+      return "CM_TempBoxModel";
+    case CG_CM_TEMPCAPSULEMODEL:
+      return "CM_TempCapsuleModel";
+    case CG_CM_POINTCONTENTS:
+      return "CM_PointContents";
+    case CG_CM_TRANSFORMEDPOINTCONTENTS:
+      return "CM_TransformedPointContents";
+    case CG_CM_BOXTRACE:
+      return "CM_BoxTrace";
+    case CG_CM_TRANSFORMEDBOXTRACE:
+      return "CM_TransformedBoxTrace";
+    case CG_CM_CAPSULETRACE:
+      return "CM_CapsuleTrace";
+    case CG_CM_TRANSFORMEDCAPSULETRACE:
+      return "CM_TransformedCapsuleTrace";
+    case CG_CM_MARKFRAGMENTS:
+      return "CM_MarkFragments";
+    case CG_R_PROJECTDECAL:
+      return "R_ProjectDecal";
+    case CG_R_CLEARDECALS:
+      return "R_ClearDecals";
+    case CG_R_REGISTERMODEL:
+      return "R_RegisterModel";
+    case CG_R_REGISTERSKIN:
+      return "R_RegisterSkin";
+    case CG_R_REGISTERSHADER:
+      return "R_RegisterShader";
+    case CG_R_REGISTERSHADERNOMIP:
+      return "R_RegisterShaderNoMip";
+    case CG_R_REGISTERFONT:
+      return "R_RegisterFont";
+    case CG_R_CLEARSCENE:
+      return "R_ClearScene";
+    case CG_R_ADDREFENTITYTOSCENE:
+      return "R_AddRefEntityToScene";
+    case CG_R_ADDPOLYTOSCENE:
+      return "R_AddPolyToScene";
+    case CG_R_ADDPOLYSTOSCENE:
+      return "R_AddPolysToScene";
+    case CG_R_ADDPOLYBUFFERTOSCENE:
+      return "R_AddPolyBufferToScene";
+    case CG_R_ADDLIGHTTOSCENE:
+      return "R_AddLightToScene";
+    case CG_R_ADDCORONATOSCENE:
+      return "R_AddCoronaToScene";
+    case CG_R_SETFOG:
+      return "R_SetFog";
+    case CG_R_SETGLOBALFOG:
+      return "R_SetGlobalFog";
+    case CG_R_RENDERSCENE:
+      return "R_RenderScene";
+    case CG_R_SAVEVIEWPARMS:
+      return "R_SaveViewParms";
+    case CG_R_RESTOREVIEWPARMS:
+      return "R_RestoreViewParms";
+    case CG_R_SETCOLOR:
+      return "R_SetColor";
+    case CG_R_DRAWSTRETCHPIC:
+      return "R_DrawStretchPic";
+    case CG_R_DRAWSTRETCHPIC_GRADIENT:
+      return "R_DrawStretchPicGradient";
+    case CG_R_DRAWROTATEDPIC:
+      return "R_DrawRotatedPic";
+    case CG_R_DRAW2DPOLYS:
+      return "R_Add2dPolys";
+    case CG_R_MODELBOUNDS:
+      return "R_ModelBounds";
+    case CG_R_LERPTAG:
+      return "R_LerpTag";
+    case CG_R_LIGHTFORPOINT:
+      return "R_LightForPoint";
+    case CG_R_INPVS:
+      return "R_inPVS";
+    case CG_R_REMAP_SHADER:
+      return "R_RemapShader";
+    case CG_R_GETSKINMODEL:
+      return "R_GetSkinModel";
+    case CG_R_GETMODELSHADER:
+      return "R_GetShaderFromModel";
+    default:
+      return nullptr;
+  }
+}
+
+void StubEngine::reset(const std::string &homePath, const std::string &mapName,
+                       const std::vector<std::string> &readPaths) {
+  files.reset(homePath + "/etjump", readPaths);
+  cvarStore.clear();
+  configstrings.assign(MAX_CONFIGSTRINGS, "");
+  registeredNames.clear();
+  tempModels.clear();
+  entityTokens.set("");
+  boxWorld.clear();
+
+  snapshots.assign(PACKET_BACKUP, snapshot_t{});
+  snapshotCount = 0;
+  usercmds.assign(CMD_BACKUP, usercmd_t{});
+  usercmdCount = 0;
+
+  names = {"rest of frame"};
+  scopeCounters.assign(1, Counters{});
+  currentScope = REST_OF_FRAME;
+  unhandledCalls = 0;
+  time = 0;
+
+  cvarStore.set("fs_homepath", homePath);
+  cvarStore.set("fs_basepath", homePath);
+  cvarStore.set("fs_game", "etjump");
+  cvarStore.set("mapname", mapName);
+  cvarStore.set("version", "ET 2.60b linux-x86_64");
+  cvarStore.set("r_mode", "-2");
+  cvarStore.set("r_customwidth", std::to_string(VID_WIDTH));
+  cvarStore.set("r_customheight", std::to_string(VID_HEIGHT));
+}
+
+CvarStore &StubEngine::cvars() { return cvarStore; }
+
+StubFileSystem &StubEngine::fileSystem() { return files; }
+
+BoxWorld &StubEngine::world() { return boxWorld; }
+
+void StubEngine::setEntityString(const std::string &entities) {
+  entityTokens.set(entities);
+}
+
+void StubEngine::setConfigstring(int index, const std::string &value) {
+  configstrings[index] = value;
+}
+
+void StubEngine::addSnapshot(const snapshot_t &snapshot) {
+  snapshots[snapshotCount++ % PACKET_BACKUP] = snapshot;
+}
+
+void StubEngine::addUsercmd(const usercmd_t &cmd) {
+  usercmds[usercmdCount++ % CMD_BACKUP] = cmd;
+}
+
+void StubEngine::setTime(int clientTime) { time = clientTime; }
+
+void StubEngine::setVerbose(bool enabled) { verbose = enabled; }
+
+int StubEngine::addScope(const std::string &name) {
+  names.push_back(name);
+  scopeCounters.emplace_back();
+  return static_cast<int>(names.size()) - 1;
+}
+
+void StubEngine::setScope(int scope) { currentScope = scope; }
+
+int StubEngine::scope() const { return currentScope; }
+
+const std::vector<std::string> &StubEngine::scopeNames() const {
+  return names;
+}
+
+const StubEngine::Counters &StubEngine::counters(int scope) const {
+  return scopeCounters[scope];
+}
+
+void StubEngine::clearCounters() {
+  for (auto &counters : scopeCounters) {
+    counters.fill(Counter{});
+  }
+  unhandledCalls = 0;
+}
+
+uint64_t StubEngine::unhandled() const { return unhandledCalls; }
+
+void StubEngine::count(intptr_t command, uint64_t bytes) {
+  if (command < 0 || command >= MAX_SYSCALLS) {
+    return;
+  }
+  auto &counter = scopeCounters[currentScope][command];
+  counter.calls++;
+  counter.bytes += bytes;
+}
+
+qhandle_t StubEngine::registerName(const char *name) {
+  const auto it = registeredNames.find(name);
+  if (it != registeredNames.end()) {
+    return it->second;
+  }
+  const auto handle = static_cast<qhandle_t>(registeredNames.size() + 1);
+  registeredNames.emplace(name, handle);
+  return handle;
+}
+
+// every glyph is a fixed width cell, text layout code only needs
+// consistent metrics
+void StubEngine::registerFont(const char *fontName, int pointSize,
+                              fontInfo_t *font) {
+  std::memset(font, 0, sizeof(*font));
+  const qhandle_t shader = registerName(fontName);
+
+  for (int i = GLYPH_START; i <= GLYPH_END; i++) {
+    auto &glyph = font->glyphs[i];
+    glyph.height = pointSize;
+    glyph.top = pointSize;
+    glyph.pitch = pointSize / 2;
+    glyph.xSkip = pointSize / 2;
+    glyph.imageWidth = pointSize / 2;
+    glyph.imageHeight = pointSize;
+    glyph.s = static_cast<float>(i % 16) / 16;
+    glyph.t = static_cast<float>(i / 16) / 16;
+    glyph.s2 = glyph.s + 1.0f / 16;
+    glyph.t2 = glyph.t + 1.0f / 16;
+    glyph.glyph = shader;
+    copyString(glyph.shaderName, sizeof(glyph.shaderName), fontName);
+  }
+  font->glyphScale = 48.0f / static_cast<float>(pointSize);
+  copyString(font->name, sizeof(font->name), fontName);
+}
+
+void StubEngine::getGameState(gameState_t *gameState) const {
+  std::memset(gameState, 0, sizeof(*gameState));
+  // offset 0 is the shared empty string
+  gameState->dataCount = 1;
+
+  for (int i = 0; i < MAX_CONFIGSTRINGS; i++) {
+    const auto &value = configstrings[i];
+    if (value.empty()) {
+      continue;
+    }
+    const int length = static_cast<int>(value.size()) + 1;
+    if (gameState->dataCount + length > MAX_GAMESTATE_CHARS) {
+      throw CgameError("MAX_GAMESTATE_CHARS exceeded");
+    }
+    gameState->stringOffsets[i] = gameState->dataCount;
+    std::memcpy(gameState->stringData + gameState->dataCount, value.c_str(),
+                length);
+    gameState->dataCount += length;
+  }
+}
+
+void StubEngine::getGlconfig(glconfig_t *glconfig) const {
+  std::memset(glconfig, 0, sizeof(*glconfig));
+  copyString(glconfig->renderer_string, sizeof(glconfig->renderer_string),
+             "harness");
+  glconfig->maxTextureSize = 8192;
+  glconfig->maxActiveTextures = 8;
+  glconfig->colorBits = 32;
+  glconfig->depthBits = 24;
+  glconfig->vidWidth = VID_WIDTH;
+  glconfig->vidHeight = VID_HEIGHT;
+  glconfig->windowAspect = static_cast<float>(VID_WIDTH) / VID_HEIGHT;
+  glconfig->displayFrequency = 125;
+  glconfig->isFullscreen = qtrue;
+}
+
+clipHandle_t StubEngine::tempBoxModel(const vec3_t mins, const vec3_t maxs,
+                                      clipHandle_t handle) {
+  Box box{};
+  VectorCopy(mins, box.mins);
+  VectorCopy(maxs, box.maxs);
+  box.contents = CONTENTS_BODY;
+  tempModels[handle] = box;
+  return handle;
+}
+
+// inline model 0 is the world, temporary models are traced in their
+// own frame at origin, rotation is ignored as both are axis aligned
+void StubEngine::boxTrace(trace_t *results, const vec3_t start,
+                          const vec3_t end, const vec3_t mins,
+                          const vec3_t maxs, clipHandle_t model, int brushMask,
+                          const vec3_t origin) const {
+  static const vec3_t zero = {0, 0, 0};
+  if (!mins) {
+    mins = zero;
+  }
+  if (!maxs) {
+    maxs = zero;
+  }
+  if (!origin) {
+    origin = zero;
+  }
+
+  vec3_t localStart;
+  vec3_t localEnd;
+  VectorSubtract(start, origin, localStart);
+  VectorSubtract(end, origin, localEnd);
+
+  trace_t tr{};
+  tr.fraction = 1;
+  tr.entityNum = ENTITYNUM_NONE;
+
+  if (model == 0) {
+    boxWorld.trace(localStart, localEnd, mins, maxs, brushMask, tr);
+  } else {
+    const auto it = tempModels.find(model);
+    if (it != tempModels.end() && (it->second.contents & brushMask)) {
+      BoxWorld::clipToBox(it->second, localStart, localEnd, mins, maxs,
+                          ENTITYNUM_NONE, tr);
+    }
+  }
+
+  for (int i = 0; i < 3; i++) {
+    tr.endpos[i] = start[i] + tr.fraction * (end[i] - start[i]);
+  }
+  *results = tr;
+}
+
+int StubEngine::pointContents(const vec3_t point, clipHandle_t model,
+                              const vec3_t origin) const {
+  vec3_t local;
+  if (origin) {
+    VectorSubtract(point, origin, local);
+  } else {
+    VectorCopy(point, local);
+  }
+
+  if (model == 0) {
+    return boxWorld.pointContents(local);
+  }
+  const auto it = tempModels.find(model);
+  if (it != tempModels.end() && BoxWorld::contains(it->second, local)) {
+    return it->second.contents;
+  }
+  return 0;
+}
+
+intptr_t StubEngine::dispatch(intptr_t command, const intptr_t *a) {
+  switch (command) {
+    case CG_PRINT:
+      if (verbose) {
+        std::fputs(str(a[0]), stdout);
+      }
+      return 0;
+    case CG_ERROR:
+      throw CgameError(str(a[0]));
+    case CG_MILLISECONDS:
+      return time;
+    case CG_REAL_TIME:
+      return realTime(ptr<qtime_t>(a[0]));
+    case CG_SNAPVECTOR:
+      snapVector(ptr<float>(a[0]));
+      return 0;
+
+    case CG_CVAR_REGISTER:
+      count(command);
+      cvarStore.registerCvar(ptr<vmCvar_t>(a[0]), str(a[1]), str(a[2]),
+                             static_cast<int>(a[3]));
+      return 0;
+    case CG_CVAR_UPDATE:
+      count(command, sizeof(vmCvar_t));
+      cvarStore.update(ptr<vmCvar_t>(a[0]));
+      return 0;
+    case CG_CVAR_SET:
+      count(command, std::strlen(str(a[0])) + std::strlen(str(a[1])));
+      cvarStore.set(str(a[0]), str(a[1]));
+      return 0;
+    case CG_CVAR_VARIABLESTRINGBUFFER:
+    case CG_CVAR_LATCHEDVARIABLESTRINGBUFFER: {
+      const auto value = cvarStore.get(str(a[0]));
+      count(command, value.size());
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]), value);
+      return 0;
+    }
+
+    case CG_ARGC:
+      return 0;
+    case CG_ARGV:
+    case CG_ARGS:
+      copyString(ptr<char>(command == CG_ARGV ? a[1] : a[0]),
+                 static_cast<int>(command == CG_ARGV ? a[2] : a[1]), "");
+      return 0;
+
+    case CG_FS_FOPENFILE:
+      return files.open(str(a[0]), ptr<fileHandle_t>(a[1]),
+                        static_cast<fsMode_t>(a[2]));
+    case CG_FS_READ:
+      files.read(ptr<void>(a[0]), static_cast<int>(a[1]),
+                 static_cast<fileHandle_t>(a[2]));
+      return 0;
+    case CG_FS_WRITE:
+      return files.write(ptr<const void>(a[0]), static_cast<int>(a[1]),
+                         static_cast<fileHandle_t>(a[2]));
+    case CG_FS_FCLOSEFILE:
+      files.close(static_cast<fileHandle_t>(a[0]));
+      return 0;
+    case CG_FS_GETFILELIST:
+      return files.list(str(a[0]), str(a[1]), ptr<char>(a[2]),
+                        static_cast<int>(a[3]));
+    case CG_FS_DELETEFILE:
+      return files.remove(str(a[0]));
+
+    case CG_SENDCONSOLECOMMAND:
+      if (verbose) {
+        std::printf("console command: %s\n", str(a[0]));
+      }
+      return 0;
+    case CG_SENDCLIENTCOMMAND:
+      if (verbose) {
+        std::printf("client command: %s\n", str(a[0]));
+      }
+      return 0;
+    case CG_ADDCOMMAND:
+    case CG_REMOVECOMMAND:
+    case CG_UPDATESCREEN:
+    case CG_PUMPEVENTLOOP:
+      return 0;
+
+    case CG_CM_LOADMAP:
+      return 0;
+    case CG_CM_NUMINLINEMODELS:
+      count(command);
+      return 1;
+    case CG_CM_INLINEMODEL:
+      count(command);
+      return a[0];
+    case CG_CM_TEMPBOXMODEL:
+      count(command);
+      return tempBoxModel(ptr<const float>(a[0]), ptr<const float>(a[1]),
+                          BOX_MODEL_HANDLE);
+    case CG_CM_TEMPCAPSULEMODEL:
+      count(command);
+      return tempBoxModel(ptr<const float>(a[0]), ptr<const float>(a[1]),
+                          CAPSULE_MODEL_HANDLE);
+    case CG_CM_POINTCONTENTS:
+      count(command);
+      return pointContents(ptr<const float>(a[0]),
+                           static_cast<clipHandle_t>(a[1]), nullptr);
+    case CG_CM_TRANSFORMEDPOINTCONTENTS:
+      count(command);
+      return pointContents(ptr<const float>(a[0]),
+                           static_cast<clipHandle_t>(a[1]),
+                           ptr<const float>(a[2]));
+    case CG_CM_BOXTRACE:
+    case CG_CM_CAPSULETRACE:
+      count(command, sizeof(trace_t));
+      boxTrace(ptr<trace_t>(a[0]), ptr<const float>(a[1]),
+               ptr<const float>(a[2]), ptr<const float>(a[3]),
+               ptr<const float>(a[4]), static_cast<clipHandle_t>(a[5]),
+               static_cast<int>(a[6]), nullptr);
+      return 0;
+    case CG_CM_TRANSFORMEDBOXTRACE:
+    case CG_CM_TRANSFORMEDCAPSULETRACE:
+      count(command, sizeof(trace_t));
+      boxTrace(ptr<trace_t>(a[0]), ptr<const float>(a[1]),
+               ptr<const float>(a[2]), ptr<const float>(a[3]),
+               ptr<const float>(a[4]), static_cast<clipHandle_t>(a[5]),
+               static_cast<int>(a[6]), ptr<const float>(a[7]));
+      return 0;
+    case CG_CM_MARKFRAGMENTS:
+      // no surfaces to project marks onto
+      count(command, a[0] * sizeof(vec3_t));
+      return 0;
+
+    case CG_R_LOADWORLDMAP:
+      return 0;
+    case CG_R_REGISTERMODEL:
+    case CG_R_REGISTERSKIN:
+    case CG_R_REGISTERSHADER:
+    case CG_R_REGISTERSHADERNOMIP:
+      count(command);
+      // unused item models are registered as null names
+      return str(a[0]) && str(a[0])[0] ? registerName(str(a[0])) : 0;
+    case CG_R_REGISTERFONT:
+      count(command, sizeof(fontInfo_t));
+      registerFont(str(a[0]), static_cast<int>(a[1]), ptr<fontInfo_t>(a[2]));
+      return 0;
+
+    case CG_R_CLEARSCENE:
+    case CG_R_CLEARDECALS:
+    case CG_R_SAVEVIEWPARMS:
+    case CG_R_RESTOREVIEWPARMS:
+    case CG_R_SETFOG:
+    case CG_R_SETGLOBALFOG:
+    case CG_R_REMAP_SHADER:
+      count(command);
+      return 0;
+    case CG_R_ADDREFENTITYTOSCENE:
+      count(command, sizeof(refEntity_t));
+      return 0;
+    case CG_R_ADDPOLYTOSCENE:
+      count(command, a[1] * sizeof(polyVert_t));
+      return 0;
+    case CG_R_ADDPOLYSTOSCENE:
+      count(command, a[1] * a[3] * sizeof(polyVert_t));
+      return 0;
+    case CG_R_ADDPOLYBUFFERTOSCENE: {
+      const auto buffer = ptr<const polyBuffer_t>(a[0]);
+      count(command, buffer->numVerts * (sizeof(vec4_t) + sizeof(vec2_t) +
+                                         4 * sizeof(byte)) +
+                         buffer->numIndicies * sizeof(int));
+      return 0;
+    }
+    case CG_R_ADDLIGHTTOSCENE:
+      count(command, sizeof(vec3_t) + 5 * sizeof(float) + 2 * sizeof(int));
+      return 0;
+    case CG_R_ADDCORONATOSCENE:
+      count(command, sizeof(vec3_t) + 4 * sizeof(float) + 2 * sizeof(int));
+      return 0;
+    case CG_R_RENDERSCENE:
+      count(command, sizeof(refdef_t));
+      return 0;
+    case CG_R_PROJECTDECAL:
+      count(command, a[1] * sizeof(vec3_t) + 2 * sizeof(vec4_t));
+      return 0;
+
+    case CG_R_SETCOLOR:
+      count(command, a[0] ? sizeof(vec4_t) : 0);
+      return 0;
+    case CG_R_DRAWSTRETCHPIC:
+      count(command, 8 * sizeof(float) + sizeof(qhandle_t));
+      return 0;
+    case CG_R_DRAWROTATEDPIC:
+      count(command, 9 * sizeof(float) + sizeof(qhandle_t));
+      return 0;
+    case CG_R_DRAWSTRETCHPIC_GRADIENT:
+      count(command, 8 * sizeof(float) + sizeof(qhandle_t) + sizeof(vec4_t) +
+                         sizeof(int));
+      return 0;
+    case CG_R_DRAW2DPOLYS:
+      count(command, a[1] * sizeof(polyVert_t));
+      return 0;
+
+    case CG_R_MODELBOUNDS: {
+      count(command);
+      auto mins = ptr<float>(a[1]);
+      auto maxs = ptr<float>(a[2]);
+      VectorSet(mins, -16, -16, -16);
+      VectorSet(maxs, 16, 16, 16);
+      return 0;
+    }
+    case CG_R_LERPTAG: {
+      // every model has each tag once, at the model origin. Like the
+      // engine, return the index of the tag found or -1, callers loop
+      // over startIndex until no more tags match
+      count(command, sizeof(orientation_t));
+      auto tag = ptr<orientation_t>(a[0]);
+      VectorClear(tag->origin);
+      AxisClear(tag->axis);
+      return a[3] == 0 ? 0 : -1;
+    }
+    case CG_R_LIGHTFORPOINT:
+    case CG_R_GETSKINMODEL:
+    case CG_R_GETMODELSHADER:
+      count(command);
+      return 0;
+    case CG_R_INPVS:
+      count(command);
+      return qtrue;
+    case CG_R_LOADDYNAMICSHADER:
+    case CG_R_RENDERTOTEXTURE:
+    case CG_R_GETTEXTUREID:
+    case CG_R_FINISH:
+      return 0;
+
+    case CG_GETGLCONFIG:
+      getGlconfig(ptr<glconfig_t>(a[0]));
+      return 0;
+    case CG_GETGAMESTATE:
+      getGameState(ptr<gameState_t>(a[0]));
+      return 0;
+    case CG_GET_ENTITY_TOKEN:
+      return entityTokens.next(ptr<char>(a[0]), static_cast<int>(a[1]));
+
+    case CG_GETCURRENTSNAPSHOTNUMBER:
+      *ptr<int>(a[0]) = snapshotCount;
+      *ptr<int>(a[1]) =
+          snapshotCount > 0
+              ? snapshots[(snapshotCount - 1) % PACKET_BACKUP].serverTime
+              : 0;
+      return 0;
+    case CG_GETSNAPSHOT: {
+      const int number = static_cast<int>(a[0]);
+      if (number < 1 || number > snapshotCount ||
+          number <= snapshotCount - PACKET_BACKUP) {
+        return qfalse;
+      }
+      // snapshot numbers start from 1, 0 means none received
+      *ptr<snapshot_t>(a[1]) = snapshots[(number - 1) % PACKET_BACKUP];
+      return qtrue;
+    }
+    case CG_GETSERVERCOMMAND:
+      return qfalse;
+    case CG_GETCURRENTCMDNUMBER:
+      return usercmdCount;
+    case CG_GETUSERCMD: {
+      const int number = static_cast<int>(a[0]);
+      if (number < 1 || number > usercmdCount ||
+          number <= usercmdCount - CMD_BACKUP) {
+        return qfalse;
+      }
+      *ptr<usercmd_t>(a[1]) = usercmds[(number - 1) % CMD_BACKUP];
+      return qtrue;
+    }
+    case CG_SETUSERCMDVALUE:
+    case CG_SETCLIENTLERPORIGIN:
+      return 0;
+
+    case CG_MEMORY_REMAINING:
+      return 64 * 1024 * 1024;
+    case CG_GETHUNKDATA:
+      *ptr<int>(a[0]) = 0;
+      *ptr<int>(a[1]) = -1;
+      return 0;
+
+    case CG_KEY_ISDOWN:
+    case CG_KEY_GETCATCHER:
+    case CG_KEY_SETCATCHER:
+    case CG_KEY_GETOVERSTRIKEMODE:
+    case CG_KEY_SETOVERSTRIKEMODE:
+    case CG_KEY_SETBINDING:
+      return 0;
+    case CG_KEY_GETKEY:
+      return -1;
+    case CG_KEY_BINDINGTOKEYS:
+      *ptr<int>(a[1]) = -1;
+      *ptr<int>(a[2]) = -1;
+      return 0;
+    case CG_KEY_GETBINDINGBUF:
+    case CG_KEY_KEYNUMTOSTRINGBUF:
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]), "");
+      return 0;
+    case CG_TRANSLATE_STRING:
+      copyString(ptr<char>(a[1]), MAX_STRING_CHARS, str(a[0]));
+      return 0;
+
+    case CG_PC_ADD_GLOBAL_DEFINE:
+      return 1;
+    case CG_PC_LOAD_SOURCE:
+      return files.loadSource(str(a[0]));
+    case CG_PC_FREE_SOURCE:
+      files.freeSource(static_cast<int>(a[0]));
+      return 0;
+    case CG_PC_READ_TOKEN:
+      return files.readToken(static_cast<int>(a[0]), ptr<pc_token_t>(a[1]));
+    case CG_PC_SOURCE_FILE_AND_LINE:
+      return files.sourceFileAndLine(static_cast<int>(a[0]), ptr<char>(a[1]),
+                                     ptr<int>(a[2]));
+    case CG_PC_UNREAD_TOKEN:
+      files.unreadToken(static_cast<int>(a[0]));
+      return 0;
+
+    default:
+      // sound, cinematics, cameras and popups have no visible effect
+      // on what gets submitted to the renderer
+      if ((command >= CG_S_STARTSOUND && command <= CG_S_GETCURRENTSOUNDTIME) ||
+          command == CG_S_STOPBACKGROUNDTRACK ||
+          command == CG_S_ADDREALLOOPINGSOUND ||
+          command == CG_S_STOPSTREAMINGSOUND ||
+          (command >= CG_CIN_PLAYCINEMATIC && command <= CG_CIN_SETEXTENTS) ||
+          (command >= CG_LOADCAMERA && command <= CG_GETCAMERAINFO) ||
+          command == CG_INGAME_POPUP || command == CG_INGAME_CLOSEPOPUP ||
+          command == CG_SENDMESSAGE || command == CG_MESSAGESTATUS) {
+        // a zero sound handle makes the cgame warn on every register
+        return command == CG_S_REGISTERSOUND && str(a[0]) && str(a[0])[0]
+                   ? registerName(str(a[0]))
+                   : 0;
+      }
+      unhandledCalls++;
+      if (verbose) {
+        std::printf("unhandled syscall %d\n", static_cast<int>(command));
+      }
+      return 0;
+  }
+}
+} // namespace CgameHarness
+} // namespace ETJump
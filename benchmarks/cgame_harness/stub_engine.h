@@ -0,0 +1,144 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// cg_public.h has no include guard, cg_local.h brings it in once
+#include "../../src/cgame/cg_local.h"
+#include "../harness_common/box_world.h"
+#include "../harness_common/cvar_store.h"
+#include "../harness_common/entity_tokens.h"
+#include "../harness_common/stub_file_system.h"
+
+namespace ETJump {
+namespace CgameHarness {
+// thrown when the cgame calls trap_Error
+class CgameError : public std::runtime_error {
+public:
+  explicit CgameError(const std::string &message)
+      : std::runtime_error(message) {}
+};
+
+// In-process replacement for the client side of the engine. Renderer
+// calls are not drawn but counted, together with the number of bytes
+// each call hands over to the renderer, and attributed to the scope
+// that is active when they are made. Collision runs against a
+// BoxWorld, and snapshots and usercmds are served from ring buffers
+// the harness fills on a virtual clock.
+class StubEngine {
+public:
+  static const int MAX_SYSCALLS = 256;
+  static const int PACKET_BACKUP = 32;
+  // scope that collects calls made outside of any named scope
+  static const int REST_OF_FRAME = 0;
+
+  struct Counter {
+    uint64_t calls{0};
+    uint64_t bytes{0};
+  };
+
+  using Counters = std::array<Counter, MAX_SYSCALLS>;
+
+  // single instance, the cgame calls back through a plain function
+  // pointer
+  static StubEngine &instance();
+  static intptr_t QDECL syscall(intptr_t command, ...);
+
+  // report name of the renderer, collision and cvar syscalls,
+  // nullptr for everything else
+  static const char *syscallName(int command);
+
+  // clears all state and roots the file system at homePath/etjump,
+  // reads fall back to readPaths
+  void reset(const std::string &homePath, const std::string &mapName,
+             const std::vector<std::string> &readPaths = {});
+
+  Harness::CvarStore &cvars();
+  Harness::StubFileSystem &fileSystem();
+  Harness::BoxWorld &world();
+  // entity string returned through trap_GetEntityToken
+  void setEntityString(const std::string &entities);
+  void setConfigstring(int index, const std::string &value);
+
+  // snapshots and usercmds age out like in the engine, the cgame can
+  // only fetch the last PACKET_BACKUP and CMD_BACKUP of them
+  void addSnapshot(const snapshot_t &snapshot);
+  void addUsercmd(const usercmd_t &cmd);
+
+  void setTime(int time);
+  void setVerbose(bool verbose);
+
+  // names a scope and returns its id, calls are counted per scope
+  int addScope(const std::string &name);
+  void setScope(int scope);
+  int scope() const;
+  const std::vector<std::string> &scopeNames() const;
+  const Counters &counters(int scope) const;
+  void clearCounters();
+
+  uint64_t unhandled() const;
+
+private:
+  StubEngine() = default;
+
+  intptr_t dispatch(intptr_t command, const intptr_t *args);
+  void count(intptr_t command, uint64_t bytes = 0);
+
+  qhandle_t registerName(const char *name);
+  void registerFont(const char *fontName, int pointSize, fontInfo_t *font);
+  void getGameState(gameState_t *gameState) const;
+  void getGlconfig(glconfig_t *glconfig) const;
+
+  clipHandle_t tempBoxModel(const vec3_t mins, const vec3_t maxs,
+                            clipHandle_t handle);
+  void boxTrace(trace_t *results, const vec3_t start, const vec3_t end,
+                const vec3_t mins, const vec3_t maxs, clipHandle_t model,
+                int brushMask, const vec3_t origin) const;
+  int pointContents(const vec3_t point, clipHandle_t model,
+                    const vec3_t origin) const;
+
+  Harness::CvarStore cvarStore;
+  Harness::StubFileSystem files;
+  Harness::EntityTokens entityTokens;
+  Harness::BoxWorld boxWorld;
+
+  std::vector<std::string> configstrings;
+  std::map<std::string, qhandle_t> registeredNames;
+  // last box given out for each temporary model handle
+  std::map<clipHandle_t, Harness::Box> tempModels;
+
+  std::vector<snapshot_t> snapshots;
+  int snapshotCount{0};
+  std::vector<usercmd_t> usercmds;
+  int usercmdCount{0};
+
+  std::vector<std::string> names;
+  std::vector<Counters> scopeCounters;
+  int currentScope{REST_OF_FRAME};
+  uint64_t unhandledCalls{0};
+
+  int time{0};
+  bool verbose{false};
+};
+
+// counts calls made while in scope against the given scope
+class ScopeGuard {
+public:
+  explicit ScopeGuard(int scope)
+      : previous(StubEngine::instance().scope()) {
+    StubEngine::instance().setScope(scope);
+  }
+  ~ScopeGuard() { StubEngine::instance().setScope(previous); }
+
+  ScopeGuard(const ScopeGuard &) = delete;
+  ScopeGuard &operator=(const ScopeGuard &) = delete;
+
+private:
+  int previous;
+};
+} // namespace CgameHarness
+} // namespace ETJump
@@ -0,0 +1,97 @@
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/game/etj_client_command_registry.h"
+
+using namespace ETJump;
+
+// every command name ClientCommand knows about, in the order the old
+// Q_stricmp chain and tables checked them
+static const char *const commandNames[] = {
+    "say", "enc_say", "say_team", "enc_say_team", "vsay", "vsay_team",
+    "say_buddy", "enc_say_buddy", "vsay_buddy", "forcetapout", "wstats",
+    "sgstats", "stshots", "score", "vote", "fireteam", "showstats", "ignore",
+    "unignore", "obj", "impkd", "imwa", "imws", "imready", "ws", "rs", "m",
+    "nogoto", "nocall", "rtvVote", "follownext", "followprev",
+    "mod_information", "backup", "save", "load", "unload", "listinfo",
+    "customvotes", "records", "times", "ranks", "top", "loadcheckpoints",
+    "load-checkpoints", "rankings", "seasons", "getchatreplay", "class",
+    "give", "god", "notarget", "noclip", "kill", "team", "where",
+    "stopcamera", "setcameraorigin", "setviewpos", "setspawnpt", "goto",
+    "call", "iwant", "shrug", "timerun_status", "setoffset", "interruptRun",
+    "tracker_print", "tracker_set", "clearsaves", "?", "bottomshots",
+    "callvote", "cv", "commands", "follow", "notready", "players", "ready",
+    "say_teamnl", "scores", "specinvite", "specuninvite", "speclock",
+    "specunlock", "speclist", "statsall", "topshots", "unready",
+    "weaponstats"};
+
+// hand written approximation of the commands a busy trickjump server
+// sees, dominated by save/load spam with chat, score polling and the odd
+// unknown command, not a real capture
+static const char *const commandMix[] = {
+    "save", "load", "load", "save", "load", "score", "say", "load", "backup",
+    "load", "save", "load", "m", "load", "timerun_status", "save", "load",
+    "load", "vsay", "score", "load", "save", "load", "follow", "say_team",
+    "load", "records", "save", "load", "goto", "load", "imready", "save",
+    "load", "load", "mod_information", "score", "load", "save", "load",
+    "interruptrun", "LOAD", "save", "load", "callvote", "load", "vote",
+    "save", "load", "team", "unknown_cmd", "load", "save", "say", "load"};
+
+static const int NUM_MIX = sizeof(commandMix) / sizeof(commandMix[0]);
+
+static int stricmp(const char *lhs, const char *rhs) {
+  for (;; ++lhs, ++rhs) {
+    const int l = std::tolower(static_cast<unsigned char>(*lhs));
+    const int r = std::tolower(static_cast<unsigned char>(*rhs));
+    if (l != r || !l) {
+      return l - r;
+    }
+  }
+}
+
+// what ClientCommand did before the registry, a case-insensitive
+// compare against every command until a match was found
+ETJ_BENCHMARK(ClientCommand_LinearScan) {
+  int found = 0;
+  while (state.keepRunning()) {
+    for (const auto cmd : commandMix) {
+      for (const auto name : commandNames) {
+        if (!stricmp(cmd, name)) {
+          found++;
+          break;
+        }
+      }
+    }
+  }
+
+  Benchmark::doNotOptimize(found);
+  state.setItemsProcessed(state.iterations() * NUM_MIX);
+}
+
+ETJ_BENCHMARK(ClientCommand_RegistryLookup) {
+  ClientCommandRegistry registry;
+  int called = 0;
+  for (const auto name : commandNames) {
+    registry.add(name, ClientCommandPhase::NoIntermission,
+                 FloodProtection::None, "",
+                 [&called](gentity_t *) { called++; });
+  }
+
+  int found = 0;
+  while (state.keepRunning()) {
+    for (const auto cmd : commandMix) {
+      // ClientCommand reads the command into a char buffer, so every
+      // lookup pays for building the key like the real call does
+      const auto command = registry.find(cmd);
+      if (command) {
+        found++;
+      }
+    }
+  }
+
+  Benchmark::doNotOptimize(found);
+  Benchmark::doNotOptimize(called);
+  state.setItemsProcessed(state.iterations() * NUM_MIX);
+}
@@ -0,0 +1,29 @@
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/cgame/etj_utilities.h"
+
+using namespace ETJump;
+
+// etj_ color cvar values in every format players use, parsed again
+// whenever one of the cvars changes
+static const std::vector<std::string> colorStrings = {
+    "white",   "Yellow",       "  red  ",       "0xff0000", "0XAABBCC",
+    "#00ff00", "#11223344",    "255 0 0",       "1.0 0.5 0.25 0.75",
+    "0 0 0 128", "mdgreen",    "not a color",   "#",        "1 1 1",
+    "orange",  "255 255 255 255"};
+
+ETJ_BENCHMARK(ColorStringParser_parseColorString) {
+  float alpha = 0;
+  while (state.keepRunning()) {
+    for (const auto &colorString : colorStrings) {
+      vec4_t color;
+      parseColorString(colorString, color);
+      alpha += color[3];
+    }
+  }
+
+  Benchmark::doNotOptimize(alpha);
+  state.setItemsProcessed(state.iterations() * colorStrings.size());
+}
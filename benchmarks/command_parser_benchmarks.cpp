@@ -0,0 +1,72 @@
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/game/etj_command_parser.h"
+
+using namespace ETJump;
+using Type = CommandParser::OptionDefinition::Type;
+
+// same options as the records command in etj_commands.cpp
+static CommandParser::CommandDefinition recordsDefinition() {
+  return CommandParser::CommandDefinition::create("records",
+                                                  "Print the timerun records.")
+      .addOption("season", "s", "Name of the season", Type::MultiToken, false)
+      .addOption("map", "m", "Name of the map", Type::MultiToken, false)
+      .addOption("run", "r", "Name of the run", Type::MultiToken, false)
+      .addOption("page", "p", "Which page to display", Type::Integer, false)
+      .addOption("page-size", "ps", "How many records to show",
+                 Type::Integer, false);
+}
+
+// same options as add-season, with the date parsing path
+static CommandParser::CommandDefinition addSeasonDefinition() {
+  return CommandParser::CommandDefinition::create("add-season",
+                                                  "Adds a new timerun season")
+      .addOption("name", "n", "Name of the season to add", Type::MultiToken,
+                 true)
+      .addOption("start-date", "sd", "Start date", Type::Date, true)
+      .addOption("end-date-exclusive", "ed", "End date", Type::Date, false);
+}
+
+// argument lists as ClientCommand hands them over after the command name
+static const std::vector<std::vector<std::string>> recordsArgs = {
+    {},
+    {"run1"},
+    {"oasis", "run1"},
+    {"--map", "oasis", "--run", "main", "run"},
+    {"--season", "summer", "2024", "--map", "pornchallenge", "--page", "2"},
+    {"-m", "uphillrun", "-r", "red", "-ps", "50"},
+    {"--run", "the", "long", "way", "round", "--page-size", "100", "-p", "3"},
+    {"--page", "notanumber"}};
+
+static const std::vector<std::vector<std::string>> addSeasonArgs = {
+    {"--name", "Winter", "2024", "--start-date", "2024-12-01"},
+    {"-n", "Summer", "-sd", "2024-06-01", "-ed", "2024-09-01"},
+    {"--name", "missing", "date"}};
+
+ETJ_BENCHMARK(CommandParser_parseRecords) {
+  const auto definition = recordsDefinition();
+  size_t options = 0;
+  while (state.keepRunning()) {
+    for (const auto &args : recordsArgs) {
+      options += CommandParser(definition, args).parse().options.size();
+    }
+  }
+
+  Benchmark::doNotOptimize(options);
+  state.setItemsProcessed(state.iterations() * recordsArgs.size());
+}
+
+ETJ_BENCHMARK(CommandParser_parseAddSeason) {
+  const auto definition = addSeasonDefinition();
+  size_t options = 0;
+  while (state.keepRunning()) {
+    for (const auto &args : addSeasonArgs) {
+      options += CommandParser(definition, args).parse().options.size();
+    }
+  }
+
+  Benchmark::doNotOptimize(options);
+  state.setItemsProcessed(state.iterations() * addSeasonArgs.size());
+}
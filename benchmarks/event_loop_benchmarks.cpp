@@ -0,0 +1,89 @@
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/cgame/etj_event_loop.h"
+
+using namespace ETJump;
+
+static const int NUM_TASKS = 10000;
+
+// schedules 10k one-shot tasks with mixed delays and drains the loop
+ETJ_BENCHMARK(EventLoop_ScheduleAndDrain10k) {
+  int64_t now = 0;
+  std::mt19937 rng(1337);
+  std::uniform_int_distribution<int> delays(0, 1000);
+  std::vector<int> taskDelays(NUM_TASKS);
+  for (auto &delay : taskDelays) {
+    delay = delays(rng);
+  }
+
+  int executed = 0;
+  while (state.keepRunning()) {
+    EventLoop loop([&now] { return now; });
+    for (const auto delay : taskDelays) {
+      loop.schedule([&executed] { executed++; }, delay);
+    }
+    while (loop.hasPendingEvents()) {
+      now += 8;
+      loop.run();
+    }
+  }
+
+  Benchmark::doNotOptimize(executed);
+  state.setItemsProcessed(state.iterations() * NUM_TASKS);
+}
+
+// one frame of a loop holding 10k persistent tasks,
+// of which roughly 1/16 are due on each frame
+ETJ_BENCHMARK(EventLoop_RunFrame10kPersistent) {
+  int64_t now = 0;
+  EventLoop loop([&now] { return now; });
+  int executed = 0;
+  for (int i = 0; i < NUM_TASKS; i++) {
+    loop.schedulePersistent([&executed] { executed++; }, 16 * (1 + i % 8));
+  }
+
+  while (state.keepRunning()) {
+    now += 1;
+    loop.run();
+  }
+
+  Benchmark::doNotOptimize(executed);
+  state.setItemsProcessed(state.iterations());
+}
+
+// frame cost of a loop with 10k pending tasks that are not due yet
+ETJ_BENCHMARK(EventLoop_RunFrame10kIdle) {
+  int64_t now = 0;
+  EventLoop loop([&now] { return now; });
+  for (int i = 0; i < NUM_TASKS; i++) {
+    loop.schedule([] {}, 1000000 + i);
+  }
+
+  while (state.keepRunning()) {
+    now += 1;
+    loop.run();
+  }
+
+  state.setItemsProcessed(state.iterations());
+}
+
+// schedules 10k tasks and cancels all of them by handle
+ETJ_BENCHMARK(EventLoop_Cancel10k) {
+  int64_t now = 0;
+  std::vector<int> handles(NUM_TASKS);
+
+  while (state.keepRunning()) {
+    EventLoop loop([&now] { return now; });
+    for (int i = 0; i < NUM_TASKS; i++) {
+      handles[i] = loop.schedule([] {}, 100 + i);
+    }
+    for (int i = NUM_TASKS - 1; i >= 0; i--) {
+      loop.unschedule(handles[i]);
+    }
+    loop.run();
+  }
+
+  state.setItemsProcessed(state.iterations() * NUM_TASKS);
+}
@@ -0,0 +1,468 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <dlfcn.h>
+#include <fstream>
+#include <ftw.h>
+#include <iostream>
+#include <json/json.h>
+
+#include "../harness_common/stand_in_assets.h"
+#include "stub_engine.h"
+#include "../../src/game/bg_public.h"
+
+// Runs the qagame module headless against StubEngine: spawns a box
+// map, connects a number of scripted clients and drives server frames
+// on a virtual clock. Per-frame wall time is reported, and a checksum
+// of the resulting player states makes it usable as a regression test.
+
+#ifndef ETJ_QAGAME_PATH
+  #define ETJ_QAGAME_PATH "qagame.mp.x86_64.so"
+#endif
+#ifndef ETJ_ASSETS_PATH
+  #define ETJ_ASSETS_PATH "assets"
+#endif
+
+using namespace ETJump::GameHarness;
+using ETJump::Harness::Box;
+using ETJump::Harness::BoxWorld;
+
+using DllEntry = void (*)(intptr_t(QDECL *)(intptr_t, ...));
+using VmMain = intptr_t (*)(int, intptr_t, intptr_t, intptr_t, intptr_t,
+                            intptr_t, intptr_t, intptr_t);
+
+struct Options {
+  std::string module = ETJ_QAGAME_PATH;
+  int clients = 16;
+  int frames = 1200;
+  int cmdMsec = 8;
+  int seed = 1;
+  bool verify = false;
+  bool verbose = false;
+  std::string jsonPath;
+};
+
+struct RunResult {
+  std::vector<double> frameNs;
+  double thinkNs{0};
+  uint64_t thinks{0};
+  uint32_t checksum{0};
+  int activeClients{0};
+  double distance{0};
+  StubEngine::Stats stats;
+};
+
+static const char *MAP_NAME = "harness";
+static const int FRAME_MSEC = 50;
+static const int SPAWN_SPOTS_PER_TEAM = 32;
+
+// 4096 unit arena with walls, a grid of crates and a few raised
+// platforms, enough geometry for pmove to collide with
+static void buildWorld(BoxWorld &world) {
+  const auto addBox = [&world](float x1, float y1, float z1, float x2,
+                               float y2, float z2) {
+    Box box{{x1, y1, z1}, {x2, y2, z2}, CONTENTS_SOLID, 0};
+    world.add(box);
+  };
+
+  addBox(-2048, -2048, -64, 2048, 2048, 0);
+  addBox(-2048, -2048, 1024, 2048, 2048, 1088);
+  addBox(-2112, -2048, 0, -2048, 2048, 1024);
+  addBox(2048, -2048, 0, 2112, 2048, 1024);
+  addBox(-2048, -2112, 0, 2048, -2048, 1024);
+  addBox(-2048, 2048, 0, 2048, 2112, 1024);
+
+  for (int x = -3; x <= 3; x++) {
+    for (int y = -3; y <= 3; y++) {
+      if (x == 0 || y == 0) {
+        continue;
+      }
+      const float cx = x * 512.0f;
+      const float cy = y * 512.0f;
+      const float height = 32.0f + 24.0f * ((x * 7 + y * 3 + 21) % 5);
+      addBox(cx - 48, cy - 48, 0, cx + 48, cy + 48, height);
+    }
+  }
+
+  addBox(-256, 1400, 0, 256, 1800, 128);
+  addBox(-256, -1800, 0, 256, -1400, 96);
+  addBox(1400, -256, 0, 1800, 256, 160);
+}
+
+static std::string entityString() {
+  std::string entities = "{\n\"classname\" \"worldspawn\"\n"
+                         "\"message\" \"harness\"\n}\n"
+                         "{\n\"classname\" \"info_player_intermission\"\n"
+                         "\"origin\" \"0 0 256\"\n}\n";
+
+  for (int team = 0; team < 2; team++) {
+    for (int i = 0; i < SPAWN_SPOTS_PER_TEAM; i++) {
+      const int x = (i % 8) * 96 - 336;
+      const int y = (i / 8) * 96 + (team == 0 ? 160 : -448);
+      entities += "{\n\"classname\" \"";
+      entities += team == 0 ? "team_CTF_redspawn" : "team_CTF_bluespawn";
+      entities += "\"\n\"spawnflags\" \"2\"\n\"origin\" \"" +
+                  std::to_string(x) + " " + std::to_string(y) + " 40\"\n}\n";
+    }
+  }
+
+  // team spawns are picked relative to the spawn objectives
+  for (int team = 0; team < 2; team++) {
+    entities += "{\n\"classname\" \"team_WOLF_objective\"\n"
+                "\"description\" \"";
+    entities += team == 0 ? "Axis spawn" : "Allied spawn";
+    entities += "\"\n\"spawnflags\" \"" + std::to_string(team + 1) +
+                "\"\n\"origin\" \"0 " +
+                std::to_string(team == 0 ? 300 : -300) + " 40\"\n}\n";
+  }
+  return entities;
+}
+
+static std::string hexId(int clientNum, uint32_t salt) {
+  char buffer[41];
+  for (int i = 0; i < 5; i++) {
+    std::snprintf(buffer + i * 8, 9, "%08X",
+                  (clientNum + 1) * 2654435761u ^ (salt * (i + 1)));
+  }
+  return buffer;
+}
+
+static std::string userinfo(int clientNum) {
+  return "\\name\\bot" + std::to_string(clientNum) + "\\ip\\10.0." +
+         std::to_string(clientNum / 250) + "." +
+         std::to_string(clientNum % 250 + 1) +
+         ":27960\\rate\\25000\\snaps\\20\\protocol\\84\\cl_guid\\" +
+         hexId(clientNum, 0x1234567);
+}
+
+// strafe jumping bot: runs forward, alternates strafe direction and
+// turns into it, holds jump in pulses
+static usercmd_t scriptedCmd(int clientNum, int serverTime, int seed) {
+  usercmd_t cmd{};
+  cmd.serverTime = serverTime;
+
+  const int phase = serverTime + clientNum * 137 + seed * 61;
+  const bool strafeRight = (phase / 700) % 2 == 0;
+  const float turn = ((phase % 700) / 700.0f) * 90.0f;
+  const float yaw = clientNum * 23.0f + (phase / 1400) * 37.0f +
+                    (strafeRight ? -turn : turn);
+
+  cmd.angles[YAW] = ANGLE2SHORT(yaw);
+  cmd.angles[PITCH] = ANGLE2SHORT(((phase / 900) % 3 - 1) * 5.0f);
+  cmd.forwardmove = 127;
+  cmd.rightmove = strafeRight ? 127 : -128;
+  cmd.upmove = (phase / 150) % 4 == 0 ? 127 : 0;
+  return cmd;
+}
+
+static uint32_t hashBytes(uint32_t hash, const void *data, size_t size) {
+  const auto bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static void clientCommand(VmMain vmMain, int clientNum,
+                          const std::vector<std::string> &args) {
+  StubEngine::instance().setArgs(args);
+  vmMain(GAME_CLIENT_COMMAND, clientNum, 0, 0, 0, 0, 0, 0);
+}
+
+static RunResult run(DllEntry dllEntry, VmMain vmMain, const Options &options,
+                     const std::string &homePath) {
+  auto &engine = StubEngine::instance();
+  engine.reset(homePath, MAP_NAME, {ETJ_ASSETS_PATH});
+  engine.setVerbose(options.verbose);
+  buildWorld(engine.world());
+  ETJump::Harness::addStandInAssets(engine.fileSystem(), MAP_NAME);
+  engine.setEntityString(entityString());
+
+  dllEntry(&StubEngine::syscall);
+
+  int levelTime = 1000;
+  engine.setTime(levelTime);
+  vmMain(GAME_INIT, levelTime, options.seed, 0, 0, 0, 0, 0);
+
+  // the server runs a few frames to let things settle before
+  // accepting clients
+  for (int i = 0; i < 3; i++) {
+    levelTime += 100;
+    engine.setTime(levelTime);
+    vmMain(GAME_RUN_FRAME, levelTime, 0, 0, 0, 0, 0, 0);
+  }
+
+  for (int i = 0; i < options.clients; i++) {
+    engine.setUserinfo(i, userinfo(i));
+    const auto reason = reinterpret_cast<const char *>(
+        vmMain(GAME_CLIENT_CONNECT, i, qtrue, qfalse, 0, 0, 0, 0));
+    if (reason) {
+      throw GameError("client " + std::to_string(i) +
+                      " was rejected: " + reason);
+    }
+    clientCommand(vmMain, i, {"authenticate", hexId(i, 0x1234567),
+                              hexId(i, 0x7654321)});
+    vmMain(GAME_CLIENT_BEGIN, i, 0, 0, 0, 0, 0, 0);
+    clientCommand(vmMain, i, {"team", i % 2 == 0 ? "r" : "b", "0"});
+  }
+
+  RunResult result;
+  result.frameNs.reserve(options.frames);
+  std::vector<int> lastCmdTime(options.clients, levelTime);
+  std::vector<std::array<float, 3>> lastOrigin(options.clients);
+  for (int i = 0; i < options.clients; i++) {
+    const playerState_t *ps = engine.playerState(i);
+    lastOrigin[i] = {ps->origin[0], ps->origin[1], ps->origin[2]};
+  }
+  uint32_t checksum = 2166136261u;
+
+  for (int frame = 0; frame < options.frames; frame++) {
+    levelTime += FRAME_MSEC;
+    engine.setTime(levelTime);
+
+    const auto frameStart = std::chrono::steady_clock::now();
+
+    // each client's usercmds arrive before the frame that follows them
+    for (int i = 0; i < options.clients; i++) {
+      while (lastCmdTime[i] + options.cmdMsec <= levelTime) {
+        lastCmdTime[i] += options.cmdMsec;
+        engine.setUsercmd(i, scriptedCmd(i, lastCmdTime[i], options.seed));
+        vmMain(GAME_CLIENT_THINK, i, 0, 0, 0, 0, 0, 0);
+        result.thinks++;
+      }
+    }
+    const auto thinkEnd = std::chrono::steady_clock::now();
+
+    vmMain(GAME_RUN_FRAME, levelTime, 0, 0, 0, 0, 0, 0);
+
+    const auto frameEnd = std::chrono::steady_clock::now();
+    result.thinkNs += std::chrono::duration<double, std::nano>(
+                          thinkEnd - frameStart)
+                          .count();
+    result.frameNs.push_back(
+        std::chrono::duration<double, std::nano>(frameEnd - frameStart)
+            .count());
+
+    for (int i = 0; i < options.clients; i++) {
+      const playerState_t *ps = engine.playerState(i);
+      checksum = hashBytes(checksum, &ps->commandTime, sizeof(ps->commandTime));
+      checksum = hashBytes(checksum, ps->origin, sizeof(ps->origin));
+      checksum = hashBytes(checksum, ps->velocity, sizeof(ps->velocity));
+      checksum = hashBytes(checksum, &ps->pm_flags, sizeof(ps->pm_flags));
+
+      const float dx = ps->origin[0] - lastOrigin[i][0];
+      const float dy = ps->origin[1] - lastOrigin[i][1];
+      result.distance += std::sqrt(dx * dx + dy * dy);
+      lastOrigin[i] = {ps->origin[0], ps->origin[1], ps->origin[2]};
+    }
+  }
+
+  for (int i = 0; i < options.clients; i++) {
+    if (engine.isDropped(i)) {
+      throw GameError("client " + std::to_string(i) +
+                      " was dropped: " + engine.dropReason(i));
+    }
+  }
+
+  for (int i = 0; i < options.clients; i++) {
+    if (engine.playerState(i)->pm_type == PM_NORMAL) {
+      result.activeClients++;
+    }
+  }
+
+  vmMain(GAME_SHUTDOWN, 0, 0, 0, 0, 0, 0, 0);
+
+  result.checksum = checksum;
+  result.stats = engine.stats();
+  return result;
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+  if (values.empty()) {
+    return 0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = static_cast<size_t>(fraction * (values.size() - 1));
+  return values[index];
+}
+
+static Json::Value report(const Options &options, const RunResult &result) {
+  double total = 0;
+  for (const auto ns : result.frameNs) {
+    total += ns;
+  }
+  const auto frames = static_cast<double>(result.frameNs.size());
+
+  Json::Value root;
+  root["clients"] = options.clients;
+  root["frames"] = options.frames;
+  root["cmd_msec"] = options.cmdMsec;
+  root["frame_ns_mean"] = frames > 0 ? total / frames : 0;
+  root["frame_ns_p50"] = percentile(result.frameNs, 0.5);
+  root["frame_ns_p95"] = percentile(result.frameNs, 0.95);
+  root["frame_ns_p99"] = percentile(result.frameNs, 0.99);
+  root["frame_ns_max"] = percentile(result.frameNs, 1.0);
+  root["active_clients"] = result.activeClients;
+  root["distance_travelled"] = result.distance;
+  root["client_thinks"] = static_cast<Json::UInt64>(result.thinks);
+  root["ns_per_think"] =
+      result.thinks > 0 ? result.thinkNs / static_cast<double>(result.thinks)
+                        : 0;
+  root["syscalls"] = static_cast<Json::UInt64>(result.stats.syscalls);
+  root["traces"] = static_cast<Json::UInt64>(result.stats.traces);
+  root["links"] = static_cast<Json::UInt64>(result.stats.links);
+  root["server_commands"] =
+      static_cast<Json::UInt64>(result.stats.serverCommands);
+  root["server_command_bytes"] =
+      static_cast<Json::UInt64>(result.stats.serverCommandBytes);
+  root["unhandled_syscalls"] =
+      static_cast<Json::UInt64>(result.stats.unhandled);
+  root["checksum"] = result.checksum;
+  return root;
+}
+
+static void printReport(const Json::Value &report) {
+  std::printf("%d clients, %d frames, %d msec commands\n",
+              report["clients"].asInt(), report["frames"].asInt(),
+              report["cmd_msec"].asInt());
+  std::printf("frame time    mean %10.1f us  p50 %10.1f us  p95 %10.1f us  "
+              "p99 %10.1f us  max %10.1f us\n",
+              report["frame_ns_mean"].asDouble() / 1000,
+              report["frame_ns_p50"].asDouble() / 1000,
+              report["frame_ns_p95"].asDouble() / 1000,
+              report["frame_ns_p99"].asDouble() / 1000,
+              report["frame_ns_max"].asDouble() / 1000);
+  std::printf("%d clients playing, %.0f units travelled\n",
+              report["active_clients"].asInt(),
+              report["distance_travelled"].asDouble());
+  std::printf("client thinks %10llu  %10.1f ns/think\n",
+              static_cast<unsigned long long>(
+                  report["client_thinks"].asUInt64()),
+              report["ns_per_think"].asDouble());
+  std::printf("syscalls %llu, traces %llu, links %llu, server commands %llu "
+              "(%llu bytes)\n",
+              static_cast<unsigned long long>(report["syscalls"].asUInt64()),
+              static_cast<unsigned long long>(report["traces"].asUInt64()),
+              static_cast<unsigned long long>(report["links"].asUInt64()),
+              static_cast<unsigned long long>(
+                  report["server_commands"].asUInt64()),
+              static_cast<unsigned long long>(
+                  report["server_command_bytes"].asUInt64()));
+  std::printf("checksum %08x\n", report["checksum"].asUInt());
+}
+
+static int removeEntry(const char *path, const struct stat *, int,
+                       struct FTW *) {
+  return std::remove(path);
+}
+
+static void removeTree(const std::string &path) {
+  nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+static void printUsage() {
+  std::cout << "usage: game_harness [--module <qagame>] [--clients <n>] "
+               "[--frames <n>] [--cmd-msec <n>] [--seed <n>] "
+               "[--json <file|->] [--verify] [--verbose]\n";
+}
+
+int main(int argc, char **argv) {
+  Options options;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--module" && i + 1 < argc) {
+      options.module = argv[++i];
+    } else if (arg == "--clients" && i + 1 < argc) {
+      options.clients = std::atoi(argv[++i]);
+    } else if (arg == "--frames" && i + 1 < argc) {
+      options.frames = std::atoi(argv[++i]);
+    } else if (arg == "--cmd-msec" && i + 1 < argc) {
+      options.cmdMsec = std::atoi(argv[++i]);
+    } else if (arg == "--seed" && i + 1 < argc) {
+      options.seed = std::atoi(argv[++i]);
+    } else if (arg == "--json" && i + 1 < argc) {
+      options.jsonPath = argv[++i];
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (arg == "--verbose") {
+      options.verbose = true;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if (options.clients < 1 || options.clients > MAX_CLIENTS ||
+      options.frames < 1 || options.cmdMsec < 1) {
+    printUsage();
+    return 1;
+  }
+
+  void *module = dlopen(options.module.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!module) {
+    std::cerr << "Could not load " << options.module << ": " << dlerror()
+              << '\n';
+    return 1;
+  }
+
+  const auto dllEntry = reinterpret_cast<DllEntry>(dlsym(module, "dllEntry"));
+  const auto vmMain = reinterpret_cast<VmMain>(dlsym(module, "vmMain"));
+  if (!dllEntry || !vmMain) {
+    std::cerr << options.module << " does not export dllEntry/vmMain\n";
+    return 1;
+  }
+
+  char tempPath[] = "/tmp/etjump-harness-XXXXXX";
+  if (!mkdtemp(tempPath)) {
+    std::cerr << "Could not create a temporary directory\n";
+    return 1;
+  }
+
+  int status = 0;
+  try {
+    const auto result =
+        run(dllEntry, vmMain, options, std::string(tempPath) + "/run0");
+    const auto json = report(options, result);
+    printReport(json);
+
+    // a map restart into an identical run must reproduce every
+    // player state bit for bit
+    if (options.verify) {
+      const auto rerun =
+          run(dllEntry, vmMain, options, std::string(tempPath) + "/run1");
+      if (rerun.checksum != result.checksum) {
+        std::printf("verify failed: checksum %08x != %08x\n", rerun.checksum,
+                    result.checksum);
+        status = 1;
+      } else {
+        std::printf("verify passed\n");
+      }
+    }
+
+    if (!options.jsonPath.empty()) {
+      Json::StreamWriterBuilder builder;
+      builder["indentation"] = "  ";
+      const auto output = Json::writeString(builder, json);
+      if (options.jsonPath == "-") {
+        std::cout << output << '\n';
+      } else {
+        std::ofstream file(options.jsonPath);
+        file << output << '\n';
+      }
+    }
+  } catch (const GameError &error) {
+    std::cerr << "Game error: " << error.what() << '\n';
+    // like the engine, never touch the module again after trap_Error,
+    // its static destructors would run on half initialized state
+    removeTree(tempPath);
+    std::fflush(stdout);
+    std::_Exit(1);
+  }
+
+  removeTree(tempPath);
+  return status;
+}
@@ -0,0 +1,410 @@
+#include <cstring>
+
+#include "../harness_common/syscall_args.h"
+#include "stub_engine.h"
+
+namespace ETJump {
+namespace GameHarness {
+using namespace Harness;
+
+StubEngine &StubEngine::instance() {
+  static StubEngine engine;
+  return engine;
+}
+
+intptr_t QDECL StubEngine::syscall(intptr_t command, ...) {
+  intptr_t args[MAX_SYSCALL_ARGS]{};
+
+  va_list ap;
+  va_start(ap, command);
+  readSyscallArgs(ap, args);
+  va_end(ap);
+
+  return instance().dispatch(command, args);
+}
+
+void StubEngine::reset(const std::string &homePath, const std::string &mapName,
+                       const std::vector<std::string> &readPaths) {
+  files.reset(homePath + "/etjump", readPaths);
+  cvarStore.clear();
+  configstrings.assign(MAX_CONFIGSTRINGS, "");
+  userinfos.assign(MAX_CLIENTS, "");
+  usercmds.assign(MAX_CLIENTS, usercmd_t{});
+  dropReasons.assign(MAX_CLIENTS, "");
+  args.clear();
+  entityTokens.set("");
+  boxWorld.clear();
+
+  gameEntities = nullptr;
+  gameEntityCount = 0;
+  gameEntitySize = 0;
+  gameClients = nullptr;
+  gameClientSize = 0;
+
+  time = 0;
+  counters = Stats{};
+
+  cvarStore.set("fs_homepath", homePath);
+  cvarStore.set("fs_basepath", homePath);
+  cvarStore.set("fs_game", "etjump");
+  cvarStore.set("dedicated", "2");
+  cvarStore.set("sv_maxclients", std::to_string(MAX_CLIENTS));
+  cvarStore.set("sv_fps", "20");
+  cvarStore.registerCvar(nullptr, "mapname", mapName.c_str(),
+                         CVAR_SERVERINFO);
+  cvarStore.set("mapname", mapName);
+  cvarStore.registerCvar(nullptr, "sv_hostname", "harness", CVAR_SERVERINFO);
+  cvarStore.registerCvar(nullptr, "protocol", "84", CVAR_SERVERINFO);
+}
+
+CvarStore &StubEngine::cvars() { return cvarStore; }
+
+StubFileSystem &StubEngine::fileSystem() { return files; }
+
+BoxWorld &StubEngine::world() { return boxWorld; }
+
+void StubEngine::setEntityString(const std::string &entities) {
+  entityTokens.set(entities);
+}
+
+void StubEngine::setUserinfo(int clientNum, const std::string &userinfo) {
+  userinfos[clientNum] = userinfo;
+}
+
+void StubEngine::setUsercmd(int clientNum, const usercmd_t &cmd) {
+  usercmds[clientNum] = cmd;
+}
+
+void StubEngine::setArgs(const std::vector<std::string> &arguments) {
+  args = arguments;
+}
+
+void StubEngine::setTime(int serverTime) { time = serverTime; }
+
+void StubEngine::setVerbose(bool enabled) { verbose = enabled; }
+
+bool StubEngine::isDropped(int clientNum) const {
+  return !dropReasons[clientNum].empty();
+}
+
+const std::string &StubEngine::dropReason(int clientNum) const {
+  return dropReasons[clientNum];
+}
+
+sharedEntity_t *StubEngine::entity(int num) const {
+  return reinterpret_cast<sharedEntity_t *>(gameEntities +
+                                            num * gameEntitySize);
+}
+
+playerState_t *StubEngine::playerState(int clientNum) const {
+  return reinterpret_cast<playerState_t *>(gameClients +
+                                           clientNum * gameClientSize);
+}
+
+int StubEngine::numEntities() const { return gameEntityCount; }
+
+const StubEngine::Stats &StubEngine::stats() const { return counters; }
+
+void StubEngine::locateGameData(void *entities, int numEntities,
+                                int entitySize, void *clients,
+                                int clientSize) {
+  gameEntities = static_cast<char *>(entities);
+  gameEntityCount = numEntities;
+  gameEntitySize = entitySize;
+  gameClients = static_cast<char *>(clients);
+  gameClientSize = clientSize;
+}
+
+void StubEngine::linkEntity(sharedEntity_t *ent) {
+  counters.links++;
+
+  // same one unit padding the engine adds to the absolute box
+  for (int i = 0; i < 3; i++) {
+    ent->r.absmin[i] = ent->r.currentOrigin[i] + ent->r.mins[i] - 1;
+    ent->r.absmax[i] = ent->r.currentOrigin[i] + ent->r.maxs[i] + 1;
+  }
+  ent->r.linked = qtrue;
+  ent->r.linkcount++;
+}
+
+void StubEngine::unlinkEntity(sharedEntity_t *ent) { ent->r.linked = qfalse; }
+
+void StubEngine::trace(trace_t *results, const vec3_t start,
+                       const vec3_t mins, const vec3_t maxs,
+                       const vec3_t end, int passEntityNum,
+                       int contentMask) {
+  static const vec3_t origin = {0, 0, 0};
+  counters.traces++;
+
+  if (!mins) {
+    mins = origin;
+  }
+  if (!maxs) {
+    maxs = origin;
+  }
+
+  trace_t tr{};
+  tr.fraction = 1;
+  tr.entityNum = ENTITYNUM_NONE;
+
+  boxWorld.trace(start, end, mins, maxs, contentMask, tr);
+
+  int passOwnerNum = -1;
+  if (passEntityNum >= 0 && passEntityNum < ENTITYNUM_MAX_NORMAL &&
+      passEntityNum < gameEntityCount) {
+    passOwnerNum = entity(passEntityNum)->r.ownerNum;
+    if (passOwnerNum == ENTITYNUM_NONE) {
+      passOwnerNum = -1;
+    }
+  }
+
+  for (int i = 0; i < gameEntityCount && !tr.allsolid; i++) {
+    const sharedEntity_t *ent = entity(i);
+    if (!ent->r.linked || !(ent->r.contents & contentMask)) {
+      continue;
+    }
+    if (passEntityNum != ENTITYNUM_NONE &&
+        (i == passEntityNum || ent->r.ownerNum == passEntityNum ||
+         ent->r.ownerNum == passOwnerNum || i == passOwnerNum)) {
+      continue;
+    }
+
+    Box box{};
+    for (int j = 0; j < 3; j++) {
+      box.mins[j] = ent->r.currentOrigin[j] + ent->r.mins[j];
+      box.maxs[j] = ent->r.currentOrigin[j] + ent->r.maxs[j];
+    }
+    box.contents = ent->r.contents;
+    BoxWorld::clipToBox(box, start, end, mins, maxs, i, tr);
+  }
+
+  for (int i = 0; i < 3; i++) {
+    tr.endpos[i] = start[i] + tr.fraction * (end[i] - start[i]);
+  }
+  *results = tr;
+}
+
+int StubEngine::pointContents(const vec3_t point, int passEntityNum) const {
+  int contents = boxWorld.pointContents(point);
+
+  for (int i = 0; i < gameEntityCount; i++) {
+    const sharedEntity_t *ent = entity(i);
+    if (i == passEntityNum || !ent->r.linked) {
+      continue;
+    }
+    Box box{};
+    for (int j = 0; j < 3; j++) {
+      box.mins[j] = ent->r.currentOrigin[j] + ent->r.mins[j];
+      box.maxs[j] = ent->r.currentOrigin[j] + ent->r.maxs[j];
+    }
+    if (BoxWorld::contains(box, point)) {
+      contents |= ent->r.contents;
+    }
+  }
+  return contents;
+}
+
+int StubEngine::entitiesInBox(const vec3_t mins, const vec3_t maxs,
+                              int *list, int maxCount) const {
+  int count = 0;
+  for (int i = 0; i < gameEntityCount && count < maxCount; i++) {
+    const sharedEntity_t *ent = entity(i);
+    if (ent->r.linked &&
+        BoxWorld::overlaps(mins, maxs, ent->r.absmin, ent->r.absmax)) {
+      list[count++] = i;
+    }
+  }
+  return count;
+}
+
+int StubEngine::entityContact(const vec3_t mins, const vec3_t maxs,
+                              const sharedEntity_t *ent) const {
+  return BoxWorld::overlaps(mins, maxs, ent->r.absmin, ent->r.absmax) ? qtrue
+                                                                      : qfalse;
+}
+
+intptr_t StubEngine::dispatch(intptr_t command, const intptr_t *a) {
+  counters.syscalls++;
+
+  switch (command) {
+    case G_PRINT:
+      if (verbose) {
+        std::fputs(str(a[0]), stdout);
+      }
+      return 0;
+    case G_ERROR:
+      throw GameError(str(a[0]));
+    case G_MILLISECONDS:
+      return time;
+
+    case G_CVAR_REGISTER:
+      cvarStore.registerCvar(ptr<vmCvar_t>(a[0]), str(a[1]), str(a[2]),
+                             static_cast<int>(a[3]));
+      return 0;
+    case G_CVAR_UPDATE:
+      cvarStore.update(ptr<vmCvar_t>(a[0]));
+      return 0;
+    case G_CVAR_SET:
+      cvarStore.set(str(a[0]), str(a[1]));
+      return 0;
+    case G_CVAR_VARIABLE_INTEGER_VALUE:
+      return std::atoi(cvarStore.get(str(a[0])).c_str());
+    case G_CVAR_VARIABLE_STRING_BUFFER:
+    case G_CVAR_LATCHEDVARIABLESTRINGBUFFER:
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]),
+                 cvarStore.get(str(a[0])));
+      return 0;
+
+    case G_ARGC:
+      return static_cast<intptr_t>(args.size());
+    case G_ARGV: {
+      const auto n = static_cast<size_t>(a[0]);
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]),
+                 n < args.size() ? args[n] : "");
+      return 0;
+    }
+
+    case G_FS_FOPEN_FILE:
+      return files.open(str(a[0]), ptr<fileHandle_t>(a[1]),
+                        static_cast<fsMode_t>(a[2]));
+    case G_FS_READ:
+      files.read(ptr<void>(a[0]), static_cast<int>(a[1]),
+                 static_cast<fileHandle_t>(a[2]));
+      return 0;
+    case G_FS_WRITE:
+      return files.write(ptr<const void>(a[0]), static_cast<int>(a[1]),
+                         static_cast<fileHandle_t>(a[2]));
+    case G_FS_RENAME:
+      return files.rename(str(a[0]), str(a[1]));
+    case G_FS_FCLOSE_FILE:
+      files.close(static_cast<fileHandle_t>(a[0]));
+      return 0;
+    case G_FS_GETFILELIST:
+      return files.list(str(a[0]), str(a[1]), ptr<char>(a[2]),
+                        static_cast<int>(a[3]));
+
+    case G_SEND_CONSOLE_COMMAND:
+      if (verbose) {
+        std::printf("console command: %s", str(a[1]));
+      }
+      return 0;
+    case G_LOCATE_GAME_DATA:
+      locateGameData(ptr<void>(a[0]), static_cast<int>(a[1]),
+                     static_cast<int>(a[2]), ptr<void>(a[3]),
+                     static_cast<int>(a[4]));
+      return 0;
+    case G_DROP_CLIENT:
+      dropReasons[a[0]] = str(a[1]);
+      return 0;
+    case G_SEND_SERVER_COMMAND:
+      counters.serverCommands++;
+      counters.serverCommandBytes += std::strlen(str(a[1]));
+      return 0;
+
+    case G_SET_CONFIGSTRING:
+      configstrings[a[0]] = a[1] ? str(a[1]) : "";
+      return 0;
+    case G_GET_CONFIGSTRING:
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]), configstrings[a[0]]);
+      return 0;
+    case G_GET_USERINFO:
+      copyString(ptr<char>(a[1]), static_cast<int>(a[2]), userinfos[a[0]]);
+      return 0;
+    case G_SET_USERINFO:
+      userinfos[a[0]] = str(a[1]);
+      return 0;
+    case G_GET_SERVERINFO:
+      copyString(ptr<char>(a[0]), static_cast<int>(a[1]),
+                 cvarStore.infoString(CVAR_SERVERINFO));
+      return 0;
+
+    case G_SET_BRUSH_MODEL: {
+      // no inline models in a box world, brush entities become points
+      auto ent = ptr<sharedEntity_t>(a[0]);
+      ent->r.bmodel = qtrue;
+      VectorClear(ent->r.mins);
+      VectorClear(ent->r.maxs);
+      return 0;
+    }
+    case G_TRACE:
+    case G_TRACECAPSULE:
+      trace(ptr<trace_t>(a[0]), ptr<const float>(a[1]),
+            ptr<const float>(a[2]), ptr<const float>(a[3]),
+            ptr<const float>(a[4]), static_cast<int>(a[5]),
+            static_cast<int>(a[6]));
+      return 0;
+    case G_POINT_CONTENTS:
+      return pointContents(ptr<const float>(a[0]), static_cast<int>(a[1]));
+    case G_IN_PVS:
+    case G_IN_PVS_IGNORE_PORTALS:
+    case G_AREAS_CONNECTED:
+      return qtrue;
+    case G_ADJUST_AREA_PORTAL_STATE:
+      return 0;
+    case G_LINKENTITY:
+      linkEntity(ptr<sharedEntity_t>(a[0]));
+      return 0;
+    case G_UNLINKENTITY:
+      unlinkEntity(ptr<sharedEntity_t>(a[0]));
+      return 0;
+    case G_ENTITIES_IN_BOX:
+      return entitiesInBox(ptr<const float>(a[0]), ptr<const float>(a[1]),
+                           ptr<int>(a[2]), static_cast<int>(a[3]));
+    case G_ENTITY_CONTACT:
+    case G_ENTITY_CONTACTCAPSULE:
+      return entityContact(ptr<const float>(a[0]), ptr<const float>(a[1]),
+                           ptr<const sharedEntity_t>(a[2]));
+
+    case G_GET_USERCMD:
+      *ptr<usercmd_t>(a[1]) = usercmds[a[0]];
+      return 0;
+    case G_GET_ENTITY_TOKEN:
+      return entityTokens.next(ptr<char>(a[0]), static_cast<int>(a[1]));
+
+    case G_REAL_TIME:
+      return realTime(ptr<qtime_t>(a[0]));
+    case G_SNAPVECTOR:
+      snapVector(ptr<float>(a[0]));
+      return 0;
+
+    case G_GETTAG:
+    case G_REGISTERTAG:
+    case G_REGISTERSOUND:
+    case G_GET_SOUND_LENGTH:
+    case G_DEBUG_POLYGON_CREATE:
+    case G_DEBUG_POLYGON_DELETE:
+    case G_BOT_ALLOCATE_CLIENT:
+    case G_BOT_FREE_CLIENT:
+    case PB_STAT_REPORT:
+    case G_SENDMESSAGE:
+    case G_MESSAGESTATUS:
+      return 0;
+
+    case BOTLIB_PC_LOAD_SOURCE:
+      return files.loadSource(str(a[0]));
+    case BOTLIB_PC_FREE_SOURCE:
+      files.freeSource(static_cast<int>(a[0]));
+      return 0;
+    case BOTLIB_PC_READ_TOKEN:
+      return files.readToken(static_cast<int>(a[0]), ptr<pc_token_t>(a[1]));
+    case BOTLIB_PC_SOURCE_FILE_AND_LINE:
+      return files.sourceFileAndLine(static_cast<int>(a[0]), ptr<char>(a[1]),
+                                     ptr<int>(a[2]));
+    case BOTLIB_PC_UNREAD_TOKEN:
+      files.unreadToken(static_cast<int>(a[0]));
+      return 0;
+
+    default:
+      // botlib is never initialized without bots
+      if (command >= BOTLIB_SETUP && command <= BOTLIB_PC_UNREAD_TOKEN) {
+        return 0;
+      }
+      counters.unhandled++;
+      if (verbose) {
+        std::printf("unhandled syscall %d\n", static_cast<int>(command));
+      }
+      return 0;
+  }
+}
+} // namespace GameHarness
+} // namespace ETJump
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../src/game/q_shared.h"
+#include "../../src/game/g_public.h"
+#include "../harness_common/box_world.h"
+#include "../harness_common/cvar_store.h"
+#include "../harness_common/entity_tokens.h"
+#include "../harness_common/stub_file_system.h"
+
+namespace ETJump {
+namespace GameHarness {
+// thrown when the game module calls trap_Error
+class GameError : public std::runtime_error {
+public:
+  explicit GameError(const std::string &message)
+      : std::runtime_error(message) {}
+};
+
+// In-process replacement for the server side of the engine. Implements
+// the syscalls the game module needs to run a map: cvars,
+// configstrings, userinfo, entity linking and traces against a
+// BoxWorld, and file I/O rooted in a scratch directory. Everything
+// that the real engine reads from the system clock comes from the
+// virtual server time instead, so runs are reproducible.
+class StubEngine {
+public:
+  struct Stats {
+    uint64_t syscalls{0};
+    uint64_t traces{0};
+    uint64_t links{0};
+    uint64_t serverCommands{0};
+    uint64_t serverCommandBytes{0};
+    uint64_t unhandled{0};
+  };
+
+  // single instance, the game module calls back through a plain
+  // function pointer
+  static StubEngine &instance();
+  static intptr_t QDECL syscall(intptr_t command, ...);
+
+  // clears all state and roots the file system at homePath/etjump,
+  // reads fall back to readPaths
+  void reset(const std::string &homePath, const std::string &mapName,
+             const std::vector<std::string> &readPaths = {});
+
+  Harness::CvarStore &cvars();
+  Harness::StubFileSystem &fileSystem();
+  Harness::BoxWorld &world();
+  // entity string returned through trap_GetEntityToken
+  void setEntityString(const std::string &entities);
+
+  void setUserinfo(int clientNum, const std::string &userinfo);
+  void setUsercmd(int clientNum, const usercmd_t &cmd);
+  // argument vector returned through trap_Argc/trap_Argv
+  void setArgs(const std::vector<std::string> &args);
+
+  void setTime(int time);
+  void setVerbose(bool verbose);
+
+  bool isDropped(int clientNum) const;
+  const std::string &dropReason(int clientNum) const;
+
+  sharedEntity_t *entity(int num) const;
+  playerState_t *playerState(int clientNum) const;
+  int numEntities() const;
+
+  const Stats &stats() const;
+
+private:
+  StubEngine() = default;
+
+  intptr_t dispatch(intptr_t command, const intptr_t *args);
+
+  void locateGameData(void *entities, int numEntities, int entitySize,
+                      void *clients, int clientSize);
+  void linkEntity(sharedEntity_t *ent);
+  void unlinkEntity(sharedEntity_t *ent);
+  void trace(trace_t *results, const vec3_t start, const vec3_t mins,
+             const vec3_t maxs, const vec3_t end, int passEntityNum,
+             int contentMask);
+  int pointContents(const vec3_t point, int passEntityNum) const;
+  int entitiesInBox(const vec3_t mins, const vec3_t maxs, int *list,
+                    int maxCount) const;
+  int entityContact(const vec3_t mins, const vec3_t maxs,
+                    const sharedEntity_t *ent) const;
+
+  Harness::CvarStore cvarStore;
+  Harness::StubFileSystem files;
+  Harness::EntityTokens entityTokens;
+  Harness::BoxWorld boxWorld;
+
+  std::vector<std::string> configstrings;
+  std::vector<std::string> userinfos;
+  std::vector<usercmd_t> usercmds;
+  std::vector<std::string> dropReasons;
+  std::vector<std::string> args;
+
+  char *gameEntities{nullptr};
+  int gameEntityCount{0};
+  int gameEntitySize{0};
+  char *gameClients{nullptr};
+  int gameClientSize{0};
+
+  int time{0};
+  bool verbose{false};
+  Stats counters;
+};
+} // namespace GameHarness
+} // namespace ETJump
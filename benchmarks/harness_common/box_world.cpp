@@ -0,0 +1,184 @@
+#include "box_world.h"
+
+namespace ETJump {
+namespace Harness {
+const float BoxWorld::SURFACE_CLIP_EPSILON = 0.125f;
+
+// clip plane index of the cut, 0 to 5 are the axial planes
+static const int CUT_PLANE = 6;
+
+void BoxWorld::add(const Box &box) { solids.push_back(box); }
+
+void BoxWorld::clear() { solids.clear(); }
+
+const std::vector<Box> &BoxWorld::boxes() const { return solids; }
+
+void BoxWorld::clipToBox(const Box &box, const vec3_t start, const vec3_t end,
+                         const vec3_t mins, const vec3_t maxs, int entityNum,
+                         trace_t &trace) {
+  float enterFrac = -1;
+  float leaveFrac = 1;
+  int clipPlane = 0;
+  bool getOut = false;
+  bool startOut = false;
+
+  // d1 and d2 are the distances of start and end in front of a plane,
+  // returns false if the box is missed
+  const auto clip = [&](float d1, float d2, int plane) {
+    if (d2 > 0) {
+      getOut = true;
+    }
+    if (d1 > 0) {
+      startOut = true;
+    }
+
+    // completely in front of the plane, the box is missed
+    if (d1 > 0 && (d2 >= SURFACE_CLIP_EPSILON || d2 >= d1)) {
+      return false;
+    }
+
+    if (d1 <= 0 && d2 <= 0) {
+      return true;
+    }
+
+    if (d1 > d2) {
+      float f = (d1 - SURFACE_CLIP_EPSILON) / (d1 - d2);
+      if (f < 0) {
+        f = 0;
+      }
+      if (f > enterFrac) {
+        enterFrac = f;
+        clipPlane = plane;
+      }
+    } else {
+      float f = (d1 + SURFACE_CLIP_EPSILON) / (d1 - d2);
+      if (f > 1) {
+        f = 1;
+      }
+      if (f < leaveFrac) {
+        leaveFrac = f;
+      }
+    }
+    return true;
+  };
+
+  // the six axial planes of the box, pushed out by the traced box so
+  // the sweep can be done as a point
+  for (int axis = 0; axis < 3; axis++) {
+    for (int side = 0; side < 2; side++) {
+      const float sign = side == 0 ? 1.0f : -1.0f;
+      const float dist = side == 0 ? box.maxs[axis] - mins[axis]
+                                   : -(box.mins[axis] - maxs[axis]);
+      if (!clip(sign * start[axis] - dist, sign * end[axis] - dist,
+                axis * 2 + side)) {
+        return;
+      }
+    }
+  }
+
+  // the cut is pushed out by the corner of the traced box furthest
+  // behind it, like the engine does for non-axial brush planes
+  const bool cut = isCut(box);
+  if (cut) {
+    vec3_t offset;
+    for (int i = 0; i < 3; i++) {
+      offset[i] = box.cutNormal[i] < 0 ? maxs[i] : mins[i];
+    }
+    const float dist = box.cutDist - DotProduct(offset, box.cutNormal);
+    if (!clip(DotProduct(start, box.cutNormal) - dist,
+              DotProduct(end, box.cutNormal) - dist, CUT_PLANE)) {
+      return;
+    }
+  }
+
+  if (!startOut) {
+    trace.startsolid = qtrue;
+    if (!getOut) {
+      trace.allsolid = qtrue;
+      trace.fraction = 0;
+      trace.contents = box.contents;
+      trace.entityNum = entityNum;
+    }
+    return;
+  }
+
+  if (enterFrac < leaveFrac && enterFrac > -1 && enterFrac < trace.fraction) {
+    trace.fraction = enterFrac < 0 ? 0 : enterFrac;
+    if (clipPlane == CUT_PLANE) {
+      VectorCopy(box.cutNormal, trace.plane.normal);
+      trace.plane.dist = box.cutDist;
+      trace.plane.type = PLANE_NON_AXIAL;
+      trace.plane.signbits = 0;
+      for (int i = 0; i < 3; i++) {
+        if (box.cutNormal[i] < 0) {
+          trace.plane.signbits |= 1 << i;
+        }
+      }
+    } else {
+      const int clipAxis = clipPlane / 2;
+      const float clipSign = clipPlane % 2 == 0 ? 1.0f : -1.0f;
+      trace.plane.normal[0] = 0;
+      trace.plane.normal[1] = 0;
+      trace.plane.normal[2] = 0;
+      trace.plane.normal[clipAxis] = clipSign;
+      trace.plane.dist =
+          clipSign > 0 ? box.maxs[clipAxis] : -box.mins[clipAxis];
+      trace.plane.type = static_cast<byte>(clipAxis);
+      trace.plane.signbits =
+          static_cast<byte>(clipSign < 0 ? 1 << clipAxis : 0);
+    }
+    trace.surfaceFlags = box.surfaceFlags;
+    trace.contents = box.contents;
+    trace.entityNum = entityNum;
+  }
+}
+
+void BoxWorld::trace(const vec3_t start, const vec3_t end, const vec3_t mins,
+                     const vec3_t maxs, int contentMask,
+                     trace_t &trace) const {
+  for (const auto &box : solids) {
+    if (!(box.contents & contentMask)) {
+      continue;
+    }
+    clipToBox(box, start, end, mins, maxs, ENTITYNUM_WORLD, trace);
+    if (trace.allsolid) {
+      return;
+    }
+  }
+}
+
+int BoxWorld::pointContents(const vec3_t point) const {
+  int contents = 0;
+  for (const auto &box : solids) {
+    if (contains(box, point)) {
+      contents |= box.contents;
+    }
+  }
+  return contents;
+}
+
+bool BoxWorld::contains(const Box &box, const vec3_t point) {
+  for (int i = 0; i < 3; i++) {
+    if (point[i] < box.mins[i] || point[i] > box.maxs[i]) {
+      return false;
+    }
+  }
+  return !isCut(box) || DotProduct(point, box.cutNormal) <= box.cutDist;
+}
+
+bool BoxWorld::isCut(const Box &box) {
+  return box.cutNormal[0] != 0 || box.cutNormal[1] != 0 ||
+         box.cutNormal[2] != 0;
+}
+
+bool BoxWorld::overlaps(const vec3_t mins1, const vec3_t maxs1,
+                        const vec3_t mins2, const vec3_t maxs2) {
+  for (int i = 0; i < 3; i++) {
+    if (mins1[i] > maxs2[i] || maxs1[i] < mins2[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace Harness
+} // namespace ETJump
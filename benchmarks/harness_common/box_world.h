@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+
+#include "../../src/game/q_shared.h"
+
+namespace ETJump {
+namespace Harness {
+// axis aligned solid used as world geometry by the stub engine
+struct Box {
+  vec3_t mins;
+  vec3_t maxs;
+  int contents;
+  int surfaceFlags;
+  // optional plane cutting off the part of the box in front of it,
+  // turns the box into a ramp. A zero normal leaves the box whole.
+  vec3_t cutNormal{};
+  float cutDist{0};
+};
+
+// Collision for the stub engine. The world is a list of axis aligned
+// brushes, optionally cut by one more plane, and traces follow the
+// same plane clipping rules as the engine's CM_TraceThroughBrush, so
+// pmove sees epsilon-correct fractions and normals.
+class BoxWorld {
+public:
+  static const float SURFACE_CLIP_EPSILON;
+
+  void add(const Box &box);
+  void clear();
+  const std::vector<Box> &boxes() const;
+
+  // clips trace against a single box, trace must be initialized
+  // by the caller and is only updated if the box is closer
+  static void clipToBox(const Box &box, const vec3_t start, const vec3_t end,
+                        const vec3_t mins, const vec3_t maxs, int entityNum,
+                        trace_t &trace);
+
+  // traces against world boxes matching contentMask
+  void trace(const vec3_t start, const vec3_t end, const vec3_t mins,
+             const vec3_t maxs, int contentMask, trace_t &trace) const;
+
+  int pointContents(const vec3_t point) const;
+
+  static bool contains(const Box &box, const vec3_t point);
+  static bool isCut(const Box &box);
+  static bool overlaps(const vec3_t mins1, const vec3_t maxs1,
+                       const vec3_t mins2, const vec3_t maxs2);
+
+private:
+  std::vector<Box> solids;
+};
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "cvar_store.h"
+
+namespace ETJump {
+namespace Harness {
+void copyString(char *buffer, int bufferSize, const std::string &value) {
+  if (!buffer || bufferSize <= 0) {
+    return;
+  }
+  const size_t length =
+      std::min(value.size(), static_cast<size_t>(bufferSize - 1));
+  std::memcpy(buffer, value.c_str(), length);
+  buffer[length] = '\0';
+}
+
+void CvarStore::clear() {
+  handles.clear();
+  cvars.clear();
+}
+
+void CvarStore::set(const std::string &name, const std::string &value) {
+  const auto it = handles.find(name);
+  if (it == handles.end()) {
+    handles[name] = static_cast<int>(cvars.size());
+    cvars.push_back({value, CVAR_USER_CREATED, 1});
+    return;
+  }
+
+  auto &cvar = cvars[it->second];
+  if (cvar.value != value) {
+    cvar.value = value;
+    cvar.modificationCount++;
+  }
+}
+
+std::string CvarStore::get(const std::string &name) const {
+  const auto it = handles.find(name);
+  return it == handles.end() ? "" : cvars[it->second].value;
+}
+
+int CvarStore::registerCvar(vmCvar_t *vmCvar, const char *name,
+                            const char *defaultValue, int flags) {
+  auto it = handles.find(name);
+  if (it == handles.end()) {
+    it = handles.emplace(name, static_cast<int>(cvars.size())).first;
+    cvars.push_back({defaultValue ? defaultValue : "", flags, 1});
+  } else {
+    auto &cvar = cvars[it->second];
+    cvar.flags = (cvar.flags & ~CVAR_USER_CREATED) | flags;
+  }
+
+  if (vmCvar) {
+    vmCvar->handle = it->second;
+    update(vmCvar);
+  }
+  return it->second;
+}
+
+void CvarStore::update(vmCvar_t *vmCvar) const {
+  const auto &cvar = cvars[vmCvar->handle];
+  vmCvar->modificationCount = cvar.modificationCount;
+  vmCvar->value = static_cast<float>(std::atof(cvar.value.c_str()));
+  vmCvar->integer = std::atoi(cvar.value.c_str());
+  copyString(vmCvar->string, sizeof(vmCvar->string), cvar.value);
+}
+
+std::string CvarStore::infoString(int flags) const {
+  std::string info;
+  for (const auto &handle : handles) {
+    if (cvars[handle.second].flags & flags) {
+      info += "\\" + handle.first + "\\" + cvars[handle.second].value;
+    }
+  }
+  return info;
+}
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../../src/game/q_shared.h"
+
+namespace ETJump {
+namespace Harness {
+// engine side cvar storage for the stub engines, handles are indices
+// into the cvar list so vmCvar_t updates don't need a lookup
+class CvarStore {
+public:
+  void clear();
+
+  // creates the cvar as user created if it doesn't exist yet
+  void set(const std::string &name, const std::string &value);
+  std::string get(const std::string &name) const;
+
+  // an existing value wins over the default, like in the engine
+  int registerCvar(vmCvar_t *vmCvar, const char *name,
+                   const char *defaultValue, int flags);
+  void update(vmCvar_t *vmCvar) const;
+
+  // info string of every cvar that has one of the flags set
+  std::string infoString(int flags) const;
+
+private:
+  struct Cvar {
+    std::string value;
+    int flags;
+    int modificationCount;
+  };
+
+  std::map<std::string, int> handles;
+  std::vector<Cvar> cvars;
+};
+
+// copies value into a module supplied buffer, always terminated
+void copyString(char *buffer, int bufferSize, const std::string &value);
+} // namespace Harness
+} // namespace ETJump
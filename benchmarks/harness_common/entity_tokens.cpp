@@ -0,0 +1,35 @@
+#include "cvar_store.h"
+#include "entity_tokens.h"
+
+namespace ETJump {
+namespace Harness {
+void EntityTokens::set(const std::string &entities) {
+  tokens.clear();
+  position = 0;
+
+  size_t i = 0;
+  while (i < entities.size()) {
+    const char c = entities[i];
+    if (c == '{' || c == '}') {
+      tokens.emplace_back(1, c);
+      i++;
+    } else if (c == '"') {
+      const size_t end = entities.find('"', i + 1);
+      tokens.push_back(entities.substr(i + 1, end - i - 1));
+      i = end == std::string::npos ? end : end + 1;
+    } else {
+      i++;
+    }
+  }
+}
+
+bool EntityTokens::next(char *buffer, int bufferSize) {
+  if (position >= tokens.size()) {
+    copyString(buffer, bufferSize, "");
+    return false;
+  }
+  copyString(buffer, bufferSize, tokens[position++]);
+  return true;
+}
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ETJump {
+namespace Harness {
+// serves a map entity string one token at a time, the way the engine
+// answers trap_GetEntityToken
+class EntityTokens {
+public:
+  void set(const std::string &entities);
+  // returns false once all tokens have been read
+  bool next(char *buffer, int bufferSize);
+
+private:
+  std::vector<std::string> tokens;
+  size_t position{0};
+};
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,40 @@
+#include "stand_in_assets.h"
+#include "../../src/game/bg_public.h"
+
+namespace ETJump {
+namespace Harness {
+void addStandInAssets(StubFileSystem &files, const std::string &mapName) {
+  static const char *teams[] = {"axis", "allied"};
+  static const char *classes[] = {"soldier", "medic", "engineer", "fieldops",
+                                  "cvops"};
+  static const char *characterDef =
+      "characterDef\n{\n"
+      "\tmesh \"models/players/temperate/body.mdm\"\n"
+      "\tanimationGroup \"animations/human_base.anim\"\n"
+      "\tanimationScript \"animations/scripts/human_base.script\"\n"
+      "\tskin \"temperate\"\n"
+      "\thudhead \"models/players/hud/head.mdm\"\n"
+      "}\n";
+
+  for (const auto team : teams) {
+    for (const auto cls : classes) {
+      files.addFile(std::string("characters/temperate/") + team + "/" + cls +
+                        ".char",
+                    characterDef);
+    }
+  }
+
+  // weapon files in assets/ point at animation configs from the paks,
+  // a static single frame for every animation is enough to parse
+  std::string weaponConfig = "newfmt\n";
+  for (int i = 0; i < MAX_WP_ANIMATIONS; i++) {
+    weaponConfig += "0 1 1 0 0 0 0\n";
+  }
+  files.addFile("models/weapons2/grenade/weapon.cfg", weaponConfig);
+  files.addFile("models/multiplayer/mortar/weapon.cfg", weaponConfig);
+
+  // map statistics only track maps that exist on disk
+  files.addFile("maps/" + mapName + ".bsp", "IBSP");
+}
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+#include "stub_file_system.h"
+
+namespace ETJump {
+namespace Harness {
+// Files from the retail paks that the modules refuse to start without.
+// The player classes point at the animation files shipped in assets/,
+// which the stub file system finds through its read paths.
+void addStandInAssets(StubFileSystem &files, const std::string &mapName);
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <set>
+#include <strings.h>
+#include <utility>
+#include <sys/stat.h>
+
+#include "cvar_store.h"
+#include "stub_file_system.h"
+
+namespace ETJump {
+namespace Harness {
+static void makeParentDirectories(const std::string &path) {
+  for (size_t i = 1; i < path.size(); i++) {
+    if (path[i] == '/') {
+      mkdir(path.substr(0, i).c_str(), 0755);
+    }
+  }
+}
+
+static bool isFile(const std::string &path, int *size = nullptr) {
+  struct stat info {};
+  if (stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+  if (size) {
+    *size = static_cast<int>(info.st_size);
+  }
+  return true;
+}
+
+void StubFileSystem::reset(const std::string &writePath,
+                           const std::vector<std::string> &readPaths) {
+  for (auto &file : files) {
+    std::fclose(file.second);
+  }
+  files.clear();
+  nextFileHandle = 1;
+  sources.clear();
+  nextSourceHandle = 1;
+
+  root = writePath;
+  makeParentDirectories(root + "/");
+  searchPaths = {root};
+  searchPaths.insert(searchPaths.end(), readPaths.begin(), readPaths.end());
+}
+
+std::string StubFileSystem::writePath(const char *path) const {
+  return root + "/" + path;
+}
+
+std::string StubFileSystem::findPath(const char *path) const {
+  for (const auto &searchPath : searchPaths) {
+    auto fullPath = searchPath + "/" + path;
+    if (isFile(fullPath)) {
+      return fullPath;
+    }
+  }
+  return "";
+}
+
+void StubFileSystem::addFile(const std::string &path,
+                             const std::string &contents) {
+  const auto fullPath = writePath(path.c_str());
+  makeParentDirectories(fullPath);
+  FILE *file = std::fopen(fullPath.c_str(), "wb");
+  if (file) {
+    std::fwrite(contents.data(), 1, contents.size(), file);
+    std::fclose(file);
+  }
+}
+
+int StubFileSystem::open(const char *path, fileHandle_t *handle,
+                         fsMode_t mode) {
+  if (mode == FS_READ) {
+    const auto fullPath = findPath(path);
+    int size = 0;
+    if (fullPath.empty() || !isFile(fullPath, &size)) {
+      if (handle) {
+        *handle = 0;
+      }
+      return -1;
+    }
+    if (!handle) {
+      return size;
+    }
+    FILE *file = std::fopen(fullPath.c_str(), "rb");
+    if (!file) {
+      *handle = 0;
+      return -1;
+    }
+    *handle = nextFileHandle++;
+    files[*handle] = file;
+    return size;
+  }
+
+  if (!handle) {
+    return -1;
+  }
+
+  const auto fullPath = writePath(path);
+  makeParentDirectories(fullPath);
+  FILE *file = std::fopen(fullPath.c_str(), mode == FS_WRITE ? "wb" : "ab");
+  if (!file) {
+    *handle = 0;
+    return -1;
+  }
+  *handle = nextFileHandle++;
+  files[*handle] = file;
+  return 0;
+}
+
+int StubFileSystem::read(void *buffer, int length, fileHandle_t handle) {
+  const auto it = files.find(handle);
+  if (it == files.end()) {
+    return 0;
+  }
+  return static_cast<int>(std::fread(buffer, 1, length, it->second));
+}
+
+int StubFileSystem::write(const void *buffer, int length,
+                          fileHandle_t handle) {
+  const auto it = files.find(handle);
+  if (it == files.end()) {
+    return 0;
+  }
+  return static_cast<int>(std::fwrite(buffer, 1, length, it->second));
+}
+
+void StubFileSystem::close(fileHandle_t handle) {
+  const auto it = files.find(handle);
+  if (it != files.end()) {
+    std::fclose(it->second);
+    files.erase(it);
+  }
+}
+
+bool StubFileSystem::rename(const char *from, const char *to) const {
+  return std::rename(writePath(from).c_str(), writePath(to).c_str()) == 0;
+}
+
+bool StubFileSystem::remove(const char *path) const {
+  return std::remove(writePath(path).c_str()) == 0;
+}
+
+int StubFileSystem::list(const char *path, const char *extension,
+                         char *buffer, int bufferSize) const {
+  const std::string ext = extension ? extension : "";
+  const bool directories = ext == "/";
+  // directory order is not stable between file systems
+  std::set<std::string> names;
+
+  for (const auto &searchPath : searchPaths) {
+    DIR *dir = opendir((searchPath + "/" + path).c_str());
+    if (!dir) {
+      continue;
+    }
+
+    while (const dirent *entry = readdir(dir)) {
+      const std::string name = entry->d_name;
+      if (name == "." || name == "..") {
+        continue;
+      }
+      const bool isDirectory = entry->d_type == DT_DIR;
+      if (directories != isDirectory) {
+        continue;
+      }
+      if (!directories && !ext.empty() &&
+          (name.size() < ext.size() ||
+           strcasecmp(name.c_str() + name.size() - ext.size(), ext.c_str()))) {
+        continue;
+      }
+      names.insert(name);
+    }
+    closedir(dir);
+  }
+
+  int count = 0;
+  int offset = 0;
+  for (const auto &name : names) {
+    const int length = static_cast<int>(name.size()) + 1;
+    if (offset + length > bufferSize) {
+      break;
+    }
+    std::memcpy(buffer + offset, name.c_str(), length);
+    offset += length;
+    count++;
+  }
+  return count;
+}
+
+std::vector<pc_token_t> StubFileSystem::tokenize(const std::string &text) {
+  std::vector<pc_token_t> tokens;
+  size_t i = 0;
+  int line = 1;
+  int lastLine = 1;
+
+  while (i < text.size()) {
+    const char c = text[i];
+    if (c == '\n') {
+      line++;
+      i++;
+      continue;
+    }
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      i++;
+      continue;
+    }
+    if (text.compare(i, 2, "//") == 0) {
+      i = text.find('\n', i);
+      continue;
+    }
+    if (text.compare(i, 2, "/*") == 0) {
+      const size_t end = text.find("*/", i + 2);
+      for (size_t j = i; j < std::min(end, text.size()); j++) {
+        line += text[j] == '\n';
+      }
+      i = end == std::string::npos ? end : end + 2;
+      continue;
+    }
+
+    pc_token_t token{};
+    std::string value;
+    if (c == '"') {
+      const size_t end = text.find('"', i + 1);
+      value = text.substr(i + 1, end - i - 1);
+      token.type = TT_STRING;
+      i = end == std::string::npos ? end : end + 1;
+    } else if (std::isdigit(static_cast<unsigned char>(c))) {
+      // like the botlib, a leading minus is a separate punctuation token
+      size_t end = i + 1;
+      while (end < text.size() &&
+             (std::isdigit(static_cast<unsigned char>(text[end])) ||
+              text[end] == '.')) {
+        end++;
+      }
+      value = text.substr(i, end - i);
+      token.type = TT_NUMBER;
+      token.intvalue = std::atoi(value.c_str());
+      token.floatvalue = static_cast<float>(std::atof(value.c_str()));
+      i = end;
+    } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+      size_t end = i + 1;
+      while (end < text.size() &&
+             (std::isalnum(static_cast<unsigned char>(text[end])) ||
+              text[end] == '_')) {
+        end++;
+      }
+      value = text.substr(i, end - i);
+      token.type = TT_NAME;
+      i = end;
+    } else {
+      value = std::string(1, c);
+      token.type = TT_PUNCTUATION;
+      i++;
+    }
+
+    copyString(token.string, sizeof(token.string), value);
+    token.line = line;
+    token.linescrossed = line - lastLine;
+    lastLine = line;
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+bool StubFileSystem::readSource(const char *filename,
+                                std::vector<pc_token_t> &tokens,
+                                int depth) const {
+  const auto fullPath = findPath(filename);
+  FILE *file = fullPath.empty() ? nullptr : std::fopen(fullPath.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+
+  std::string text;
+  char buffer[4096];
+  size_t count;
+  while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    text.append(buffer, count);
+  }
+  std::fclose(file);
+
+  const auto fileTokens = tokenize(text);
+  for (size_t i = 0; i < fileTokens.size(); i++) {
+    // the animation files split their tables with #include
+    if (depth < MAX_INCLUDE_DEPTH && i + 2 < fileTokens.size() &&
+        !std::strcmp(fileTokens[i].string, "#") &&
+        !std::strcmp(fileTokens[i + 1].string, "include") &&
+        fileTokens[i + 2].type == TT_STRING) {
+      readSource(fileTokens[i + 2].string, tokens, depth + 1);
+      i += 2;
+      continue;
+    }
+    tokens.push_back(fileTokens[i]);
+  }
+  return true;
+}
+
+int StubFileSystem::loadSource(const char *filename) {
+  std::vector<pc_token_t> tokens;
+  if (!readSource(filename, tokens, 0)) {
+    return 0;
+  }
+
+  const int handle = nextSourceHandle++;
+  sources[handle] = {filename, std::move(tokens), 0};
+  return handle;
+}
+
+void StubFileSystem::freeSource(int handle) { sources.erase(handle); }
+
+int StubFileSystem::readToken(int handle, pc_token_t *token) {
+  const auto it = sources.find(handle);
+  if (it == sources.end() || it->second.next >= it->second.tokens.size()) {
+    return 0;
+  }
+  *token = it->second.tokens[it->second.next++];
+  return 1;
+}
+
+void StubFileSystem::unreadToken(int handle) {
+  const auto it = sources.find(handle);
+  if (it != sources.end() && it->second.next > 0) {
+    it->second.next--;
+  }
+}
+
+int StubFileSystem::sourceFileAndLine(int handle, char *filename,
+                                      int *line) const {
+  const auto it = sources.find(handle);
+  if (it == sources.end()) {
+    return 0;
+  }
+  const auto &source = it->second;
+  copyString(filename, MAX_QPATH, source.filename);
+  *line = source.next > 0 ? source.tokens[source.next - 1].line : 0;
+  return 1;
+}
+} // namespace Harness
+} // namespace ETJump
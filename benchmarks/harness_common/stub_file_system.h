@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../../src/game/q_shared.h"
+
+namespace ETJump {
+namespace Harness {
+// trap_FS_* and trap_PC_* for the stub engines. Writes go to a scratch
+// directory, reads fall back to the read only search paths in order,
+// so stand-in assets can shadow the repository ones.
+class StubFileSystem {
+public:
+  // closes open files and sources, roots writes at writePath
+  void reset(const std::string &writePath,
+             const std::vector<std::string> &readPaths = {});
+
+  void addFile(const std::string &path, const std::string &contents);
+
+  // trap_FS_FOpenFile, returns the file length or -1
+  int open(const char *path, fileHandle_t *handle, fsMode_t mode);
+  int read(void *buffer, int length, fileHandle_t handle);
+  int write(const void *buffer, int length, fileHandle_t handle);
+  void close(fileHandle_t handle);
+  bool rename(const char *from, const char *to) const;
+  bool remove(const char *path) const;
+  // trap_FS_GetFileList, names are sorted and NUL separated
+  int list(const char *path, const char *extension, char *buffer,
+           int bufferSize) const;
+
+  // trap_PC_LoadSource, tokens follow the botlib precompiler for the
+  // subset the game files use: #include is expanded, defines are not
+  int loadSource(const char *filename);
+  void freeSource(int handle);
+  int readToken(int handle, pc_token_t *token);
+  void unreadToken(int handle);
+  int sourceFileAndLine(int handle, char *filename, int *line) const;
+
+  static std::vector<pc_token_t> tokenize(const std::string &text);
+
+private:
+  struct Source {
+    std::string filename;
+    std::vector<pc_token_t> tokens;
+    size_t next;
+  };
+
+  static const int MAX_INCLUDE_DEPTH = 8;
+
+  // appends the tokens of filename and the files it includes
+  bool readSource(const char *filename, std::vector<pc_token_t> &tokens,
+                  int depth) const;
+  std::string writePath(const char *path) const;
+  // first existing path in the search order, empty if none
+  std::string findPath(const char *path) const;
+
+  std::string root;
+  std::vector<std::string> searchPaths;
+  std::map<int, FILE *> files;
+  int nextFileHandle{1};
+  std::map<int, Source> sources;
+  int nextSourceHandle{1};
+};
+} // namespace Harness
+} // namespace ETJump
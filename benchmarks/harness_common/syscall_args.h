@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+
+#include "../../src/game/q_shared.h"
+
+namespace ETJump {
+namespace Harness {
+static const int MAX_SYSCALL_ARGS = 13;
+
+// every trap passes VM_CALL_END after its last argument, so stubs can
+// stop reading there instead of knowing each call's arity
+inline void readSyscallArgs(va_list ap, intptr_t *args) {
+  for (int i = 0; i < MAX_SYSCALL_ARGS; i++) {
+    const intptr_t arg = va_arg(ap, intptr_t);
+    if (static_cast<int>(arg) == VM_CALL_END) {
+      break;
+    }
+    args[i] = arg;
+  }
+}
+
+template <typename T>
+inline T *ptr(intptr_t arg) {
+  return reinterpret_cast<T *>(arg);
+}
+
+inline const char *str(intptr_t arg) { return ptr<const char>(arg); }
+
+// floats are passed bit for bit through the integer arguments
+inline float flt(intptr_t arg) {
+  floatint_t fi;
+  fi.i = static_cast<int>(arg);
+  return fi.f;
+}
+
+// trap_RealTime with a fixed wall clock, so log file names and anything
+// time stamped stay stable between runs
+inline intptr_t realTime(qtime_t *qtime) {
+  if (qtime) {
+    *qtime = qtime_t{0, 0, 12, 1, 0, 120, 3, 0, 0};
+  }
+  return 1577880000;
+}
+
+// trap_SnapVector, rounds to the nearest integer like the engine
+inline void snapVector(float *v) {
+  for (int i = 0; i < 3; i++) {
+    v[i] = std::rint(v[i]);
+  }
+}
+} // namespace Harness
+} // namespace ETJump
@@ -0,0 +1,69 @@
+#include <random>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/cgame/etj_particle_pool.h"
+#include "../src/cgame/etj_poly_batcher.h"
+
+using namespace ETJump;
+
+static constexpr int NUM_PARTICLES = 1024 * 8;
+
+// a full pool of smoke-like particles which never expire
+static void fillPool(ParticlePool &pool) {
+  std::mt19937 rng(1337);
+  std::uniform_real_distribution<float> dist(-256.0f, 256.0f);
+
+  pool.clear();
+  for (int i = 0; i < pool.getCapacity(); i++) {
+    const int index = pool.alloc();
+    pool.spawnTime[index] = 0;
+    pool.endTime[index] = 1e9f;
+    pool.orgX[index] = dist(rng);
+    pool.orgY[index] = dist(rng);
+    pool.orgZ[index] = dist(rng);
+    pool.velX[index] = dist(rng);
+    pool.velY[index] = dist(rng);
+    pool.velZ[index] = dist(rng);
+    pool.accelX[index] = 0;
+    pool.accelY[index] = 0;
+    pool.accelZ[index] = -40;
+    pool.alpha[index] = 1;
+    pool.alphaVel[index] = 0;
+    pool.expires[index] = 1;
+  }
+}
+
+ETJ_BENCHMARK(Particles_Integrate) {
+  ParticlePool pool(NUM_PARTICLES);
+  fillPool(pool);
+  float time = 0;
+
+  while (state.keepRunning()) {
+    pool.integrate(time);
+    Benchmark::doNotOptimize(pool.posX.data());
+    time += 8;
+  }
+
+  state.setItemsProcessed(state.iterations() * NUM_PARTICLES);
+}
+
+// a handful of shaders interleaved, like smoke puffs next to sparks
+ETJ_BENCHMARK(Particles_BatchQuads) {
+  PolyBatcher batcher;
+  polyVert_t quad[4] = {};
+  int runs = 0;
+
+  while (state.keepRunning()) {
+    for (int i = 0; i < NUM_PARTICLES; i++) {
+      batcher.add(1 + i % 4, 4, quad);
+    }
+    batcher.flush([&](qhandle_t, int, const polyVert_t *verts, int) {
+      Benchmark::doNotOptimize(verts);
+      runs++;
+    });
+  }
+
+  Benchmark::doNotOptimize(runs);
+  state.setItemsProcessed(state.iterations() * NUM_PARTICLES);
+}
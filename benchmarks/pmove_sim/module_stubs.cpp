@@ -0,0 +1,79 @@
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+#include "module_stubs.h"
+#include "../../src/game/bg_public.h"
+
+namespace ETJump {
+namespace PmoveSim {
+static bool printEnabled = false;
+
+Harness::StubFileSystem &fileSystem() {
+  static Harness::StubFileSystem files;
+  return files;
+}
+
+void setVerbose(bool verbose) { printEnabled = verbose; }
+} // namespace PmoveSim
+} // namespace ETJump
+
+using ETJump::PmoveSim::fileSystem;
+
+// cvars bg_pmove and bg_misc read from qagame, cheats stay off
+vmCvar_t g_cheats;
+vmCvar_t g_developer;
+
+void QDECL Com_Printf(const char *msg, ...) {
+  if (!ETJump::PmoveSim::printEnabled) {
+    return;
+  }
+  va_list ap;
+  va_start(ap, msg);
+  std::vprintf(msg, ap);
+  va_end(ap);
+}
+
+void QDECL Com_Error(int level, const char *error, ...) {
+  char message[1024];
+  va_list ap;
+  va_start(ap, error);
+  Q_vsnprintf(message, sizeof(message), error, ap);
+  va_end(ap);
+  throw ETJump::PmoveSim::PmoveError(message);
+}
+
+// the server keeps these for the client's next frame, nothing to do
+// without one
+void ClientStoreSurfaceFlags(int clientNum, int surfaceFlags) {}
+
+void trap_Cvar_Set(const char *var_name, const char *value) {}
+
+// the engine rounds to nearest, like its x87 snapping
+void trap_SnapVector(float *v) {
+  for (int i = 0; i < 3; i++) {
+    v[i] = std::rint(v[i]);
+  }
+}
+
+int trap_PC_LoadSource(const char *filename) {
+  return fileSystem().loadSource(filename);
+}
+
+int trap_PC_FreeSource(int handle) {
+  fileSystem().freeSource(handle);
+  return 1;
+}
+
+int trap_PC_ReadToken(int handle, pc_token_t *pc_token) {
+  return fileSystem().readToken(handle, pc_token);
+}
+
+int trap_PC_SourceFileAndLine(int handle, char *filename, int *line) {
+  return fileSystem().sourceFileAndLine(handle, filename, line);
+}
+
+int trap_PC_UnReadToken(int handle) {
+  fileSystem().unreadToken(handle);
+  return 0;
+}
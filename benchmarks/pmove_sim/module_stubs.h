@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+#include "../harness_common/stub_file_system.h"
+
+namespace ETJump {
+namespace PmoveSim {
+// thrown when the bg code calls Com_Error
+class PmoveError : public std::runtime_error {
+public:
+  explicit PmoveError(const std::string &message)
+      : std::runtime_error(message) {}
+};
+
+// The bg code is built without the rest of the game module, so the
+// few game functions and syscalls it calls are defined here instead.
+// Character files are read through this file system.
+Harness::StubFileSystem &fileSystem();
+
+// prints Com_Printf output when enabled
+void setVerbose(bool verbose);
+} // namespace PmoveSim
+} // namespace ETJump
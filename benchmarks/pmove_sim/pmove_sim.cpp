@@ -0,0 +1,606 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <json/json.h>
+#include <string>
+#include <vector>
+
+#include "../harness_common/box_world.h"
+#include "module_stubs.h"
+#include "../../src/game/bg_public.h"
+
+// Runs bg_pmove on its own, without a game module: scripted usercmds
+// drive a single player through box brush worlds, one scenario per
+// movement technique. The final player state of each scenario can be
+// written out and compared against an earlier run, and every Pmove
+// call is timed, so physics changes can be shown to be both bit
+// identical and faster.
+
+#ifndef ETJ_ASSETS_PATH
+  #define ETJ_ASSETS_PATH "assets"
+#endif
+
+using ETJump::Harness::Box;
+using ETJump::Harness::BoxWorld;
+using namespace ETJump::PmoveSim;
+
+struct Options {
+  int moves = 2000;
+  int iterations = 10;
+  int cmdMsec = 8;
+  std::string statesPath;
+  std::string goldenPath;
+  bool verify = false;
+  bool verbose = false;
+  std::string jsonPath;
+};
+
+// input state a script carries from one move to the next
+struct Script {
+  int side{1};
+  bool wasOnGround{false};
+};
+
+struct Scenario {
+  const char *name;
+  void (*build)(BoxWorld &world);
+  void (*spawn)(playerState_t &ps);
+  void (*input)(const playerState_t &ps, int msec, Script &script,
+                usercmd_t &cmd);
+};
+
+struct ScenarioResult {
+  std::string name;
+  playerState_t ps;
+  uint32_t trajectory{0};
+  double ns{0};
+  double bestNs{0};
+  bool deterministic{true};
+};
+
+static const char *ANIMATION_GROUP = "animations/human_base.anim";
+static const char *ANIMATION_SCRIPT = "animations/scripts/human_base.script";
+static const int START_TIME = 1000;
+
+static BoxWorld world;
+
+static void addBox(BoxWorld &target, float x1, float y1, float z1, float x2,
+                   float y2, float z2) {
+  Box box{{x1, y1, z1}, {x2, y2, z2}, CONTENTS_SOLID, 0};
+  target.add(box);
+}
+
+static void addFloor(BoxWorld &target) {
+  addBox(target, -32768, -32768, -64, 32768, 32768, 0);
+}
+
+// trickjump maps mark their floors so landings can jump right away
+static void buildJumpFloor(BoxWorld &target) {
+  Box floor{{-32768, -32768, -64}, {32768, 32768, 0}, CONTENTS_SOLID,
+            SURF_NOJUMPDELAY};
+  target.add(floor);
+}
+
+static void spawnStanding(playerState_t &ps) {
+  ps.origin[2] = -playerMins[2];
+}
+
+// a 60 degree ramp rising along +x, too steep to stand on, topped
+// by a flat platform
+static void buildRamp(BoxWorld &target) {
+  addFloor(target);
+  Box ramp{{512, -32768, 0}, {2048, 32768, 2048}, CONTENTS_SOLID, 0};
+  const float slope = DEG2RAD(60.0f);
+  ramp.cutNormal[0] = -std::sin(slope);
+  ramp.cutNormal[2] = std::cos(slope);
+  ramp.cutDist = ramp.mins[0] * ramp.cutNormal[0];
+  target.add(ramp);
+}
+
+// just off the ramp face, high up and moving along it
+static void spawnOnRamp(playerState_t &ps) {
+  ps.origin[0] = 1500;
+  ps.origin[2] = 1824;
+  ps.velocity[1] = 600;
+}
+
+// 24 steps of 16 units leading up to a platform
+static void buildStairs(BoxWorld &target) {
+  addFloor(target);
+  for (int i = 0; i < 24; i++) {
+    addBox(target, 256 + i * 32.0f, -256, 0, 1280, 256, (i + 1) * 16.0f);
+  }
+}
+
+// dropped onto the floor from a height where the landing move ends
+// inside the ground trace window, so the next walk move turns the
+// fall speed into ground speed instead of stopping it
+static const float OVERBOUNCE_HEIGHT = 98.6f;
+
+static void spawnOverbounce(playerState_t &ps) {
+  ps.origin[2] = OVERBOUNCE_HEIGHT - playerMins[2];
+  ps.velocity[0] = 320;
+}
+
+// view yaw that puts a forward plus side move at the angle to the
+// velocity that gains the most speed in the air
+static float strafeYaw(const playerState_t &ps, int msec, int side) {
+  const float speed = std::sqrt(ps.velocity[0] * ps.velocity[0] +
+                                ps.velocity[1] * ps.velocity[1]);
+  const float wishSpeed = ps.speed * ps.sprintSpeedScale;
+  const float accelSpeed = pm_airaccelerate * wishSpeed * msec / 1000.0f;
+
+  float angle = 0;
+  float velocityYaw = 0;
+  if (speed > 0) {
+    velocityYaw = RAD2DEG(std::atan2(ps.velocity[1], ps.velocity[0]));
+  }
+  if (speed > wishSpeed - accelSpeed) {
+    angle = RAD2DEG(std::acos((wishSpeed - accelSpeed) / speed));
+  }
+
+  // forward plus right moves 45 degrees to the right of the view
+  return velocityYaw - side * (angle - 45);
+}
+
+// strafe jumps on flat ground, switching sides on every landing
+static void strafeJumpInput(const playerState_t &ps, int msec,
+                            Script &script, usercmd_t &cmd) {
+  const bool onGround = ps.groundEntityNum != ENTITYNUM_NONE;
+  if (onGround && !script.wasOnGround) {
+    script.side = -script.side;
+  }
+  script.wasOnGround = onGround;
+
+  cmd.buttons = BUTTON_SPRINT;
+  cmd.forwardmove = 127;
+  cmd.rightmove = static_cast<signed char>(script.side * 127);
+  cmd.upmove = onGround ? 127 : 0;
+  cmd.angles[YAW] = ANGLE2SHORT(strafeYaw(ps, msec, script.side));
+}
+
+// faces along the ramp and strafes into it, surfing down the face
+static void rampSlideInput(const playerState_t &ps, int msec,
+                           Script &script, usercmd_t &cmd) {
+  cmd.buttons = BUTTON_SPRINT;
+  cmd.rightmove = 127;
+  cmd.angles[YAW] = ANGLE2SHORT(90);
+}
+
+static void runForwardInput(const playerState_t &ps, int msec,
+                            Script &script, usercmd_t &cmd) {
+  cmd.buttons = BUTTON_SPRINT;
+  cmd.forwardmove = 127;
+}
+
+static const Scenario SCENARIOS[] = {
+    {"strafe_jumps", buildJumpFloor, spawnStanding, strafeJumpInput},
+    {"ramp_slide", buildRamp, spawnOnRamp, rampSlideInput},
+    {"stairs", buildStairs, spawnStanding, runForwardInput},
+    {"overbounce", addFloor, spawnOverbounce, runForwardInput},
+};
+
+static void trace(trace_t *results, const vec3_t start, const vec3_t mins,
+                  const vec3_t maxs, const vec3_t end, int passEntityNum,
+                  int contentMask) {
+  static const vec3_t origin = {0, 0, 0};
+  if (!mins) {
+    mins = origin;
+  }
+  if (!maxs) {
+    maxs = origin;
+  }
+
+  trace_t tr{};
+  tr.fraction = 1;
+  tr.entityNum = ENTITYNUM_NONE;
+  world.trace(start, end, mins, maxs, contentMask, tr);
+
+  for (int i = 0; i < 3; i++) {
+    tr.endpos[i] = start[i] + tr.fraction * (end[i] - start[i]);
+  }
+  *results = tr;
+}
+
+static int pointContents(const vec3_t point, int passEntityNum) {
+  return world.pointContents(point);
+}
+
+// the server's character for every player class, loaded from the
+// repository's animation files
+static bg_character_t *loadCharacter() {
+  static animModelInfo_t animModelInfo;
+  static animScriptData_t scriptData;
+  static bg_character_t character;
+
+  // nothing is written, the file system only serves the animations
+  fileSystem().reset(ETJ_ASSETS_PATH);
+  // like G_InitGame, the script refers to weapons by name
+  BG_ClearAnimationPool();
+  BG_InitWeaponStrings();
+
+  character.animModelInfo = &animModelInfo;
+  Q_strncpyz(animModelInfo.animationGroup, ANIMATION_GROUP,
+             sizeof(animModelInfo.animationGroup));
+  Q_strncpyz(animModelInfo.animationScript, ANIMATION_SCRIPT,
+             sizeof(animModelInfo.animationScript));
+
+  if (!BG_R_RegisterAnimationGroup(ANIMATION_GROUP, &animModelInfo)) {
+    throw PmoveError(std::string("Could not load ") + ANIMATION_GROUP);
+  }
+
+  fileHandle_t file;
+  const int length = fileSystem().open(ANIMATION_SCRIPT, &file, FS_READ);
+  if (length <= 0) {
+    throw PmoveError(std::string("Could not load ") + ANIMATION_SCRIPT);
+  }
+  std::vector<char> text(length + 1);
+  fileSystem().read(text.data(), length, file);
+  fileSystem().close(file);
+
+  BG_AnimParseAnimScript(&animModelInfo, &scriptData, ANIMATION_SCRIPT,
+                         text.data());
+  return &character;
+}
+
+// player state as ClientSpawn leaves it
+static void spawnPlayer(const Scenario &scenario, playerState_t &ps,
+                        pmoveExt_t &pmext) {
+  std::memset(&ps, 0, sizeof(ps));
+  std::memset(&pmext, 0, sizeof(pmext));
+
+  ps.commandTime = START_TIME;
+  ps.pm_type = PM_NORMAL;
+  ps.groundEntityNum = ENTITYNUM_NONE;
+  ps.gravity = 800;
+  ps.speed = 320;
+  ps.stats[STAT_HEALTH] = 100;
+  ps.stats[STAT_MAX_HEALTH] = 100;
+  ps.weapon = WP_KNIFE;
+  ps.weaponstate = WEAPON_READY;
+  COM_BitSet(ps.weapons, WP_KNIFE);
+
+  VectorCopy(playerMins, ps.mins);
+  VectorCopy(playerMaxs, ps.maxs);
+  ps.crouchViewHeight = CROUCH_VIEWHEIGHT;
+  ps.standViewHeight = DEFAULT_VIEWHEIGHT;
+  ps.deadViewHeight = DEAD_VIEWHEIGHT;
+  ps.crouchMaxZ = ps.maxs[2] - (ps.standViewHeight - ps.crouchViewHeight);
+  ps.viewheight = DEFAULT_VIEWHEIGHT;
+  ps.runSpeedScale = 0.8f;
+  ps.sprintSpeedScale = 1.1f;
+  ps.crouchSpeedScale = 0.25f;
+  ps.friction = 1.0f;
+  pmext.sprintTime = SPRINTTIME;
+  // what ClientEndFrame does on a g_nofatigue server
+  ps.powerups[PW_ADRENALINE] = 1;
+
+  scenario.spawn(ps);
+}
+
+static uint32_t hashBytes(uint32_t hash, const void *data, size_t size) {
+  const auto bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+// Runs one scenario and returns the time spent in Pmove. The
+// trajectory hash covers the position and velocity after every move,
+// so a difference anywhere along the way is caught, not only one that
+// survives to the final state.
+static double runScenario(const Scenario &scenario, const Options &options,
+                          bg_character_t *character, playerState_t &ps,
+                          uint32_t &trajectory) {
+  static int skill[SK_NUM_SKILLS];
+  pmoveExt_t pmext;
+
+  world.clear();
+  scenario.build(world);
+  spawnPlayer(scenario, ps, pmext);
+
+  Script script;
+  usercmd_t oldcmd{};
+  vec3_t mins;
+  vec3_t maxs;
+  VectorCopy(ps.mins, mins);
+  VectorCopy(ps.maxs, maxs);
+  int waterlevel = 0;
+  int watertype = 0;
+
+  trajectory = 2166136261u;
+  double ns = 0;
+
+  for (int move = 0; move < options.moves; move++) {
+    usercmd_t cmd{};
+    cmd.serverTime = ps.commandTime + options.cmdMsec;
+    cmd.weapon = static_cast<byte>(ps.weapon);
+    scenario.input(ps, options.cmdMsec, script, cmd);
+
+    // set up like ClientThink_real does for a living player
+    pmove_t pm{};
+    pm.ps = &ps;
+    pm.pmext = &pmext;
+    pm.character = character;
+    pm.cmd = cmd;
+    pm.oldcmd = oldcmd;
+    pm.tracemask = MASK_PLAYERSOLID;
+    pm.trace = trace;
+    pm.pointcontents = pointContents;
+    pm.pmove_msec = options.cmdMsec;
+    pm.gametype = ETJUMP_GAMETYPE;
+    pm.skill = skill;
+    VectorCopy(mins, pm.mins);
+    VectorCopy(maxs, pm.maxs);
+    pm.waterlevel = waterlevel;
+    pm.watertype = watertype;
+
+    const auto start = std::chrono::steady_clock::now();
+    Pmove(&pm);
+    const auto end = std::chrono::steady_clock::now();
+    ns += std::chrono::duration<double, std::nano>(end - start).count();
+
+    VectorCopy(pm.mins, mins);
+    VectorCopy(pm.maxs, maxs);
+    waterlevel = pm.waterlevel;
+    watertype = pm.watertype;
+    oldcmd = cmd;
+
+    trajectory = hashBytes(trajectory, ps.origin, sizeof(ps.origin));
+    trajectory = hashBytes(trajectory, ps.velocity, sizeof(ps.velocity));
+  }
+  return ns;
+}
+
+static std::vector<ScenarioResult> run(const Options &options,
+                                       bg_character_t *character) {
+  std::vector<ScenarioResult> results;
+
+  for (const auto &scenario : SCENARIOS) {
+    ScenarioResult result;
+    result.name = scenario.name;
+
+    for (int i = 0; i < options.iterations; i++) {
+      playerState_t ps;
+      uint32_t trajectory;
+      const double ns =
+          runScenario(scenario, options, character, ps, trajectory);
+
+      if (i == 0) {
+        result.ps = ps;
+        result.trajectory = trajectory;
+        result.bestNs = ns;
+      } else if (trajectory != result.trajectory) {
+        result.deterministic = false;
+      }
+      result.ns += ns;
+      result.bestNs = std::min(result.bestNs, ns);
+    }
+
+    result.ns /= static_cast<double>(options.iterations) * options.moves;
+    result.bestNs /= options.moves;
+    results.push_back(result);
+  }
+  return results;
+}
+
+static std::string formatVector(const vec3_t v) {
+  char buffer[128];
+  // 9 significant digits round trip any float
+  std::snprintf(buffer, sizeof(buffer), "%.9g %.9g %.9g", v[0], v[1], v[2]);
+  return buffer;
+}
+
+// one "scenario key values" line per field, stable between runs of the
+// same build so the files can be diffed
+static std::vector<std::string> stateLines(const ScenarioResult &result) {
+  const auto &ps = result.ps;
+  char buffer[128];
+  std::vector<std::string> lines;
+
+  lines.push_back(result.name + " origin " + formatVector(ps.origin));
+  lines.push_back(result.name + " velocity " + formatVector(ps.velocity));
+  lines.push_back(result.name + " viewangles " +
+                  formatVector(ps.viewangles));
+  std::snprintf(buffer, sizeof(buffer), " flags %d %d %d %d", ps.pm_flags,
+                ps.pm_time, ps.eFlags, ps.groundEntityNum);
+  lines.push_back(result.name + buffer);
+  std::snprintf(buffer, sizeof(buffer), " anims %d %d %d %d", ps.legsAnim,
+                ps.legsTimer, ps.torsoAnim, ps.torsoTimer);
+  lines.push_back(result.name + buffer);
+  std::snprintf(buffer, sizeof(buffer), " trajectory %08x",
+                result.trajectory);
+  lines.push_back(result.name + buffer);
+  return lines;
+}
+
+// returns the lines of the golden file that differ from this run
+static std::vector<std::string>
+compareGolden(const std::string &path,
+              const std::vector<ScenarioResult> &results) {
+  std::ifstream file(path);
+  std::vector<std::string> golden;
+  for (std::string line; std::getline(file, line);) {
+    golden.push_back(line);
+  }
+
+  std::vector<std::string> current;
+  for (const auto &result : results) {
+    const auto lines = stateLines(result);
+    current.insert(current.end(), lines.begin(), lines.end());
+  }
+
+  std::vector<std::string> differences;
+  for (size_t i = 0; i < std::max(golden.size(), current.size()); i++) {
+    const auto &expected = i < golden.size() ? golden[i] : "";
+    const auto &actual = i < current.size() ? current[i] : "";
+    if (expected != actual) {
+      differences.push_back("- " + expected + "\n+ " + actual);
+    }
+  }
+  return differences;
+}
+
+static Json::Value report(const Options &options,
+                          const std::vector<ScenarioResult> &results) {
+  Json::Value root;
+  root["moves"] = options.moves;
+  root["cmd_msec"] = options.cmdMsec;
+  root["iterations"] = options.iterations;
+
+  double total = 0;
+  for (const auto &result : results) {
+    Json::Value scenario;
+    scenario["name"] = result.name;
+    scenario["ns_per_move"] = result.ns;
+    scenario["best_ns_per_move"] = result.bestNs;
+    scenario["deterministic"] = result.deterministic;
+    char trajectory[16];
+    std::snprintf(trajectory, sizeof(trajectory), "%08x", result.trajectory);
+    scenario["trajectory"] = trajectory;
+    for (int i = 0; i < 3; i++) {
+      scenario["origin"].append(result.ps.origin[i]);
+      scenario["velocity"].append(result.ps.velocity[i]);
+    }
+    root["scenarios"].append(scenario);
+    total += result.ns;
+  }
+  root["ns_per_move"] = results.empty() ? 0 : total / results.size();
+  return root;
+}
+
+static void printReport(const Json::Value &report) {
+  std::printf("%d moves per scenario, %d msec moves, %d iterations\n\n",
+              report["moves"].asInt(), report["cmd_msec"].asInt(),
+              report["iterations"].asInt());
+  std::printf("%-14s %12s %12s %12s %10s\n", "scenario", "ns/move",
+              "best ns/move", "speed", "trajectory");
+
+  for (const auto &scenario : report["scenarios"]) {
+    const auto &velocity = scenario["velocity"];
+    const double speed = std::sqrt(velocity[0].asDouble() *
+                                       velocity[0].asDouble() +
+                                   velocity[1].asDouble() *
+                                       velocity[1].asDouble());
+    std::printf("%-14s %12.1f %12.1f %12.1f %10s\n",
+                scenario["name"].asCString(),
+                scenario["ns_per_move"].asDouble(),
+                scenario["best_ns_per_move"].asDouble(), speed,
+                scenario["trajectory"].asCString());
+  }
+  std::printf("\nmean %.1f ns/move\n", report["ns_per_move"].asDouble());
+}
+
+static void printUsage() {
+  std::cout << "usage: pmove_sim [--moves <n>] [--iterations <n>] "
+               "[--cmd-msec <n>] [--states <file>] [--golden <file>] "
+               "[--json <file|->] [--verify] [--verbose]\n";
+}
+
+int main(int argc, char **argv) {
+  Options options;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "--moves" && i + 1 < argc) {
+      options.moves = std::atoi(argv[++i]);
+    } else if (arg == "--iterations" && i + 1 < argc) {
+      options.iterations = std::atoi(argv[++i]);
+    } else if (arg == "--cmd-msec" && i + 1 < argc) {
+      options.cmdMsec = std::atoi(argv[++i]);
+    } else if (arg == "--states" && i + 1 < argc) {
+      options.statesPath = argv[++i];
+    } else if (arg == "--golden" && i + 1 < argc) {
+      options.goldenPath = argv[++i];
+    } else if (arg == "--json" && i + 1 < argc) {
+      options.jsonPath = argv[++i];
+    } else if (arg == "--verify") {
+      options.verify = true;
+    } else if (arg == "--verbose") {
+      options.verbose = true;
+    } else {
+      printUsage();
+      return 1;
+    }
+  }
+
+  if (options.moves < 1 || options.iterations < 1 || options.cmdMsec < 1) {
+    printUsage();
+    return 1;
+  }
+  // verifying needs a second run to compare against
+  if (options.verify) {
+    options.iterations = std::max(options.iterations, 2);
+  }
+
+  setVerbose(options.verbose);
+
+  int status = 0;
+  try {
+    const auto results = run(options, loadCharacter());
+    const auto json = report(options, results);
+    printReport(json);
+
+    if (options.verify) {
+      bool deterministic = true;
+      for (const auto &result : results) {
+        if (!result.deterministic) {
+          std::printf("verify failed: %s differs between iterations\n",
+                      result.name.c_str());
+          deterministic = false;
+        }
+      }
+      if (deterministic) {
+        std::printf("verify passed\n");
+      } else {
+        status = 1;
+      }
+    }
+
+    if (!options.statesPath.empty()) {
+      std::ofstream file(options.statesPath);
+      for (const auto &result : results) {
+        for (const auto &line : stateLines(result)) {
+          file << line << '\n';
+        }
+      }
+    }
+
+    if (!options.goldenPath.empty()) {
+      const auto differences = compareGolden(options.goldenPath, results);
+      for (const auto &difference : differences) {
+        std::printf("%s\n", difference.c_str());
+      }
+      if (differences.empty()) {
+        std::printf("golden states match\n");
+      } else {
+        std::printf("golden states differ from %s\n",
+                    options.goldenPath.c_str());
+        status = 1;
+      }
+    }
+
+    if (!options.jsonPath.empty()) {
+      Json::StreamWriterBuilder builder;
+      builder["indentation"] = "  ";
+      const auto output = Json::writeString(builder, json);
+      if (options.jsonPath == "-") {
+        std::cout << output << '\n';
+      } else {
+        std::ofstream file(options.jsonPath);
+        file << output << '\n';
+      }
+    }
+  } catch (const PmoveError &error) {
+    std::cerr << "Pmove error: " << error.what() << '\n';
+    return 1;
+  }
+
+  return status;
+}
@@ -0,0 +1,74 @@
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/cgame/etj_snaphud_table.h"
+
+using namespace ETJump;
+
+// frame accelerations for a sweep of wishspeeds and pmove_msec values,
+// both on ground (accel 10) and in air (accel 1), clamped like snaphud does
+static std::vector<float> frameAccelSweep() {
+  const float wishspeeds[] = {127.0f, 160.0f, 256.0f, 320.0f, 352.0f, 480.0f};
+  const int msecs[] = {1, 4, 7, 8, 11, 16};
+  const float accels[] = {1.0f, 10.0f};
+
+  std::vector<float> sweep;
+  for (const auto accel : accels) {
+    for (const auto wishspeed : wishspeeds) {
+      for (const auto msec : msecs) {
+        float a = accel * wishspeed * (static_cast<float>(msec) / 1000.0f);
+        if (a > 85) {
+          a = 85;
+        }
+        sweep.push_back(a);
+      }
+    }
+  }
+  return sweep;
+}
+
+// what snaphud did on every accel change before caching
+ETJ_BENCHMARK(Snaphud_BuildTableSweep) {
+  const auto sweep = frameAccelSweep();
+  SnapTable table;
+
+  while (state.keepRunning()) {
+    for (const auto a : sweep) {
+      table.build(a);
+      Benchmark::doNotOptimize(table.zones.data());
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * sweep.size());
+}
+
+// frametime jitter without pmove_fixed, accel alternates between
+// a few values every frame, all of which fit in the cache
+ETJ_BENCHMARK(Snaphud_CachedTableJitter) {
+  const float jitter[] = {352.0f * 0.007f, 352.0f * 0.008f,
+                          352.0f * 0.008f, 352.0f * 0.009f};
+  SnapTableCache cache(8);
+
+  while (state.keepRunning()) {
+    for (const auto a : jitter) {
+      Benchmark::doNotOptimize(cache.get(a)->zones.data());
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * 4);
+}
+
+// full sweep through a cache smaller than the sweep, worst case
+// where most lookups miss and rebuild an evicted table in place
+ETJ_BENCHMARK(Snaphud_CachedTableSweepMisses) {
+  const auto sweep = frameAccelSweep();
+  SnapTableCache cache(8);
+
+  while (state.keepRunning()) {
+    for (const auto a : sweep) {
+      Benchmark::doNotOptimize(cache.get(a)->zones.data());
+    }
+  }
+
+  state.setItemsProcessed(state.iterations() * sweep.size());
+}
@@ -0,0 +1,246 @@
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/game/etj_string_utilities.h"
+
+using namespace ETJump;
+
+// names as they show up in userinfo on a public trickjump server, most
+// are colored and a few carry stray carets or trailing spaces
+static const std::vector<std::string> playerNames = {
+    "^7Player",
+    "^1e^7t^1j^7u^1m^7p",
+    "^0[^7TJ^0]^3Zero",
+    "^>^8strafe^>god",
+    "^dx^9-^dshadow^7",
+    "^s^^^7caret^^name",
+    "^2gr^3a^4di^5ent^6n^7ame^8x^9y",
+    "unnamed player",
+    "^7  padded  ",
+    "^a^b^c^d^e^f^g^h^i^j^k^l",
+    "ETPlayer",
+    "^7[^1SNIPER^7]^3 ^4elite",
+    "^9|^7cl4n^9| ^wmember",
+    "^^^^^^",
+    "^3long^7name^3with^7many^3colors^7and^3more",
+    "plainname"};
+
+// chat lines as they go through say and the chat replay buffer
+static const std::vector<std::string> chatMessages = {
+    "^7gg",
+    "^3anyone know where the ^1secret ^3is on this map?",
+    "load",
+    "^2nice run ^7man, that was ^5clean",
+    "brb",
+    "^1Warning: ^7you are not allowed to use ^3noclip ^7here",
+    "how do you do the ^6overbounce ^7at the end of the second room",
+    "^dlol",
+    "      spaces everywhere      ",
+    "^7type ^3/records ^7to see the top times on ^2this ^7map",
+    "^1r^2a^3i^4n^5b^6o^7w ^8m^9e^as^bs^ca^dg^ee",
+    "ok"};
+
+// checkpoint lists are sent as comma separated times
+static const std::vector<std::string> checkpointLists = {
+    "1200,3400,5600,7800,9100,11200,13400,15600,17800,19100,21200,23400,"
+    "25600,27800,29100,31200",
+    "-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1",
+    "512,1024,2048,4096,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1"};
+
+// command arguments as players type them, often with stray whitespace
+static const std::vector<std::string> paddedArguments = {
+    "  season 1  ", "map", " run name ", "\t--page 2\t", "   ",
+    "oasis ", " 100", "plain"};
+
+// large enough for everything in the corpora above
+static const int MAX_NAME_BYTES = 64;
+static const int MAX_MESSAGE_BYTES = 128;
+
+static uint64_t totalBytes(const std::vector<std::string> &corpus) {
+  uint64_t bytes = 0;
+  for (const auto &text : corpus) {
+    bytes += text.size();
+  }
+  return bytes;
+}
+
+ETJ_BENCHMARK(StringUtilities_sanitizePlayerNames) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &name : playerNames) {
+      length += sanitize(name).size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * playerNames.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(playerNames));
+}
+
+// name comparisons and the database lsanitize function lowercase too
+ETJ_BENCHMARK(StringUtilities_sanitizePlayerNamesToLower) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &name : playerNames) {
+      length += sanitize(name, true).size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * playerNames.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(playerNames));
+}
+
+ETJ_BENCHMARK(StringUtilities_sanitizeChatMessages) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &message : chatMessages) {
+      length += sanitize(message).size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * chatMessages.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(chatMessages));
+}
+
+// what sanitize did before the table, one branchy pass into a fresh
+// buffer per string
+static void legacySanitize(const char *in, char *out, bool toLower) {
+  while (*in) {
+    if (*in == 27 || *in == '^') {
+      in++;
+      if (*in) {
+        in++;
+      }
+      continue;
+    }
+
+    if (*in < 32) {
+      in++;
+      continue;
+    }
+
+    *out++ = toLower ? static_cast<char>(std::tolower(*in++)) : *in++;
+  }
+
+  *out = 0;
+}
+
+ETJ_BENCHMARK(StringUtilities_legacySanitizePlayerNames) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &name : playerNames) {
+      std::vector<char> out(name.size() + 1);
+      legacySanitize(name.c_str(), out.data(), true);
+      length += std::string(out.data()).size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * playerNames.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(playerNames));
+}
+
+// the allocation free core writing into a reused buffer, like the
+// SanitizeString callers do with their stack buffers
+ETJ_BENCHMARK(StringUtilities_sanitizeIntoPlayerNames) {
+  char out[MAX_NAME_BYTES];
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &name : playerNames) {
+      length += sanitizeInto(name.data(), name.size(), out, {true});
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * playerNames.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(playerNames));
+}
+
+ETJ_BENCHMARK(StringUtilities_sanitizeIntoChatMessages) {
+  char out[MAX_MESSAGE_BYTES];
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &message : chatMessages) {
+      length += sanitizeInto(message.data(), message.size(), out);
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * chatMessages.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(chatMessages));
+}
+
+ETJ_BENCHMARK(StringUtilities_sanitizeIntoChatMessagesFolded) {
+  SanitizeOptions options;
+  options.toLower = true;
+  options.foldWhitespace = true;
+
+  char out[MAX_MESSAGE_BYTES];
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &message : chatMessages) {
+      length += sanitizeInto(message.data(), message.size(), out, options);
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * chatMessages.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(chatMessages));
+}
+
+ETJ_BENCHMARK(StringUtilities_splitCheckpointLists) {
+  size_t parts = 0;
+  while (state.keepRunning()) {
+    for (const auto &list : checkpointLists) {
+      parts += StringUtil::split(list, ",").size();
+    }
+  }
+
+  Benchmark::doNotOptimize(parts);
+  state.setItemsProcessed(state.iterations() * checkpointLists.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(checkpointLists));
+}
+
+ETJ_BENCHMARK(StringUtilities_splitChatWords) {
+  size_t parts = 0;
+  while (state.keepRunning()) {
+    for (const auto &message : chatMessages) {
+      parts += StringUtil::split(message, " ").size();
+    }
+  }
+
+  Benchmark::doNotOptimize(parts);
+  state.setItemsProcessed(state.iterations() * chatMessages.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(chatMessages));
+}
+
+ETJ_BENCHMARK(StringUtilities_trimArguments) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &argument : paddedArguments) {
+      length += trim(argument).size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * paddedArguments.size());
+  state.setBytesProcessed(state.iterations() * totalBytes(paddedArguments));
+}
+
+ETJ_BENCHMARK(StringUtilities_iEqualSanitizedNames) {
+  int equal = 0;
+  while (state.keepRunning()) {
+    for (const auto &name : playerNames) {
+      if (StringUtil::iEqual(name, playerNames[0], true)) {
+        equal++;
+      }
+    }
+  }
+
+  Benchmark::doNotOptimize(equal);
+  state.setItemsProcessed(state.iterations() * playerNames.size());
+}
@@ -0,0 +1,87 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/game/etj_printer.h"
+#include "../src/game/etj_timerun_repository.h"
+#include "../src/game/q_shared.h"
+
+using namespace ETJump;
+
+// the database logger flushes through the printer on the next frame,
+// which never comes here
+void Printer::LogPrintln(const std::string &message) {}
+
+static const std::vector<int> activeSeasons = {1, 2, 3};
+static const int NUM_PLAYERS = 200;
+static const char *const MAP = "oasis";
+static const char *const RUN = "main run";
+
+static Timerun::Record createRecord(int seasonId, int userId, int time) {
+  Timerun::Record record;
+  record.seasonId = seasonId;
+  record.map = MAP;
+  record.run = RUN;
+  record.userId = userId;
+  record.time = time;
+  record.checkpoints = std::vector<int>(MAX_TIMERUN_CHECKPOINTS, -1);
+  record.recordDate = getCurrentTime();
+  record.playerName = "^7player" + std::to_string(userId);
+  record.metadata = {{"mod_version", "benchmark"}};
+  return record;
+}
+
+// an in-memory database with a few seasons and a record for every player
+// in each of them, so statement overhead isn't hidden behind disk syncs
+static std::unique_ptr<TimerunRepository> createRepository() {
+  auto repository = std::make_unique<TimerunRepository>(
+      std::make_unique<DatabaseV2>("timerun", ":memory:"),
+      std::make_unique<DatabaseV2>("old", ":memory:"));
+  repository->initialize();
+
+  for (int i = 2; i <= 3; i++) {
+    Timerun::AddSeasonParams params{};
+    params.name = "season " + std::to_string(i);
+    params.startTime = Time::fromString("2024-01-01 00:00:00");
+    repository->addSeason(params);
+  }
+
+  for (const auto seasonId : activeSeasons) {
+    for (int userId = 1; userId <= NUM_PLAYERS; userId++) {
+      repository->insertRecord(createRecord(seasonId, userId, 60000 + userId));
+    }
+  }
+
+  return repository;
+}
+
+// what TimerunV2::checkRecord does when a player finishes a run: look up
+// the top and personal records for all active seasons, then store the
+// time for each season it improves on
+static void completeRun(TimerunRepository &repository, int userId, int time) {
+  const auto topRecords = repository.getTopRecords(activeSeasons, MAP, RUN);
+  const auto playerRecords =
+      repository.getRecordsForPlayer(activeSeasons, MAP, RUN, userId);
+
+  Benchmark::doNotOptimize(topRecords.size());
+  for (const auto &previous : playerRecords) {
+    if (time < previous.time) {
+      repository.updateRecord(createRecord(previous.seasonId, userId, time));
+    }
+  }
+}
+
+ETJ_BENCHMARK(TimerunRepository_completeRun) {
+  auto repository = createRepository();
+
+  // every finish is a new best time, so the top records stay one per
+  // season instead of piling up ties
+  int run = 0;
+  while (state.keepRunning()) {
+    completeRun(*repository, run % NUM_PLAYERS + 1, 60000 - run);
+    run++;
+  }
+
+  state.setItemsProcessed(state.iterations());
+}
@@ -0,0 +1,104 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "../src/game/etj_timerun_shared.h"
+
+using namespace ETJump;
+
+static const int RUN_CHECKPOINTS = 8;
+
+static std::array<int, MAX_TIMERUN_CHECKPOINTS> checkpointTimes(int step) {
+  std::array<int, MAX_TIMERUN_CHECKPOINTS> times{};
+  times.fill(-1);
+  for (int i = 0; i < RUN_CHECKPOINTS; i++) {
+    times[i] = (i + 1) * step;
+  }
+  return times;
+}
+
+// the commands the server sends for one finished run with checkpoints,
+// in the order they go out
+static std::vector<std::string> serializeRun(int clientNum) {
+  const std::string runName = "^7main ^3run";
+  std::vector<std::string> commands;
+
+  commands.push_back(TimerunCommands::Start(clientNum, 123456, runName, 65432,
+                                            true, checkpointTimes(8000),
+                                            checkpointTimes(7900))
+                         .serialize());
+  for (int i = 0; i < RUN_CHECKPOINTS; i++) {
+    commands.push_back(
+        TimerunCommands::Checkpoint(clientNum, i, (i + 1) * 7900, runName)
+            .serialize());
+  }
+  commands.push_back(
+      TimerunCommands::Completion(clientNum, 64210, 65432, runName)
+          .serialize());
+  commands.push_back(
+      TimerunCommands::Record(clientNum, 64210, 65432, runName).serialize());
+  return commands;
+}
+
+// splits a command the way the engine tokenizer does, quoted strings
+// become one argument
+static std::vector<std::string> tokenize(const std::string &command) {
+  std::vector<std::string> args;
+  size_t i = 0;
+  while (i < command.size()) {
+    if (command[i] == ' ') {
+      i++;
+      continue;
+    }
+    if (command[i] == '"') {
+      const auto end = command.find('"', i + 1);
+      args.push_back(command.substr(i + 1, end - i - 1));
+      i = end + 1;
+      continue;
+    }
+    const auto end = command.find(' ', i);
+    args.push_back(command.substr(i, end - i));
+    i = end == std::string::npos ? command.size() : end;
+  }
+  return args;
+}
+
+ETJ_BENCHMARK(TimerunCommands_serializeRun) {
+  size_t length = 0;
+  while (state.keepRunning()) {
+    for (const auto &command : serializeRun(3)) {
+      length += command.size();
+    }
+  }
+
+  Benchmark::doNotOptimize(length);
+  state.setItemsProcessed(state.iterations() * (RUN_CHECKPOINTS + 3));
+}
+
+ETJ_BENCHMARK(TimerunCommands_deserializeRun) {
+  std::vector<std::vector<std::string>> commands;
+  for (const auto &command : serializeRun(3)) {
+    commands.push_back(tokenize(command));
+  }
+
+  int parsed = 0;
+  while (state.keepRunning()) {
+    // dispatched on the second argument, like
+    // Timerun::parseServerCommand does
+    for (const auto &args : commands) {
+      if (args[1] == "start") {
+        parsed += TimerunCommands::Start::deserialize(args).hasValue();
+      } else if (args[1] == "checkpoint") {
+        parsed += TimerunCommands::Checkpoint::deserialize(args).hasValue();
+      } else if (args[1] == "record") {
+        parsed += TimerunCommands::Record::deserialize(args).hasValue();
+      } else if (args[1] == "completion") {
+        parsed += TimerunCommands::Completion::deserialize(args).hasValue();
+      }
+    }
+  }
+
+  Benchmark::doNotOptimize(parsed);
+  state.setItemsProcessed(state.iterations() * commands.size());
+}
@@ -10,6 +10,9 @@
 
 #define ATM_NEW
 
+#include <algorithm>
+#include <chrono>
+
 #include "cg_local.h"
 
 #define MAX_ATMOSPHERIC_HEIGHT MAX_MAP_SIZE  // maximum world height
@@ -164,16 +167,31 @@ qboolean CG_AtmosphericKludge() {
 
 typedef enum { ACT_NOT, ACT_FALLING } active_t;
 
+// per particle data which is only touched when a particle
+// is generated or rendered, the state updated every frame
+// lives in the arrays of cg_atmosphericEffect_t
 typedef struct cg_atmosphericParticle_s {
-  vec3_t pos, delta, deltaNormalized, colour;
-  float height, weight;
-  active_t active;
+  vec3_t deltaNormalized, colour;
+  float weight;
   int nextDropTime;
   qhandle_t *effectshader;
 } cg_atmosphericParticle_t;
 
 typedef struct cg_atmosphericEffect_s {
   cg_atmosphericParticle_t particles[MAX_ATMOSPHERIC_PARTICLES];
+
+  // kept as separate arrays so the per-frame update vectorizes
+  float posX[MAX_ATMOSPHERIC_PARTICLES];
+  float posY[MAX_ATMOSPHERIC_PARTICLES];
+  float posZ[MAX_ATMOSPHERIC_PARTICLES];
+  float deltaX[MAX_ATMOSPHERIC_PARTICLES];
+  float deltaY[MAX_ATMOSPHERIC_PARTICLES];
+  float deltaZ[MAX_ATMOSPHERIC_PARTICLES];
+  float height[MAX_ATMOSPHERIC_PARTICLES];
+  uint8_t active[MAX_ATMOSPHERIC_PARTICLES];
+  // in front of the viewer, only valid for active particles
+  uint8_t inView[MAX_ATMOSPHERIC_PARTICLES];
+
   qhandle_t effectshaders[MAX_ATMOSPHERIC_EFFECTSHADERS];
   int lastRainTime, numDrops;
   int gustStartTime, gustEndTime;
@@ -189,69 +207,149 @@ typedef struct cg_atmosphericEffect_s {
 
   vec3_t viewDir;
 
-  qboolean (*ParticleCheckVisible)(cg_atmosphericParticle_t *particle);
-  qboolean (*ParticleGenerate)(cg_atmosphericParticle_t *particle,
-                               vec3_t currvec, float currweight);
-  void (*ParticleRender)(cg_atmosphericParticle_t *particle);
+  qboolean (*ParticleCheckVisible)(int index, float *groundHeight);
+  qboolean (*ParticleGenerate)(int index, vec3_t currvec, float currweight);
+  void (*ParticleRender)(int index, float groundHeight);
 
   int dropsActive, oldDropsActive;
   int dropsRendered, dropsCreated, dropsSkipped;
+
+  // number of particles processed last frame
+  int lastMax;
+  // fraction of numDrops allowed by etj_weatherBudget
+  float budgetScale;
+  // smoothed cost of CG_AddAtmosphericEffects in milliseconds
+  float averageCost;
 } cg_atmosphericEffect_t;
 
 static cg_atmosphericEffect_t cg_atmFx;
 
-static qboolean CG_SetParticleActive(cg_atmosphericParticle_t *particle,
-                                     active_t active) {
-  particle->active = active;
+static qboolean CG_SetParticleActive(int index, active_t active) {
+  cg_atmFx.active[index] = active;
   return active ? qtrue : qfalse;
 }
 
 /*
-**	Raindrop management functions
+**	Shared spawn position for raindrops and snowflakes
 */
 
-static qboolean CG_RainParticleGenerate(cg_atmosphericParticle_t *particle,
-                                        vec3_t currvec, float currweight) {
-  // Attempt to 'spot' a raindrop somewhere below a sky texture.
+static qboolean CG_AtmosphericParticleSpot(int index) {
+  // Attempt to 'spot' a particle somewhere below a sky texture.
 
   float angle, distance;
   float groundHeight, skyHeight;
-  //	int msec = trap_Milliseconds();
-
-  //	n_generatetime++;
+  vec3_t pos;
 
   angle = random() * 2 * M_PI;
   distance = 20 + MAX_ATMOSPHERIC_DISTANCE * random();
 
-  particle->pos[0] = cg.refdef_current->vieworg[0] + sin(angle) * distance;
-  particle->pos[1] = cg.refdef_current->vieworg[1] + cos(angle) * distance;
+  pos[0] = cg.refdef_current->vieworg[0] + sin(angle) * distance;
+  pos[1] = cg.refdef_current->vieworg[1] + cos(angle) * distance;
+  pos[2] = 0;
 
   // ydnar: choose a spawn point randomly between sky and ground
-  skyHeight = BG_GetSkyHeightAtPoint(particle->pos);
+  skyHeight = BG_GetSkyHeightAtPoint(pos);
   if (skyHeight == MAX_ATMOSPHERIC_HEIGHT) {
     return qfalse;
   }
-  groundHeight = BG_GetSkyGroundHeightAtPoint(particle->pos);
+  groundHeight = BG_GetSkyGroundHeightAtPoint(pos);
   if (groundHeight >= skyHeight) {
     return qfalse;
   }
-  particle->pos[2] = groundHeight + random() * (skyHeight - groundHeight);
+  pos[2] = groundHeight + random() * (skyHeight - groundHeight);
 
   // make sure it doesn't fall from too far cause it then will go over
   // our heads
   // ('lower the ceiling')
   if (cg_atmFx.baseHeightOffset > 0) {
-    if (particle->pos[2] - cg.refdef_current->vieworg[2] >
-        cg_atmFx.baseHeightOffset) {
-      particle->pos[2] =
-          cg.refdef_current->vieworg[2] + cg_atmFx.baseHeightOffset;
+    if (pos[2] - cg.refdef_current->vieworg[2] > cg_atmFx.baseHeightOffset) {
+      pos[2] = cg.refdef_current->vieworg[2] + cg_atmFx.baseHeightOffset;
 
-      if (particle->pos[2] < groundHeight) {
+      if (pos[2] < groundHeight) {
         return qfalse;
       }
     }
   }
 
+  cg_atmFx.posX[index] = pos[0];
+  cg_atmFx.posY[index] = pos[1];
+  cg_atmFx.posZ[index] = pos[2];
+  return qtrue;
+}
+
+static void CG_SetParticleDelta(int index, const vec3_t delta) {
+  cg_atmosphericParticle_t *particle = &cg_atmFx.particles[index];
+
+  cg_atmFx.deltaX[index] = delta[0];
+  cg_atmFx.deltaY[index] = delta[1];
+  cg_atmFx.deltaZ[index] = delta[2];
+  VectorCopy(delta, particle->deltaNormalized);
+  VectorNormalizeFast(particle->deltaNormalized);
+}
+
+static void CG_GetParticlePos(int index, vec3_t pos) {
+  pos[0] = cg_atmFx.posX[index];
+  pos[1] = cg_atmFx.posY[index];
+  pos[2] = cg_atmFx.posZ[index];
+}
+
+/*
+**	Moves every particle and drops the ones which left the visible
+**	range. Kept free of calls and branches so it vectorizes.
+*/
+
+static void CG_AtmosphericParticlesMove(int max) {
+  const float moved = (cg.time - cg_atmFx.lastRainTime) * 0.001f;
+  const float viewX = cg.refdef_current->vieworg[0];
+  const float viewY = cg.refdef_current->vieworg[1];
+  const float viewZ = cg.refdef_current->vieworg[2];
+  const float forwardX = cg.refdef_current->viewaxis[0][0];
+  const float forwardY = cg.refdef_current->viewaxis[0][1];
+  const float forwardZ = cg.refdef_current->viewaxis[0][2];
+  const float maxDistSquared = Square(MAX_ATMOSPHERIC_DISTANCE);
+
+  float *posX = cg_atmFx.posX;
+  float *posY = cg_atmFx.posY;
+  float *posZ = cg_atmFx.posZ;
+  const float *deltaX = cg_atmFx.deltaX;
+  const float *deltaY = cg_atmFx.deltaY;
+  const float *deltaZ = cg_atmFx.deltaZ;
+  const float *height = cg_atmFx.height;
+  uint8_t *active = cg_atmFx.active;
+  uint8_t *inView = cg_atmFx.inView;
+
+  for (int i = 0; i < max; i++) {
+    posX[i] += moved * deltaX[i];
+    posY[i] += moved * deltaY[i];
+    posZ[i] += moved * deltaZ[i];
+
+    const float dx = posX[i] - viewX;
+    const float dy = posY[i] - viewY;
+    const float dz = posZ[i] - viewZ;
+
+    // ydnar: just nuke particles out of range, let them respawn
+    active[i] &= static_cast<uint8_t>(dx * dx + dy * dy <= maxDistSquared);
+
+    // behind the view plane, with some slack for the particle length
+    inView[i] = static_cast<uint8_t>(dx * forwardX + dy * forwardY +
+                                         dz * forwardZ >=
+                                     -height[i]);
+  }
+}
+
+/*
+**	Raindrop management functions
+*/
+
+static qboolean CG_RainParticleGenerate(int index, vec3_t currvec,
+                                        float currweight) {
+  cg_atmosphericParticle_t *particle = &cg_atmFx.particles[index];
+  vec3_t delta;
+
+  if (!CG_AtmosphericParticleSpot(index)) {
+    return qfalse;
+  }
+
   // ydnar: rain goes in bursts
   {
     float maxActiveDrops;
@@ -264,117 +362,75 @@ static qboolean CG_RainParticleGenerate(cg_atmosphericParticle_t *particle,
     }
   }
 
-  CG_SetParticleActive(particle, ACT_FALLING);
+  CG_SetParticleActive(index, ACT_FALLING);
   particle->colour[0] = 0.6 + 0.2 * random() * 0xFF;
   particle->colour[1] = 0.6 + 0.2 * random() * 0xFF;
   particle->colour[2] = 0.6 + 0.2 * random() * 0xFF;
-  VectorCopy(currvec, particle->delta);
-  particle->delta[2] += crandom() * 100;
-  VectorCopy(particle->delta, particle->deltaNormalized);
-  VectorNormalizeFast(particle->deltaNormalized);
-  particle->height = ATMOSPHERIC_RAIN_HEIGHT + crandom() * 100;
+  VectorCopy(currvec, delta);
+  delta[2] += crandom() * 100;
+  CG_SetParticleDelta(index, delta);
+  cg_atmFx.height[index] = ATMOSPHERIC_RAIN_HEIGHT + crandom() * 100;
   particle->weight = currweight;
   particle->effectshader = &cg_atmFx.effectshaders[0];
   //	particle->effectshader = &cg_atmFx.effectshaders[ (int)
   //(random() * (
   // cg_atmFx.numEffectShaders - 1 )) ];
 
-  //	generatetime += trap_Milliseconds() - msec;
   return (qtrue);
 }
 
-static qboolean
-CG_RainParticleCheckVisible(cg_atmosphericParticle_t *particle) {
-  // Check the raindrop is visible and still going, wrapping if
-  // necessary.
+static qboolean CG_RainParticleCheckVisible(int index, float *groundHeight) {
+  // Check the raindrop is still going, movement and range checks
+  // are done for all particles in CG_AtmosphericParticlesMove.
 
-  float moved;
-  vec2_t distance;
-  //	int msec = trap_Milliseconds();
+  vec3_t pos;
 
-  if (!particle || particle->active == ACT_NOT) {
-    //		checkvisibletime += trap_Milliseconds() - msec;
+  if (cg_atmFx.active[index] == ACT_NOT) {
     return (qfalse);
   }
 
-  moved =
-      (cg.time - cg_atmFx.lastRainTime) * 0.001; // Units moved since last frame
-  VectorMA(particle->pos, moved, particle->delta, particle->pos);
-  if (particle->pos[2] + particle->height <
-      BG_GetSkyGroundHeightAtPoint(particle->pos)) {
-    //		checkvisibletime += trap_Milliseconds() - msec;
-    return CG_SetParticleActive(particle, ACT_NOT);
-  }
-
-  distance[0] = particle->pos[0] - cg.refdef_current->vieworg[0];
-  distance[1] = particle->pos[1] - cg.refdef_current->vieworg[1];
-  if ((distance[0] * distance[0] + distance[1] * distance[1]) >
-      Square(MAX_ATMOSPHERIC_DISTANCE)) {
-    // ydnar: just nuke this particle, let it respawn
-    return CG_SetParticleActive(particle, ACT_NOT);
-
-    /*
-    // Attempt to respot the particle at our other side
-    particle->pos[0] -= 1.85f * distance[0];
-    particle->pos[1] -= 1.85f * distance[1];
-
-    // Valid spot?
-    pointHeight = BG_GetSkyHeightAtPoint( particle->pos );
-    if( pointHeight == MAX_ATMOSPHERIC_HEIGHT ) {
-    //			checkvisibletime += trap_Milliseconds() -
-    msec; return CG_SetParticleActive( particle, ACT_NOT );
-    }
-
-    pointHeight = BG_GetSkyGroundHeightAtPoint( particle->pos );
-    if( pointHeight == MAX_ATMOSPHERIC_HEIGHT || pointHeight >=
-    particle->pos[2] ) {
-    //			checkvisibletime += trap_Milliseconds() -
-    msec; return CG_SetParticleActive( particle, ACT_NOT );
-    }
-    */
+  CG_GetParticlePos(index, pos);
+  *groundHeight = BG_GetSkyGroundHeightAtPoint(pos);
+  if (pos[2] + cg_atmFx.height[index] < *groundHeight) {
+    return CG_SetParticleActive(index, ACT_NOT);
   }
 
-  //	checkvisibletime += trap_Milliseconds() - msec;
   return (qtrue);
 }
 
-static void CG_RainParticleRender(cg_atmosphericParticle_t *particle) {
+static void CG_RainParticleRender(int index, float groundHeight) {
   // Draw a raindrop
 
+  cg_atmosphericParticle_t *particle = &cg_atmFx.particles[index];
+  const float height = cg_atmFx.height[index];
   vec3_t forward, right;
   polyVert_t verts[3];
   vec2_t line;
   float len, dist;
   vec3_t start, finish;
-  float groundHeight;
-  //	int			msec = trap_Milliseconds();
-
-  //	n_rendertime++;
 
-  if (particle->active == ACT_NOT) {
-    //		rendertime += trap_Milliseconds() - msec;
+  if (cg_atmFx.active[index] == ACT_NOT || !cg_atmFx.inView[index]) {
     return;
   }
 
-  if (CG_CullPoint(particle->pos)) {
+  CG_GetParticlePos(index, start);
+
+  if (CG_CullPoint(start)) {
     return;
   }
 
-  VectorCopy(particle->pos, start);
+  dist = DistanceSquared(start, cg.refdef_current->vieworg);
 
-  dist = DistanceSquared(particle->pos, cg.refdef_current->vieworg);
-
-  // Make sure it doesn't clip through surfaces
-  groundHeight = BG_GetSkyGroundHeightAtPoint(start);
-  len = particle->height;
+  // Make sure it doesn't clip through surfaces,
+  // groundHeight was looked up at this same point by the visibility check
+  len = height;
   if (start[2] <= groundHeight) {
     // Stop snow going through surfaces.
-    len = particle->height - groundHeight + start[2];
-    VectorMA(start, len - particle->height, particle->deltaNormalized, start);
+    len = height - groundHeight + start[2];
+    VectorMA(start, len - height, particle->deltaNormalized, start);
   }
 
   if (len <= 0) {
-    //		rendertime += trap_Milliseconds() - msec;
     return;
   }
 
@@ -422,175 +478,102 @@ static void CG_RainParticleRender(cg_atmosphericParticle_t *particle) {
   verts[2].modulate[3] = 200 * dist;
 
   CG_AddPolyToPool(*particle->effectshader, verts);
-
-  //	rendertime += trap_Milliseconds() - msec;
 }
 
 /*
 **	Snow management functions
 */
 
-static qboolean CG_SnowParticleGenerate(cg_atmosphericParticle_t *particle,
-                                        vec3_t currvec, float currweight) {
-  // Attempt to 'spot' a snowflake somewhere below a sky texture.
-
-  float angle, distance;
-  float groundHeight, skyHeight;
-  //	int msec = trap_Milliseconds();
-
-  //	n_generatetime++;
-
-  angle = random() * 2 * M_PI;
-  distance = 20 + MAX_ATMOSPHERIC_DISTANCE * random();
-
-  particle->pos[0] = cg.refdef_current->vieworg[0] + sin(angle) * distance;
-  particle->pos[1] = cg.refdef_current->vieworg[1] + cos(angle) * distance;
+static qboolean CG_SnowParticleGenerate(int index, vec3_t currvec,
+                                        float currweight) {
+  cg_atmosphericParticle_t *particle = &cg_atmFx.particles[index];
+  vec3_t delta;
 
-  // ydnar: choose a spawn point randomly between sky and ground
-  skyHeight = BG_GetSkyHeightAtPoint(particle->pos);
-  if (skyHeight == MAX_ATMOSPHERIC_HEIGHT) {
-    return qfalse;
-  }
-  groundHeight = BG_GetSkyGroundHeightAtPoint(particle->pos);
-  if (groundHeight >= skyHeight) {
+  if (!CG_AtmosphericParticleSpot(index)) {
     return qfalse;
   }
-  particle->pos[2] = groundHeight + random() * (skyHeight - groundHeight);
 
-  // make sure it doesn't fall from too far cause it then will go over
-  // our heads
-  // ('lower the ceiling')
-  if (cg_atmFx.baseHeightOffset > 0) {
-    if (particle->pos[2] - cg.refdef_current->vieworg[2] >
-        cg_atmFx.baseHeightOffset) {
-      particle->pos[2] =
-          cg.refdef_current->vieworg[2] + cg_atmFx.baseHeightOffset;
-      if (particle->pos[2] < groundHeight) {
-        return qfalse;
-      }
-    }
-  }
-
-  CG_SetParticleActive(particle, ACT_FALLING);
-  VectorCopy(currvec, particle->delta);
-  particle->delta[2] += crandom() * 25;
-  VectorCopy(particle->delta, particle->deltaNormalized);
-  VectorNormalizeFast(particle->deltaNormalized);
-  particle->height = ATMOSPHERIC_SNOW_HEIGHT + random() * 2;
-  particle->weight = particle->height * 0.5f;
+  CG_SetParticleActive(index, ACT_FALLING);
+  VectorCopy(currvec, delta);
+  delta[2] += crandom() * 25;
+  CG_SetParticleDelta(index, delta);
+  cg_atmFx.height[index] = ATMOSPHERIC_SNOW_HEIGHT + random() * 2;
+  particle->weight = cg_atmFx.height[index] * 0.5f;
   particle->effectshader = &cg_atmFx.effectshaders[0];
   //	particle->effectshader = &cg_atmFx.effectshaders[ (int)
   //(random() * (
   // cg_atmFx.numEffectShaders - 1 )) ];
 
-  //	generatetime += trap_Milliseconds() - msec;
   return (qtrue);
 }
 
-static qboolean
-CG_SnowParticleCheckVisible(cg_atmosphericParticle_t *particle) {
-  // Check the snowflake is visible and still going, wrapping if
-  // necessary.
+static qboolean CG_SnowParticleCheckVisible(int index, float *groundHeight) {
+  // Check the snowflake is still going, movement and range checks
+  // are done for all particles in CG_AtmosphericParticlesMove.
 
-  float moved;
-  vec2_t distance;
-  //	int msec = trap_Milliseconds();
+  vec3_t pos;
 
-  //	n_checkvisibletime++;
-
-  if (!particle || particle->active == ACT_NOT) {
-    //		checkvisibletime += trap_Milliseconds() - msec;
+  if (cg_atmFx.active[index] == ACT_NOT) {
     return (qfalse);
   }
 
-  moved =
-      (cg.time - cg_atmFx.lastRainTime) * 0.001; // Units moved since last frame
-  VectorMA(particle->pos, moved, particle->delta, particle->pos);
-  if (particle->pos[2] < BG_GetSkyGroundHeightAtPoint(particle->pos)) {
-    //		checkvisibletime += trap_Milliseconds() - msec;
-    return CG_SetParticleActive(particle, ACT_NOT);
+  CG_GetParticlePos(index, pos);
+  *groundHeight = BG_GetSkyGroundHeightAtPoint(pos);
+  if (pos[2] < *groundHeight) {
+    return CG_SetParticleActive(index, ACT_NOT);
   }
 
-  distance[0] = particle->pos[0] - cg.refdef_current->vieworg[0];
-  distance[1] = particle->pos[1] - cg.refdef_current->vieworg[1];
-  if ((distance[0] * distance[0] + distance[1] * distance[1]) >
-      Square(MAX_ATMOSPHERIC_DISTANCE)) {
-    // ydnar: just nuke this particle, let it respawn
-    return CG_SetParticleActive(particle, ACT_NOT);
-
-    /*
-    // Attempt to respot the particle at our other side
-    particle->pos[0] -= 1.85f * distance[0];
-    particle->pos[1] -= 1.85f * distance[1];
-
-    // ydnar: place particle in random position between ground
-    and sky groundHeight = BG_GetSkyGroundHeightAtPoint(
-    particle->pos ); skyHeight = BG_GetSkyHeightAtPoint(
-    particle->pos ); if( skyHeight == MAX_ATMOSPHERIC_HEIGHT )
-        return CG_SetParticleActive( particle, ACT_NOT );
-    particle->pos[ 2 ] = groundHeight + random() * (skyHeight -
-    groundHeight);
-
-    // ydnar: valid spot?
-    if( particle->pos[ 2 ] <= groundHeight || particle->pos[ 2 ]
-    >= skyHeight ) return CG_SetParticleActive( particle,
-    ACT_NOT );
-    */
-  }
-
-  //	checkvisibletime += trap_Milliseconds() - msec;
   return (qtrue);
 }
 
-static void CG_SnowParticleRender(cg_atmosphericParticle_t *particle) {
+static void CG_SnowParticleRender(int index, float groundHeight) {
   // Draw a snowflake
 
+  cg_atmosphericParticle_t *particle = &cg_atmFx.particles[index];
+  const float height = cg_atmFx.height[index];
+  vec3_t pos;
   vec3_t forward, right;
   polyVert_t verts[3];
   vec2_t line;
   float len, sinTumbling, cosTumbling, particleWidth, dist;
   vec3_t start, finish;
-  float groundHeight;
-  //	int			msec = trap_Milliseconds();
-
-  //	n_rendertime++;
 
-  if (particle->active == ACT_NOT) {
-    //		rendertime += trap_Milliseconds() - msec;
+  if (cg_atmFx.active[index] == ACT_NOT || !cg_atmFx.inView[index]) {
     return;
   }
 
-  if (CG_CullPoint(particle->pos)) {
+  CG_GetParticlePos(index, pos);
+
+  if (CG_CullPoint(pos)) {
     return;
   }
 
-  VectorCopy(particle->pos, start);
+  VectorCopy(pos, start);
 
-  sinTumbling =
-      std::sin(particle->pos[2] * 0.03125f * (0.5f * particle->weight));
-  cosTumbling = std::cos((particle->pos[2] + particle->pos[1]) * 0.03125f *
-                         (0.5f * particle->weight));
+  sinTumbling = std::sin(pos[2] * 0.03125f * (0.5f * particle->weight));
+  cosTumbling =
+      std::cos((pos[2] + pos[1]) * 0.03125f * (0.5f * particle->weight));
   start[0] += 24 * (1 - particle->deltaNormalized[2]) * sinTumbling;
   start[1] += 24 * (1 - particle->deltaNormalized[2]) * cosTumbling;
 
-  // Make sure it doesn't clip through surfaces
+  // Make sure it doesn't clip through surfaces, tumbling moved
+  // the flake away from where the visibility check looked
   groundHeight = BG_GetSkyGroundHeightAtPoint(start);
-  len = particle->height;
+  len = height;
   if (start[2] <= groundHeight) {
     // Stop snow going through surfaces.
-    len = particle->height - groundHeight + start[2];
-    VectorMA(start, len - particle->height, particle->deltaNormalized, start);
+    len = height - groundHeight + start[2];
+    VectorMA(start, len - height, particle->deltaNormalized, start);
   }
 
   if (len <= 0) {
-    //		rendertime += trap_Milliseconds() - msec;
     return;
   }
 
-  line[0] = particle->pos[0] - cg.refdef_current->vieworg[0];
-  line[1] = particle->pos[1] - cg.refdef_current->vieworg[1];
+  line[0] = pos[0] - cg.refdef_current->vieworg[0];
+  line[1] = pos[1] - cg.refdef_current->vieworg[1];
 
-  dist = DistanceSquared(particle->pos, cg.refdef_current->vieworg);
+  dist = DistanceSquared(pos, cg.refdef_current->vieworg);
   // dist becomes scale
   if (dist > Square(500.f)) {
     dist = 1.f + ((dist - Square(500.f)) * (10.f / Square(2000.f)));
@@ -637,8 +620,6 @@ static void CG_SnowParticleRender(cg_atmosphericParticle_t *particle) {
   verts[2].modulate[3] = 255;
 
   CG_AddPolyToPool(*particle->effectshader, verts);
-
-  //	rendertime += trap_Milliseconds() - msec;
 }
 
 /*
@@ -887,13 +868,44 @@ void CG_EffectParse(const char *effectstr) {
 
   // Initialise atmospheric effect to prevent all particles falling at
   // the start
-  for (count = 0; count < cg_atmFx.numDrops; count++)
+  for (count = 0; count < cg_atmFx.numDrops; count++) {
     cg_atmFx.particles[count].nextDropTime =
         ATMOSPHERIC_DROPDELAY + (rand() % ATMOSPHERIC_DROPDELAY);
+    cg_atmFx.active[count] = ACT_NOT;
+  }
+
+  cg_atmFx.lastMax = 0;
+  cg_atmFx.budgetScale = 1.0f;
+  cg_atmFx.averageCost = 0;
 
   CG_EffectGust();
 }
 
+/*
+**	Scales the number of particles so the effect stays
+**	within etj_weatherBudget milliseconds per frame
+*/
+
+static void CG_UpdateAtmosphericBudget(float cost) {
+  // slow enough to ride out single frame spikes
+  static const float COST_SMOOTHING = 0.1f;
+  static const float MIN_BUDGET_SCALE = 0.1f;
+
+  cg_atmFx.averageCost += (cost - cg_atmFx.averageCost) * COST_SMOOTHING;
+
+  if (etj_weatherBudget.value <= 0) {
+    cg_atmFx.budgetScale = 1.0f;
+    return;
+  }
+
+  if (cg_atmFx.averageCost > etj_weatherBudget.value) {
+    cg_atmFx.budgetScale =
+        std::max(cg_atmFx.budgetScale * 0.9f, MIN_BUDGET_SCALE);
+  } else if (cg_atmFx.averageCost < etj_weatherBudget.value * 0.75f) {
+    cg_atmFx.budgetScale = std::min(cg_atmFx.budgetScale * 1.05f, 1.0f);
+  }
+}
+
 /*
 ** Main render loop
 */
@@ -905,12 +917,15 @@ void CG_AddAtmosphericEffects() {
   cg_atmosphericParticle_t *particle;
   vec3_t currvec;
   float currweight;
+  float groundHeight;
 
   if (cg_atmFx.numDrops <= 0 || cg_atmFx.numEffectShaders == 0 ||
       cg_atmosphericEffects.value <= 0) {
     return;
   }
 
+  const auto startTime = std::chrono::steady_clock::now();
+
 #ifndef ATM_NEW
   CG_ClearPolyPool();
 #endif // ATM_NEW
@@ -918,6 +933,16 @@ void CG_AddAtmosphericEffects() {
   max = cg_atmosphericEffects.value < 1
             ? cg_atmosphericEffects.value * cg_atmFx.numDrops
             : cg_atmFx.numDrops;
+  max = std::min(
+      max, static_cast<int>(cg_atmFx.budgetScale * cg_atmFx.numDrops));
+
+  // particles dropped by a lower limit would otherwise resume from
+  // wherever they were when the limit goes back up
+  for (curr = max; curr < cg_atmFx.lastMax; curr++) {
+    cg_atmFx.active[curr] = ACT_NOT;
+  }
+  cg_atmFx.lastMax = max;
+
   if (CG_EffectGustCurrent(currvec, &currweight, &currnum)) {
     CG_EffectGust(); // Recalculate gust parameters
   }
@@ -935,10 +960,12 @@ void CG_AddAtmosphericEffects() {
   VectorSet(cg_atmFx.viewDir, cg.refdef_current->viewaxis[0][0],
             cg.refdef_current->viewaxis[0][1], 0.f);
 
+  CG_AtmosphericParticlesMove(max);
+
   for (curr = 0; curr < max; curr++) {
     particle = &cg_atmFx.particles[curr];
     //%	if( !CG_SnowParticleCheckVisible( particle ) )
-    if (!cg_atmFx.ParticleCheckVisible(particle)) {
+    if (!cg_atmFx.ParticleCheckVisible(curr, &groundHeight)) {
       // Effect has terminated / fallen from screen view
       /*
       if( !particle->nextDropTime )
@@ -955,7 +982,7 @@ void CG_AddAtmosphericEffects() {
       } */
       //%	if( !CG_SnowParticleGenerate( particle,
       // currvec, currweight ) )
-      if (!cg_atmFx.ParticleGenerate(particle, currvec, currweight)) {
+      if (!cg_atmFx.ParticleGenerate(curr, currvec, currweight)) {
         // Ensure it doesn't attempt to generate
         // every frame, to prevent 'clumping'
         // when there's only a small sky area
@@ -965,10 +992,14 @@ void CG_AddAtmosphericEffects() {
       } else {
         cg_atmFx.dropsCreated++;
       }
+
+      // new particles missed the view check in the move pass
+      cg_atmFx.inView[curr] = 1;
+      cg_atmFx.ParticleCheckVisible(curr, &groundHeight);
     }
 
     //%	CG_RainParticleRender( particle );
-    cg_atmFx.ParticleRender(particle);
+    cg_atmFx.ParticleRender(curr, groundHeight);
     cg_atmFx.dropsActive++;
   }
 
@@ -976,6 +1007,11 @@ void CG_AddAtmosphericEffects() {
 
   cg_atmFx.lastRainTime = cg.time;
 
+  CG_UpdateAtmosphericBudget(
+      std::chrono::duration<float, std::milli>(
+          std::chrono::steady_clock::now() - startTime)
+          .count());
+
   //	CG_Printf( "Active: %d Generated: %d Rendered: %d Skipped:
   //%d\n",
   // cg_atmFx.dropsActive, cg_atmFx.dropsCreated,
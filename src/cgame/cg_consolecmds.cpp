@@ -1309,6 +1309,7 @@ static const consoleCommand_t anyTimeCommands[] = {
     {"mod_information", CG_ModInformation_f},
     {"incrementVar", CG_IncrementVar_f},
     {"extraTrace", CG_ExtraTrace_f},
+    {"predictionStats", CG_PredictionStats_f},
     {"listspawnpt", ETJump::listSpawnPoints},
 };
 
@@ -1353,19 +1354,16 @@ qboolean CG_ConsoleCommand(void) {
     }
   }
 
-  std::vector<std::string> arguments;
-  std::string command = cmd;
-  auto argc = trap_Argc();
-  for (i = 1; i < argc; ++i) {
-    // Zero: cannot use CG_Argv here either. Check
-    // serverCommandsHandler on cg_servercommands.c for more
-    // info
-    char buf[MAX_TOKEN_CHARS]{};
-    trap_Argv(i, buf, sizeof(buf));
-    arguments.push_back(buf);
+  const char *tokens[MAX_STRING_TOKENS];
+  const int numTokens = CG_ArgvTokens(tokens, MAX_STRING_TOKENS);
+  if (numTokens < 0) {
+    CG_Printf("^3Warning: ^7command ^3%s ^7is too long, ignoring\n", cmd);
+    return qtrue;
   }
 
-  bool found = ETJump::consoleCommandsHandler->check(command, arguments);
+  const ETJump::CommandArguments arguments(tokens + 1, numTokens - 1);
+
+  bool found = ETJump::consoleCommandsHandler->check(cmd, arguments);
 
   if (CG_ConsoleCommandExt(cmd)) {
     return qtrue;
@@ -11,6 +11,8 @@
 #include "../game/etj_string_utilities.h"
 #include "etj_client_rtv_handler.h"
 #include "etj_demo_compatibility.h"
+#include "etj_profiler.h"
+#include "etj_glyph_run_cache.h"
 
 #define STATUSBARHEIGHT 452
 char *BindingFromName(const char *cvar);
@@ -181,6 +183,87 @@ void CG_Text_Paint_RightAligned_Ext(float x, float y, float scalex,
                     font);
 }
 
+static ETJump::GlyphRunCache &CG_GlyphRunCache() {
+  static ETJump::GlyphRunCache cache;
+  return cache;
+}
+
+static void CG_CountTextCalls(int drawCalls, int colorChanges,
+                              bool cacheMiss) {
+  auto *profiler = ETJump::profiler.get();
+
+  if (!profiler || !profiler->isActive()) {
+    return;
+  }
+
+  profiler->count(ETJump::textProfilerCounters.drawCalls, drawCalls);
+  profiler->count(ETJump::textProfilerCounters.colorChanges, colorChanges);
+  profiler->count(ETJump::textProfilerCounters.cacheMisses, cacheMiss);
+}
+
+static void CG_DrawGlyphQuads(const ETJump::GlyphRunCache::Quad *quads,
+                              int numQuads, float x, float y) {
+  for (int i = 0; i < numQuads; i++) {
+    const auto &q = quads[i];
+    float qx = x + q.x;
+    float qy = y + q.y;
+    float qw = q.w;
+    float qh = q.h;
+    CG_AdjustFrom640(&qx, &qy, &qw, &qh);
+
+    trap_R_DrawStretchPic(qx, qy, std::max(qw, 1.0f), std::max(qh, 1.0f),
+                          q.s, q.t, q.s2, q.t2, q.shader);
+  }
+}
+
+// draws text laid out by the glyph run cache, shadows are drawn
+// all at once under the text instead of interleaved with each glyph
+static void CG_Text_PaintCached(float x, float y, float scalex, float scaley,
+                                const vec4_t color, const char *text,
+                                float adjust, int limit, int style,
+                                const fontInfo_t *font) {
+  auto &cache = CG_GlyphRunCache();
+  const int misses = cache.missCount();
+  const auto &run = cache.get(text, scalex, scaley, adjust, limit, font);
+  const int numQuads = static_cast<int>(run.quads.size());
+  int colorChanges = 0;
+
+  if (style == ITEM_TEXTSTYLE_SHADOWED && numQuads) {
+    constexpr float ofs = 2.5f;
+    colorBlack[3] = color[3];
+    trap_R_SetColor(colorBlack);
+    colorBlack[3] = 1.0;
+    colorChanges++;
+
+    CG_DrawGlyphQuads(run.quads.data(), numQuads, x + ofs * scalex,
+                      y + ofs * scaley);
+  }
+
+  for (size_t i = 0; i < run.spans.size(); i++) {
+    const auto &span = run.spans[i];
+    const int end =
+        i + 1 < run.spans.size() ? run.spans[i + 1].firstQuad : numQuads;
+
+    if (span.colorIndex < 0) {
+      trap_R_SetColor(color);
+    } else {
+      vec4_t spanColor;
+      Vector4Copy(g_color_table[span.colorIndex], spanColor);
+      spanColor[3] = color[3];
+      trap_R_SetColor(spanColor);
+    }
+    colorChanges++;
+
+    CG_DrawGlyphQuads(&run.quads[span.firstQuad], end - span.firstQuad, x, y);
+  }
+
+  trap_R_SetColor(nullptr);
+
+  const int shadowQuads = style == ITEM_TEXTSTYLE_SHADOWED ? numQuads : 0;
+  CG_CountTextCalls(numQuads + shadowQuads, colorChanges + 1,
+                    cache.missCount() != misses);
+}
+
 void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley,
                        vec4_t color, const char *text, float adjust, int limit,
                        int style, fontInfo_t *font) {
@@ -191,8 +274,16 @@ void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley,
   scalex *= font->glyphScale;
   scaley *= font->glyphScale;
 
+  if (text && etj_textCache.integer) {
+    CG_Text_PaintCached(x, y, scalex, scaley, color, text, adjust, limit,
+                        style, font);
+    return;
+  }
+
   if (text) {
     const char *s = text;
+    int drawCalls = 0;
+    int colorChanges = 1;
     trap_R_SetColor(color);
     memcpy(&newColor[0], &color[0], sizeof(vec4_t));
     len = strlen(text);
@@ -211,6 +302,7 @@ void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley,
           newColor[3] = color[3];
         }
         trap_R_SetColor(newColor);
+        colorChanges++;
         s += 2;
         continue;
       } else {
@@ -225,6 +317,8 @@ void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley,
                                 glyph->t, glyph->s2, glyph->t2, glyph->glyph);
           colorBlack[3] = 1.0;
           trap_R_SetColor(newColor);
+          drawCalls++;
+          colorChanges += 2;
         }
         CG_Text_PaintChar_Ext(x + (glyph->pitch * scalex), y - yadj,
                               glyph->imageWidth, glyph->imageHeight, scalex,
@@ -233,9 +327,11 @@ void CG_Text_Paint_Ext(float x, float y, float scalex, float scaley,
         x += (glyph->xSkip * scalex) + adjust;
         s++;
         count++;
+        drawCalls++;
       }
     }
     trap_R_SetColor(NULL);
+    CG_CountTextCalls(drawCalls, colorChanges + 1, false);
   }
 }
 
@@ -4323,12 +4419,8 @@ static void CG_Draw2D() {
     CG_CheckForReticle();
 
     // crosshair is the only renderable that should be drawn here
-    for (const auto &r : ETJump::renderables) {
-      if (auto crosshair = std::dynamic_pointer_cast<ETJump::Crosshair>(r)) {
-        if (crosshair->beforeRender()) {
-          crosshair->render();
-        }
-      }
+    if (ETJump::crosshair && ETJump::crosshair->beforeRender()) {
+      ETJump::crosshair->render();
     }
     CG_DrawFlashFade();
     return;
@@ -4432,7 +4524,11 @@ static void CG_Draw2D() {
   }
 
   if (!cgs.demoCam.renderingFreeCam) {
-    for (const auto &r : ETJump::renderables) {
+    for (size_t i = 0; i < ETJump::renderables.size(); i++) {
+      ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                    ETJump::renderableProfilerSections[i]);
+      const auto &r = ETJump::renderables[i];
+
       if (r->beforeRender()) {
         r->render();
       }
@@ -4753,6 +4849,8 @@ void CG_DrawActive(stereoFrame_t stereoView) {
 
   if (!cg.showGameView) {
     // draw status bar and other floating elements
+    ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                  ETJump::Profiler::Draw2D);
     CG_Draw2D();
   } else {
     CG_LimboPanel_Draw();
@@ -1997,6 +1997,10 @@ typedef struct {
   int numInlineModels;
   qhandle_t inlineDrawModel[MAX_MODELS];
   vec3_t inlineModelMidpoints[MAX_MODELS];
+  // bounds of inline models, used to cull entity traces
+  vec3_t inlineModelMins[MAX_MODELS];
+  vec3_t inlineModelMaxs[MAX_MODELS];
+  float inlineModelRadius[MAX_MODELS];
 
   clientInfo_t clientinfo[MAX_CLIENTS];
 
@@ -2765,12 +2769,25 @@ extern vmCvar_t etj_playerBBoxBottomOnlyOther;
 extern vmCvar_t etj_playerBBoxBottomOnlyFireteam;
 extern vmCvar_t etj_playerBBoxShader;
 
+extern vmCvar_t etj_cvarPollInterval;
+
+extern vmCvar_t etj_profiler;
+
+// milliseconds per frame atmospheric effects may take before
+// the number of rain drops or snow flakes is scaled down
+extern vmCvar_t etj_weatherBudget;
+
+// draw HUD text from cached glyph runs, 0 lays text out on every call
+// like before so profiler counters can be compared between the two
+extern vmCvar_t etj_textCache;
+
 //
 // cg_main.c
 //
 const char *CG_ConfigString(int index);
 int CG_ConfigStringCopy(int index, char *buff, int buffsize);
 const char *CG_Argv(int arg);
+int CG_ArgvTokens(const char **tokens, int maxTokens);
 
 float CG_Cvar_Get(const char *cvar);
 
@@ -3051,9 +3068,16 @@ void CG_BuildSolidList(void);
 int CG_PointContents(const vec3_t point, int passEntityNum);
 void CG_Trace(trace_t *result, const vec3_t start, const vec3_t mins,
               const vec3_t maxs, const vec3_t end, int skipNumber, int mask);
+void CG_Trace_World(trace_t *result, const vec3_t start, const vec3_t mins,
+                    const vec3_t maxs, const vec3_t end, int skipNumber,
+                    int mask);
+void CG_ClipTraceToEntities(trace_t *result, const vec3_t start,
+                            const vec3_t mins, const vec3_t maxs,
+                            const vec3_t end, int skipNumber, int mask);
 void CG_FTTrace(trace_t *result, const vec3_t start, const vec3_t mins,
                 const vec3_t maxs, const vec3_t end, int skipNumber, int mask);
 void CG_PredictPlayerState(void);
+void CG_PredictionStats_f();
 // void CG_LoadDeferredPlayers( void );
 void CG_TraceCapsule(trace_t *result, const vec3_t start, const vec3_t mins,
                      const vec3_t maxs, const vec3_t end, int skipNumber,
@@ -3472,6 +3496,7 @@ void CG_FreecamGetPos_f(void);
 // cg_servercmds.c
 //
 void CG_ExecuteNewServerCommands(int latestSequence);
+void CG_InitServerCommands(void);
 void CG_ParseServerinfo(void);
 void CG_ParseSysteminfo(void);
 void CG_ParseSpawns(void);
@@ -4199,6 +4224,8 @@ class ClientRtvHandler;
 class DemoCompatibility;
 class AccelColor;
 class PlayerBBox;
+class Profiler;
+class Crosshair;
 
 extern std::shared_ptr<ClientCommandsHandler> serverCommandsHandler;
 extern std::shared_ptr<ClientCommandsHandler> consoleCommandsHandler;
@@ -4213,6 +4240,25 @@ extern std::shared_ptr<ClientRtvHandler> rtvHandler;
 extern std::shared_ptr<DemoCompatibility> demoCompatibility;
 extern std::array<bool, MAX_CLIENTS> tempTraceIgnoredClients;
 extern std::shared_ptr<PlayerBBox> playerBBox;
+extern std::shared_ptr<Profiler> profiler;
+// profiler section of each renderable, indexed like renderables
+extern std::vector<int> renderableProfilerSections;
+// profiler counters for CG_Text_Paint_Ext, -1 while not registered
+struct TextProfilerCounters {
+  int drawCalls = -1;
+  int colorChanges = -1;
+  int cacheMisses = -1;
+};
+extern TextProfilerCounters textProfilerCounters;
+// profiler counters for CG_PredictPlayerState, -1 while not registered
+struct PredictionProfilerCounters {
+  int predicted = -1;
+  int playedBack = -1;
+  int backupHits = -1;
+  int backupMisses = -1;
+};
+extern PredictionProfilerCounters predictionProfilerCounters;
+extern std::shared_ptr<Crosshair> crosshair;
 
 void addRealLoopingSound(const vec3_t origin, const vec3_t velocity,
                          sfxHandle_t sfx, int range, int volume, int soundTime);
@@ -7,6 +7,8 @@
 
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <bitset>
 
 #include "cg_local.h"
 #include "etj_init.h"
@@ -667,6 +669,14 @@ vmCvar_t etj_playerBBoxBottomOnlyOther;
 vmCvar_t etj_playerBBoxBottomOnlyFireteam;
 vmCvar_t etj_playerBBoxShader;
 
+vmCvar_t etj_cvarPollInterval;
+
+vmCvar_t etj_profiler;
+
+vmCvar_t etj_weatherBudget;
+
+vmCvar_t etj_textCache;
+
 typedef struct {
   vmCvar_t *vmCvar;
   const char *cvarName;
@@ -1252,12 +1262,78 @@ cvarTable_t cvarTable[] = {
      CVAR_ARCHIVE},
     {&etj_playerBBoxShader, "etj_playerBBoxShader", "bbox_nocull",
      CVAR_ARCHIVE | CVAR_LATCH},
+    {&etj_cvarPollInterval, "etj_cvarPollInterval", "100", CVAR_ARCHIVE},
+    {&etj_profiler, "etj_profiler", "0", 0},
+    {&etj_weatherBudget, "etj_weatherBudget", "2", CVAR_ARCHIVE},
+    {&etj_textCache, "etj_textCache", "1", 0},
 };
 
-int cvarTableSize = sizeof(cvarTable) / sizeof(cvarTable[0]);
+static constexpr int CVAR_TABLE_SIZE = sizeof(cvarTable) / sizeof(cvarTable[0]);
+int cvarTableSize = CVAR_TABLE_SIZE;
 qboolean cvarsLoaded = qfalse;
 void CG_setClientFlags(void);
 
+// cvars which are sent to the server as part of cg_uinfo
+static const vmCvar_t *const clientFlagCvars[] = {
+    &cg_autoAction,      &cg_autoReload,
+    &int_cl_timenudge,   &int_cl_maxpackets,
+    &cg_autoactivate,    &pmove_fixed,
+    &com_maxfps,         &etj_nofatigue,
+    &etj_drawCGaz,       &cl_yawspeed,
+    &cl_freelook,        &int_m_pitch,
+    &etj_loadviewangles, &etj_hideMe,
+    &etj_noclipScale,    &etj_enableTimeruns,
+    &etj_noActivateLean, &etj_touchPickupWeapons,
+    &etj_autoLoad,       &etj_quickFollow,
+    &etj_drawSnapHUD,    &etj_noPanzerAutoswitch,
+};
+
+// cvars that are commonly toggled with binds mid-run and must apply on
+// the next frame, these are polled every frame along with client flag cvars
+static const vmCvar_t *const hotCvars[] = {
+    &cg_thirdPerson,   &cg_thirdPersonRange, &cg_thirdPersonAngle,
+    &cg_fov,           &cg_drawGun,          &cg_draw2D,
+    &cg_drawCrosshair, &etj_drawKeys,        &etj_drawOB,
+    &etj_drawAccel,
+};
+
+// everything else is only polled every etj_cvarPollInterval milliseconds,
+// or right after the console or a menu is closed
+static std::bitset<CVAR_TABLE_SIZE> clientFlagCvarBits;
+static std::vector<int> hotCvarIndices;
+static std::vector<int> coldCvarIndices;
+static int lastColdCvarPoll;
+static int lastKeyCatcher;
+
+template <size_t N>
+static bool CG_CvarInList(const vmCvar_t *cvar,
+                          const vmCvar_t *const (&list)[N]) {
+  return std::find(std::begin(list), std::end(list), cvar) != std::end(list);
+}
+
+static void CG_BuildCvarPollLists() {
+  clientFlagCvarBits.reset();
+  hotCvarIndices.clear();
+  coldCvarIndices.clear();
+
+  for (int i = 0; i < cvarTableSize; i++) {
+    const vmCvar_t *cvar = cvarTable[i].vmCvar;
+
+    if (!cvar) {
+      continue;
+    }
+
+    if (CG_CvarInList(cvar, clientFlagCvars)) {
+      clientFlagCvarBits.set(i);
+      hotCvarIndices.push_back(i);
+    } else if (CG_CvarInList(cvar, hotCvars)) {
+      hotCvarIndices.push_back(i);
+    } else {
+      coldCvarIndices.push_back(i);
+    }
+  }
+}
+
 /*
 =================
 CG_RegisterCvars
@@ -1285,6 +1361,10 @@ void CG_RegisterCvars(void) {
     }
   }
 
+  CG_BuildCvarPollLists();
+  lastColdCvarPoll = trap_Milliseconds();
+  lastKeyCatcher = trap_Key_GetCatcher();
+
   // see if we are also running the server on this machine
   trap_Cvar_VariableStringBuffer("sv_running", var, sizeof(var));
   cgs.localServer = Q_atoi(var) ? qtrue : qfalse;
@@ -1294,74 +1374,81 @@ void CG_RegisterCvars(void) {
   cvarsLoaded = qtrue;
 }
 
+// returns true if the cvar changed and client flags need to be resent
+static bool CG_UpdateCvar(int index) {
+  cvarTable_t *cv = &cvarTable[index];
+
+  trap_Cvar_Update(cv->vmCvar);
+  if (cv->modificationCount == cv->vmCvar->modificationCount) {
+    return false;
+  }
+  cv->modificationCount = cv->vmCvar->modificationCount;
+
+  if (cv->vmCvar == &cg_rconPassword && *cg_rconPassword.string) {
+    trap_SendConsoleCommand(va("rconAuth %s\n", cg_rconPassword.string));
+  } else if (cv->vmCvar == &cg_refereePassword && *cg_refereePassword.string) {
+    trap_SendConsoleCommand(va("ref %s\n", cg_refereePassword.string));
+  } else if (cv->vmCvar == &demo_infoWindow) {
+    if (demo_infoWindow.integer == 0 && cg.demohelpWindow == SHOW_ON) {
+      CG_ShowHelp_On(&cg.demohelpWindow);
+    } else if (demo_infoWindow.integer > 0 && cg.demohelpWindow != SHOW_ON) {
+      CG_ShowHelp_On(&cg.demohelpWindow);
+    }
+  } else if (cv->vmCvar == &cg_errorDecay) {
+    // rain - cap errordecay
+    // because prediction is
+    // EXTREMELY broken right now.
+    if (cg_errorDecay.value < 0.0) {
+      trap_Cvar_Set("cg_errorDecay", "0");
+    } else if (cg_errorDecay.value > 500.0) {
+      trap_Cvar_Set("cg_errorDecay", "500");
+    }
+  }
+
+  ETJump::cvarUpdateHandler->check(cv->vmCvar);
+
+  // Check if we need to update any client
+  // flags to be sent to the server
+  return clientFlagCvarBits.test(index);
+}
+
 /*
 =================
 CG_UpdateCvars
 =================
 */
 void CG_UpdateCvars(void) {
-  int i;
-  qboolean fSetFlags = qfalse;
-  cvarTable_t *cv;
+  bool setFlags = false;
 
   if (!cvarsLoaded) {
     return;
   }
 
-  for (i = 0, cv = cvarTable; i < cvarTableSize; i++, cv++) {
-    if (cv->vmCvar) {
-      trap_Cvar_Update(cv->vmCvar);
-      if (cv->modificationCount != cv->vmCvar->modificationCount) {
-        cv->modificationCount = cv->vmCvar->modificationCount;
+  const int now = trap_Milliseconds();
+  const int keyCatcher = trap_Key_GetCatcher();
+  const int closedCatchers = lastKeyCatcher & ~keyCatcher;
+  lastKeyCatcher = keyCatcher;
 
-        // Check if we need to update any client
-        // flags to be sent to the server
-        if (cv->vmCvar == &cg_autoAction || cv->vmCvar == &cg_autoReload ||
-            cv->vmCvar == &int_cl_timenudge ||
-            cv->vmCvar == &int_cl_maxpackets ||
-            cv->vmCvar == &cg_autoactivate || cv->vmCvar == &pmove_fixed ||
-            cv->vmCvar == &com_maxfps || cv->vmCvar == &etj_nofatigue ||
-            cv->vmCvar == &etj_drawCGaz || cv->vmCvar == &cl_yawspeed ||
-            cv->vmCvar == &cl_freelook || cv->vmCvar == &int_m_pitch ||
-            cv->vmCvar == &etj_loadviewangles || cv->vmCvar == &etj_hideMe ||
-            cv->vmCvar == &etj_noclipScale ||
-            cv->vmCvar == &etj_enableTimeruns ||
-            cv->vmCvar == &etj_noActivateLean ||
-            cv->vmCvar == &etj_touchPickupWeapons ||
-            cv->vmCvar == &etj_autoLoad || cv->vmCvar == &etj_quickFollow ||
-            cv->vmCvar == &etj_drawSnapHUD ||
-            cv->vmCvar == &etj_noPanzerAutoswitch) {
-          fSetFlags = qtrue;
-        } else if (cv->vmCvar == &cg_rconPassword && *cg_rconPassword.string) {
-          trap_SendConsoleCommand(va("rconAuth %s\n", cg_rconPassword.string));
-        } else if (cv->vmCvar == &cg_refereePassword &&
-                   *cg_refereePassword.string) {
-          trap_SendConsoleCommand(va("ref %s\n", cg_refereePassword.string));
-        } else if (cv->vmCvar == &demo_infoWindow) {
-          if (demo_infoWindow.integer == 0 && cg.demohelpWindow == SHOW_ON) {
-            CG_ShowHelp_On(&cg.demohelpWindow);
-          } else if (demo_infoWindow.integer > 0 &&
-                     cg.demohelpWindow != SHOW_ON) {
-            CG_ShowHelp_On(&cg.demohelpWindow);
-          }
-        } else if (cv->vmCvar == &cg_errorDecay) {
-          // rain - cap errordecay
-          // because prediction is
-          // EXTREMELY broken right now.
-          if (cg_errorDecay.value < 0.0) {
-            trap_Cvar_Set("cg_errorDecay", "0");
-          } else if (cg_errorDecay.value > 500.0) {
-            trap_Cvar_Set("cg_errorDecay", "500");
-          }
-        }
+  // closing the console or a menu is when cvars are most likely
+  // to have changed, so don't make the user wait for the next sweep
+  const bool pollCold = etj_cvarPollInterval.integer <= 0 ||
+                        (closedCatchers & (KEYCATCH_CONSOLE | KEYCATCH_UI)) ||
+                        now - lastColdCvarPoll >= etj_cvarPollInterval.integer;
 
-        ETJump::cvarUpdateHandler->check(cv->vmCvar);
-      }
+  for (const int index : hotCvarIndices) {
+    setFlags |= CG_UpdateCvar(index);
+  }
+
+  if (pollCold) {
+    lastColdCvarPoll = now;
+
+    for (const int index : coldCvarIndices) {
+      setFlags |= CG_UpdateCvar(index);
     }
   }
 
   // Send any relevent updates
-  if (fSetFlags) {
+  if (setFlags) {
     CG_setClientFlags();
   }
 }
@@ -1495,6 +1582,49 @@ const char *CG_Argv(int arg) {
   return buffer;
 }
 
+/*
+================
+CG_ArgvTokens
+
+Copies every token of the current command into one shared buffer,
+so unlike CG_Argv all of them can be used at once. The tokens stay
+valid until the next call. Returns the number of tokens copied,
+or -1 if the command doesn't fit in the buffer or in maxTokens.
+================
+*/
+int CG_ArgvTokens(const char **tokens, int maxTokens) {
+  static char buffer[BIG_INFO_STRING];
+  int used = 0;
+  int count = 0;
+  const int argc = trap_Argc();
+
+  if (argc > maxTokens) {
+    return -1;
+  }
+
+  for (int i = 0; i < argc; i++) {
+    const int space = static_cast<int>(sizeof(buffer)) - used;
+    const int size = std::min(space, static_cast<int>(MAX_TOKEN_CHARS));
+    if (size <= 1) {
+      return -1;
+    }
+
+    trap_Argv(i, buffer + used, size);
+    const int length = static_cast<int>(strlen(buffer + used));
+
+    // a token filling up the rest of the buffer was cut short,
+    // tokens longer than MAX_TOKEN_CHARS are cut the same as in CG_Argv
+    if (size < MAX_TOKEN_CHARS && length == size - 1) {
+      return -1;
+    }
+
+    tokens[count++] = buffer + used;
+    used += length + 1;
+  }
+
+  return count;
+}
+
 // Cleans a string for filesystem compatibility
 void CG_nameCleanFilename(const char *pszIn, char *pszOut,
                           unsigned int dwOutSize) {
@@ -2888,6 +3018,9 @@ static void CG_RegisterGraphics(void) {
     for (j = 0; j < 3; j++) {
       cgs.inlineModelMidpoints[i][j] = mins[j] + 0.5 * (maxs[j] - mins[j]);
     }
+    VectorCopy(mins, cgs.inlineModelMins[i]);
+    VectorCopy(maxs, cgs.inlineModelMaxs[i]);
+    cgs.inlineModelRadius[i] = RadiusFromBounds(mins, maxs);
   }
 
   CG_LoadingString(" - server models");
@@ -3411,9 +3544,9 @@ void CG_ParseMenu(const char *menuFile) {
   pc_token_t token;
   int handle;
 
-  handle = trap_PC_LoadSource(menuFile);
+  handle = Menu_LoadSource(menuFile);
   if (!handle) {
-    handle = trap_PC_LoadSource("ui/testhud.menu");
+    handle = Menu_LoadSource("ui/testhud.menu");
   }
   if (!handle) {
     return;
@@ -3484,6 +3617,8 @@ void CG_LoadMenus(char *menuFile) {
   int len, start;
   fileHandle_t f;
   static char buf[MAX_MENUDEFFILE];
+  qboolean cached;
+  char defines[MAX_CVAR_VALUE_STRING];
 
   start = trap_Milliseconds();
 
@@ -3514,6 +3649,11 @@ void CG_LoadMenus(char *menuFile) {
 
   Menu_Reset();
 
+  // global defines added by the UI are still active for the HUD menus
+  trap_Cvar_VariableStringBuffer("ui_pcGlobalDefines", defines,
+                                 sizeof(defines));
+  Menu_BeginTokenCache(va("%s%s", menuFile, defines));
+
   p = buf;
 
   while (1) {
@@ -3545,7 +3685,10 @@ void CG_LoadMenus(char *menuFile) {
     }
   }
 
-  Com_Printf("UI menu load time = %d milli seconds\n",
+  cached = Menu_EndTokenCache();
+
+  Com_Printf("HUD menus %s in %d msec\n",
+             cached ? "loaded from cache" : "parsed",
              trap_Milliseconds() - start);
 }
 
@@ -2,6 +2,8 @@
 // cg_particles.c
 
 #include "cg_local.h"
+#include "etj_particle_pool.h"
+#include "etj_poly_batcher.h"
 
 #define MUSTARD 1
 #define BLOODRED 2
@@ -10,8 +12,6 @@
 #define ZOMBIE 5
 
 typedef struct particle_s {
-  struct particle_s *next;
-
   float time;
   float endtime;
 
@@ -91,9 +91,14 @@ static int numShaderAnims;
 #define PARTICLE_GRAVITY 40
 #define MAX_PARTICLES 1024 * 8
 
-cparticle_t *active_particles, *free_particles;
+// live particles occupy [0, particlePool.size()) in both 'particles'
+// and 'particlePool', which holds the motion state as flat arrays
 cparticle_t particles[MAX_PARTICLES];
-int cl_numparticles = MAX_PARTICLES;
+static ETJump::ParticlePool particlePool(MAX_PARTICLES);
+// particles spawned since the last CG_AddParticles start at this index,
+// their motion state is copied into particlePool on the next frame
+static int numSyncedParticles;
+static ETJump::PolyBatcher particlePolys;
 
 qboolean initparticles = qfalse;
 vec3_t vforward, vright, vup;
@@ -110,15 +115,8 @@ void CG_ClearParticles(void) {
   int i;
 
   memset(particles, 0, sizeof(particles));
-
-  free_particles = &particles[0];
-  active_particles = NULL;
-
-  for (i = 0; i < cl_numparticles; i++) {
-    particles[i].next = &particles[i + 1];
-    particles[i].type = 0;
-  }
-  particles[cl_numparticles - 1].next = NULL;
+  particlePool.clear();
+  numSyncedParticles = 0;
 
   oldtime = cg.time;
 
@@ -137,6 +135,65 @@ void CG_ClearParticles(void) {
   initparticles = qtrue;
 }
 
+/*
+===============
+CG_AllocParticle
+
+Returns a zeroed particle, or NULL if all particles are in use
+===============
+*/
+static cparticle_t *CG_AllocParticle() {
+  const int index = particlePool.alloc();
+
+  if (index < 0) {
+    return nullptr;
+  }
+
+  memset(&particles[index], 0, sizeof(particles[index]));
+  return &particles[index];
+}
+
+/*
+===============
+CG_SyncParticle
+
+Copies the motion state of a particle into particlePool, must be
+called whenever it changes after the particle has been spawned
+===============
+*/
+static void CG_SyncParticle(int index) {
+  const cparticle_t *p = &particles[index];
+
+  particlePool.spawnTime[index] = p->time;
+  particlePool.endTime[index] = p->endtime;
+  particlePool.orgX[index] = p->org[0];
+  particlePool.orgY[index] = p->org[1];
+  particlePool.orgZ[index] = p->org[2];
+  particlePool.velX[index] = p->vel[0];
+  particlePool.velY[index] = p->vel[1];
+  particlePool.velZ[index] = p->vel[2];
+  particlePool.accelX[index] = p->accel[0];
+  particlePool.accelY[index] = p->accel[1];
+  particlePool.accelZ[index] = p->accel[2];
+  particlePool.alpha[index] = p->alpha;
+  particlePool.alphaVel[index] = p->alphavel;
+
+  switch (p->type) {
+    case P_SMOKE:
+    case P_ANIM:
+    case P_DLIGHT_ANIM:
+    case P_BLEED:
+    case P_SMOKE_IMPACT:
+    case P_WEATHER_FLURRY:
+    case P_FLAT_SCALEUP_FADE:
+      particlePool.expires[index] = 1;
+      break;
+    default:
+      particlePool.expires[index] = 0;
+      break;
+  }
+}
+
 /*
 =====================
 CG_AddParticleToScene
@@ -796,9 +853,9 @@ void CG_AddParticleToScene(cparticle_t *p, vec3_t org, float alpha) {
 
   if (p->type == P_WEATHER || p->type == P_WEATHER_TURBULENT ||
       p->type == P_WEATHER_FLURRY) {
-    trap_R_AddPolyToScene(p->pshader, 3, TRIverts);
+    particlePolys.add(p->pshader, 3, TRIverts);
   } else {
-    trap_R_AddPolyToScene(p->pshader, 4, verts);
+    particlePolys.add(p->pshader, 4, verts);
   }
 }
 
@@ -811,11 +868,7 @@ CG_AddParticles
 ===============
 */
 void CG_AddParticles(void) {
-  cparticle_t *p, *next;
-  float alpha;
-  float time, time2;
   vec3_t org;
-  cparticle_t *active, *tail;
   vec3_t rotate_ang;
 
   if (!initparticles) {
@@ -833,94 +886,49 @@ void CG_AddParticles(void) {
 
   oldtime = cg.time;
 
-  active = NULL;
-  tail = NULL;
-
-  for (p = active_particles; p; p = next) {
-
-    next = p->next;
+  for (int i = numSyncedParticles; i < particlePool.size(); i++) {
+    CG_SyncParticle(i);
+  }
 
-    time = (cg.time - p->time) * 0.001;
+  particlePool.integrate(static_cast<float>(cg.time));
 
-    alpha = p->alpha + time * p->alphavel;
-    if (alpha <= 0) { // faded out
-      p->next = free_particles;
-      free_particles = p;
-      p->type = 0;
-      p->color = 0;
-      p->alpha = 0;
-      continue;
-    }
+  // walk backwards so the particle moved into a removed slot
+  // has already been processed
+  for (int i = particlePool.size() - 1; i >= 0; i--) {
+    cparticle_t *p = &particles[i];
+    bool remove = particlePool.dead[i] != 0;
 
-    if (p->type == P_SMOKE || p->type == P_ANIM || p->type == P_DLIGHT_ANIM ||
-        p->type == P_BLEED || p->type == P_SMOKE_IMPACT) {
-      if (cg.time > p->endtime) {
-        p->next = free_particles;
-        free_particles = p;
-        p->type = 0;
-        p->color = 0;
-        p->alpha = 0;
-
-        continue;
-      }
-    }
+    if (!remove) {
+      org[0] = particlePool.posX[i];
+      org[1] = particlePool.posY[i];
+      org[2] = particlePool.posZ[i];
 
-    if (p->type == P_WEATHER_FLURRY) {
-      if (cg.time > p->endtime) {
-        p->next = free_particles;
-        free_particles = p;
-        p->type = 0;
-        p->color = 0;
-        p->alpha = 0;
+      CG_AddParticleToScene(p, org, particlePool.currentAlpha[i]);
 
-        continue;
+      // temporary sprite
+      if (p->type == P_SPRITE && p->endtime < 0) {
+        remove = true;
+      } else if (p->type == P_WEATHER || p->type == P_WEATHER_TURBULENT ||
+                 p->type == P_BUBBLE || p->type == P_BUBBLE_TURBULENT) {
+        // these respawn at the top (or bottom) of their volume
+        CG_SyncParticle(i);
       }
     }
 
-    if (p->type == P_FLAT_SCALEUP_FADE) {
-      if (cg.time > p->endtime) {
-        p->next = free_particles;
-        free_particles = p;
-        p->type = 0;
-        p->color = 0;
-        p->alpha = 0;
-        continue;
+    if (remove) {
+      const int moved = particlePool.remove(i);
+      if (moved != i) {
+        particles[i] = particles[moved];
       }
     }
-
-    if (p->type == P_SPRITE && p->endtime < 0) {
-      // temporary sprite
-      CG_AddParticleToScene(p, p->org, alpha);
-      p->next = free_particles;
-      free_particles = p;
-      p->type = 0;
-      p->color = 0;
-      p->alpha = 0;
-      continue;
-    }
-
-    p->next = NULL;
-    if (!tail) {
-      active = tail = p;
-    } else {
-      tail->next = p;
-      tail = p;
-    }
-
-    if (alpha > 1.0) {
-      alpha = 1;
-    }
-
-    time2 = time * time;
-
-    org[0] = p->org[0] + p->vel[0] * time + p->accel[0] * time2;
-    org[1] = p->org[1] + p->vel[1] * time + p->accel[1] * time2;
-    org[2] = p->org[2] + p->vel[2] * time + p->accel[2] * time2;
-
-    CG_AddParticleToScene(p, org, alpha);
   }
 
-  active_particles = active;
+  numSyncedParticles = particlePool.size();
+
+  particlePolys.flush([](qhandle_t shader, int numVerts,
+                         const polyVert_t *verts, int numPolys) {
+    trap_R_AddPolysToScene(shader, numVerts, verts, numPolys);
+  });
 }
 
 /*
@@ -936,13 +944,10 @@ void CG_ParticleSnowFlurry(qhandle_t pshader, centity_t *cent) {
     CG_Printf("CG_ParticleSnowFlurry pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->color = 0;
   p->alpha = 0.90;
@@ -997,13 +1002,10 @@ void CG_ParticleSnow(qhandle_t pshader, vec3_t origin, vec3_t origin2, int turb,
     CG_Printf("CG_ParticleSnow pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->color = 0;
   p->alpha = 0.40;
@@ -1052,13 +1054,10 @@ void CG_ParticleBubble(qhandle_t pshader, vec3_t origin, vec3_t origin2,
     CG_Printf("CG_ParticleSnow pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->color = 0;
   p->alpha = 0.40;
@@ -1112,13 +1111,10 @@ void CG_ParticleSmoke(qhandle_t pshader, centity_t *cent) {
     CG_Printf("CG_ParticleSmoke == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
 
   p->endtime = cg.time + cent->currentState.time;
@@ -1239,13 +1235,10 @@ void CG_ParticleBulletDebris(vec3_t org, vec3_t vel, int duration) {
 
   cparticle_t *p;
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
 
   p->endtime = cg.time + duration;
@@ -1281,13 +1274,10 @@ void CG_ParticleDirtBulletDebris(vec3_t org, vec3_t vel, int duration) {
   int r = rand() % 3;
   cparticle_t *p;
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
 
   p->endtime = cg.time + duration;
@@ -1329,13 +1319,10 @@ void CG_ParticleDirtBulletDebris_Core(vec3_t org, vec3_t vel, int duration,
                                       qhandle_t shader) {
   cparticle_t *p;
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
 
   p->time = cg.time;
   p->endtime = cg.time + duration;
@@ -1400,13 +1387,10 @@ void CG_ParticleExplosion(const char *animStr, vec3_t origin, vec3_t vel,
     return;
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->alpha = 1.0;
   p->alphavel = 0;
@@ -1516,13 +1500,12 @@ int CG_NewParticleArea(int num) {
 }
 
 void CG_SnowLink(centity_t *cent, qboolean particleOn) {
-  cparticle_t *p, *next;
   int id;
 
   id = cent->currentState.frame;
 
-  for (p = active_particles; p; p = next) {
-    next = p->next;
+  for (int i = 0; i < particlePool.size(); i++) {
+    cparticle_t *p = &particles[i];
 
     if (p->type == P_WEATHER || p->type == P_WEATHER_TURBULENT) {
       if (p->snum == id) {
@@ -1545,13 +1528,10 @@ void CG_ParticleImpactSmokePuffExtended(qhandle_t pshader, vec3_t origin,
     CG_Printf("CG_ParticleImpactSmokePuff pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->alpha = alpha;
   p->alphavel = 0;
@@ -1596,13 +1576,10 @@ void CG_Particle_Bleed(qhandle_t pshader, vec3_t start, vec3_t dir,
     CG_Printf("CG_Particle_Bleed pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->alpha = 1.0;
   p->alphavel = 0;
@@ -1666,13 +1643,10 @@ void CG_Particle_OilParticle(qhandle_t pshader, vec3_t origin, vec3_t dir,
     CG_Printf("CG_Particle_OilParticle == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->alphavel = 0;
   p->roll = 0;
@@ -1720,13 +1694,10 @@ void CG_Particle_OilSlick(qhandle_t pshader, centity_t *cent) {
     CG_Printf("CG_Particle_OilSlick == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
 
   if (cent->currentState.angles2[2]) {
@@ -1778,7 +1749,6 @@ void CG_Particle_OilSlick(qhandle_t pshader, centity_t *cent) {
 }
 
 void CG_OilSlickRemove(centity_t *cent) {
-  cparticle_t *p, *next;
   int id;
 
   id = cent->currentState.density;
@@ -1787,14 +1757,15 @@ void CG_OilSlickRemove(centity_t *cent) {
     CG_Printf("CG_OilSlickRevove NULL id\n");
   }
 
-  for (p = active_particles; p; p = next) {
-    next = p->next;
+  for (int i = 0; i < particlePool.size(); i++) {
+    cparticle_t *p = &particles[i];
 
     if (p->type == P_FLAT_SCALEUP) {
       if (p->snum == id) {
         p->endtime = cg.time + 100;
         p->startfade = p->endtime;
         p->type = P_FLAT_SCALEUP_FADE;
+        CG_SyncParticle(i);
       }
     }
   }
@@ -1882,15 +1853,11 @@ void CG_ParticleBloodCloud(centity_t *cent, vec3_t origin, vec3_t dir) {
   for (i = 0; i < dist; i++) {
     VectorMA(point, crittersize, forward, point);
 
-    if (!free_particles) {
+    p = CG_AllocParticle();
+    if (!p) {
       return;
     }
 
-    p = free_particles;
-    free_particles = p->next;
-    p->next = active_particles;
-    active_particles = p;
-
     p->time = cg.time;
     p->alpha = 1.0;
     p->alphavel = 0;
@@ -1973,15 +1940,11 @@ void CG_ParticleBloodCloudZombie(centity_t *cent, vec3_t origin, vec3_t dir) {
   for (i = 0; i < dist; i++) {
     VectorMA(point, crittersize, forward, point);
 
-    if (!free_particles) {
+    p = CG_AllocParticle();
+    if (!p) {
       return;
     }
 
-    p = free_particles;
-    free_particles = p->next;
-    p->next = active_particles;
-    active_particles = p;
-
     p->time = cg.time;
     p->alpha = 0.2;
     p->alphavel = 0;
@@ -2052,13 +2015,10 @@ void CG_ParticleSparks(vec3_t org, vec3_t vel, int duration, float x, float y,
                        float speed) {
   cparticle_t *p;
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
 
   p->endtime = cg.time + duration;
@@ -2132,15 +2092,11 @@ void CG_ParticleDust(centity_t *cent, vec3_t origin, vec3_t dir) {
   for (i = 0; i < dist; i++) {
     VectorMA(point, crittersize, forward, point);
 
-    if (!free_particles) {
+    p = CG_AllocParticle();
+    if (!p) {
       return;
     }
 
-    p = free_particles;
-    free_particles = p->next;
-    p->next = active_particles;
-    active_particles = p;
-
     p->time = cg.time;
     p->alpha = 5.0;
     p->alphavel = 0;
@@ -2221,14 +2177,10 @@ void CG_ParticleMisc(qhandle_t pshader, vec3_t origin, int size, int duration,
     CG_Printf("CG_ParticleImpactSmokePuff pshader == ZERO!\n");
   }
 
-  if (!free_particles) {
+  p = CG_AllocParticle();
+  if (!p) {
     return;
   }
-
-  p = free_particles;
-  free_particles = p->next;
-  p->next = active_particles;
-  active_particles = p;
   p->time = cg.time;
   p->alpha = 1.0;
   p->alphavel = 0;
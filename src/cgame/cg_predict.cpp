@@ -5,10 +5,13 @@
 // ahead the client's movement.
 // It also handles local physics interaction, like fragments bouncing off walls
 
+#include <algorithm>
 #include <array>
 #include "cg_local.h"
 #include "etj_utilities.h"
 #include "../game/etj_entity_utilities_shared.h"
+#include "etj_trace_broadphase.h"
+#include "etj_profiler.h"
 
 /*static*/ pmove_t cg_pmove;
 
@@ -19,6 +22,19 @@ static centity_t *cg_solidFTEntities[MAX_ENTITIES_IN_SNAPSHOT];
 static int cg_numTriggerEntities;
 static centity_t *cg_triggerEntities[MAX_ENTITIES_IN_SNAPSHOT];
 
+// broadphase over cg_solidEntities, indexed like the solid list
+static ETJump::TraceBroadphase cg_solidBroadphase;
+static std::vector<int> cg_traceCandidates;
+static bool cg_solidBroadphaseValid;
+// state the broadphase bounds were last computed for
+static const snapshot_t *cg_solidBroadphaseSnap;
+static int cg_solidBroadphaseSnapTime;
+static int cg_solidBroadphasePhysicsTime;
+
+// inline model render bounds are 1 unit smaller than the collision
+// bounds, and traces allow for small epsilons, so pad generously
+static const float BROADPHASE_MARGIN = 4.0f;
+
 /*
 ====================
 CG_BuildSolidList
@@ -114,6 +130,151 @@ void CG_BuildSolidList(void) {
       }
     }
   }
+
+  // bounds are evaluated lazily on the next trace
+  cg_solidBroadphaseValid = false;
+}
+
+/*
+====================
+CG_SolidEntityBounds
+
+World space bounds of a solid brush model at cg.physicsTime,
+which is when CG_ClipMoveToEntities evaluates its position.
+Returns false for entities which must be checked on every trace,
+such as players whose lerpOrigin changes between traces.
+====================
+*/
+static bool CG_SolidEntityBounds(const centity_t *cent, vec3_t mins,
+                                 vec3_t maxs) {
+  const entityState_t *ent = &cent->currentState;
+  vec3_t origin, angles;
+
+  if (ent->solid != SOLID_BMODEL || ent->modelindex <= 0 ||
+      ent->modelindex >= MAX_MODELS) {
+    return false;
+  }
+
+  const float radius = cgs.inlineModelRadius[ent->modelindex];
+
+  // no bounds available for the model
+  if (radius <= 0) {
+    return false;
+  }
+
+  BG_EvaluateTrajectory(&ent->apos, cg.physicsTime, angles, qtrue,
+                        ent->effect2Time);
+  BG_EvaluateTrajectory(&ent->pos, cg.physicsTime, origin, qfalse,
+                        ent->effect2Time);
+
+  if (angles[0] || angles[1] || angles[2]) {
+    // rotated models are traced in model space,
+    // so use bounds covering every rotation
+    for (int i = 0; i < 3; i++) {
+      mins[i] = origin[i] - radius - BROADPHASE_MARGIN;
+      maxs[i] = origin[i] + radius + BROADPHASE_MARGIN;
+    }
+  } else {
+    const float *modelMins = cgs.inlineModelMins[ent->modelindex];
+    const float *modelMaxs = cgs.inlineModelMaxs[ent->modelindex];
+
+    for (int i = 0; i < 3; i++) {
+      mins[i] = origin[i] + modelMins[i] - BROADPHASE_MARGIN;
+      maxs[i] = origin[i] + modelMaxs[i] + BROADPHASE_MARGIN;
+    }
+  }
+
+  return true;
+}
+
+/*
+====================
+CG_UpdateSolidBroadphase
+
+Recomputes solid entity bounds when the snapshot or physics time
+has changed since the last trace. The grid is only touched for
+entities which moved to different cells, so in practice only
+movers do any work here.
+====================
+*/
+static void CG_UpdateSolidBroadphase() {
+  const int snapTime = cg.snap ? cg.snap->serverTime : 0;
+
+  if (cg_solidBroadphaseValid && cg_solidBroadphaseSnap == cg.snap &&
+      cg_solidBroadphaseSnapTime == snapTime &&
+      cg_solidBroadphasePhysicsTime == cg.physicsTime) {
+    return;
+  }
+
+  if (!cg_solidBroadphaseValid) {
+    cg_solidBroadphase.clear();
+  }
+
+  for (int i = 0; i < cg_numSolidEntities; i++) {
+    vec3_t mins, maxs;
+    const bool bounded = CG_SolidEntityBounds(cg_solidEntities[i], mins, maxs);
+
+    if (!cg_solidBroadphaseValid) {
+      if (bounded) {
+        cg_solidBroadphase.add(mins, maxs);
+      } else {
+        cg_solidBroadphase.addUnbounded();
+      }
+    } else if (bounded) {
+      cg_solidBroadphase.update(i, mins, maxs);
+    } else {
+      cg_solidBroadphase.setUnbounded(i);
+    }
+  }
+
+  cg_solidBroadphaseValid = true;
+  cg_solidBroadphaseSnap = cg.snap;
+  cg_solidBroadphaseSnapTime = snapTime;
+  cg_solidBroadphasePhysicsTime = cg.physicsTime;
+}
+
+/*
+====================
+CG_TraceBounds
+
+Bounds of everything a trace can touch. Traces against rotated
+models use a sphere enclosing the trace box, so the box is padded
+by a radius that covers both.
+====================
+*/
+static void CG_TraceBounds(const vec3_t start, const vec3_t mins,
+                           const vec3_t maxs, const vec3_t end,
+                           vec3_t boundsMins, vec3_t boundsMaxs) {
+  vec3_t center, halfSize;
+
+  for (int i = 0; i < 3; i++) {
+    const float boxMin = mins ? mins[i] : 0;
+    const float boxMax = maxs ? maxs[i] : 0;
+    center[i] = (boxMin + boxMax) * 0.5f;
+    halfSize[i] = (boxMax - boxMin) * 0.5f;
+  }
+
+  const float radius =
+      VectorLength(center) + VectorLength(halfSize) + BROADPHASE_MARGIN;
+
+  for (int i = 0; i < 3; i++) {
+    boundsMins[i] = std::min(start[i], end[i]) - radius;
+    boundsMaxs[i] = std::max(start[i], end[i]) + radius;
+  }
+}
+
+static bool CG_EntityBoxTouchesTrace(const vec3_t origin, const vec3_t bmins,
+                                     const vec3_t bmaxs,
+                                     const vec3_t boundsMins,
+                                     const vec3_t boundsMaxs) {
+  for (int i = 0; i < 3; i++) {
+    if (origin[i] + bmins[i] - BROADPHASE_MARGIN > boundsMaxs[i] ||
+        origin[i] + bmaxs[i] + BROADPHASE_MARGIN < boundsMins[i]) {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 /*
@@ -126,16 +287,22 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins,
                                   const vec3_t maxs, const vec3_t end,
                                   int skipNumber, int mask, int capsule,
                                   qboolean tracePlayers, trace_t *tr) {
-  int i, x, zd, zu;
+  int x, zd, zu;
   trace_t trace;
   entityState_t *ent;
   clipHandle_t cmodel;
   vec3_t bmins, bmaxs;
   vec3_t origin, angles;
+  vec3_t boundsMins, boundsMaxs;
   centity_t *cent;
 
-  for (i = 0; i < cg_numSolidEntities; i++) {
-    cent = cg_solidEntities[i];
+  CG_UpdateSolidBroadphase();
+  CG_TraceBounds(start, mins, maxs, end, boundsMins, boundsMaxs);
+  // candidates are in solid list order, so results match a full scan
+  cg_solidBroadphase.query(boundsMins, boundsMaxs, cg_traceCandidates);
+
+  for (const int index : cg_traceCandidates) {
+    cent = cg_solidEntities[index];
     ent = &cent->currentState;
 
     if (ent->number == skipNumber ||
@@ -175,6 +342,13 @@ static void CG_ClipMoveToEntities(const vec3_t start, const vec3_t mins,
         bmaxs[2] = zu;
       }
 
+      // not in the broadphase grid since lerpOrigin moves between
+      // traces, so reject here before creating a temp model
+      if (!CG_EntityBoxTouchesTrace(cent->lerpOrigin, bmins, bmaxs,
+                                    boundsMins, boundsMaxs)) {
+        continue;
+      }
+
       // cmodel = trap_CM_TempCapsuleModel( bmins, bmaxs
       // );
       cmodel = trap_CM_TempBoxModel(bmins, bmaxs);
@@ -299,6 +473,14 @@ void CG_Trace_World(trace_t *result, const vec3_t start, const vec3_t mins,
   *result = t;
 }
 
+// the entity half of CG_Trace, for a world trace done separately
+void CG_ClipTraceToEntities(trace_t *result, const vec3_t start,
+                            const vec3_t mins, const vec3_t maxs,
+                            const vec3_t end, int skipNumber, int mask) {
+  CG_ClipMoveToEntities(start, mins, maxs, end, skipNumber, mask, qfalse, qtrue,
+                        result);
+}
+
 void CG_FTTrace(trace_t *result, const vec3_t start, const vec3_t mins,
                 const vec3_t maxs, const vec3_t end, int skipNumber, int mask) {
   trace_t t;
@@ -383,6 +565,18 @@ int CG_PointContents(const vec3_t point, int passEntityNum) {
       continue;
     }
 
+    // the model can't contain points further away from its origin
+    // than its bounding radius, regardless of rotation
+    if (ent->modelindex > 0 && ent->modelindex < MAX_MODELS &&
+        cgs.inlineModelRadius[ent->modelindex] > 0) {
+      const float radius =
+          cgs.inlineModelRadius[ent->modelindex] + BROADPHASE_MARGIN;
+
+      if (DistanceSquared(point, cent->lerpOrigin) > Square(radius)) {
+        continue;
+      }
+    }
+
     cmodel = trap_CM_InlineModel(ent->modelindex);
     if (!cmodel) {
       continue;
@@ -849,6 +1043,134 @@ to ease the jerk.
 
 pmoveExt_t oldpmext[CMD_BACKUP];
 
+static const int NUM_PREDICTION_ERRORS =
+    sizeof(predictionStrings) / sizeof(predictionStrings[0]);
+
+// collected for /predictionStats, reset with /predictionStats reset
+static struct {
+  int frames;
+  // commands run through Pmove
+  int predicted;
+  // commands restored from cg.backupStates instead of running Pmove
+  int playedBack;
+  int maxPerFrame;
+  // new snapshots whose player state matched a saved state
+  int backupHits;
+  // matches which needed server-only fields patched in (adaptive mode)
+  int backupPatched;
+  int missTeleport;
+  // no saved state with the snapshot's commandTime
+  int missNoState;
+  // a saved state was found but had deviated from the snapshot
+  int missError;
+  int missErrorCodes[NUM_PREDICTION_ERRORS];
+  // origin errors large enough to be smoothed out
+  int predictionErrors;
+} predictionStats;
+
+// per frame view of the stats above in the profiler
+static void CG_CountPrediction(int counter, int events = 1) {
+  auto *profiler = ETJump::profiler.get();
+
+  if (profiler && profiler->isActive()) {
+    profiler->count(counter, events);
+  }
+}
+
+/*
+=================
+CG_CopyServerOnlyFields
+
+Fields which only the server writes and Pmove never touches.
+A saved state which only differs from the snapshot in these can
+take over the snapshot values instead of being re-predicted.
+=================
+*/
+static void CG_CopyServerOnlyFields(const playerState_t *from,
+                                    playerState_t *to) {
+  to->damageEvent = from->damageEvent;
+  to->damageYaw = from->damageYaw;
+  to->damagePitch = from->damagePitch;
+  to->damageCount = from->damageCount;
+
+  to->externalEvent = from->externalEvent;
+  to->externalEventParm = from->externalEventParm;
+  to->externalEventTime = from->externalEventTime;
+
+  to->onFireStart = from->onFireStart;
+
+  for (int i = 0; i < MAX_PERSISTANT; i++) {
+    // read or written by pmove
+    if (i == PERS_TEAM || i == PERS_JUMP_SPEED || i == PERS_HWEAPON_USE) {
+      continue;
+    }
+    to->persistant[i] = from->persistant[i];
+  }
+}
+
+/*
+=================
+CG_PatchBackupStates
+
+Adaptive prediction: if the saved state at 'first' only differs from
+the snapshot in server-only fields, patch those into every queued
+state so they can still be played back. Pmove never touches these
+fields, so the result is the same as predicting from the snapshot.
+=================
+*/
+static bool CG_PatchBackupStates(int first, playerState_t *snapshot) {
+  playerState_t patched = cg.backupStates[first];
+  CG_CopyServerOnlyFields(snapshot, &patched);
+
+  if (CG_PredictionOk(snapshot, &patched)) {
+    return false;
+  }
+
+  for (int i = first; i != cg.backupStateTail;
+       i = (i + 1) % MAX_BACKUP_STATES) {
+    CG_CopyServerOnlyFields(snapshot, &cg.backupStates[i]);
+  }
+
+  return true;
+}
+
+void CG_PredictionStats_f() {
+  if (trap_Argc() > 1 && !Q_stricmp(CG_Argv(1), "reset")) {
+    predictionStats = {};
+    CG_Printf("Prediction stats reset.\n");
+    return;
+  }
+
+  const auto &stats = predictionStats;
+  const int snapshots = stats.backupHits + stats.missTeleport +
+                        stats.missNoState + stats.missError;
+  const float frames = static_cast<float>(std::max(stats.frames, 1));
+
+  CG_Printf("^7Prediction stats over ^3%d ^7frames (etj_optimizePrediction "
+            "%d):\n",
+            stats.frames, etj_optimizePrediction.integer);
+  CG_Printf("  commands predicted:   %d (%.2f/frame)\n", stats.predicted,
+            stats.predicted / frames);
+  CG_Printf("  commands played back: %d (%.2f/frame)\n", stats.playedBack,
+            stats.playedBack / frames);
+  CG_Printf("  most commands in a frame: %d\n", stats.maxPerFrame);
+  CG_Printf("  new snapshots: %d\n", snapshots);
+  CG_Printf("    backup hits:   %d (%d patched)\n", stats.backupHits,
+            stats.backupPatched);
+  CG_Printf("    teleports:     %d\n", stats.missTeleport);
+  CG_Printf("    no saved state: %d\n", stats.missNoState);
+  CG_Printf("    deviated:      %d\n", stats.missError);
+
+  for (int i = 0; i < NUM_PREDICTION_ERRORS; i++) {
+    if (stats.missErrorCodes[i]) {
+      CG_Printf("      %2d %-18s %d\n", i, predictionStrings[i],
+                stats.missErrorCodes[i]);
+    }
+  }
+
+  CG_Printf("  prediction errors: %d\n", stats.predictionErrors);
+}
+
 void CG_PredictPlayerState() {
   int cmdNum, current;
   playerState_t oldPlayerState;
@@ -1087,6 +1409,11 @@ void CG_PredictPlayerState() {
 
   if (etj_optimizePrediction.integer) {
     if (cg.nextFrameTeleport || cg.thisFrameTeleport) {
+      if (cg.physicsTime != cg.lastPhysicsTime) {
+        predictionStats.missTeleport++;
+        CG_CountPrediction(ETJump::predictionProfilerCounters.backupMisses);
+      }
+
       // do a full predict
       cg.lastPredictedCommand = 0;
       cg.backupStateTail = cg.backupStateTop;
@@ -1100,6 +1427,7 @@ void CG_PredictPlayerState() {
     } else {
       // we have a new snapshot
       bool error = true;
+      bool foundState = false;
 
       // loop through the saved states queue
       for (int i = cg.backupStateTop; i != cg.backupStateTail;
@@ -1108,12 +1436,25 @@ void CG_PredictPlayerState() {
         // player state's commandTime
         if (cg.backupStates[i].commandTime ==
             cg.predictedPlayerState.commandTime) {
+          foundState = true;
+
           // make sure the state differences are acceptable
           int errorcode =
               CG_PredictionOk(&cg.predictedPlayerState, &cg.backupStates[i]);
 
+          if (errorcode && etj_optimizePrediction.integer == 2 &&
+              CG_PatchBackupStates(i, &cg.predictedPlayerState)) {
+            predictionStats.backupPatched++;
+            errorcode = 0;
+          }
+
           // too much change?
           if (errorcode) {
+            predictionStats.missError++;
+            if (errorcode < NUM_PREDICTION_ERRORS) {
+              predictionStats.missErrorCodes[errorcode]++;
+            }
+
             if (cg_showmiss.integer) {
               CG_Printf(
                   "CG_PredictPlayerState: errorcode %i '%s' at cg.time: %i\n",
@@ -1133,12 +1474,20 @@ void CG_PredictPlayerState() {
 
           // a saved state matched, so flag it
           error = false;
+          predictionStats.backupHits++;
+          CG_CountPrediction(ETJump::predictionProfilerCounters.backupHits);
           break;
         }
       }
 
+      if (!foundState) {
+        predictionStats.missNoState++;
+      }
+
       // if no saved states matched
       if (error) {
+        CG_CountPrediction(ETJump::predictionProfilerCounters.backupMisses);
+
         // do a full predict
         cg.lastPredictedCommand = 0;
         cg.backupStateTail = cg.backupStateTop;
@@ -1209,6 +1558,8 @@ void CG_PredictPlayerState() {
         VectorSubtract(oldPlayerState.origin, adjusted, delta);
         len = VectorLength(delta);
         if (len > 0.1) {
+          predictionStats.predictionErrors++;
+
           if (cg_showmiss.integer) {
             CG_Printf("Prediction miss: %f\n", len);
           }
@@ -1295,7 +1646,11 @@ void CG_PredictPlayerState() {
       if (cmdNum >= predictCmd ||
           (stateIndex + 1) % MAX_BACKUP_STATES == cg.backupStateTop) {
         // run the Pmove
-        Pmove(&cg_pmove);
+        {
+          ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                        ETJump::Profiler::Pmove);
+          Pmove(&cg_pmove);
+        }
         numPredicted++; // debug code
 
         // record the last predicted command
@@ -1327,7 +1682,11 @@ void CG_PredictPlayerState() {
       }
     } else {
       // run the Pmove
-      Pmove(&cg_pmove);
+      {
+        ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                      ETJump::Profiler::Pmove);
+        Pmove(&cg_pmove);
+      }
       numPredicted++; // debug code
     }
     // END unlagged - optimized prediction
@@ -1340,6 +1699,16 @@ void CG_PredictPlayerState() {
 
   ETJump::resetTempTraceIgnoredClients();
 
+  predictionStats.frames++;
+  predictionStats.predicted += numPredicted;
+  predictionStats.playedBack += numPlayedBack;
+  predictionStats.maxPerFrame =
+      std::max(predictionStats.maxPerFrame, numPredicted + numPlayedBack);
+  CG_CountPrediction(ETJump::predictionProfilerCounters.predicted,
+                     numPredicted);
+  CG_CountPrediction(ETJump::predictionProfilerCounters.playedBack,
+                     numPlayedBack);
+
   // unlagged - optimized prediction
   //  do a /condump after a few seconds of this
   //  if everything is working right, numPredicted should be 1 more than 98%
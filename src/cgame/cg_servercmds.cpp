@@ -2214,620 +2214,622 @@ void CG_FixLinesEndingWithCaret(char *text, int size) {
   text[size - 1] = 0;
 }
 
-static void CG_ServerCommand(void) {
-  const char *cmd;
-  char text[MAX_SAY_TEXT];
-  qboolean enc = qfalse; // used for enc_chat, enc_tchat
+static void CG_ScoreAxis_cmd(void) { CG_ParseScore(TEAM_AXIS); }
 
-  cmd = CG_Argv(0);
+static void CG_ScoreAllies_cmd(void) { CG_ParseScore(TEAM_ALLIES); }
 
-  if (!cmd[0]) {
-    // server claimed the command
-    return;
-  }
+static void CG_WeaponStats_cmd(void) {
+  int i, start = 1;
 
-  if (!strcmp(cmd, "tinfo")) {
-    CG_ParseTeamInfo();
-    return;
-  }
-  if (!strcmp(cmd, "sc0")) {
-    CG_ParseScore(TEAM_AXIS);
-    return;
-  } else if (!strcmp(cmd, "sc1")) {
-    CG_ParseScore(TEAM_ALLIES);
-    return;
-  }
+  for (i = 0; i < WP_NUM_WEAPONS; i++) {
 
-  if (!strcmp(cmd, "WeaponStats")) {
-    int i, start = 1;
+    if (!BG_ValidStatWeapon((weapon_t)i)) {
+      continue;
+    }
 
-    for (i = 0; i < WP_NUM_WEAPONS; i++) {
+    cgs.playerStats.weaponStats[i].kills = Q_atoi(CG_Argv(start++));
+    cgs.playerStats.weaponStats[i].killedby = Q_atoi(CG_Argv(start++));
+    cgs.playerStats.weaponStats[i].teamkills = Q_atoi(CG_Argv(start++));
+  }
 
-      if (!BG_ValidStatWeapon((weapon_t)i)) {
-        continue;
-      }
+  cgs.playerStats.suicides = Q_atoi(CG_Argv(start++));
 
-      cgs.playerStats.weaponStats[i].kills = Q_atoi(CG_Argv(start++));
-      cgs.playerStats.weaponStats[i].killedby = Q_atoi(CG_Argv(start++));
-      cgs.playerStats.weaponStats[i].teamkills = Q_atoi(CG_Argv(start++));
-    }
+  for (i = 0; i < HR_NUM_HITREGIONS; i++) {
+    cgs.playerStats.hitRegions[i] = Q_atoi(CG_Argv(start++));
+  }
 
-    cgs.playerStats.suicides = Q_atoi(CG_Argv(start++));
+  cgs.numOIDtriggers = Q_atoi(CG_Argv(start++));
 
-    for (i = 0; i < HR_NUM_HITREGIONS; i++) {
-      cgs.playerStats.hitRegions[i] = Q_atoi(CG_Argv(start++));
-    }
+  for (i = 0; i < cgs.numOIDtriggers; i++) {
+    cgs.playerStats.objectiveStats[i] = Q_atoi(CG_Argv(start++));
+    cgs.teamobjectiveStats[i] = Q_atoi(CG_Argv(start++));
+  }
+}
 
-    cgs.numOIDtriggers = Q_atoi(CG_Argv(start++));
+static void CG_HasTimerun_cmd(void) {
+  cg.hasTimerun = Q_atoi(CG_Argv(1)) ? qtrue : qfalse;
+}
 
-    for (i = 0; i < cgs.numOIDtriggers; i++) {
-      cgs.playerStats.objectiveStats[i] = Q_atoi(CG_Argv(start++));
-      cgs.teamobjectiveStats[i] = Q_atoi(CG_Argv(start++));
-    }
+static void CG_CheatCvarsOff_cmd(void) {
+  const int flags = Q_atoi(CG_Argv(1));
 
-    return;
+  if (flags & static_cast<int>(ETJump::CheatCvarFlags::LookYaw)) {
+    trap_SendConsoleCommand("set cl_freelook 1\n");
+    trap_SendConsoleCommand("set cl_yawspeed 0\n");
   }
 
-  if (!Q_stricmp(cmd, "hasTimerun")) {
-    cg.hasTimerun = Q_atoi(CG_Argv(1)) ? qtrue : qfalse;
-    return;
+  if (flags & static_cast<int>(ETJump::CheatCvarFlags::PmoveFPS)) {
+    trap_SendConsoleCommand("set pmove_fixed 1\n");
   }
+}
 
-  if (!Q_stricmpn(cmd, "cheatCvarsOff",
-                  static_cast<int>(strlen("cheatCvarsOff")))) {
-    const int flags = Q_atoi(CG_Argv(1));
+static void CG_PopupMessage_cmd(void) {
+  CG_AddPMItem(PM_MESSAGE, CG_LocalizeServerCommand(CG_Argv(1)),
+               cgs.media.voiceChatShader);
+}
+
+// Banner Printing
+static void CG_BannerPrint_cmd(void) {
+  CG_BannerPrint(CG_LocalizeServerCommand(CG_Argv(1)));
+}
+
+static void CG_CenterPrint_cmd(void) {
+  // NERVE - SMF
+  int args = trap_Argc();
+  char *s;
 
-    if (flags & static_cast<int>(ETJump::CheatCvarFlags::LookYaw)) {
-      trap_SendConsoleCommand("set cl_freelook 1\n");
-      trap_SendConsoleCommand("set cl_yawspeed 0\n");
+  if (args >= 3) {
+    s = CG_TranslateString(CG_Argv(1));
+
+    if (args == 4) {
+      s = va("%s%s", CG_Argv(3), s);
     }
 
-    if (flags & static_cast<int>(ETJump::CheatCvarFlags::PmoveFPS)) {
-      trap_SendConsoleCommand("set pmove_fixed 1\n");
+    // OSP - for client logging
+    if (cg_printObjectiveInfo.integer > 0 &&
+        (args == 4 || Q_atoi(CG_Argv(2)) > 1)) {
+      CG_Printf("[cgnotify]*** ^3INFO: ^5%s\n",
+                CG_LocalizeServerCommand(CG_Argv(1)));
     }
-    return;
+    CG_PriorityCenterPrint(s, SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.20),
+                           SMALLCHAR_WIDTH, Q_atoi(CG_Argv(2)));
+  } else {
+    CG_CenterPrint(CG_LocalizeServerCommand(CG_Argv(1)),
+                   SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.20),
+                   SMALLCHAR_WIDTH); //----(SA)	modified
   }
+}
 
-  if (!Q_stricmp(cmd, "cpm")) {
-    CG_AddPMItem(PM_MESSAGE, CG_LocalizeServerCommand(CG_Argv(1)),
-                 cgs.media.voiceChatShader);
-    return;
-  }
+static void CG_StatsDebug_cmd(void) { CG_StatsDebugAddText(CG_Argv(1)); }
 
-  // Banner Printing
-  if (!Q_stricmp(cmd, "bp")) {
-    CG_BannerPrint(CG_LocalizeServerCommand(CG_Argv(1)));
-    return;
-  }
+static void CG_Print_cmd(void) {
+  CG_Printf("[cgnotify]%s", CG_LocalizeServerCommand(CG_Argv(1)));
+}
 
-  if (!Q_stricmp(cmd, "cp")) {
-    // NERVE - SMF
-    int args = trap_Argc();
-    char *s;
+static void CG_EntityInfo_cmd(void) {
+  char buffer[16];
+  int allied_number, axis_number;
 
-    if (args >= 3) {
-      s = CG_TranslateString(CG_Argv(1));
+  trap_Argv(1, buffer, 16);
+  axis_number = Q_atoi(buffer);
 
-      if (args == 4) {
-        s = va("%s%s", CG_Argv(3), s);
-      }
+  trap_Argv(2, buffer, 16);
+  allied_number = Q_atoi(buffer);
 
-      // OSP - for client logging
-      if (cg_printObjectiveInfo.integer > 0 &&
-          (args == 4 || Q_atoi(CG_Argv(2)) > 1)) {
-        CG_Printf("[cgnotify]*** ^3INFO: ^5%s\n",
-                  CG_LocalizeServerCommand(CG_Argv(1)));
-      }
-      CG_PriorityCenterPrint(s, SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.20),
-                             SMALLCHAR_WIDTH, Q_atoi(CG_Argv(2)));
-    } else {
-      CG_CenterPrint(CG_LocalizeServerCommand(CG_Argv(1)),
-                     SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.20),
-                     SMALLCHAR_WIDTH); //----(SA)	modified
-    }
-    return;
+  CG_ParseMapEntityInfo(axis_number, allied_number);
+}
+
+// enc is used for enc_chat
+static void CG_Chat(qboolean enc) {
+  char text[MAX_SAY_TEXT];
+  int msgType = 0;
+  if (Q_atoi(CG_Argv(4))) {
+    msgType |= REPLAY_MSG;
   }
+  const char *s = CG_Argv(2);
+  if (s[0] == '\0') { // server sends empty clientNum
+    msgType |= SERVER_MSG;
+  }
+  const int clientNum = Q_atoi(s);
 
-  if (!Q_stricmp(cmd, "sdbg")) {
-    CG_StatsDebugAddText(CG_Argv(1));
+  if (cg_teamChatsOnly.integer) {
     return;
   }
 
-  if (!Q_stricmp(cmd, "cs")) {
-    CG_ConfigStringModified();
-    return;
+  if (Q_atoi(CG_Argv(3))) {
+    s = CG_LocalizeServerCommand(CG_Argv(1));
+  } else {
+    s = CG_Argv(1);
   }
 
-  if (!Q_stricmp(cmd, "print")) {
-    CG_Printf("[cgnotify]%s", CG_LocalizeServerCommand(CG_Argv(1)));
-    return;
+  Q_strncpyz(text, s, MAX_SAY_TEXT);
+
+  if (enc) {
+    CG_DecodeQP(text);
   }
 
-  if (!Q_stricmp(cmd, "entnfo")) {
-    char buffer[16];
-    int allied_number, axis_number;
+  CG_RemoveChatEscapeChar(text);
+  CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
+  s = CG_AddChatModifications(text, clientNum, msgType);
+  CG_AddToTeamChat(s, clientNum, msgType);
+  CG_Printf("%s\n", s);
+}
 
-    trap_Argv(1, buffer, 16);
-    axis_number = Q_atoi(buffer);
+static void CG_Chat_cmd(void) { CG_Chat(qfalse); }
 
-    trap_Argv(2, buffer, 16);
-    allied_number = Q_atoi(buffer);
+static void CG_EncodedChat_cmd(void) { CG_Chat(qtrue); }
 
-    CG_ParseMapEntityInfo(axis_number, allied_number);
+// enc is used for enc_tchat
+static void CG_TeamChat(qboolean enc) {
+  char text[MAX_SAY_TEXT];
+  const char *s;
 
-    return;
+  if (Q_atoi(CG_Argv(3))) {
+    s = CG_LocalizeServerCommand(CG_Argv(1));
+  } else {
+    s = CG_Argv(1);
   }
 
-  enc = !Q_stricmp(cmd, "enc_chat") ? qtrue : qfalse;
-  if (!Q_stricmp(cmd, "chat") || enc) {
-    int msgType = 0;
-    if (Q_atoi(CG_Argv(4))) {
-      msgType |= REPLAY_MSG;
-    }
-    const char *s = CG_Argv(2);
-    if (s[0] == '\0') { // server sends empty clientNum
-      msgType |= SERVER_MSG;
-    }
-    const int clientNum = Q_atoi(s);
+  Q_strncpyz(text, s, MAX_SAY_TEXT);
+  if (enc) {
+    CG_DecodeQP(text);
+  }
+  CG_RemoveChatEscapeChar(text);
 
-    if (cg_teamChatsOnly.integer) {
-      return;
-    }
+  s = CG_AddChatModifications(text, Q_atoi(CG_Argv(2)), 0);
+  Q_strncpyz(text, s, MAX_SAY_TEXT);
 
-    if (Q_atoi(CG_Argv(3))) {
-      s = CG_LocalizeServerCommand(CG_Argv(1));
-    } else {
-      s = CG_Argv(1);
-    }
+  CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
+  CG_AddToTeamChat(text, Q_atoi(CG_Argv(2)), 0);
+  CG_Printf("%s\n", text); // JPW NERVE
+}
 
-    Q_strncpyz(text, s, MAX_SAY_TEXT);
+static void CG_TeamChat_cmd(void) { CG_TeamChat(qfalse); }
 
-    if (enc) {
-      CG_DecodeQP(text);
-    }
+static void CG_EncodedTeamChat_cmd(void) { CG_TeamChat(qtrue); }
+
+// NERVE - SMF - enabled support
+static void CG_VoiceChatAll_cmd(void) { CG_VoiceChat(SAY_ALL); }
+
+static void CG_VoiceChatTeam_cmd(void) { CG_VoiceChat(SAY_TEAM); }
 
-    CG_RemoveChatEscapeChar(text);
-    CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
-    s = CG_AddChatModifications(text, clientNum, msgType);
-    CG_AddToTeamChat(s, clientNum, msgType);
-    CG_Printf("%s\n", s);
+static void CG_VoiceChatBuddy_cmd(void) { CG_VoiceChat(SAY_BUDDY); }
 
+static void CG_Voted_cmd(void) {
+  cgs.votedYes = !Q_strncmp(CG_Argv(1), "y", 1);
+  cgs.votedNo = !Q_strncmp(CG_Argv(1), "n", 1);
+}
+
+// DHM - Nerve :: Allow client to lodge a complaing
+static void CG_Complaint_cmd(void) {
+  if (cgs.gamestate != GS_PLAYING) {
     return;
   }
 
-  enc = !Q_stricmp(cmd, "enc_tchat") ? qtrue : qfalse;
-  if (!Q_stricmp(cmd, "tchat") || enc) {
+  cgs.complaintEndTime = cg.time + 20000;
+  cgs.complaintClient = Q_atoi(CG_Argv(1));
 
-    const char *s;
+  if (cgs.complaintClient < 0) {
+    cgs.complaintEndTime = cg.time + 10000;
+  }
+}
+// dhm
 
-    if (Q_atoi(CG_Argv(3))) {
-      s = CG_LocalizeServerCommand(CG_Argv(1));
-    } else {
-      s = CG_Argv(1);
-    }
+// OSP - weapon stats parsing
+static void CG_WeaponStatsDump_cmd(void) {
+  if (cgs.dumpStatsTime > cg.time) {
+    CG_dumpStats();
+  } else {
+    CG_parseWeaponStats_cmd(CG_printConsoleString);
+    cgs.dumpStatsTime = 0;
+  }
+}
 
-    Q_strncpyz(text, s, MAX_SAY_TEXT);
-    if (enc) {
-      CG_DecodeQP(text);
-    }
-    CG_RemoveChatEscapeChar(text);
+// OSP - "topshots"-related commands
+static void CG_TopShots_cmd(void) {
+  CG_parseTopShotsStats_cmd(qtrue, CG_printConsoleString);
+}
 
-    s = CG_AddChatModifications(text, Q_atoi(CG_Argv(2)), 0);
-    Q_strncpyz(text, s, MAX_SAY_TEXT);
+static void CG_TopShotsBottom_cmd(void) {
+  CG_parseTopShotsStats_cmd(qfalse, CG_printConsoleString);
+}
 
-    CG_FixLinesEndingWithCaret(text, MAX_SAY_TEXT);
-    CG_AddToTeamChat(text, Q_atoi(CG_Argv(2)), 0);
-    CG_Printf("%s\n", text); // JPW NERVE
+static void CG_BestShots_cmd(void) {
+  CG_parseBestShotsStats_cmd(qtrue, CG_printConsoleString);
+}
 
-    return;
-  }
+static void CG_BestShotsBottom_cmd(void) {
+  CG_parseBestShotsStats_cmd(qfalse, CG_printConsoleString);
+}
 
-  if (!Q_stricmp(cmd, "vchat")) {
-    CG_VoiceChat(SAY_ALL); // NERVE - SMF - enabled support
-    return;
-  }
+static void CG_WindowTopShots_cmd(void) { CG_topshotsParse_cmd(qtrue); }
 
-  if (!Q_stricmp(cmd, "vtchat")) {
-    CG_VoiceChat(SAY_TEAM); // NERVE - SMF - enabled support
-    return;
-  }
+static void CG_StartCam_cmd(void) {
+  CG_StartCamera(CG_Argv(1), Q_atoi(CG_Argv(2)) ? qtrue : qfalse);
+}
 
-  if (!Q_stricmp(cmd, "vbchat")) {
-    CG_VoiceChat(SAY_BUDDY);
-    return;
-  }
+static void CG_SetInitialCamera_cmd(void) {
+  CG_SetInitialCamera(CG_Argv(1), Q_atoi(CG_Argv(2)) ? qtrue : qfalse);
+}
 
-  if (!Q_stricmp(cmd, "voted")) {
-    cgs.votedYes = !Q_strncmp(CG_Argv(1), "y", 1);
-    cgs.votedNo = !Q_strncmp(CG_Argv(1), "n", 1);
-    return;
-  }
+static void CG_SetSpawnPoint_cmd(void) {
+  cg.selectedSpawnPoint = Q_atoi(CG_Argv(1)) + 1;
+}
 
-  // DHM - Nerve :: Allow client to lodge a complaing
-  if (!Q_stricmp(cmd, "complaint") && cgs.gamestate == GS_PLAYING) {
-    cgs.complaintEndTime = cg.time + 20000;
-    cgs.complaintClient = Q_atoi(CG_Argv(1));
+// map loaded, game is ready to begin.
+static void CG_RockAndRoll_cmd(void) {
+  // Arnout: FIXME: re-enable when we get menus that deal with fade
+  // properly
+  //		CG_Fade(0, 0, 0, 255, cg.time, 0);		// go
+  // black
+  // trap_UI_Popup("pregame");				// start
+  // pregame menu trap_Cvar_Set("cg_norender", "1");	// don't
+  // render the world until the player clicks in and the
+  // 'playerstart' func has been called (g_main in
+  // G_UpdateCvars() ~ilne 949)
+
+  trap_S_FadeAllSound(1.0f, 1000, qfalse); // fade sound up
+}
 
-    if (cgs.complaintClient < 0) {
-      cgs.complaintEndTime = cg.time + 10000;
-    }
+static void CG_Application_cmd(void) {
+  cgs.applicationEndTime = cg.time + 20000;
+  cgs.applicationClient = Q_atoi(CG_Argv(1));
 
-    return;
+  if (cgs.applicationClient < 0) {
+    cgs.applicationEndTime = cg.time + 10000;
   }
-  // dhm
+}
 
-  if (!Q_stricmp(cmd, "map_restart")) {
-    CG_MapRestart();
-    return;
-  }
+static void CG_Invitation_cmd(void) {
+  cgs.invitationEndTime = cg.time + 20000;
+  cgs.invitationClient = Q_atoi(CG_Argv(1));
 
-  // OSP - match stats
-  if (!Q_stricmp(cmd, "sc")) {
-    CG_scores_cmd();
-    return;
+  if (cgs.invitationClient < 0) {
+    cgs.invitationEndTime = cg.time + 10000;
   }
+}
 
-  // OSP - weapon stats parsing
-  if (!Q_stricmp(cmd, "ws")) {
-    if (cgs.dumpStatsTime > cg.time) {
-      CG_dumpStats();
-    } else {
-      CG_parseWeaponStats_cmd(CG_printConsoleString);
-      cgs.dumpStatsTime = 0;
-    }
+static void CG_Proposition_cmd(void) {
+  cgs.propositionEndTime = cg.time + 20000;
+  cgs.propositionClient = Q_atoi(CG_Argv(1));
+  cgs.propositionClient2 = Q_atoi(CG_Argv(2));
 
-    return;
-  }
-  if (!Q_stricmp(cmd, "wws")) {
-    CG_wstatsParse_cmd();
-    return;
-  }
-  if (!Q_stricmp(cmd, "gstats")) {
-    CG_parseWeaponStatsGS_cmd();
-    return;
+  if (cgs.propositionClient < 0) {
+    cgs.propositionEndTime = cg.time + 10000;
   }
+}
 
-  // OSP - "topshots"-related commands
-  if (!Q_stricmp(cmd, "astats")) {
-    CG_parseTopShotsStats_cmd(qtrue, CG_printConsoleString);
-    return;
-  }
-  if (!Q_stricmp(cmd, "astatsb")) {
-    CG_parseTopShotsStats_cmd(qfalse, CG_printConsoleString);
-    return;
-  }
-  if (!Q_stricmp(cmd, "bstats")) {
-    CG_parseBestShotsStats_cmd(qtrue, CG_printConsoleString);
-    return;
-  }
-  if (!Q_stricmp(cmd, "bstatsb")) {
-    CG_parseBestShotsStats_cmd(qfalse, CG_printConsoleString);
-    return;
-  }
-  //	if(!strcmp(cmd, "wastats")) {
-  //		CG_wtopshotsParse_cmd(qfalse);
-  //		return;
-  //	}
-  if (!Q_stricmp(cmd, "wbstats")) {
-    CG_topshotsParse_cmd(qtrue);
-    return;
-  }
+static void CG_AutoFireteam_cmd(void) {
+  cgs.autoFireteamEndTime = cg.time + 20000;
+  cgs.autoFireteamNum = Q_atoi(CG_Argv(1));
 
-  // Gordon: single weapon stat (requested weapon stats)
-  if (!Q_stricmp(cmd, "rws")) {
-    CG_ParseWeaponStats();
-    return;
-  }
-  if (!Q_stricmp(cmd, "portalcampos")) {
-    CG_ParsePortalPos();
-    return;
+  if (cgs.autoFireteamNum < -1) {
+    cgs.autoFireteamEndTime = cg.time + 10000;
   }
+}
 
-  if (!Q_stricmp(cmd, "startCam")) {
-    CG_StartCamera(CG_Argv(1), Q_atoi(CG_Argv(2)) ? qtrue : qfalse);
-    return;
-  }
+static void CG_AutoFireteamCreate_cmd(void) {
+  cgs.autoFireteamCreateEndTime = cg.time;
+  cgs.autoFireteamCreateNum = Q_atoi(CG_Argv(1));
 
-  if (!Q_stricmp(cmd, "SetInitialCamera")) {
-    CG_SetInitialCamera(CG_Argv(1), Q_atoi(CG_Argv(2)) ? qtrue : qfalse);
-    return;
+  if (cgs.autoFireteamCreateNum < -1) {
+    cgs.autoFireteamCreateEndTime = cg.time + 10000;
   }
+}
 
-  if (!Q_stricmp(cmd, "stopCam")) {
-    CG_StopCamera();
-    return;
-  }
+static void CG_AutoFireteamJoin_cmd(void) {
+  cgs.autoFireteamJoinEndTime = cg.time + 20000;
+  cgs.autoFireteamJoinNum = Q_atoi(CG_Argv(1));
 
-  if (!Q_stricmp(cmd, "setspawnpt")) {
-    cg.selectedSpawnPoint = Q_atoi(CG_Argv(1)) + 1;
-    return;
+  if (cgs.autoFireteamJoinNum < -1) {
+    cgs.autoFireteamJoinEndTime = cg.time + 10000;
   }
+}
 
-  if (!strcmp(cmd,
-              "rockandroll")) // map loaded, game is ready to begin.
-  { // Arnout: FIXME: re-enable when we get menus that deal with fade
-    // properly
-    //		CG_Fade(0, 0, 0, 255, cg.time, 0);		// go
-    // black
-    // trap_UI_Popup("pregame");				// start
-    // pregame menu trap_Cvar_Set("cg_norender", "1");	// don't
-    // render the world until the player clicks in and the
-    // 'playerstart' func has been called (g_main in
-    // G_UpdateCvars() ~ilne 949)
-
-    trap_S_FadeAllSound(1.0f, 1000, qfalse); // fade sound up
-
-    return;
+static void CG_RemapShader_cmd(void) {
+  if (trap_Argc() == 4) {
+    trap_R_RemapShader(CG_Argv(1), CG_Argv(2), CG_Argv(3));
   }
+}
 
-  if (!Q_stricmp(cmd, "application")) {
-    cgs.applicationEndTime = cg.time + 20000;
-    cgs.applicationClient = Q_atoi(CG_Argv(1));
+// GS Copied in code from old source for mu_start, mu_play & mu_stop
+//
+//  music
+//
 
-    if (cgs.applicationClient < 0) {
-      cgs.applicationEndTime = cg.time + 10000;
-    }
+// loops, has optional parameter for fade-up time
+static void CG_MusicStart_cmd(void) {
+  char text[MAX_SAY_TEXT];
+  int fadeTime = 0; // default to instant start
 
-    return;
+  Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
+  if (strlen(text)) {
+    fadeTime = Q_atoi(text);
   }
 
-  if (!Q_stricmp(cmd, "invitation")) {
-    cgs.invitationEndTime = cg.time + 20000;
-    cgs.invitationClient = Q_atoi(CG_Argv(1));
+  trap_S_StartBackgroundTrack(CG_Argv(1), CG_Argv(1), fadeTime);
+}
 
-    if (cgs.invitationClient < 0) {
-      cgs.invitationEndTime = cg.time + 10000;
-    }
+// plays once then back to whatever the loop was,
+// has optional parameter for fade-up time
+static void CG_MusicPlay_cmd(void) {
+  char text[MAX_SAY_TEXT];
+  int fadeTime = 0; // default to instant start
 
-    return;
+  Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
+  if (strlen(text)) {
+    fadeTime = Q_atoi(text);
   }
 
-  if (!Q_stricmp(cmd, "proposition")) {
-    cgs.propositionEndTime = cg.time + 20000;
-    cgs.propositionClient = Q_atoi(CG_Argv(1));
-    cgs.propositionClient2 = Q_atoi(CG_Argv(2));
+  trap_S_StartBackgroundTrack(CG_Argv(1), "onetimeonly", fadeTime);
+}
 
-    if (cgs.propositionClient < 0) {
-      cgs.propositionEndTime = cg.time + 10000;
-    }
+// has optional parameter for fade-down time
+static void CG_MusicStop_cmd(void) {
+  char text[MAX_SAY_TEXT];
+  int fadeTime = 0; // default to instant stop
 
-    return;
+  Q_strncpyz(text, CG_Argv(1), MAX_SAY_TEXT);
+  if (strlen(text)) {
+    fadeTime = Q_atoi(text);
   }
 
-  if (!Q_stricmp(cmd, "aft")) {
-    cgs.autoFireteamEndTime = cg.time + 20000;
-    cgs.autoFireteamNum = Q_atoi(CG_Argv(1));
+  trap_S_FadeBackgroundTrack(0.0f, fadeTime, 0);
+  trap_S_StartBackgroundTrack("", "", -2); // '-2' for 'queue looping track'
+                                           // (QUEUED_PLAY_LOOPED)
+}
+
+static void CG_MusicFade_cmd(void) {
+  trap_S_FadeBackgroundTrack(Q_atof(CG_Argv(1)), Q_atoi(CG_Argv(2)), 0);
+}
 
-    if (cgs.autoFireteamNum < -1) {
-      cgs.autoFireteamEndTime = cg.time + 10000;
-    }
-    return;
-  }
+static void CG_SoundFade_cmd(void) {
+  trap_S_FadeAllSound(Q_atof(CG_Argv(1)), Q_atoi(CG_Argv(2)),
+                      Q_atoi(CG_Argv(3)) ? qtrue : qfalse);
+}
 
-  if (!Q_stricmp(cmd, "aftc")) {
-    cgs.autoFireteamCreateEndTime = cg.time;
-    cgs.autoFireteamCreateNum = Q_atoi(CG_Argv(1));
+static void CG_FireteamCommands_cmd(void) {
+  char info[MAX_INFO_STRING];
+  trap_Argv(1, info, sizeof(info));
 
-    if (cgs.autoFireteamCreateNum < -1) {
-      cgs.autoFireteamCreateEndTime = cg.time + 10000;
-    }
-    return;
-  }
+  cg.botMenuIcons = Q_atoi(info);
+}
 
-  if (!Q_stricmp(cmd, "aftj")) {
-    cgs.autoFireteamJoinEndTime = cg.time + 20000;
-    cgs.autoFireteamJoinNum = Q_atoi(CG_Argv(1));
+static void CG_SetName_cmd(void) {
+  int argc, totlen, i, len;
+  static char line[MAX_STRING_CHARS];
+  char arg[MAX_STRING_CHARS];
 
-    if (cgs.autoFireteamJoinNum < -1) {
-      cgs.autoFireteamJoinEndTime = cg.time + 10000;
+  len = 0;
+  argc = trap_Argc();
+  for (i = 1; i < argc; i++) {
+    trap_Argv(i, arg, sizeof(arg));
+    totlen = strlen(arg);
+    if (len + totlen >= MAX_STRING_CHARS - 1) {
+      break;
     }
-    return;
-  }
-
-  if (Q_stricmp(cmd, "remapShader") == 0) {
-    if (trap_Argc() == 4) {
-      trap_R_RemapShader(CG_Argv(1), CG_Argv(2), CG_Argv(3));
+    memcpy(line + len, arg, totlen);
+    len += totlen;
+    if (i != argc - 1) {
+      line[len] = ' ';
+      len++;
     }
   }
 
-  // GS Copied in code from old source for mu_start, mu_play & mu_stop
-  //
-  //  music
-  //
-
-  // loops \/
-  if (!Q_stricmp(cmd,
-                 "mu_start")) // has optional parameter for fade-up time
-  {
-    int fadeTime = 0; // default to instant start
-
-    Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
-    if (strlen(text)) {
-      fadeTime = Q_atoi(text);
-    }
+  line[len] = 0;
 
-    trap_S_StartBackgroundTrack(CG_Argv(1), CG_Argv(1), fadeTime);
-    return;
-  }
-  // plays once then back to whatever the loop was \/
-  if (!Q_stricmp(cmd,
-                 "mu_play")) // has optional parameter for fade-up time
-  {
-    int fadeTime = 0; // default to instant start
+  trap_Cvar_Set("name", line);
+}
 
-    Q_strncpyz(text, CG_Argv(2), MAX_SAY_TEXT);
-    if (strlen(text)) {
-      fadeTime = Q_atoi(text);
-    }
+// ensure a file gets into a build (mainly for scripted music calls)
+static void CG_AddToBuild_cmd(void) {
+  fileHandle_t f;
 
-    trap_S_StartBackgroundTrack(CG_Argv(1), "onetimeonly", fadeTime);
+  if (!cg_buildScript.integer) {
     return;
   }
 
-  if (!Q_stricmp(cmd, "mu_stop")) // has optional parameter for fade-down time
-  {
-    int fadeTime = 0; // default to instant stop
+  // just open the file so it gets copied to the build dir
+  // CG_FileTouchForBuild(CG_Argv(1));
+  trap_FS_FOpenFile(CG_Argv(1), &f, FS_READ);
+  trap_FS_FCloseFile(f);
+}
 
-    Q_strncpyz(text, CG_Argv(1), MAX_SAY_TEXT);
-    if (strlen(text)) {
-      fadeTime = Q_atoi(text);
-    }
+// ydnar: bug 267: server sends this command when it's about to kill
+// the current server, before the client can reconnect
+static void CG_SpawnServer_cmd(void) {
+  // print message informing player the server is restarting
+  // with a new map
+  CG_PriorityCenterPrint(va("%s", CG_TranslateString("^3Server Restarting")),
+                         SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.25),
+                         SMALLCHAR_WIDTH, 999999);
+
+  // hack here
+  cg.serverRespawning = qtrue;
+
+  // fade out over the course of 5 seconds, should be enough
+  // (nuking: atvi bug 3793)
+  //%	CG_Fade( 0, 0, 0, 255, cg.time, 5000 );
+}
 
-    trap_S_FadeBackgroundTrack(0.0f, fadeTime, 0);
-    trap_S_StartBackgroundTrack("", "", -2); // '-2' for 'queue looping track'
-                                             // (QUEUED_PLAY_LOOPED)
-    return;
-  }
-  if (!Q_stricmp(cmd, "mu_fade")) {
-    trap_S_FadeBackgroundTrack(Q_atof(CG_Argv(1)), Q_atoi(CG_Argv(2)), 0);
-    return;
-  }
+static void CG_DisplayByName_cmd(void) { CG_displaybyname(); }
 
-  if (!Q_stricmp(cmd, "snd_fade")) {
-    trap_S_FadeAllSound(Q_atof(CG_Argv(1)), Q_atoi(CG_Argv(2)),
-                        Q_atoi(CG_Argv(3)) ? qtrue : qfalse);
-    return;
-  }
+static void CG_DisplayByNumber_cmd(void) { CG_displaybynumber(); }
 
-  if (!Q_stricmp(cmd, "ftCommands")) {
-    char info[MAX_INFO_STRING];
-    trap_Argv(1, info, sizeof(info));
+// shut up console when we send this over from save
+static void CG_ResetStrafeQuality_cmd(void) {}
 
-    cg.botMenuIcons = Q_atoi(info);
+static void CG_SavePrint_cmd(void) {
+  int pos = Q_atoi(CG_Argv(1));
+  std::string saveMsg = etj_saveMsg.string;
 
-    return;
+  if (pos) {
+    saveMsg += ' ' + std::to_string(pos);
   }
-
-  if (!Q_stricmp(cmd, "manual")) {
-    CG_Manual_f();
-    return;
+  if (trap_Argc() == 3) {
+    int remainingSaves = Q_atoi(CG_Argv(2));
+    std::string remainingSavesStr =
+        va("^7(^3%d ^7remaining)\n", remainingSaves);
+    saveMsg += '\n' + remainingSavesStr;
   }
 
-  if (!Q_stricmp(cmd, "set_name")) {
-    int argc, totlen, i, len;
-    static char line[MAX_STRING_CHARS];
-    char arg[MAX_STRING_CHARS];
-    ;
-    if (!CG_Argv(1)) {
-      return;
-    }
+  CPri(saveMsg.c_str());
+}
 
-    len = 0;
-    argc = trap_Argc();
-    for (i = 1; i < argc; i++) {
-      trap_Argv(i, arg, sizeof(arg));
-      totlen = strlen(arg);
-      if (len + totlen >= MAX_STRING_CHARS - 1) {
-        break;
-      }
-      memcpy(line + len, arg, totlen);
-      len += totlen;
-      if (i != argc - 1) {
-        line[len] = ' ';
-        len++;
-      }
-    }
+static void CG_OpenRtvMenu_cmd(void) {
+  trap_SendConsoleCommand("openRtvMenu");
+}
 
-    line[len] = 0;
+// for !rtv admin command
+static void CG_Callvote_cmd(void) {
+  std::string command = va("callvote %s", CG_Argv(1));
 
-    trap_Cvar_Set("name", line);
-    return;
+  if (trap_Argc() > 2) {
+    command += " " + std::string(CG_Argv(2));
   }
 
-  // ensure a file gets into a build (mainly for scripted music calls)
-  if (!Q_stricmp(cmd, "addToBuild")) {
-    fileHandle_t f;
-
-    if (!cg_buildScript.integer) {
-      return;
-    }
-
-    // just open the file so it gets copied to the build dir
-    // CG_FileTouchForBuild(CG_Argv(1));
-    trap_FS_FOpenFile(CG_Argv(1), &f, FS_READ);
-    trap_FS_FCloseFile(f);
-    return;
-  }
+  trap_SendConsoleCommand(command.c_str());
+}
 
-  // ydnar: bug 267: server sends this command when it's about to kill
-  // the current server, before the client can reconnect
-  if (!Q_stricmp(cmd, "spawnserver")) {
-    // print message informing player the server is restarting
-    // with a new map
-    CG_PriorityCenterPrint(va("%s", CG_TranslateString("^3Server Restarting")),
-                           SCREEN_HEIGHT - (SCREEN_HEIGHT * 0.25),
-                           SMALLCHAR_WIDTH, 999999);
+typedef struct {
+  const char *cmd;
+  void (*function)(void);
+  // matched with strcmp instead of Q_stricmp, as before the handler table
+  qboolean caseSensitive;
+} serverCommand_t;
+
+static const serverCommand_t serverCommands[] = {
+    {"tinfo", CG_ParseTeamInfo, qtrue},
+    {"sc0", CG_ScoreAxis_cmd, qtrue},
+    {"sc1", CG_ScoreAllies_cmd, qtrue},
+    {"WeaponStats", CG_WeaponStats_cmd, qtrue},
+    {"hasTimerun", CG_HasTimerun_cmd},
+    {"cheatCvarsOff", CG_CheatCvarsOff_cmd},
+    {"cpm", CG_PopupMessage_cmd},
+    {"bp", CG_BannerPrint_cmd},
+    {"cp", CG_CenterPrint_cmd},
+    {"sdbg", CG_StatsDebug_cmd},
+    {"cs", CG_ConfigStringModified},
+    {"print", CG_Print_cmd},
+    {"entnfo", CG_EntityInfo_cmd},
+    {"chat", CG_Chat_cmd},
+    {"enc_chat", CG_EncodedChat_cmd},
+    {"tchat", CG_TeamChat_cmd},
+    {"enc_tchat", CG_EncodedTeamChat_cmd},
+    {"vchat", CG_VoiceChatAll_cmd},
+    {"vtchat", CG_VoiceChatTeam_cmd},
+    {"vbchat", CG_VoiceChatBuddy_cmd},
+    {"voted", CG_Voted_cmd},
+    {"complaint", CG_Complaint_cmd},
+    {"map_restart", CG_MapRestart},
+    {"sc", CG_scores_cmd},
+    {"ws", CG_WeaponStatsDump_cmd},
+    {"wws", CG_wstatsParse_cmd},
+    {"gstats", CG_parseWeaponStatsGS_cmd},
+    {"astats", CG_TopShots_cmd},
+    {"astatsb", CG_TopShotsBottom_cmd},
+    {"bstats", CG_BestShots_cmd},
+    {"bstatsb", CG_BestShotsBottom_cmd},
+    {"wbstats", CG_WindowTopShots_cmd},
+    {"rws", CG_ParseWeaponStats},
+    {"portalcampos", CG_ParsePortalPos},
+    {"startCam", CG_StartCam_cmd},
+    {"SetInitialCamera", CG_SetInitialCamera_cmd},
+    {"stopCam", CG_StopCamera},
+    {"setspawnpt", CG_SetSpawnPoint_cmd},
+    {"rockandroll", CG_RockAndRoll_cmd},
+    {"application", CG_Application_cmd},
+    {"invitation", CG_Invitation_cmd},
+    {"proposition", CG_Proposition_cmd},
+    {"aft", CG_AutoFireteam_cmd},
+    {"aftc", CG_AutoFireteamCreate_cmd},
+    {"aftj", CG_AutoFireteamJoin_cmd},
+    {"remapShader", CG_RemapShader_cmd},
+    {"mu_start", CG_MusicStart_cmd},
+    {"mu_play", CG_MusicPlay_cmd},
+    {"mu_stop", CG_MusicStop_cmd},
+    {"mu_fade", CG_MusicFade_cmd},
+    {"snd_fade", CG_SoundFade_cmd},
+    {"ftCommands", CG_FireteamCommands_cmd},
+    {"manual", CG_Manual_f},
+    {"set_name", CG_SetName_cmd},
+    {"addToBuild", CG_AddToBuild_cmd},
+    {"spawnserver", CG_SpawnServer_cmd},
+    {"tjl_displaybyname", CG_DisplayByName_cmd},
+    {"tjl_displaybynumber", CG_DisplayByNumber_cmd},
+    {"resetStrafeQuality", CG_ResetStrafeQuality_cmd},
+    {"savePrint", CG_SavePrint_cmd},
+    {"openRtvMenu", CG_OpenRtvMenu_cmd},
+    {"callvote", CG_Callvote_cmd},
+};
 
-    // hack here
-    cg.serverRespawning = qtrue;
+/*
+=================
+CG_InitServerCommands
 
-    // fade out over the course of 5 seconds, should be enough
-    // (nuking: atvi bug 3793)
-    //%	CG_Fade( 0, 0, 0, 255, cg.time, 5000 );
+Registers the commands above to the server commands handler,
+so every server command is dispatched through its hash table
+=================
+*/
+static void CG_UnknownServerCommand(const char *cmd) {
+  CG_Printf("Unknown client game command: %s\n", cmd);
+}
 
-    return;
-  }
+void CG_InitServerCommands(void) {
+  for (const auto &command : serverCommands) {
+    const auto function = command.function;
+    const char *name = command.cmd;
+
+    if (command.caseSensitive) {
+      ETJump::serverCommandsHandler->subscribe(
+          name,
+          [function, name](const ETJump::CommandArguments &args) {
+            const char *cmd = CG_Argv(0);
+            if (strcmp(cmd, name)) {
+              CG_UnknownServerCommand(cmd);
+              return;
+            }
+            function();
+          },
+          false);
+      continue;
+    }
 
-  std::vector<std::string> arguments;
-  for (auto i = 1, argc = trap_Argc(); i < argc; ++i) {
-    // Zero: CG_Argv cannot be used here as it uses a single
-    // static buffer and breaks the CG_ServerCommandExt as cmd
-    // will be replaced with whatever was the last argument
-    char buf[MAX_TOKEN_CHARS]{};
-    trap_Argv(i, buf, sizeof(buf));
-    arguments.push_back(buf);
+    ETJump::serverCommandsHandler->subscribe(
+        name, [function](const ETJump::CommandArguments &args) { function(); },
+        false);
   }
+}
 
-  bool found = ETJump::serverCommandsHandler->check(cmd, arguments);
+static void CG_ServerCommand(void) {
+  const char *tokens[MAX_STRING_TOKENS];
+  const int numTokens = CG_ArgvTokens(tokens, MAX_STRING_TOKENS);
 
-  if (CG_ServerCommandExt(cmd)) {
+  if (numTokens < 0) {
+    CG_Printf("^3Warning: ^7server command ^3%s ^7is too long, ignoring\n",
+              CG_Argv(0));
     return;
   }
 
-  // shut up console when we send this over from save
-  if (!Q_stricmp(cmd, "resetStrafeQuality")) {
+  if (!numTokens || !tokens[0][0]) {
+    // server claimed the command
     return;
   }
 
-  if (!Q_stricmp(cmd, "savePrint")) {
-    int pos = Q_atoi(CG_Argv(1));
-    std::string saveMsg = etj_saveMsg.string;
-
-    if (pos) {
-      saveMsg += ' ' + std::to_string(pos);
-    }
-    if (trap_Argc() == 3) {
-      int remainingSaves = Q_atoi(CG_Argv(2));
-      std::string remainingSavesStr =
-          va("^7(^3%d ^7remaining)\n", remainingSaves);
-      saveMsg += '\n' + remainingSavesStr;
-    }
-
-    CPri(saveMsg.c_str());
-    return;
-  }
+  const ETJump::CommandArguments arguments(tokens + 1, numTokens - 1);
 
-  if (!Q_stricmp(cmd, "openRtvMenu")) {
-    trap_SendConsoleCommand("openRtvMenu");
+  if (ETJump::serverCommandsHandler->check(tokens[0], arguments)) {
     return;
   }
 
-  // for !rtv admin command
-  if (!Q_stricmp(cmd, "callvote")) {
-    std::string command = va("%s %s", cmd, arguments[0].c_str());
-
-    if (arguments.size() > 1) {
-      command += " " + arguments[1];
-    }
-
-    trap_SendConsoleCommand(command.c_str());
+  // cheatCvarsOff has always been matched by prefix
+  if (!Q_stricmpn(tokens[0], "cheatCvarsOff",
+                  static_cast<int>(strlen("cheatCvarsOff")))) {
+    CG_CheatCvarsOff_cmd();
     return;
   }
 
-  if (found)
-    return;
-
-  CG_Printf("Unknown client game command: %s\n", cmd);
+  CG_UnknownServerCommand(tokens[0]);
 }
 
 /*
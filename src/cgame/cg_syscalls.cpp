@@ -666,18 +666,34 @@ int trap_PC_LoadSource(const char *filename) {
 }
 
 int trap_PC_FreeSource(int handle) {
+  if (PC_IsCachedSource(handle)) {
+    return PC_FreeCachedSource(handle);
+  }
+
   return SystemCall(CG_PC_FREE_SOURCE, handle);
 }
 
 int trap_PC_ReadToken(int handle, pc_token_t *pc_token) {
+  if (PC_IsCachedSource(handle)) {
+    return PC_ReadCachedToken(handle, pc_token);
+  }
+
   return SystemCall(CG_PC_READ_TOKEN, handle, pc_token);
 }
 
 int trap_PC_SourceFileAndLine(int handle, char *filename, int *line) {
+  if (PC_IsCachedSource(handle)) {
+    return PC_CachedSourceFileAndLine(handle, filename, line);
+  }
+
   return SystemCall(CG_PC_SOURCE_FILE_AND_LINE, handle, filename, line);
 }
 
 int trap_PC_UnReadToken(int handle) {
+  if (PC_IsCachedSource(handle)) {
+    return PC_UnReadCachedToken(handle);
+  }
+
   return SystemCall(CG_PC_UNREAD_TOKEN, handle);
 }
 
@@ -2,6 +2,8 @@
 // for a 3D rendering
 #include "cg_local.h"
 #include "../game/etj_numeric_utilities.h"
+#include "etj_player_bbox.h"
+#include "etj_profiler.h"
 
 //========================
 extern pmove_t cg_pmove;
@@ -1899,10 +1901,35 @@ Generates and draws a game scene and status information at the given time.
 
 qboolean CG_CalcMuzzlePoint(int entityNum, vec3_t muzzle);
 
+// times the whole frame and commits it to the profiler history,
+// regardless of which path CG_DrawActiveFrame returns from
+class ProfilerFrame {
+  ETJump::Profiler *profiler;
+
+public:
+  explicit ProfilerFrame(ETJump::Profiler *profiler) : profiler(profiler) {
+    if (profiler) {
+      profiler->beginFrame(etj_profiler.integer > 0);
+    }
+  }
+
+  ~ProfilerFrame() {
+    if (profiler) {
+      profiler->endFrame();
+    }
+  }
+};
+
 void CG_DrawActiveFrame(int serverTime, stereoFrame_t stereoView,
                         qboolean demoPlayback) {
   int inwater;
 
+  // destroyed in reverse order, so the frame scope is
+  // recorded before the frame is committed
+  ProfilerFrame profilerFrame(ETJump::profiler.get());
+  ETJump::Profiler::Scope frameScope(ETJump::profiler.get(),
+                                     ETJump::Profiler::Frame);
+
 #ifdef DEBUGTIME_ENABLED
   int dbgTime = trap_Milliseconds(), elapsed;
   int dbgCnt = 0;
@@ -1995,7 +2022,11 @@ void CG_DrawActiveFrame(int serverTime, stereoFrame_t stereoView,
   cg.clientFrame++;
 
   // update cg.predictedPlayerState
-  CG_PredictPlayerState();
+  {
+    ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                  ETJump::Profiler::Prediction);
+    CG_PredictPlayerState();
+  }
 
   DEBUGTIME
 
@@ -2043,9 +2074,14 @@ void CG_DrawActiveFrame(int serverTime, stereoFrame_t stereoView,
 
     // build the render lists
     if (!cg.hyperspace) {
-      CG_AddPacketEntities(); // adter calcViewValues,
-                              // so predicted player
-                              // state is correct
+      {
+        ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                      ETJump::Profiler::PacketEntities);
+        CG_AddPacketEntities(); // adter calcViewValues,
+                                // so predicted player
+                                // state is correct
+        ETJump::playerBBox->addToScene();
+      }
       CG_AddMarks();
 
       DEBUGTIME
@@ -2055,12 +2091,20 @@ void CG_DrawActiveFrame(int serverTime, stereoFrame_t stereoView,
       DEBUGTIME
 
       // Rafael particles
-      CG_AddParticles();
+      {
+        ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                      ETJump::Profiler::Particles);
+        CG_AddParticles();
+      }
       // done.
 
       DEBUGTIME
 
-      CG_AddLocalEntities();
+      {
+        ETJump::Profiler::Scope scope(ETJump::profiler.get(),
+                                      ETJump::Profiler::LocalEntities);
+        CG_AddLocalEntities();
+      }
 
       DEBUGTIME
 
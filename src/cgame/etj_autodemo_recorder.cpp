@@ -25,6 +25,7 @@
 #include "etj_autodemo_recorder.h"
 #include "etj_utilities.h"
 #include "etj_demo_recorder.h"
+#include "etj_file_copier.h"
 #include "../game/etj_filesystem.h"
 #include "../game/etj_string_utilities.h"
 #include "../game/etj_numeric_utilities.h"
@@ -39,6 +40,8 @@ static const int DEMO_MAX_SAVE_DELAY = 10000;
 static const int DEMO_START_TIMEOUT = 500;
 static const int MAX_TEMP = 20;
 static const char *TEMP_PATH = "temp";
+// bytes copied per frame when saving a demo
+static const int DEMO_COPY_CHUNK_SIZE = 1 << 18;
 
 std::string ETJump::AutoDemoRecorder::TempNameGenerator::pop() {
   if (!names.size())
@@ -110,7 +113,7 @@ ETJump::AutoDemoRecorder::AutoDemoRecorder() {
       });
 
   consoleCommandsHandler->subscribe(
-      "ad_save", [&](const std::vector<std::string> &args) {
+      "ad_save", [&](const CommandArguments &args) {
         if (etj_autoDemo.integer <= 0)
           return;
         if (!cl_demorecording.integer) {
@@ -177,14 +180,39 @@ void ETJump::AutoDemoRecorder::saveTimerunDemo(const std::string &src,
 void ETJump::AutoDemoRecorder::saveDemo(const std::string &src,
                                         const std::string &dst) {
   maybeCancelDelayedSave();
-  setTimeout([src, dst] { FileSystem::safeCopy(src, dst); }, DEMO_SAVE_DELAY);
+  setTimeout(
+      [src, dst] {
+        // report progress on long demos only, in quarters
+        auto lastQuarter = std::make_shared<int>(0);
+        auto onProgress = [lastQuarter](int copied, int total) {
+          if (total < DEMO_COPY_CHUNK_SIZE * 4) {
+            return;
+          }
+          const int quarter = static_cast<int>(4LL * copied / total);
+          if (quarter > *lastQuarter && quarter < 4) {
+            *lastQuarter = quarter;
+            CG_Printf("^7Saving demo... %d%%\n", quarter * 25);
+          }
+        };
+        auto onComplete = [dst](bool success) {
+          if (!success) {
+            CG_Printf("^1Failed to save demo to %s\n", dst.c_str());
+            return;
+          }
+          CG_AddPMItem(PM_MESSAGE, "^7Demo saved!\n",
+                       cgs.media.voiceChatShader);
+          CG_Printf("^7Demo saved to %s\n", dst.c_str());
+        };
+        std::make_shared<FileCopier>(src, dst, DEMO_COPY_CHUNK_SIZE,
+                                     onProgress, onComplete)
+            ->start();
+      },
+      DEMO_SAVE_DELAY);
 }
 
 void ETJump::AutoDemoRecorder::saveDemoWithRestart(const std::string &src,
                                                    const std::string &dst) {
   saveDemo(src, dst);
-  CG_AddPMItem(PM_MESSAGE, "^7Demo saved!\n", cgs.media.voiceChatShader);
-  CG_Printf("^7Demo saved to %s\n", dst.c_str());
   restart();
 }
 
@@ -38,13 +38,13 @@ ETJump::AwaitedCommandHandler::AwaitedCommandHandler(
       _sendConsoleCommand(sendConsoleCommand), _printToConsole(printToConsole) {
   _awaitedCommands.clear();
   _consoleCommandsHandler->subscribe(
-      "await", [this](const std::vector<std::string> &args) {
+      "await", [this](const CommandArguments &args) {
         if (cgs.clientinfo->timerunActive) {
           message("^3Error: ^7cannot use ^3await "
                   "^7during timeruns.");
           return;
         }
-        this->awaitCommand(args);
+        this->awaitCommand(args.toVector());
       });
 
   playerEventsHandler->subscribe(
@@ -34,6 +34,99 @@
 #define CHSCHAR_SIZEX 0.2
 #define CHSCHAR_SIZEY 0.2
 
+// inputs a stat can depend on, each has a generation counter that is bumped
+// whenever the input changes so unchanged stats can skip formatting
+enum {
+  CHS_DEP_PLAYER, // origin, velocity, angles, health and jump speed
+  CHS_DEP_VIEW,   // view origin and axis
+  CHS_DEP_AMMO,
+  CHS_DEP_JUMP, // last jump position
+  CHS_NUM_DEPS
+};
+
+#define CHS_PLAYER (1 << CHS_DEP_PLAYER)
+#define CHS_VIEW (1 << CHS_DEP_VIEW)
+#define CHS_AMMO (1 << CHS_DEP_AMMO)
+#define CHS_JUMP (1 << CHS_DEP_JUMP)
+
+#define CHS_NO_TRACE -1
+#define CHS_MAX_TRACES 4
+#define CHS_NUM_SLOTS 16
+
+// view trace for a single contents mask, done at most once per frame
+typedef struct {
+  int contents;
+  int frame;
+  // bumped when the trace result differs from the previous one
+  int generation;
+  trace_t trace;
+  // distances are only valid if trace.fraction != 1.0
+  float distXY;
+  float distZ;
+  float distXYZ;
+  float distView;
+  float planeAngleZ;
+} chsTrace_t;
+
+typedef struct {
+  vec3_t origin;
+  vec3_t velocity;
+  vec3_t viewangles;
+  int health;
+  int jumpSpeed;
+} chsPlayerInputs_t;
+
+typedef struct {
+  vec3_t vieworg;
+  vec3_t viewaxis[3];
+} chsViewInputs_t;
+
+typedef struct {
+  int ammo;
+  int clips;
+  int akimboAmmo;
+} chsAmmoInputs_t;
+
+// values shared by every stat drawn during a frame
+typedef struct {
+  int frame;
+  playerState_t *ps;
+
+  chsPlayerInputs_t player; // origin is lowered to feet with etj_CHSUseFeet
+  chsViewInputs_t view;
+  chsAmmoInputs_t ammo;
+  vec3_t jumpPos;
+
+  float speedXY;
+  float speedXYZ;
+  float speedForward;
+  float speedSideways;
+
+  vec4_t color;
+  int textStyle;
+
+  chsTrace_t traces[CHS_MAX_TRACES];
+  int numTraces;
+  int traceGeneration;
+
+  int generation[CHS_NUM_DEPS];
+} chsContext_t;
+
+// formatted stat of a single CHS1/CHS2 position
+typedef struct {
+  qboolean valid;
+  int stat;
+  qboolean drawName;
+  int generation[CHS_NUM_DEPS];
+  int traceGeneration;
+  char text[256];
+  int width;
+  int height;
+} chsSlot_t;
+
+static chsContext_t chs;
+static chsSlot_t chsSlots[CHS_NUM_SLOTS];
+
 static playerState_t *CG_CHS_GetPlayerState(void) {
   if (cg.snap->ps.clientNum != cg.clientNum) {
     return &cg.snap->ps;
@@ -44,351 +137,360 @@ static playerState_t *CG_CHS_GetPlayerState(void) {
 }
 
 static void CG_CHS_ViewTrace(trace_t *trace, int traceContents) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
   vec3_t start, end;
 
   VectorCopy(cg.refdef.vieworg, start);
   VectorMA(start, 131072, cg.refdef.viewaxis[0], end);
-  CG_Trace(trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
+  CG_Trace(trace, start, vec3_origin, vec3_origin, end, chs.ps->clientNum,
            traceContents);
 }
 
+template <typename T>
+static void CG_CHS_TrackInputs(int dep, const T &current, T &previous) {
+  if (memcmp(&current, &previous, sizeof(T))) {
+    previous = current;
+    chs.generation[dep]++;
+  }
+}
+
+static void CG_CHS_BeginFrame(void) {
+  chsPlayerInputs_t player;
+  chsViewInputs_t view;
+  chsAmmoInputs_t ammo;
+  vec3_t jumpPos;
+  const int offset = etj_CHSUseFeet.integer ? 24 : 0;
+
+  chs.frame++;
+  chs.ps = CG_CHS_GetPlayerState();
+
+  VectorCopy(chs.ps->origin, player.origin);
+  player.origin[2] -= offset;
+  VectorCopy(chs.ps->velocity, player.velocity);
+  VectorCopy(chs.ps->viewangles, player.viewangles);
+  player.health = chs.ps->stats[STAT_HEALTH];
+  player.jumpSpeed = chs.ps->persistant[PERS_JUMP_SPEED];
+  CG_CHS_TrackInputs(CHS_DEP_PLAYER, player, chs.player);
+
+  VectorCopy(cg.refdef.vieworg, view.vieworg);
+  AxisCopy(cg.refdef.viewaxis, view.viewaxis);
+  CG_CHS_TrackInputs(CHS_DEP_VIEW, view, chs.view);
+
+  CG_PlayerAmmoValue(&ammo.ammo, &ammo.clips, &ammo.akimboAmmo);
+  CG_CHS_TrackInputs(CHS_DEP_AMMO, ammo, chs.ammo);
+
+  VectorCopy(cg.etjLastJumpPos, jumpPos);
+  jumpPos[2] -= offset;
+  if (!VectorCompare(jumpPos, chs.jumpPos)) {
+    VectorCopy(jumpPos, chs.jumpPos);
+    chs.generation[CHS_DEP_JUMP]++;
+  }
+
+  chs.speedXY = sqrt(SQR(player.velocity[0]) + SQR(player.velocity[1]));
+  chs.speedXYZ = VectorLength(player.velocity);
+  chs.speedForward = DotProduct(player.velocity, view.viewaxis[0]);
+  chs.speedSideways = DotProduct(player.velocity, view.viewaxis[1]);
+
+  // alpha, shadow and color stuff
+  chs.textStyle = ITEM_TEXTSTYLE_NORMAL;
+  if (etj_CHSShadow.integer > 0) {
+    chs.textStyle = ITEM_TEXTSTYLE_SHADOWED;
+  }
+
+  Vector4Set(chs.color, 1.f, 1.f, 1.f, 1.f);
+  ETJump::parseColorString(etj_CHSColor.string, chs.color);
+  chs.color[3] = Numeric::clamp(etj_CHSAlpha.value, 0.0f, 1.0f);
+}
+
+// returns the view trace for the given extra trace option, tracing only
+// if no other stat has traced with the same contents this frame
+static const chsTrace_t *CG_CHS_Trace(int extraTraceOption) {
+  const int contents = ETJump::checkExtraTrace(extraTraceOption);
+  chsTrace_t *entry = nullptr;
+
+  for (int i = 0; i < chs.numTraces; i++) {
+    if (chs.traces[i].contents == contents) {
+      entry = &chs.traces[i];
+      break;
+    }
+  }
+
+  if (!entry) {
+    if (chs.numTraces < CHS_MAX_TRACES) {
+      entry = &chs.traces[chs.numTraces++];
+    } else {
+      entry = &chs.traces[CHS_MAX_TRACES - 1];
+    }
+
+    memset(entry, 0, sizeof(*entry));
+    entry->contents = contents;
+    entry->frame = chs.frame - 1;
+    entry->generation = ++chs.traceGeneration;
+  }
+
+  if (entry->frame == chs.frame) {
+    return entry;
+  }
+
+  trace_t trace;
+  CG_CHS_ViewTrace(&trace, contents);
+
+  if (trace.fraction != entry->trace.fraction ||
+      !VectorCompare(trace.endpos, entry->trace.endpos) ||
+      !VectorCompare(trace.plane.normal, entry->trace.plane.normal) ||
+      trace.plane.dist != entry->trace.plane.dist) {
+    entry->generation = ++chs.traceGeneration;
+  }
+
+  entry->trace = trace;
+  entry->frame = chs.frame;
+
+  const float *origin = chs.player.origin;
+  const float *end = trace.endpos;
+  entry->distXY = sqrt(SQR(end[0] - origin[0]) + SQR(end[1] - origin[1]));
+  entry->distZ = end[2] - origin[2];
+  entry->distXYZ = Distance(end, origin);
+  entry->distView = Distance(end, chs.view.vieworg);
+
+  const float *normal = trace.plane.normal;
+  entry->planeAngleZ =
+      atan2(sqrt(pow(normal[0], 2) + pow(normal[1], 2)), normal[2]) * 180 /
+      M_PI;
+
+  return entry;
+}
+
 static void CG_CHS_Speed(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", VectorLength(ps->velocity));
+  Com_sprintf(buf, size, "%.0f", chs.speedXYZ);
 }
 
 static void CG_CHS_Health(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%d", ps->stats[STAT_HEALTH]);
+  Com_sprintf(buf, size, "%d", chs.player.health);
 }
 
 static void CG_CHS_Ammo(char *buf, int size) {
-  int ammo, clips, akimboammo;
-  CG_PlayerAmmoValue(&ammo, &clips, &akimboammo);
-  if (akimboammo >= 0) {
-    Com_sprintf(buf, size, "%d|%d/%d", akimboammo, ammo, clips);
-  } else if (clips >= 0) {
-    Com_sprintf(buf, size, "%d/%d", ammo, clips);
-  } else if (ammo >= 0) {
-    Com_sprintf(buf, size, "%d", ammo);
+  const chsAmmoInputs_t &ammo = chs.ammo;
+  if (ammo.akimboAmmo >= 0) {
+    Com_sprintf(buf, size, "%d|%d/%d", ammo.akimboAmmo, ammo.ammo, ammo.clips);
+  } else if (ammo.clips >= 0) {
+    Com_sprintf(buf, size, "%d/%d", ammo.ammo, ammo.clips);
+  } else if (ammo.ammo >= 0) {
+    Com_sprintf(buf, size, "%d", ammo.ammo);
   }
 }
 
 static void CG_CHS_Distance_XY(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  trace_t trace;
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_10_11);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_10_11);
 
-  if (trace.fraction != 1.0) {
-    Com_sprintf(buf, size, "%.0f",
-                sqrt(SQR(trace.endpos[0] - ps->origin[0]) +
-                     SQR(trace.endpos[1] - ps->origin[1])));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f", trace->distXY);
   } else {
     Com_sprintf(buf, size, "-");
   }
 }
 
 static void CG_CHS_Distance_Z(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  trace_t trace;
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_10_11);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_10_11);
 
-  if (trace.fraction != 1.0) {
-    Com_sprintf(buf, size, "%.0f", trace.endpos[2] - (ps->origin[2] - offset));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f", trace->distZ);
   } else {
     Com_sprintf(buf, size, "-");
   }
 }
 
 static void CG_CHS_Distance_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  trace_t trace;
-  vec3_t origin;
-  vec3_t originOffset{0, 0, 24};
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_12);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_12);
 
-  VectorCopy(ps->origin, origin);
-  if (trace.fraction != 1.0) {
-    if (etj_CHSUseFeet.integer) {
-      _VectorSubtract(origin, originOffset, origin);
-    }
-    Com_sprintf(buf, size, "%.0f", Distance(trace.endpos, origin));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f", trace->distXYZ);
   } else {
     Com_sprintf(buf, size, "-");
   }
 }
 
 static void CG_CHS_Distance_ViewXYZ(char *buf, int size) {
-  trace_t trace;
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_13_15);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_13_15);
 
-  if (trace.fraction != 1.0) {
-    Com_sprintf(buf, size, "%.0f", Distance(trace.endpos, cg.refdef.vieworg));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f", trace->distView);
   } else {
     Com_sprintf(buf, size, "-");
   }
 }
 
 static void CG_CHS_Distance_XY_Z_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  trace_t trace;
-  vec3_t origin;
-  vec3_t originOffset{0, 0, 24};
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_13_15);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_13_15);
 
-  VectorCopy(ps->origin, origin);
-  if (trace.fraction != 1.0) {
-    if (etj_CHSUseFeet.integer) {
-      _VectorSubtract(origin, originOffset, origin);
-    }
-    Com_sprintf(buf, size, "%.0f %.0f %.0f",
-                sqrt(SQR(trace.endpos[0] - origin[0]) +
-                     SQR(trace.endpos[1] - origin[1])),
-                trace.endpos[2] - origin[2], Distance(trace.endpos, origin));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f %.0f %.0f", trace->distXY, trace->distZ,
+                trace->distXYZ);
   } else {
     Com_sprintf(buf, size, "- - -");
   }
 }
 
 static void CG_CHS_Distance_XY_Z_ViewXYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  trace_t trace;
-  vec3_t origin;
-  vec3_t originOffset{0, 0, 24};
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_13_15);
 
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_13_15);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
-
-  VectorCopy(ps->origin, origin);
-  if (trace.fraction != 1.0) {
-    if (etj_CHSUseFeet.integer) {
-      _VectorSubtract(origin, originOffset, origin);
-    }
-    Com_sprintf(buf, size, "%.0f %.0f %.0f",
-                sqrt(SQR(trace.endpos[0] - origin[0]) +
-                     SQR(trace.endpos[1] - origin[1])),
-                trace.endpos[2] - origin[2],
-                Distance(trace.endpos, cg.refdef.vieworg));
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f %.0f %.0f", trace->distXY, trace->distZ,
+                trace->distView);
   } else {
     Com_sprintf(buf, size, "- - -");
   }
 }
 
 static void CG_CHS_Look_XYZ(char *buf, int size) {
-  trace_t trace;
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_16);
+  const cplane_t &plane = trace->trace.plane;
 
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_16);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
-
-  if (trace.fraction != 1.0) {
-    Com_sprintf(buf, size, "%.0f %.0f %.0f",
-                trace.plane.dist * trace.plane.normal[0],
-                trace.plane.dist * trace.plane.normal[1],
-                trace.plane.dist * trace.plane.normal[2]);
+  if (trace->trace.fraction != 1.0) {
+    Com_sprintf(buf, size, "%.0f %.0f %.0f", plane.dist * plane.normal[0],
+                plane.dist * plane.normal[1], plane.dist * plane.normal[2]);
   } else {
     Com_sprintf(buf, size, "- - -");
   }
 }
 
 static void CG_CHS_Speed_X(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", ps->velocity[0]);
+  Com_sprintf(buf, size, "%.0f", chs.player.velocity[0]);
 }
 
 static void CG_CHS_Speed_Y(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", ps->velocity[1]);
+  Com_sprintf(buf, size, "%.0f", chs.player.velocity[1]);
 }
 
 static void CG_CHS_Speed_Z(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", ps->velocity[2]);
+  Com_sprintf(buf, size, "%.0f", chs.player.velocity[2]);
 }
 
 static void CG_CHS_Speed_XY(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f",
-              sqrt(SQR(ps->velocity[0]) + SQR(ps->velocity[1])));
+  Com_sprintf(buf, size, "%.0f", chs.speedXY);
 }
 
 static void CG_CHS_Speed_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", VectorLength(ps->velocity));
+  Com_sprintf(buf, size, "%.0f", chs.speedXYZ);
 }
 
 static void CG_CHS_Speed_Forward(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f",
-              DotProduct(ps->velocity, cg.refdef.viewaxis[0]));
+  Com_sprintf(buf, size, "%.0f", chs.speedForward);
 }
 
 static void CG_CHS_Speed_Sideways(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f",
-              DotProduct(ps->velocity, cg.refdef.viewaxis[1]));
+  Com_sprintf(buf, size, "%.0f", chs.speedSideways);
 }
 
 static void CG_CHS_Speed_Forward_Sideways(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f %.0f",
-              DotProduct(ps->velocity, cg.refdef.viewaxis[0]),
-              DotProduct(ps->velocity, cg.refdef.viewaxis[1]));
+  Com_sprintf(buf, size, "%.0f %.0f", chs.speedForward, chs.speedSideways);
 }
 
 static void CG_CHS_Speed_XY_Forward_Sideways(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f %.0f %.0f",
-              sqrt(SQR(ps->velocity[0]) + SQR(ps->velocity[1])),
-              DotProduct(ps->velocity, cg.refdef.viewaxis[0]),
-              DotProduct(ps->velocity, cg.refdef.viewaxis[1]));
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", chs.speedXY, chs.speedForward,
+              chs.speedSideways);
 }
 
 static void CG_CHS_Pitch(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.2f", ps->viewangles[PITCH]);
+  Com_sprintf(buf, size, "%.2f", chs.player.viewangles[PITCH]);
 }
 
 static void CG_CHS_Yaw(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.2f", ps->viewangles[YAW]);
+  Com_sprintf(buf, size, "%.2f", chs.player.viewangles[YAW]);
 }
 
 static void CG_CHS_Roll(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.2f", ps->viewangles[ROLL]);
+  Com_sprintf(buf, size, "%.2f", chs.player.viewangles[ROLL]);
 }
 
 static void CG_CHS_Position_X(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", ps->origin[0]);
+  Com_sprintf(buf, size, "%.0f", chs.player.origin[0]);
 }
 
 static void CG_CHS_Position_Y(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f", ps->origin[1]);
+  Com_sprintf(buf, size, "%.0f", chs.player.origin[1]);
 }
 
 static void CG_CHS_Position_Z(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
-  Com_sprintf(buf, size, "%.0f", (ps->origin[2] - offset));
+  Com_sprintf(buf, size, "%.0f", chs.player.origin[2]);
 }
 
 static void CG_CHS_ViewPosition_X(char *buf, int size) {
-  Com_sprintf(buf, size, "%.0f", cg.refdef.vieworg[0]);
+  Com_sprintf(buf, size, "%.0f", chs.view.vieworg[0]);
 }
 
 static void CG_CHS_ViewPosition_Y(char *buf, int size) {
-  Com_sprintf(buf, size, "%.0f", cg.refdef.vieworg[1]);
+  Com_sprintf(buf, size, "%.0f", chs.view.vieworg[1]);
 }
 
 static void CG_CHS_ViewPosition_Z(char *buf, int size) {
-  Com_sprintf(buf, size, "%.0f", cg.refdef.vieworg[2]);
+  Com_sprintf(buf, size, "%.0f", chs.view.vieworg[2]);
 }
 
 static void CG_CHS_Pitch_Yaw(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.2f %.2f", ps->viewangles[PITCH],
-              ps->viewangles[YAW]);
+  Com_sprintf(buf, size, "%.2f %.2f", chs.player.viewangles[PITCH],
+              chs.player.viewangles[YAW]);
 }
 
 static void CG_CHS_Player_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
-  Com_sprintf(buf, size, "%.0f %.0f %.0f", ps->origin[0], ps->origin[1],
-              (ps->origin[2] - offset));
+  const float *origin = chs.player.origin;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", origin[0], origin[1], origin[2]);
 }
 
 static void CG_CHS_Player_XYZ_Pitch_Yaw(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
-  Com_sprintf(buf, size, "%.0f %.0f %.0f %.2f %.2f", ps->origin[0],
-              ps->origin[1], (ps->origin[2] - offset), ps->viewangles[PITCH],
-              ps->viewangles[YAW]);
+  const float *origin = chs.player.origin;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f %.2f %.2f", origin[0], origin[1],
+              origin[2], chs.player.viewangles[PITCH],
+              chs.player.viewangles[YAW]);
 }
 
 static void CG_CHS_ViewPosition_XYZ_Pitch_Yaw(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f %.0f %.0f %.2f %.2f", cg.refdef.vieworg[0],
-              cg.refdef.vieworg[1], cg.refdef.vieworg[2], ps->viewangles[PITCH],
-              ps->viewangles[YAW]);
+  const float *vieworg = chs.view.vieworg;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f %.2f %.2f", vieworg[0], vieworg[1],
+              vieworg[2], chs.player.viewangles[PITCH],
+              chs.player.viewangles[YAW]);
 }
 
 static void CG_CHS_Position_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
-  Com_sprintf(buf, size, "%.0f %.0f %.0f", ps->origin[0], ps->origin[1],
-              (ps->origin[2] - offset));
+  const float *origin = chs.player.origin;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", origin[0], origin[1], origin[2]);
 }
 
 static void CG_CHS_ViewPosition_XYZ(char *buf, int size) {
-  Com_sprintf(buf, size, "%.0f %.0f %.0f", cg.refdef.vieworg[0],
-              cg.refdef.vieworg[1], cg.refdef.vieworg[2]);
+  const float *vieworg = chs.view.vieworg;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", vieworg[0], vieworg[1], vieworg[2]);
 }
 
 static void CG_CHS_Angles_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.2f %.2f %.2f", ps->viewangles[PITCH],
-              ps->viewangles[YAW], ps->viewangles[ROLL]);
+  const float *angles = chs.player.viewangles;
+  Com_sprintf(buf, size, "%.2f %.2f %.2f", angles[PITCH], angles[YAW],
+              angles[ROLL]);
 }
 
 static void CG_CHS_Velocity_XYZ(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%.0f %.0f %.0f", ps->velocity[0], ps->velocity[1],
-              ps->velocity[2]);
+  const float *velocity = chs.player.velocity;
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", velocity[0], velocity[1],
+              velocity[2]);
 }
 
 static void CG_CHS_LastJumpPosition_XYZ(char *buf, int size) {
-  int offset = etj_CHSUseFeet.integer ? 24 : 0;
-  Com_sprintf(buf, size, "%.0f %.0f %.0f", cg.etjLastJumpPos[0],
-              cg.etjLastJumpPos[1], (cg.etjLastJumpPos[2] - offset));
+  Com_sprintf(buf, size, "%.0f %.0f %.0f", chs.jumpPos[0], chs.jumpPos[1],
+              chs.jumpPos[2]);
 }
 
 static void CG_CHS_PlaneAngleZ(char *buf, int size) {
-  trace_t trace;
-
-  int traceContents = ETJump::checkExtraTrace(ETJump::CHS_53);
-
-  CG_CHS_ViewTrace(&trace, traceContents);
-
-  float vec_x = trace.plane.normal[0];
-  float vec_y = trace.plane.normal[1];
-  float vec_z = trace.plane.normal[2];
-
-  float angle_z =
-      atan2(sqrt(pow(vec_x, 2) + pow(vec_y, 2)), vec_z) * 180 / M_PI;
-
-  Com_sprintf(buf, size, "%.2f", angle_z);
+  const chsTrace_t *trace = CG_CHS_Trace(ETJump::CHS_53);
+  Com_sprintf(buf, size, "%.2f", trace->planeAngleZ);
 }
 
 static void CG_CHS_LastJumpSpeed(char *buf, int size) {
-  playerState_t *ps = CG_CHS_GetPlayerState();
-  Com_sprintf(buf, size, "%d", ps->persistant[PERS_JUMP_SPEED]);
+  Com_sprintf(buf, size, "%d", chs.player.jumpSpeed);
 }
 
 typedef struct {
   void (*fun)(char *, int);
   const char *name; // used as a CHS2 prefix
   const char *desc; // used to display info about the stat
+  int deps;         // CHS_* inputs the value is formatted from
+  int trace;        // extraTraceOptions value of the view trace used
 } stat_t;
 
 /*
@@ -397,11 +499,13 @@ typedef struct {
  */
 static stat_t stats[] = {
     /*   0 */ {NULL},
-    /*   1 */ {CG_CHS_Speed, "Speed", "player speed"},
-    /*   2 */ {CG_CHS_Health, "Health", "player health"},
+    /*   1 */ {CG_CHS_Speed, "Speed", "player speed", CHS_PLAYER, CHS_NO_TRACE},
+    /*   2 */
+    {CG_CHS_Health, "Health", "player health", CHS_PLAYER, CHS_NO_TRACE},
     /*   3 */ {NULL}, // armor
-                      /*   4 */
-    {CG_CHS_Ammo, "Ammo", "player ammo for currently selected weapon"},
+    /*   4 */
+    {CG_CHS_Ammo, "Ammo", "player ammo for currently selected weapon", CHS_AMMO,
+     CHS_NO_TRACE},
     /*   5 */ {NULL}, // health/armor
     /*   6 */ {NULL}, // health/armor/ammo
     /*   7 */ {NULL}, // empty
@@ -409,76 +513,132 @@ static stat_t stats[] = {
     /*   9 */ {NULL}, // empty
 
     /*  10 */
-    {CG_CHS_Distance_XY, "Distance XY", "horizontal distance to plane"},
-    /*  11 */ {CG_CHS_Distance_Z, "Distance Z", "vertical distance to plane"},
-    /*  12 */ {CG_CHS_Distance_XYZ, "Distance XYZ", "true distance to plane"},
+    {CG_CHS_Distance_XY, "Distance XY", "horizontal distance to plane",
+     CHS_PLAYER | CHS_VIEW, ETJump::CHS_10_11},
+    /*  11 */
+    {CG_CHS_Distance_Z, "Distance Z", "vertical distance to plane",
+     CHS_PLAYER | CHS_VIEW, ETJump::CHS_10_11},
+    /*  12 */
+    {CG_CHS_Distance_XYZ, "Distance XYZ", "true distance to plane",
+     CHS_PLAYER | CHS_VIEW, ETJump::CHS_12},
     /*  13 */
     {CG_CHS_Distance_ViewXYZ, "Distance ViewXYZ",
-     "true distance to plane from view point"},
+     "true distance to plane from view point", CHS_PLAYER | CHS_VIEW,
+     ETJump::CHS_13_15},
     /*  14 */
     {CG_CHS_Distance_XY_Z_XYZ, "Distance XY Z XYZ",
-     "horizontal/vertical/true distance to plane"},
+     "horizontal/vertical/true distance to plane", CHS_PLAYER | CHS_VIEW,
+     ETJump::CHS_13_15},
     /*  15 */
     {CG_CHS_Distance_XY_Z_ViewXYZ, "Distance XY Z ViewXYZ",
-     "horizontal/vertical/true(view) distance to plane"},
-    /*  16 */ {CG_CHS_Look_XYZ, "Look XYZ", "world x y z location of plane"},
+     "horizontal/vertical/true(view) distance to plane", CHS_PLAYER | CHS_VIEW,
+     ETJump::CHS_13_15},
+    /*  16 */
+    {CG_CHS_Look_XYZ, "Look XYZ", "world x y z location of plane", CHS_VIEW,
+     ETJump::CHS_16},
     /*  17 */ {NULL}, // empty
     /*  18 */ {NULL}, // empty
     /*  19 */ {NULL}, // empty
 
-    /*  20 */ {CG_CHS_Speed_X, "Speed X", "speed along world x axis"},
-    /*  21 */ {CG_CHS_Speed_Y, "Speed Y", "speed along world y axis"},
-    /*  22 */ {CG_CHS_Speed_Z, "Speed Z", "speed along world z axis"},
-    /*  23 */ {CG_CHS_Speed_XY, "Speed XY", "horizontal speed"},
-    /*  24 */ {CG_CHS_Speed_XYZ, "Speed XYZ", "true speed"},
+    /*  20 */
+    {CG_CHS_Speed_X, "Speed X", "speed along world x axis", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  21 */
+    {CG_CHS_Speed_Y, "Speed Y", "speed along world y axis", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  22 */
+    {CG_CHS_Speed_Z, "Speed Z", "speed along world z axis", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  23 */
+    {CG_CHS_Speed_XY, "Speed XY", "horizontal speed", CHS_PLAYER, CHS_NO_TRACE},
+    /*  24 */
+    {CG_CHS_Speed_XYZ, "Speed XYZ", "true speed", CHS_PLAYER, CHS_NO_TRACE},
     /*  25 */
-    {CG_CHS_Speed_Forward, "Speed Forward", "speed relative to forward"},
+    {CG_CHS_Speed_Forward, "Speed Forward", "speed relative to forward",
+     CHS_PLAYER | CHS_VIEW, CHS_NO_TRACE},
     /*  26 */
-    {CG_CHS_Speed_Sideways, "Speed Sideways", "speed relative to side"},
+    {CG_CHS_Speed_Sideways, "Speed Sideways", "speed relative to side",
+     CHS_PLAYER | CHS_VIEW, CHS_NO_TRACE},
     /*  27 */
     {CG_CHS_Speed_Forward_Sideways, "Speed Forward Sideways",
-     "speed relative to forward/side"},
+     "speed relative to forward/side", CHS_PLAYER | CHS_VIEW, CHS_NO_TRACE},
     /*  28 */
     {CG_CHS_Speed_XY_Forward_Sideways, "Speed XY Forward Sideways",
-     "horizontal speed/speed relative to forward/side"},
+     "horizontal speed/speed relative to forward/side", CHS_PLAYER | CHS_VIEW,
+     CHS_NO_TRACE},
     /*  29 */ {NULL}, // empty
 
-    /*  30 */ {CG_CHS_Pitch, "Pitch", "player pitch"},
-    /*  31 */ {CG_CHS_Yaw, "Yaw", "player yaw"},
-    /*  32 */ {CG_CHS_Roll, "Roll", "player roll"},
-    /*  33 */ {CG_CHS_Position_X, "Position X", "player X position"},
-    /*  34 */ {CG_CHS_Position_Y, "Position Y", "player Y position"},
-    /*  35 */ {CG_CHS_Position_Z, "Position Z", "player Z position"},
-    /*  36 */ {CG_CHS_ViewPosition_X, "View Position X", "view X position"},
-    /*  37 */ {CG_CHS_ViewPosition_Y, "View Position Y", "view Y position"},
-    /*  38 */ {CG_CHS_ViewPosition_Z, "View Position Z", "view Z position"},
+    /*  30 */ {CG_CHS_Pitch, "Pitch", "player pitch", CHS_PLAYER, CHS_NO_TRACE},
+    /*  31 */ {CG_CHS_Yaw, "Yaw", "player yaw", CHS_PLAYER, CHS_NO_TRACE},
+    /*  32 */ {CG_CHS_Roll, "Roll", "player roll", CHS_PLAYER, CHS_NO_TRACE},
+    /*  33 */
+    {CG_CHS_Position_X, "Position X", "player X position", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  34 */
+    {CG_CHS_Position_Y, "Position Y", "player Y position", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  35 */
+    {CG_CHS_Position_Z, "Position Z", "player Z position", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  36 */
+    {CG_CHS_ViewPosition_X, "View Position X", "view X position", CHS_VIEW,
+     CHS_NO_TRACE},
+    /*  37 */
+    {CG_CHS_ViewPosition_Y, "View Position Y", "view Y position", CHS_VIEW,
+     CHS_NO_TRACE},
+    /*  38 */
+    {CG_CHS_ViewPosition_Z, "View Position Z", "view Z position", CHS_VIEW,
+     CHS_NO_TRACE},
     /*  39 */ {NULL}, // empty
 
-    /*  40 */ {CG_CHS_Pitch_Yaw, "Pitch Yaw", "player pitch/yaw"},
-    /*  41 */ {CG_CHS_Player_XYZ, "Player XYZ", "player position in the world"},
+    /*  40 */
+    {CG_CHS_Pitch_Yaw, "Pitch Yaw", "player pitch/yaw", CHS_PLAYER,
+     CHS_NO_TRACE},
+    /*  41 */
+    {CG_CHS_Player_XYZ, "Player XYZ", "player position in the world",
+     CHS_PLAYER, CHS_NO_TRACE},
     /*  42 */
     {CG_CHS_Player_XYZ_Pitch_Yaw, "Player XYZ Pitch Yaw",
-     "player position in the world and pitch/yaw"},
+     "player position in the world and pitch/yaw", CHS_PLAYER, CHS_NO_TRACE},
     /*  43 */
     {CG_CHS_ViewPosition_XYZ_Pitch_Yaw, "View Position XYZ Pitch Yaw",
-     "view position in the world and pitch/yaw"},
-    /*  44 */ {CG_CHS_Position_XYZ, "Position XYZ", "position x y z"},
+     "view position in the world and pitch/yaw", CHS_PLAYER | CHS_VIEW,
+     CHS_NO_TRACE},
+    /*  44 */
+    {CG_CHS_Position_XYZ, "Position XYZ", "position x y z", CHS_PLAYER,
+     CHS_NO_TRACE},
     /*  45 */
-    {CG_CHS_ViewPosition_XYZ, "View Position XYZ", "view position x y z"},
-    /*  46 */ {CG_CHS_Angles_XYZ, "Angles XYZ", "angles x y z"},
-    /*  47 */ {CG_CHS_Velocity_XYZ, "Velocity XYZ", "velocity x y z"},
+    {CG_CHS_ViewPosition_XYZ, "View Position XYZ", "view position x y z",
+     CHS_VIEW, CHS_NO_TRACE},
+    /*  46 */
+    {CG_CHS_Angles_XYZ, "Angles XYZ", "angles x y z", CHS_PLAYER, CHS_NO_TRACE},
+    /*  47 */
+    {CG_CHS_Velocity_XYZ, "Velocity XYZ", "velocity x y z", CHS_PLAYER,
+     CHS_NO_TRACE},
     /*  48 */ {NULL}, // empty
     /*  49 */ {NULL}, // empty
 
-    /*  50 */ {CG_CHS_LastJumpPosition_XYZ, "Jump XYZ", "jump x y z"},
+    /*  50 */
+    {CG_CHS_LastJumpPosition_XYZ, "Jump XYZ", "jump x y z", CHS_JUMP,
+     CHS_NO_TRACE},
     /*  51 */ {NULL}, // Reserved for possible Plane Angle X
     /*  52 */ {NULL}, // Reserved for possible Plane Angle Y
-    /*  53 */ {CG_CHS_PlaneAngleZ, "Plane Angle Z", "plane angle z"},
+    /*  53 */
+    {CG_CHS_PlaneAngleZ, "Plane Angle Z", "plane angle z", CHS_VIEW,
+     ETJump::CHS_53},
     /*  54 */ {NULL}, // Reserved for possible Plane Angle XYZ
-    /*  55 */ {CG_CHS_LastJumpSpeed, "Last Jump Speed", "last jump speed"},
+    /*  55 */
+    {CG_CHS_LastJumpSpeed, "Last Jump Speed", "last jump speed", CHS_PLAYER,
+     CHS_NO_TRACE},
 
     {NULL}};
 
+static bool CG_CHS_IsValidStat(int statNum) {
+  return statNum >= 0 &&
+         statNum < static_cast<int>(sizeof(stats) / sizeof(stats[0])) &&
+         stats[statNum].fun;
+}
+
 static void CG_CHS_GetName(char *buf, int size, int statNum) {
   if (!buf || size <= 0) {
     // no can do
@@ -488,9 +648,7 @@ static void CG_CHS_GetName(char *buf, int size, int statNum) {
   // always terminate the buffer
   buf[0] = '\0';
 
-  if (statNum < 0 ||
-      statNum >= static_cast<int>(sizeof(stats) / sizeof(stats[0])) ||
-      !stats[statNum].fun || !stats[statNum].name) {
+  if (!CG_CHS_IsValidStat(statNum) || !stats[statNum].name) {
     return;
   }
 
@@ -507,9 +665,7 @@ static void CG_CHS_GetValue(char *buf, int size, int statNum) {
   // always terminate the buffer
   buf[0] = '\0';
 
-  if (statNum < 0 ||
-      statNum >= static_cast<int>(sizeof(stats) / sizeof(stats[0])) ||
-      !stats[statNum].fun) {
+  if (!CG_CHS_IsValidStat(statNum)) {
     return;
   }
 
@@ -517,37 +673,70 @@ static void CG_CHS_GetValue(char *buf, int size, int statNum) {
   stats[statNum].fun(buf, size);
 }
 
-// XXX isn't similar enum defined somewhere else already?
-typedef enum { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT } align_t;
+// rebuilds the slot text and its size if the stat or any input it is
+// formatted from has changed since the slot was last built
+static void CG_CHS_UpdateSlot(chsSlot_t *slot, int stat, qboolean drawName) {
+  bool changed = !slot->valid || slot->stat != stat ||
+                 slot->drawName != drawName;
+  int traceGeneration = 0;
 
-static void CG_CHS_DrawSingleInfo(int x, int y, int stat, qboolean drawName,
-                                  align_t align) {
-  char buf[1024];
-  int l = 0;
-  int x_off, y_off;
+  if (CG_CHS_IsValidStat(stat)) {
+    const stat_t &s = stats[stat];
 
-  // alpha, shadow and color stuff
-  int textStyle = ITEM_TEXTSTYLE_NORMAL;
-  float textAlpha = etj_CHSAlpha.value;
-  vec4_t CHSColor = {1.f, 1.f, 1.f, 1.f};
+    for (int i = 0; i < CHS_NUM_DEPS; i++) {
+      if ((s.deps & (1 << i)) && slot->generation[i] != chs.generation[i]) {
+        changed = true;
+      }
+    }
 
-  if (etj_CHSShadow.integer > 0) {
-    textStyle = ITEM_TEXTSTYLE_SHADOWED;
+    if (s.trace != CHS_NO_TRACE) {
+      traceGeneration = CG_CHS_Trace(s.trace)->generation;
+      if (slot->traceGeneration != traceGeneration) {
+        changed = true;
+      }
+    }
   }
 
-  ETJump::parseColorString(etj_CHSColor.string, CHSColor);
+  if (!changed) {
+    return;
+  }
 
-  CHSColor[3] = Numeric::clamp(textAlpha, 0.0f, 1.0f);
-  // end alpha, shadow and color stuff
+  int l = 0;
 
   if (drawName) {
-    CG_CHS_GetName(buf, sizeof(buf), stat);
-    l = strlen(buf);
+    CG_CHS_GetName(slot->text, sizeof(slot->text), stat);
+    l = strlen(slot->text);
+  }
+  CG_CHS_GetValue(slot->text + l, sizeof(slot->text) - l, stat);
+
+  slot->width =
+      CG_Text_Width_Ext(slot->text, CHSCHAR_SIZEX, 0, &cgs.media.limboFont1);
+  slot->height =
+      CG_Text_Height_Ext(slot->text, CHSCHAR_SIZEY, 0, &cgs.media.limboFont1);
+
+  slot->valid = qtrue;
+  slot->stat = stat;
+  slot->drawName = drawName;
+  slot->traceGeneration = traceGeneration;
+  memcpy(slot->generation, chs.generation, sizeof(slot->generation));
+}
+
+// XXX isn't similar enum defined somewhere else already?
+typedef enum { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT } align_t;
+
+static void CG_CHS_DrawSingleInfo(int slotNum, int x, int y, int stat,
+                                  qboolean drawName, align_t align) {
+  chsSlot_t *slot = &chsSlots[slotNum];
+  int x_off, y_off;
+
+  CG_CHS_UpdateSlot(slot, stat, drawName);
+
+  if (!slot->text[0]) {
+    return;
   }
-  CG_CHS_GetValue(buf + l, sizeof(buf) - l, stat);
 
-  x_off = CG_Text_Width_Ext(buf, CHSCHAR_SIZEX, 0, &cgs.media.limboFont1);
-  y_off = CG_Text_Height_Ext(buf, CHSCHAR_SIZEY, 0, &cgs.media.limboFont1) / 2;
+  x_off = slot->width;
+  y_off = slot->height / 2;
   switch (align) {
     case ALIGN_LEFT:
       x_off = 0;
@@ -560,13 +749,20 @@ static void CG_CHS_DrawSingleInfo(int x, int y, int stat, qboolean drawName,
   }
 
   CG_Text_Paint_Ext(x - x_off, y + y_off, CHSCHAR_SIZEX, CHSCHAR_SIZEY,
-                    CHSColor, buf, 0, 0, textStyle, &cgs.media.limboFont1);
+                    chs.color, slot->text, 0, 0, chs.textStyle,
+                    &cgs.media.limboFont1);
 }
 
 void CG_DrawCHS(void) {
   int x, y;
   align_t CHS2Align = ALIGN_LEFT;
 
+  if (!etj_drawCHS1.integer && !etj_drawCHS2.integer) {
+    return;
+  }
+
+  CG_CHS_BeginFrame();
+
   // CHS1
   if (etj_drawCHS1.integer) {
     x = (SCREEN_WIDTH / 2) - 1;
@@ -577,20 +773,21 @@ void CG_DrawCHS(void) {
      *   6     4
      *      5
      */
-    CG_CHS_DrawSingleInfo(x, y - 20, etj_CHS1Info1.integer, qfalse,
+    CG_CHS_DrawSingleInfo(0, x, y - 20, etj_CHS1Info1.integer, qfalse,
                           ALIGN_CENTER);
-    CG_CHS_DrawSingleInfo(x + 10, y - 10, etj_CHS1Info2.integer, qfalse,
+    CG_CHS_DrawSingleInfo(1, x + 10, y - 10, etj_CHS1Info2.integer, qfalse,
+                          ALIGN_LEFT);
+    CG_CHS_DrawSingleInfo(2, x + 20, y, etj_CHS1Info3.integer, qfalse,
                           ALIGN_LEFT);
-    CG_CHS_DrawSingleInfo(x + 20, y, etj_CHS1Info3.integer, qfalse, ALIGN_LEFT);
-    CG_CHS_DrawSingleInfo(x + 10, y + 10, etj_CHS1Info4.integer, qfalse,
+    CG_CHS_DrawSingleInfo(3, x + 10, y + 10, etj_CHS1Info4.integer, qfalse,
                           ALIGN_LEFT);
-    CG_CHS_DrawSingleInfo(x, y + 20, etj_CHS1Info5.integer, qfalse,
+    CG_CHS_DrawSingleInfo(4, x, y + 20, etj_CHS1Info5.integer, qfalse,
                           ALIGN_CENTER);
-    CG_CHS_DrawSingleInfo(x - 10, y + 10, etj_CHS1Info6.integer, qfalse,
+    CG_CHS_DrawSingleInfo(5, x - 10, y + 10, etj_CHS1Info6.integer, qfalse,
                           ALIGN_RIGHT);
-    CG_CHS_DrawSingleInfo(x - 20, y, etj_CHS1Info7.integer, qfalse,
+    CG_CHS_DrawSingleInfo(6, x - 20, y, etj_CHS1Info7.integer, qfalse,
                           ALIGN_RIGHT);
-    CG_CHS_DrawSingleInfo(x - 10, y - 10, etj_CHS1Info8.integer, qfalse,
+    CG_CHS_DrawSingleInfo(7, x - 10, y - 10, etj_CHS1Info8.integer, qfalse,
                           ALIGN_RIGHT);
   }
 
@@ -605,14 +802,21 @@ void CG_DrawCHS(void) {
       x = SCREEN_WIDTH - 30 + chs2OffsetX;
     }
 
-    CG_CHS_DrawSingleInfo(x, y + 0, etj_CHS2Info1.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 10, etj_CHS2Info2.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 20, etj_CHS2Info3.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 30, etj_CHS2Info4.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 40, etj_CHS2Info5.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 50, etj_CHS2Info6.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 60, etj_CHS2Info7.integer, qtrue, CHS2Align);
-    CG_CHS_DrawSingleInfo(x, y + 70, etj_CHS2Info8.integer, qtrue, CHS2Align);
+    CG_CHS_DrawSingleInfo(8, x, y + 0, etj_CHS2Info1.integer, qtrue, CHS2Align);
+    CG_CHS_DrawSingleInfo(9, x, y + 10, etj_CHS2Info2.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(10, x, y + 20, etj_CHS2Info3.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(11, x, y + 30, etj_CHS2Info4.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(12, x, y + 40, etj_CHS2Info5.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(13, x, y + 50, etj_CHS2Info6.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(14, x, y + 60, etj_CHS2Info7.integer, qtrue,
+                          CHS2Align);
+    CG_CHS_DrawSingleInfo(15, x, y + 70, etj_CHS2Info8.integer, qtrue,
+                          CHS2Align);
   }
 }
 
@@ -37,7 +37,7 @@ ETJump::ClientAuthentication::ClientAuthentication(
       _serverCommandsHandler(serverCommandsHandler), GUID_FILE("etguid.dat") {
   _serverCommandsHandler->subscribe(
       Constants::Authentication::GUID_REQUEST,
-      [&](const std::vector<std::string> &args) { login(); });
+      [&](const CommandArguments &args) { login(); });
 }
 
 ETJump::ClientAuthentication::~ClientAuthentication() {
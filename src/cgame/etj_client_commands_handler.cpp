@@ -23,7 +23,6 @@
  */
 
 #include "etj_client_commands_handler.h"
-#include "../game/etj_string_utilities.h"
 
 ETJump::ClientCommandsHandler::ClientCommandsHandler(
     void (*addToAutocompleteList)(const char *))
@@ -33,10 +32,9 @@ ETJump::ClientCommandsHandler::ClientCommandsHandler(
 
 ETJump::ClientCommandsHandler::~ClientCommandsHandler() {}
 
-bool ETJump::ClientCommandsHandler::check(
-    const std::string &command, const std::vector<std::string> &arguments) {
-  auto lowercasedCommand = ETJump::StringUtil::toLowerCase(command);
-  auto match = _callbacks.find(lowercasedCommand);
+bool ETJump::ClientCommandsHandler::check(const std::string &command,
+                                          const CommandArguments &arguments) {
+  auto match = _callbacks.find(command);
   if (match != end(_callbacks)) {
     match->second(arguments);
     return true;
@@ -44,16 +42,25 @@ bool ETJump::ClientCommandsHandler::check(
   return false;
 }
 
-bool ETJump::ClientCommandsHandler::subscribe(
-    const std::string &command,
-    std::function<void(const std::vector<std::string> &)> callback,
-    bool autocomplete) {
-  auto lowercasedCommand = ETJump::StringUtil::toLowerCase(command);
-  if (_callbacks.find(lowercasedCommand) != end(_callbacks)) {
+bool ETJump::ClientCommandsHandler::check(
+    const std::string &command, const std::vector<std::string> &arguments) {
+  std::vector<const char *> tokens;
+  tokens.reserve(arguments.size());
+  for (const auto &argument : arguments) {
+    tokens.push_back(argument.c_str());
+  }
+
+  return check(command, CommandArguments(tokens.data(), tokens.size()));
+}
+
+bool ETJump::ClientCommandsHandler::subscribe(const std::string &command,
+                                              Callback callback,
+                                              bool autocomplete) {
+  if (_callbacks.find(command) != end(_callbacks)) {
     return false;
   }
 
-  _callbacks[lowercasedCommand] = callback;
+  _callbacks[command] = std::move(callback);
   if (_addToAutocompleteList != nullptr && autocomplete) {
     _addToAutocompleteList(command.c_str());
   }
@@ -61,9 +68,8 @@ bool ETJump::ClientCommandsHandler::subscribe(
 }
 
 bool ETJump::ClientCommandsHandler::unsubscribe(const std::string &command) {
-  auto lowercasedCommand = ETJump::StringUtil::toLowerCase(command);
-  auto callback = _callbacks.find(lowercasedCommand);
-  if (callback != end(_callbacks)) {
+  auto callback = _callbacks.find(command);
+  if (callback == end(_callbacks)) {
     return false;
   }
 
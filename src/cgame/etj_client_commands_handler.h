@@ -25,25 +25,54 @@
 #pragma once
 #include <string>
 #include <functional>
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
+#include "../game/etj_string_utilities.h"
+
 namespace ETJump {
+// non-owning view of the arguments of a command, the tokens
+// must outlive the callback the view is passed to
+class CommandArguments {
+public:
+  CommandArguments() = default;
+  CommandArguments(const char *const *tokens, size_t count)
+      : _tokens{tokens}, _count{count} {}
+
+  size_t size() const { return _count; }
+  bool empty() const { return _count == 0; }
+  const char *operator[](size_t index) const { return _tokens[index]; }
+
+  const char *const *begin() const { return _tokens; }
+  const char *const *end() const { return _tokens + _count; }
+
+  // copies the arguments for callers that need to keep them
+  std::vector<std::string> toVector() const {
+    return std::vector<std::string>(begin(), end());
+  }
+
+private:
+  const char *const *_tokens = nullptr;
+  size_t _count = 0;
+};
+
 class ClientCommandsHandler {
 public:
+  using Callback = std::function<void(const CommandArguments &)>;
+
   explicit ClientCommandsHandler(void(const char *));
   ~ClientCommandsHandler();
 
   // returns true if a match was found and function was called
+  bool check(const std::string &command, const CommandArguments &arguments);
   bool check(const std::string &command,
              const std::vector<std::string> &arguments);
 
   // registers a command handler that will be called if the command was
   // received from the server returns false if handler with the same
   // name already exists
-  bool subscribe(const std::string &command,
-                 std::function<void(const std::vector<std::string> &)> callback,
+  bool subscribe(const std::string &command, Callback callback,
                  bool autocomplete = true);
 
   // unsubscribes the command handler
@@ -53,7 +82,10 @@ public:
 private:
   void (*_addToAutocompleteList)(const char *command);
 
-  std::map<std::string, std::function<void(std::vector<std::string>)>>
+  // commands are matched case-insensitively without lowercasing
+  // the received command first
+  std::unordered_map<std::string, Callback, StringUtil::CaseInsensitiveHash,
+                     StringUtil::CaseInsensitiveEqual>
       _callbacks;
 };
 } // namespace ETJump
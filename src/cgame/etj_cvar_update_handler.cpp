@@ -29,28 +29,42 @@ ETJump::CvarUpdateHandler::CvarUpdateHandler() { callbacks.clear(); }
 ETJump::CvarUpdateHandler::~CvarUpdateHandler() {}
 
 bool ETJump::CvarUpdateHandler::check(const vmCvar_t *cvar) {
-  auto match = callbacks.find(cvar->handle);
-  if (match != end(callbacks)) {
-    for (const auto &callback : match->second) {
-      callback(cvar);
-    }
-    return true;
+  if (cvar->handle < 0 ||
+      cvar->handle >= static_cast<int>(callbacks.size())) {
+    return false;
+  }
+
+  const auto &subscribers = callbacks[cvar->handle];
+  if (subscribers.empty()) {
+    return false;
+  }
+
+  for (const auto &callback : subscribers) {
+    callback(cvar);
   }
-  return false;
+  return true;
 }
 
 bool ETJump::CvarUpdateHandler::subscribe(
     const vmCvar_t *target,
     const std::function<void(const vmCvar_t *cvar)> &callback) {
+  if (target->handle < 0) {
+    return false;
+  }
+
+  if (target->handle >= static_cast<int>(callbacks.size())) {
+    callbacks.resize(target->handle + 1);
+  }
   callbacks[target->handle].push_back(callback);
   return true;
 }
 
 bool ETJump::CvarUpdateHandler::unsubscribe(const vmCvar_t *target) {
-  auto callback = callbacks.find(target->handle);
-  if (callback != end(callbacks)) {
+  if (target->handle < 0 ||
+      target->handle >= static_cast<int>(callbacks.size()) ||
+      callbacks[target->handle].empty()) {
     return false;
   }
-  callbacks.erase(callback);
+  callbacks[target->handle].clear();
   return true;
 }
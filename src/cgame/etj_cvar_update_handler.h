@@ -35,12 +35,12 @@
 
 #include <string>
 #include <functional>
-#include <map>
 #include <vector>
 
 namespace ETJump {
 class CvarUpdateHandler {
-  std::map<int, std::vector<std::function<void(const vmCvar_t *)>>> callbacks;
+  // indexed by cvar handle, handles are small sequential engine slots
+  std::vector<std::vector<std::function<void(const vmCvar_t *)>>> callbacks;
 
 public:
   CvarUpdateHandler();
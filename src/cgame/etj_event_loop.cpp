@@ -22,143 +22,243 @@
  * SOFTWARE.
  */
 
+
 #include <algorithm>
-#include <chrono>
-#include "cg_local.h"
+#include <climits>
 #include "etj_event_loop.h"
 
-using std::find_if;
-using std::remove_if;
-using std::chrono::duration_cast;
-using std::chrono::milliseconds;
-using std::chrono::system_clock;
+namespace {
+const int MAX_SLOTS = 0xFFFF;
+} // namespace
+
+bool ETJump::EventLoop::runsLater(const HeapNode &lhs, const HeapNode &rhs) {
+  if (lhs.end != rhs.end) {
+    return lhs.end > rhs.end;
+  }
+  if (lhs.priority != rhs.priority) {
+    return lhs.priority > rhs.priority;
+  }
+  return lhs.sequence > rhs.sequence;
+}
+
+ETJump::EventLoop::EventLoop(std::function<int64_t()> clock)
+    : clock(std::move(clock)) {}
 
 void ETJump::EventLoop::run() {
-  processEvents();
-  cleanUpEvents();
+  if (heap.empty()) {
+    return;
+  }
+
+  const auto now = getNow();
+  isExecutingEvents = true;
+
+  while (!heap.empty()) {
+    const HeapNode node = heap.front();
+    if (node.end > now) {
+      break;
+    }
+
+    std::pop_heap(heap.begin(), heap.end(), runsLater);
+    heap.pop_back();
+
+    Task &task = slots[node.slot];
+    if (!task.active || task.id != node.id) {
+      staleNodes--;
+      continue;
+    }
+
+    // move the callback out so the task can safely unschedule itself
+    auto fn = std::move(task.fn);
+    const auto id = task.id;
+
+    if (task.persistent) {
+      pushNode(node.slot, now + task.delay, task.priority);
+    } else {
+      releaseSlot(node.slot);
+    }
+
+    fn();
+
+    Task &current = slots[node.slot];
+    if (current.active && current.id == id) {
+      current.fn = std::move(fn);
+    }
+  }
+
+  isExecutingEvents = false;
+
+  // tasks (re)scheduled while running wait for the next run, otherwise
+  // zero delay intervals would never yield and an immediate task adding
+  // itself back would starve everything else due at the same time
+  for (const auto &node : deferred) {
+    heap.push_back(node);
+    std::push_heap(heap.begin(), heap.end(), runsLater);
+  }
+  deferred.clear();
+
+  if (staleNodes > static_cast<int>(heap.size()) / 2) {
+    compactHeap();
+  }
 }
 
-int ETJump::EventLoop::schedule(function<void()> fn, int delay,
+int ETJump::EventLoop::schedule(std::function<void()> fn, int delay,
                                 TaskPriorities priority) {
-  Task task{fn, ++eventCounter, delay, getNow() + delay, false, false};
-  return scheduleEvent(task, priority);
+  return scheduleEvent(std::move(fn), delay, false, priority);
 }
 
-int ETJump::EventLoop::schedulePersistent(function<void()> fn, int delay,
+int ETJump::EventLoop::schedulePersistent(std::function<void()> fn, int delay,
                                           TaskPriorities priority) {
-  Task task{fn, ++eventCounter, delay, getNow() + delay, true, false};
-  return scheduleEvent(task, priority);
+  return scheduleEvent(std::move(fn), delay, true, priority);
 }
 
 bool ETJump::EventLoop::unschedule(int taskId) {
-  // auto predicate = [&taskId](const Task &task) { return task.id ==
-  // taskId; }; for (auto *storage : { &ordinaryTasks, &importantTasks
-  // }) {
-  //	auto it = find_if(storage->begin(), storage->end(), predicate);
-  //	if (it != storage->end()) {
-  //		if (isExecutingEvents) it->deprecated = true; //
-  // postpone
-  // removal; let event processing handle it 		else
-  // storage->erase(it); return true;
-  //	}
-  // }
-  // return false;
-
-  Task *task = findTask(taskId);
-  if (task) {
-    task->deprecated = true; // let event processing handle removal
-    return true;
-  }
-  return false;
+  int slot;
+  if (!findTask(taskId, slot)) {
+    return false;
+  }
+
+  // heap node is left behind and skipped once it surfaces
+  releaseSlot(slot);
+  staleNodes++;
+
+  if (!isExecutingEvents && staleNodes > static_cast<int>(heap.size()) / 2) {
+    compactHeap();
+  }
+  return true;
 }
 
 void ETJump::EventLoop::shutdown() {
-  removeEventsIf([&](Task const &task) {
-    if (!task.deprecated)
-      task.fn();
-    return true;
-  });
-}
+  std::vector<int> pending;
+  for (int i = 0; i < static_cast<int>(slots.size()); i++) {
+    if (slots[i].active) {
+      pending.push_back(i);
+    }
+  }
 
-bool ETJump::EventLoop::hasPendingEvents() {
-  return !ordinaryTasks.empty() || !importantTasks.empty();
-}
+  for (const auto slot : pending) {
+    auto fn = std::move(slots[slot].fn);
+    if (fn) {
+      fn();
+    }
+  }
 
-int ETJump::EventLoop::pendingEventsCount() {
-  return ordinaryTasks.empty() + importantTasks.size();
+  slots.clear();
+  freeSlots.clear();
+  heap.clear();
+  deferred.clear();
+  handles.clear();
+  activeTasks = 0;
+  staleNodes = 0;
 }
 
-void ETJump::EventLoop::processEvents() {
-  if (!importantTasks.size() && !ordinaryTasks.size())
-    return;
+bool ETJump::EventLoop::hasPendingEvents() { return activeTasks > 0; }
 
-  auto now = getNow();
-  vector<Task *> queue;
-  isExecutingEvents = true;
-  iterateEvents([&](Task &task) {
-    if (!task.deprecated && now >= task.end)
-      queue.push_back(&task);
-  });
+int ETJump::EventLoop::pendingEventsCount() { return activeTasks; }
 
-  for (auto *task : queue) {
-    if (task->persistent)
-      task->end = now + task->delay; // reschedule
-    task->fn();
+int ETJump::EventLoop::scheduleEvent(std::function<void()> fn, int delay,
+                                     bool persistent,
+                                     TaskPriorities priority) {
+  int slot;
+  if (!freeSlots.empty()) {
+    slot = freeSlots.back();
+    freeSlots.pop_back();
+  } else {
+    if (static_cast<int>(slots.size()) >= MAX_SLOTS) {
+      return 0;
+    }
+    slot = static_cast<int>(slots.size());
+    slots.push_back(Task{nullptr, 0, 0, TaskPriorities::Default, false, false});
   }
 
-  isExecutingEvents = false;
-}
+  Task &task = slots[slot];
+  task.fn = std::move(fn);
+  task.id = nextId();
+  task.delay = delay;
+  task.priority = priority;
+  task.persistent = persistent;
+  task.active = true;
+  activeTasks++;
+  handles[task.id] = slot;
 
-int ETJump::EventLoop::scheduleEvent(const Task &task,
-                                     TaskPriorities priority) {
-  if (priority == TaskPriorities::Default)
-    ordinaryTasks.push_back(task);
-  else if (priority == TaskPriorities::Immediate)
-    importantTasks.push_back(task);
-  return eventCounter;
+  pushNode(slot, getNow() + delay, priority);
+  return task.id;
 }
 
-void ETJump::EventLoop::iterateEvents(function<void(Task &task)> fn) {
-  for (auto *storage : {&importantTasks, &ordinaryTasks}) {
-    for_each(storage->begin(), storage->end(), [&](Task &task) { fn(task); });
+void ETJump::EventLoop::pushNode(int slot, int64_t end,
+                                 TaskPriorities priority) {
+  const int rank = priority == TaskPriorities::Immediate ? 0 : 1;
+  const HeapNode node{end, rank, sequenceCounter++, slot, slots[slot].id};
+
+  if (isExecutingEvents) {
+    deferred.push_back(node);
+    return;
   }
+
+  heap.push_back(node);
+  std::push_heap(heap.begin(), heap.end(), runsLater);
 }
 
-void ETJump::EventLoop::cleanUpEvents() {
-  auto now = getNow();
-  removeEventsIf([&](Task &task) {
-    if (task.deprecated)
-      return true;
-    if (!task.persistent && now >= task.end)
-      return true;
-    return false;
-  });
+void ETJump::EventLoop::releaseSlot(int slot) {
+  Task &task = slots[slot];
+  handles.erase(task.id);
+  task.fn = nullptr;
+  task.id = 0;
+  task.active = false;
+  activeTasks--;
+  freeSlots.push_back(slot);
 }
 
-void ETJump::EventLoop::removeEventsIf(function<bool(Task &task)> fn) {
-  for (auto *storage : {&importantTasks, &ordinaryTasks}) {
-    auto removeIter = remove_if(storage->begin(), storage->end(),
-                                [&](Task &task) { return fn(task); });
-    storage->erase(removeIter, storage->end());
-  }
+void ETJump::EventLoop::compactHeap() {
+  heap.erase(std::remove_if(heap.begin(), heap.end(),
+                            [this](const HeapNode &node) {
+                              const Task &task = slots[node.slot];
+                              return !task.active || task.id != node.id;
+                            }),
+             heap.end());
+  std::make_heap(heap.begin(), heap.end(), runsLater);
+  staleNodes = 0;
 }
 
-ETJump::EventLoop::Task *ETJump::EventLoop::findTask(int taskId) {
-  auto predicate = [&taskId](const Task &task) { return task.id == taskId; };
-  for (auto *storage : {&ordinaryTasks, &importantTasks}) {
-    auto it = find_if(storage->begin(), storage->end(), predicate);
-    if (it != storage->end())
-      return &*it;
+ETJump::EventLoop::Task *ETJump::EventLoop::findTask(int taskId, int &slot) {
+  const auto it = handles.find(taskId);
+  if (it == handles.end()) {
+    return nullptr;
   }
-  return nullptr;
+
+  slot = it->second;
+  return &slots[slot];
 }
 
-int64_t ETJump::EventLoop::getNow() { return static_cast<int64_t>(cg.time); }
+int ETJump::EventLoop::nextId() {
+  // ids only repeat after 2^31 tasks, and never while the old one is live
+  do {
+    idCounter = idCounter == INT_MAX ? 1 : idCounter + 1;
+  } while (handles.count(idCounter));
+
+  return idCounter;
+}
+
+int64_t ETJump::EventLoop::getNow() { return clock(); }
 
 void ETJump::EventLoop::execute(int taskId) {
-  Task *target = findTask(taskId);
-  if (target) {
-    target->end = 0;
-    target->fn();
+  int slot;
+  Task *target = findTask(taskId, slot);
+  if (!target || !target->fn) {
+    return;
+  }
+
+  auto fn = std::move(target->fn);
+  const auto id = target->id;
+
+  if (!target->persistent) {
+    releaseSlot(slot);
+    staleNodes++;
+  }
+
+  fn();
+
+  Task &current = slots[slot];
+  if (current.active && current.id == id) {
+    current.fn = std::move(fn);
   }
 }
@@ -22,8 +22,14 @@
  * SOFTWARE.
  */
 
+
 /*
         Single threaded(non thread safe) ordered task scheduler.
+
+        Tasks are kept in a slot pool and ordered by a binary min-heap
+        on their due time. Handles are increasing 31-bit ids mapped to
+        their slot, so cancelling is O(1) and stale heap nodes are
+        skipped lazily.
 */
 #pragma once
 
@@ -35,36 +41,56 @@
 #endif
 
 #include <functional>
+#include <deque>
+#include <unordered_map>
 #include <vector>
 #include <cstdint>
 
-using std::function;
-using std::vector;
-
 namespace ETJump {
 enum class TaskPriorities { Default, Immediate };
 
 class EventLoop {
   struct Task {
-    function<void()> fn;
+    std::function<void()> fn;
     int id;
     int delay;
-    int64_t end;
+    TaskPriorities priority;
     bool persistent;
-    bool deprecated;
+    bool active;
+  };
+
+  struct HeapNode {
+    int64_t end;
+    // immediate tasks run before default ones due at the same time
+    int priority;
+    // insertion order, keeps same time tasks FIFO
+    uint32_t sequence;
+    int slot;
+    int id;
   };
-  vector<Task> ordinaryTasks;
-  vector<Task> importantTasks;
-  int eventCounter = 0;
+
+  // deque so references stay valid when tasks schedule new tasks
+  std::deque<Task> slots;
+  std::vector<int> freeSlots;
+  std::vector<HeapNode> heap;
+  // nodes pushed while running, added to the heap once the run is over
+  std::vector<HeapNode> deferred;
+  std::unordered_map<int, int> handles;
+  int idCounter = 0;
+  int activeTasks = 0;
+  int staleNodes = 0;
+  uint32_t sequenceCounter = 0;
   bool isExecutingEvents = false;
+  std::function<int64_t()> clock;
 
 public:
-  EventLoop(){};
+  // clock returns the current time in milliseconds
+  explicit EventLoop(std::function<int64_t()> clock);
   ~EventLoop(){};
   void run();
-  int schedule(function<void()> fn, int delay,
+  int schedule(std::function<void()> fn, int delay,
                TaskPriorities priority = TaskPriorities::Default);
-  int schedulePersistent(function<void()> fn, int delay,
+  int schedulePersistent(std::function<void()> fn, int delay,
                          TaskPriorities priority = TaskPriorities::Default);
   bool unschedule(int taskId);
   void shutdown();
@@ -73,12 +99,15 @@ public:
   void execute(int taskId); // nasty little helper to execute non
                             // persistent tasks beforehand
 private:
-  void processEvents();
-  int scheduleEvent(const Task &task, TaskPriorities priority);
-  void cleanUpEvents();
-  void iterateEvents(function<void(Task &task)> fn);
-  void removeEventsIf(function<bool(Task &task)> fn);
-  Task *findTask(int taskId);
+  int scheduleEvent(std::function<void()> fn, int delay, bool persistent,
+                    TaskPriorities priority);
+  void pushNode(int slot, int64_t end, TaskPriorities priority);
+  void releaseSlot(int slot);
+  void compactHeap();
+  Task *findTask(int taskId, int &slot);
+  int nextId();
   int64_t getNow();
+
+  static bool runsLater(const HeapNode &lhs, const HeapNode &rhs);
 };
 } // namespace ETJump
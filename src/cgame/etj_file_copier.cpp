@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "etj_file_copier.h"
+#include "etj_utilities.h"
+#include "../game/etj_filesystem.h"
+
+ETJump::FileCopier::FileCopier(std::string src, std::string dst,
+                               int bytesPerFrame, ProgressCallback onProgress,
+                               CompletionCallback onComplete)
+    : src(std::move(src)), dst(std::move(dst)),
+      bytesPerFrame(bytesPerFrame > 0 ? bytesPerFrame : 1),
+      onProgress(std::move(onProgress)), onComplete(std::move(onComplete)) {}
+
+ETJump::FileCopier::~FileCopier() {
+  // the event loop is being torn down (e.g. map change) while copying.
+  // Finishing here would copy the rest in one frame during shutdown, so
+  // the copy is abandoned and the truncated file removed. No callbacks
+  // fire since the module is going away.
+  if (!done) {
+    removePartialCopy();
+  }
+}
+
+bool ETJump::FileCopier::start() {
+  if (src == dst) {
+    complete(true);
+    return true;
+  }
+
+  try {
+    srcFile = std::unique_ptr<File>(new File(src, File::Mode::Read));
+    dstFile = std::unique_ptr<File>(new File(dst, File::Mode::Write));
+  } catch (const File::FileNotFoundException &) {
+    complete(false);
+    return false;
+  } catch (const File::WriteFailedException &) {
+    complete(false);
+    return false;
+  } catch (const std::logic_error &) {
+    complete(false);
+    return false;
+  }
+
+  buffer.resize(bytesPerFrame);
+
+  // the event loop owns the copier until it's done
+  auto self = shared_from_this();
+  intervalHandle = setInterval([self] { self->copyChunk(); }, 0);
+  return true;
+}
+
+bool ETJump::FileCopier::isDone() const { return done; }
+
+int ETJump::FileCopier::bytesCopied() const { return copiedBytes; }
+
+int ETJump::FileCopier::totalBytes() const {
+  return srcFile ? srcFile->length() : 0;
+}
+
+void ETJump::FileCopier::copyChunk() {
+  if (done) {
+    return;
+  }
+
+  int bytesRead;
+  try {
+    bytesRead = srcFile->read(buffer.data(), bytesPerFrame);
+    if (bytesRead > 0) {
+      dstFile->write(buffer.data(), bytesRead);
+    }
+  } catch (const File::WriteFailedException &) {
+    complete(false);
+    return;
+  } catch (const std::logic_error &) {
+    complete(false);
+    return;
+  }
+
+  if (bytesRead > 0) {
+    copiedBytes += bytesRead;
+
+    if (onProgress) {
+      onProgress(copiedBytes, totalBytes());
+    }
+  }
+
+  if (bytesRead < bytesPerFrame) {
+    complete(true);
+  }
+}
+
+void ETJump::FileCopier::removePartialCopy() {
+  // only remove the destination if this copier created it, a copy that
+  // failed to open the source leaves an existing file alone
+  if (!dstFile) {
+    return;
+  }
+
+  dstFile = nullptr;
+  FileSystem::remove(dst);
+}
+
+void ETJump::FileCopier::complete(bool success) {
+  done = true;
+
+  if (intervalHandle) {
+    clearInterval(intervalHandle);
+    intervalHandle = 0;
+  }
+
+  if (success) {
+    // close handles before notifying so the file is fully flushed
+    dstFile = nullptr;
+  } else {
+    removePartialCopy();
+  }
+  srcFile = nullptr;
+  std::vector<char>().swap(buffer);
+
+  if (onComplete) {
+    onComplete(success);
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../game/etj_file.h"
+
+namespace ETJump {
+// Copies a file in fixed size chunks spread across frames using the
+// event loop, so large files (e.g. demos) don't cause hitches and peak
+// memory use doesn't scale with the file size.
+class FileCopier : public std::enable_shared_from_this<FileCopier> {
+public:
+  // called after each chunk with bytes copied so far and total bytes
+  using ProgressCallback = std::function<void(int copied, int total)>;
+  // called once the copy is done, or failed to start or to write. A
+  // failed copy leaves nothing behind at the destination.
+  using CompletionCallback = std::function<void(bool success)>;
+
+private:
+  void copyChunk();
+  void complete(bool success);
+  // closes and deletes the destination if it was opened
+  void removePartialCopy();
+
+  std::string src;
+  std::string dst;
+  int bytesPerFrame;
+  ProgressCallback onProgress;
+  CompletionCallback onComplete;
+
+  std::unique_ptr<File> srcFile;
+  std::unique_ptr<File> dstFile;
+  std::vector<char> buffer;
+  int copiedBytes{0};
+  int intervalHandle{0};
+  bool done{false};
+
+public:
+  FileCopier(std::string src, std::string dst, int bytesPerFrame,
+             ProgressCallback onProgress, CompletionCallback onComplete);
+  ~FileCopier();
+
+  // opens the files and schedules the copy, returns false if the
+  // source file could not be opened
+  bool start();
+
+  bool isDone() const;
+  int bytesCopied() const;
+  int totalBytes() const;
+};
+} // namespace ETJump
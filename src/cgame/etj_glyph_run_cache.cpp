@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "etj_glyph_run_cache.h"
+
+ETJump::GlyphRunCache::GlyphRunCache(size_t capacity)
+    : capacity(std::max(capacity, static_cast<size_t>(1))) {}
+
+void ETJump::GlyphRunCache::build(GlyphRun &run, const char *text,
+                                  float scalex, float scaley, float adjust,
+                                  int limit, const fontInfo_t *font) {
+  run.quads.clear();
+  run.spans.clear();
+  run.spans.push_back({0, -1});
+
+  int len = static_cast<int>(strlen(text));
+  if (limit > 0 && len > limit) {
+    len = limit;
+  }
+
+  const char *s = text;
+  float x = 0;
+  int count = 0;
+
+  while (*s && count < len) {
+    if (Q_IsColorString(s)) {
+      const int colorIndex = *(s + 1) == COLOR_NULL ? -1 : ColorIndex(*(s + 1));
+      const int nextQuad = static_cast<int>(run.quads.size());
+
+      // consecutive color codes, only the last one matters
+      if (run.spans.back().firstQuad == nextQuad) {
+        run.spans.back().colorIndex = colorIndex;
+      } else {
+        run.spans.push_back({nextQuad, colorIndex});
+      }
+
+      s += 2;
+      continue;
+    }
+
+    const glyphInfo_t &glyph = font->glyphs[static_cast<unsigned char>(*s)];
+
+    run.quads.push_back({x + glyph.pitch * scalex, -scaley * glyph.top,
+                         glyph.imageWidth * scalex, glyph.imageHeight * scaley,
+                         glyph.s, glyph.t, glyph.s2, glyph.t2, glyph.glyph});
+
+    x += glyph.xSkip * scalex + adjust;
+    s++;
+    count++;
+  }
+
+  // trailing color codes don't color anything
+  if (run.spans.size() > 1 &&
+      run.spans.back().firstQuad == static_cast<int>(run.quads.size())) {
+    run.spans.pop_back();
+  }
+}
+
+const ETJump::GlyphRunCache::GlyphRun &
+ETJump::GlyphRunCache::get(const char *text, float scalex, float scaley,
+                           float adjust, int limit, const fontInfo_t *font) {
+  // text can't contain a null, so the parameters appended after it
+  // can never be confused with the text itself
+  keyBuffer.assign(text);
+  keyBuffer.push_back('\0');
+  keyBuffer.append(reinterpret_cast<const char *>(&font), sizeof(font));
+  keyBuffer.append(reinterpret_cast<const char *>(&scalex), sizeof(scalex));
+  keyBuffer.append(reinterpret_cast<const char *>(&scaley), sizeof(scaley));
+  keyBuffer.append(reinterpret_cast<const char *>(&adjust), sizeof(adjust));
+  keyBuffer.append(reinterpret_cast<const char *>(&limit), sizeof(limit));
+
+  const auto it = lookup.find(keyBuffer);
+
+  if (it != lookup.end()) {
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->run;
+  }
+
+  misses++;
+
+  if (entries.size() >= capacity) {
+    // rebuild the least recently used entry in place,
+    // so its buffers get reused
+    lookup.erase(entries.back().key);
+    entries.splice(entries.begin(), entries, std::prev(entries.end()));
+  } else {
+    entries.emplace_front();
+  }
+
+  Entry &entry = entries.front();
+  entry.key = keyBuffer;
+  build(entry.run, text, scalex, scaley, adjust, limit, font);
+  lookup.emplace(entry.key, entries.begin());
+
+  return entry.run;
+}
+
+void ETJump::GlyphRunCache::clear() {
+  entries.clear();
+  lookup.clear();
+}
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+        Cache of laid out text.
+
+        Maps a string drawn with a given font, scale, spacing and
+        character limit to the glyph quads it produces and the color
+        spans set by its color codes. HUD strings rarely change between
+        frames, so drawing them becomes a loop over ready-made quads
+        without any parsing. Any change to the text or its parameters
+        is a different key, old entries are evicted least recently
+        used first.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../game/q_shared.h"
+
+namespace ETJump {
+class GlyphRunCache {
+public:
+  struct Quad {
+    // relative to the draw position, in virtual screen units
+    float x, y, w, h;
+    float s, t, s2, t2;
+    qhandle_t shader;
+  };
+
+  struct ColorSpan {
+    // first quad drawn in this color, spans run until the next one
+    int firstQuad;
+    // index into g_color_table, or -1 for the color passed in by the caller
+    int colorIndex;
+  };
+
+  struct GlyphRun {
+    std::vector<Quad> quads;
+    std::vector<ColorSpan> spans;
+  };
+
+private:
+  struct Entry {
+    std::string key;
+    GlyphRun run;
+  };
+
+  size_t capacity;
+  // most recently used first
+  std::list<Entry> entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> lookup;
+  // reused so lookups don't allocate
+  std::string keyBuffer;
+  int hits = 0;
+  int misses = 0;
+
+  static void build(GlyphRun &run, const char *text, float scalex,
+                    float scaley, float adjust, int limit,
+                    const fontInfo_t *font);
+
+public:
+  explicit GlyphRunCache(size_t capacity = 512);
+
+  // 'scalex' and 'scaley' are expected to include the font's glyphScale
+  const GlyphRun &get(const char *text, float scalex, float scaley,
+                      float adjust, int limit, const fontInfo_t *font);
+
+  void clear();
+
+  int size() const { return static_cast<int>(entries.size()); }
+  int hitCount() const { return hits; }
+  int missCount() const { return misses; }
+};
+} // namespace ETJump
@@ -55,6 +55,7 @@
 #include "etj_spectatorinfo_drawable.h"
 #include "etj_crosshair.h"
 #include "etj_overbounce_detector.h"
+#include "etj_overbounce_shared.h"
 #include "etj_rtv_drawable.h"
 #include "etj_client_rtv_handler.h"
 #include "etj_areaindicator_drawable.h"
@@ -63,6 +64,8 @@
 #include "etj_accel_color.h"
 #include "etj_utilities.h"
 #include "etj_player_bbox.h"
+#include "etj_profiler.h"
+#include "etj_profiler_drawable.h"
 
 namespace ETJump {
 std::shared_ptr<ClientCommandsHandler> serverCommandsHandler;
@@ -88,6 +91,11 @@ std::shared_ptr<DemoCompatibility> demoCompatibility;
 std::shared_ptr<AccelColor> accelColor;
 std::array<bool, MAX_CLIENTS> tempTraceIgnoredClients;
 std::shared_ptr<PlayerBBox> playerBBox;
+std::shared_ptr<Profiler> profiler;
+std::vector<int> renderableProfilerSections;
+TextProfilerCounters textProfilerCounters;
+PredictionProfilerCounters predictionProfilerCounters;
+std::shared_ptr<Crosshair> crosshair;
 } // namespace ETJump
 
 static bool isInitialized{false};
@@ -182,6 +190,15 @@ bool showingScores() {
   return (cg.showScores || cg.scoreFadeTime + FADE_TIME > cg.time);
 }
 
+// ~2 seconds of history at 125fps
+static const int PROFILER_HISTORY_FRAMES = 256;
+
+static void addRenderable(const std::string &name,
+                          std::shared_ptr<IRenderable> renderable) {
+  renderables.push_back(std::move(renderable));
+  renderableProfilerSections.push_back(profiler->addSection(name));
+}
+
 void init() {
 
   CG_Printf(S_COLOR_LTGREY GAME_HEADER);
@@ -199,6 +216,15 @@ void init() {
   // they're still being used in the C code
   // => make sure they're created first
   serverCommandsHandler = std::make_shared<ClientCommandsHandler>(nullptr);
+  CG_InitServerCommands();
+  serverCommandsHandler->subscribe(
+      "timerun",
+      [](const CommandArguments &args) {
+        std::vector<std::string> command{"timerun"};
+        command.insert(command.end(), args.begin(), args.end());
+        timerun->parseServerCommand(command);
+      },
+      false);
   consoleCommandsHandler =
       std::make_shared<ClientCommandsHandler>(trap_AddCommand);
   entityEventsHandler = std::make_shared<EntityEventsHandler>();
@@ -215,12 +241,13 @@ void init() {
   awaitedCommandHandler = std::make_shared<AwaitedCommandHandler>(
       consoleCommandsHandler, trap_SendConsoleCommand,
       [](const char *text) { Com_Printf(text); });
-  eventLoop = std::make_shared<ETJump::EventLoop>();
+  eventLoop = std::make_shared<ETJump::EventLoop>(
+      [] { return static_cast<int64_t>(cg.time); });
 
   ////////////////////////////////////////////////////////////////
   // TODO: move these to own client commands handler
   ////////////////////////////////////////////////////////////////
-  auto minimize = [](const std::vector<std::string> &args) {
+  auto minimize = [](const CommandArguments &args) {
     operatingSystem->minimize();
   };
   consoleCommandsHandler->subscribe("min", minimize);
@@ -235,45 +262,68 @@ void init() {
 
   playerBBox = std::make_shared<PlayerBBox>();
 
+  profiler = std::make_shared<Profiler>(PROFILER_HISTORY_FRAMES);
+  textProfilerCounters.drawCalls = profiler->addCounter("text draw calls");
+  textProfilerCounters.colorChanges =
+      profiler->addCounter("text color changes");
+  textProfilerCounters.cacheMisses = profiler->addCounter("text cache misses");
+  predictionProfilerCounters.predicted =
+      profiler->addCounter("predicted commands");
+  predictionProfilerCounters.playedBack =
+      profiler->addCounter("played back commands");
+  predictionProfilerCounters.backupHits =
+      profiler->addCounter("prediction backup hits");
+  predictionProfilerCounters.backupMisses =
+      profiler->addCounter("prediction backup misses");
+
   // initialize renderables
+  Overbounce::clearTraces();
   // Overbounce watcher
-  ETJump::renderables.push_back(
-      std::make_shared<OverbounceWatcher>(consoleCommandsHandler.get()));
-  ETJump::renderables.push_back(std::make_shared<OverbounceDetector>());
+  addRenderable("overbounce watcher", std::make_shared<OverbounceWatcher>(
+                                          consoleCommandsHandler.get()));
+  addRenderable("overbounce detector", std::make_shared<OverbounceDetector>());
   // Display max speed from previous load session
-  ETJump::renderables.push_back(
-      std::make_shared<DisplayMaxSpeed>(ETJump::entityEventsHandler.get()));
-  ETJump::renderables.push_back(std::make_shared<DrawSpeed>());
-  ETJump::renderables.push_back(std::make_shared<AccelMeter>());
-  ETJump::renderables.push_back(std::make_shared<StrafeQuality>());
-  ETJump::renderables.push_back(
-      std::make_shared<JumpSpeeds>(ETJump::entityEventsHandler.get()));
-  ETJump::renderables.push_back(std::make_shared<QuickFollowDrawer>());
-  ETJump::renderables.push_back(std::make_shared<SpectatorInfo>());
-  ETJump::renderables.push_back(std::make_shared<AreaIndicator>());
+  addRenderable("max speed", std::make_shared<DisplayMaxSpeed>(
+                                 ETJump::entityEventsHandler.get()));
+  addRenderable("speed", std::make_shared<DrawSpeed>());
+  addRenderable("accel meter", std::make_shared<AccelMeter>());
+  addRenderable("strafe quality", std::make_shared<StrafeQuality>());
+  addRenderable("jump speeds", std::make_shared<JumpSpeeds>(
+                                   ETJump::entityEventsHandler.get()));
+  addRenderable("quick follow", std::make_shared<QuickFollowDrawer>());
+  addRenderable("spectator info", std::make_shared<SpectatorInfo>());
+  addRenderable("area indicator", std::make_shared<AreaIndicator>());
 
   if (etj_CGazOnTop.integer) {
-    ETJump::renderables.push_back(std::make_shared<Snaphud>());
-    ETJump::renderables.push_back(std::make_shared<CGaz>());
+    addRenderable("snaphud", std::make_shared<Snaphud>());
+    addRenderable("cgaz", std::make_shared<CGaz>());
   } else {
-    ETJump::renderables.push_back(std::make_shared<CGaz>());
-    ETJump::renderables.push_back(std::make_shared<Snaphud>());
+    addRenderable("cgaz", std::make_shared<CGaz>());
+    addRenderable("snaphud", std::make_shared<Snaphud>());
   }
 
-  ETJump::renderables.push_back(std::make_shared<UpperRight>());
-  ETJump::renderables.push_back(std::make_shared<UpmoveMeter>());
+  addRenderable("upper right", std::make_shared<UpperRight>());
+  addRenderable("upmove meter", std::make_shared<UpmoveMeter>());
 
-  ETJump::renderables.push_back(std::make_shared<RtvDrawable>());
+  addRenderable("rtv", std::make_shared<RtvDrawable>());
 
   ETJump::consoleAlphaHandler = std::make_shared<ETJump::ConsoleAlphaHandler>();
   ETJump::drawLeavesHandler = std::make_shared<ETJump::DrawLeavesHandler>();
   auto keySetSystem = new ETJump::KeySetSystem(etj_drawKeys);
-  ETJump::renderables.push_back(
-      std::shared_ptr<ETJump::IRenderable>(keySetSystem));
+  addRenderable("keys", std::shared_ptr<ETJump::IRenderable>(keySetSystem));
   ETJump::initDrawKeys(keySetSystem);
   ETJump::autoDemoRecorder = std::make_shared<ETJump::AutoDemoRecorder>();
 
-  ETJump::renderables.push_back(std::make_shared<Crosshair>());
+  crosshair = std::make_shared<Crosshair>();
+  addRenderable("crosshair", crosshair);
+
+  auto profilerDrawable = std::make_shared<ProfilerDrawable>(profiler.get());
+  addRenderable("profiler", profilerDrawable);
+  consoleCommandsHandler->subscribe(
+      "profiler_dump",
+      [profilerDrawable](const CommandArguments &args) {
+        profilerDrawable->dump();
+      });
 
   const std::vector<std::pair<const vmCvar_t *, const std::string>> cvars{
       {&etj_drawFoliage, "r_drawfoliage"},
@@ -360,11 +410,17 @@ void shutdown() {
   if (ETJump::consoleCommandsHandler) {
     ETJump::consoleCommandsHandler->unsubscribe("min");
     ETJump::consoleCommandsHandler->unsubscribe("minimize");
+    ETJump::consoleCommandsHandler->unsubscribe("profiler_dump");
   }
 
   ETJump::operatingSystem = nullptr;
   ETJump::authentication = nullptr;
   ETJump::renderables.clear();
+  ETJump::renderableProfilerSections.clear();
+  ETJump::textProfilerCounters = {};
+  ETJump::predictionProfilerCounters = {};
+  ETJump::crosshair = nullptr;
+  ETJump::profiler = nullptr;
   ETJump::cvarShadows.clear();
   ETJump::cvarUpdateHandler = nullptr;
 
@@ -388,40 +444,6 @@ void shutdown() {
 }
 } // namespace ETJump
 
-/**
- * Extended CG_ServerCommand function. Checks whether server
- * sent command matches to any defined here. If no match is found
- * returns false
- * @return qboolean Whether a match was found or not
- */
-qboolean CG_ServerCommandExt(const char *cmd) {
-  const std::string command = cmd != nullptr ? cmd : "";
-
-  if (command == "timerun") {
-    char arg[MAX_TOKEN_CHARS]{};
-    std::vector<std::string> args;
-
-    for (int i = 0, len = trap_Argc(); i < len; ++i) {
-      trap_Argv(i, arg, sizeof(arg));
-
-      args.push_back(arg);
-    }
-
-    ETJump::timerun->parseServerCommand(args);
-    return qtrue;
-  }
-
-  if (command == "tjl_displaybyname") {
-    return CG_displaybyname();
-  }
-
-  if (command == "tjl_displaybynumber") {
-    return CG_displaybynumber();
-  }
-
-  return qfalse;
-}
-
 /**
  * Checks if the command exists and calls the handler
  * @param cmd The command to be matched
@@ -30,7 +30,6 @@
  * returns false
  * @return qboolean Whether a match was found or not
  */
-qboolean CG_ServerCommandExt(const char *cmd);
 qboolean CG_ConsoleCommandExt(const char *cmd);
 void CG_DrawActiveFrameExt();
 
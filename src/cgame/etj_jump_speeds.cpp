@@ -32,10 +32,10 @@ JumpSpeeds::JumpSpeeds(EntityEventsHandler *entityEventsHandler)
     : _entityEventsHandler{entityEventsHandler} {
   serverCommandsHandler->subscribe(
       "resetJumpSpeeds",
-      [&](const std::vector<std::string> &args) { queueJumpSpeedsReset(); });
+      [&](const CommandArguments &args) { queueJumpSpeedsReset(); });
   consoleCommandsHandler->subscribe(
       "resetJumpSpeeds",
-      [&](const std::vector<std::string> &args) { queueJumpSpeedsReset(); });
+      [&](const CommandArguments &args) { queueJumpSpeedsReset(); });
   entityEventsHandler->subscribe(EV_JUMP,
                                  [&](centity_t *cent) { updateJumpSpeeds(); });
   playerEventsHandler->subscribe(
@@ -53,11 +53,8 @@ bool OverbounceDetector::beforeRender() {
     // below ob
     VectorCopy(ps->origin, start);
     start[2] = startHeight;
-    VectorCopy(start, end);
-    end[2] -= Overbounce::MAX_TRACE_DIST;
 
-    CG_Trace(&trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
-             traceContents);
+    Overbounce::groundTrace(&trace, start, ps->clientNum, traceContents);
 
     if (trace.fraction != 1.0 && trace.plane.type == 2) {
       // something was hit and it's a floor
@@ -76,8 +73,7 @@ bool OverbounceDetector::beforeRender() {
   VectorCopy(cg.refdef.vieworg, start);
   VectorMA(start, Overbounce::MAX_TRACE_DIST, cg.refdef.viewaxis[0], end);
 
-  CG_Trace(&trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
-           traceContents);
+  Overbounce::trace(&trace, start, end, ps->clientNum, traceContents);
 
   if (trace.fraction != 1.0 && trace.plane.type == 2) {
     // something was hit and it's a floor
@@ -23,8 +23,18 @@
  */
 
 #include "etj_overbounce_shared.h"
+#include "etj_trace_cache.h"
 
 namespace ETJump {
+// only the world half of CG_Trace is cached, movers and players are
+// interpolated again every render frame and clipped against per call
+static TraceCache overbounceTraces(
+    [](trace_t *result, const vec3_t start, const vec3_t end, int skipNumber,
+       int contents) {
+      CG_Trace_World(result, start, vec3_origin, vec3_origin, end, skipNumber,
+                     contents);
+    });
+
 bool Overbounce::isOverbounce(float zVel, float startHeight, float endHeight,
                               float zVelSnapped, float pmoveSec, int gravity) {
   float a, b, c, discriminant;
@@ -75,4 +85,25 @@ bool Overbounce::surfaceAllowsOverbounce(trace_t *trace) {
     return (trace->surfaceFlags & SURF_OVERBOUNCE) == 0;
   }
 }
+
+void Overbounce::clearTraces() { overbounceTraces.clear(); }
+
+void Overbounce::trace(trace_t *result, const vec3_t start, const vec3_t end,
+                       int skipNumber, int contents) {
+  overbounceTraces.trace(result, start, end, skipNumber, contents);
+  CG_ClipTraceToEntities(result, start, vec3_origin, vec3_origin, end,
+                         skipNumber, contents);
+}
+
+void Overbounce::groundTrace(trace_t *result, const vec3_t start,
+                             int skipNumber, int contents) {
+  overbounceTraces.groundTrace(result, start, MAX_TRACE_DIST, groundEpsilon,
+                               skipNumber, contents);
+
+  vec3_t end;
+  VectorCopy(start, end);
+  end[2] -= MAX_TRACE_DIST;
+  CG_ClipTraceToEntities(result, start, vec3_origin, vec3_origin, end,
+                         skipNumber, contents);
+}
 } // namespace ETJump
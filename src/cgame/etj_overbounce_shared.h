@@ -33,7 +33,23 @@ public:
                            float zVelSnapped, float pmoveSec, int gravity);
   static bool surfaceAllowsOverbounce(trace_t *trace);
 
+  // CG_Trace with the world part shared between the overbounce detector
+  // and watcher across frames. Movers and other players are clipped
+  // against on every call.
+  static void trace(trace_t *result, const vec3_t start, const vec3_t end,
+                    int skipNumber, int contents);
+
+  // drops the cached world traces of the previous map
+  static void clearTraces();
+
+  // traces MAX_TRACE_DIST straight down from start. A cached ground hit
+  // is reused while start stays within groundEpsilon of it horizontally
+  // and lies on the segment that was already traced above the ground.
+  static void groundTrace(trace_t *result, const vec3_t start, int skipNumber,
+                          int contents);
+
   static constexpr float stickyOffset = 0.25f;
   static constexpr int MAX_TRACE_DIST = MAX_MAP_SIZE * 2;
+  static constexpr float groundEpsilon = 0.01f;
 };
 } // namespace ETJump
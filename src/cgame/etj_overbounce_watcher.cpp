@@ -44,7 +44,7 @@ OverbounceWatcher::OverbounceWatcher(
   _positions.clear();
 
   clientCommandsHandler->subscribe(
-      "ob_save", [&](const std::vector<std::string> &args) {
+      "ob_save", [&](const CommandArguments &args) {
         vec3_t c;
         ps = getValidPlayerState();
         for (int i = 0; i < 3; ++i) {
@@ -63,7 +63,7 @@ OverbounceWatcher::OverbounceWatcher(
       });
 
   clientCommandsHandler->subscribe(
-      "ob_load", [&](const std::vector<std::string> &args) {
+      "ob_load", [&](const CommandArguments &args) {
         const auto &name = !args.empty() ? sanitize(args[0], true) : "default";
         if (!load(name)) {
           CG_AddPMItem(PM_MESSAGE,
@@ -81,7 +81,7 @@ OverbounceWatcher::OverbounceWatcher(
       });
 
   clientCommandsHandler->subscribe(
-      "ob_reset", [&](const std::vector<std::string> &args) {
+      "ob_reset", [&](const CommandArguments &args) {
         reset();
         CG_AddPMItem(PM_MESSAGE,
                      "^3OB watcher: ^7current coordinates have been reset.\n",
@@ -89,7 +89,7 @@ OverbounceWatcher::OverbounceWatcher(
       });
 
   clientCommandsHandler->subscribe(
-      "ob_list", [&](const std::vector<std::string> &args) {
+      "ob_list", [&](const CommandArguments &args) {
         if (_positions.empty()) {
           CG_Printf("^3OB watcher: ^7no saved positions.\n");
           return;
@@ -141,11 +141,8 @@ bool OverbounceWatcher::beforeRender() {
   trace_t trace;
   VectorCopy(*_current, start);
   start[2] = startHeight;
-  VectorCopy(start, end);
-  end[2] -= Overbounce::MAX_TRACE_DIST;
 
-  CG_Trace(&trace, start, vec3_origin, vec3_origin, end, ps->clientNum,
-           CONTENTS_SOLID);
+  Overbounce::groundTrace(&trace, start, ps->clientNum, CONTENTS_SOLID);
 
   // CG_Printf("startHeight: %f endHeight: %f\n", startHeight, endHeight);
   if (Overbounce::isOverbounce(zVel, startHeight, endHeight, zVelSnapped,
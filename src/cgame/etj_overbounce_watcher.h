@@ -67,7 +67,7 @@ private:
   float zVel{}, zVelSnapped{};
 
   float startHeight{}, endHeight{};
-  vec3_t start{}, end{};
+  vec3_t start{};
   vec3_t snap{};
 
   int gravity{};
@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "etj_particle_pool.h"
+
+ETJump::ParticlePool::ParticlePool(int capacity)
+    : capacity(std::max(capacity, 0)) {
+  forEachArray([this](auto &array) { array.resize(this->capacity); });
+}
+
+int ETJump::ParticlePool::alloc() {
+  if (count >= capacity) {
+    return -1;
+  }
+
+  return count++;
+}
+
+int ETJump::ParticlePool::remove(int index) {
+  const int last = --count;
+
+  if (index != last) {
+    forEachArray([index, last](auto &array) { array[index] = array[last]; });
+  }
+
+  return last;
+}
+
+void ETJump::ParticlePool::integrate(float time) {
+  // plain pointers and no branches, so the compiler can vectorize this
+  const float *sTime = spawnTime.data();
+  const float *eTime = endTime.data();
+  const float *ox = orgX.data();
+  const float *oy = orgY.data();
+  const float *oz = orgZ.data();
+  const float *vx = velX.data();
+  const float *vy = velY.data();
+  const float *vz = velZ.data();
+  const float *ax = accelX.data();
+  const float *ay = accelY.data();
+  const float *az = accelZ.data();
+  const float *a = alpha.data();
+  const float *av = alphaVel.data();
+  const uint8_t *expiring = expires.data();
+  float *px = posX.data();
+  float *py = posY.data();
+  float *pz = posZ.data();
+  float *ca = currentAlpha.data();
+  uint8_t *d = dead.data();
+
+  for (int i = 0; i < count; i++) {
+    const float t = (time - sTime[i]) * 0.001f;
+    const float t2 = t * t;
+
+    px[i] = ox[i] + vx[i] * t + ax[i] * t2;
+    py[i] = oy[i] + vy[i] * t + ay[i] * t2;
+    pz[i] = oz[i] + vz[i] * t + az[i] * t2;
+
+    const float fade = a[i] + t * av[i];
+    ca[i] = std::min(fade, 1.0f);
+    d[i] = static_cast<uint8_t>((fade <= 0.0f) |
+                                (expiring[i] & (time > eTime[i])));
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+        Structure of arrays storage for particle motion.
+
+        Every live particle occupies one slot in [0, size()), slots are
+        kept dense by moving the last particle into a removed slot, so
+        integrate() can run over flat float arrays without chasing
+        pointers or skipping free entries.
+
+        Positions are integrated analytically from the spawn state,
+        pos = org + vel * t + accel * t^2, with t in seconds since
+        spawnTime, the same way the original particle code did.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace ETJump {
+class ParticlePool {
+  int capacity;
+  int count = 0;
+
+public:
+  explicit ParticlePool(int capacity);
+
+  // spawn state, times are in milliseconds
+  std::vector<float> spawnTime;
+  std::vector<float> endTime;
+  std::vector<float> orgX, orgY, orgZ;
+  std::vector<float> velX, velY, velZ;
+  std::vector<float> accelX, accelY, accelZ;
+  std::vector<float> alpha;
+  std::vector<float> alphaVel;
+  // non-zero if the particle dies once endTime has passed
+  std::vector<uint8_t> expires;
+
+  // written by integrate()
+  std::vector<float> posX, posY, posZ;
+  // clamped to 1
+  std::vector<float> currentAlpha;
+  std::vector<uint8_t> dead;
+
+  // calls fn(array) for every per particle array above, anything that
+  // touches a whole particle goes through this so no field is missed
+  template <typename Fn> void forEachArray(Fn &&fn) {
+    fn(spawnTime);
+    fn(endTime);
+    fn(orgX);
+    fn(orgY);
+    fn(orgZ);
+    fn(velX);
+    fn(velY);
+    fn(velZ);
+    fn(accelX);
+    fn(accelY);
+    fn(accelZ);
+    fn(alpha);
+    fn(alphaVel);
+    fn(expires);
+    fn(posX);
+    fn(posY);
+    fn(posZ);
+    fn(currentAlpha);
+    fn(dead);
+  }
+
+  void clear() { count = 0; }
+
+  // returns the index of a new slot, or -1 if the pool is full
+  int alloc();
+
+  // moves the last particle into 'index' and returns the slot it was
+  // moved from, so callers can move any data they keep alongside
+  int remove(int index);
+
+  // computes position, alpha and whether each particle is dead at 'time'
+  void integrate(float time);
+
+  int size() const { return count; }
+  int getCapacity() const { return capacity; }
+};
+} // namespace ETJump
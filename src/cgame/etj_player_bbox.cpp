@@ -100,22 +100,65 @@ void PlayerBBox::drawBBox(clientInfo_t *ci, centity_t *cent) {
     }
   }
 
+  // skip boxes outside of the view
+  vec3_t center;
+  VectorAdd(box.mins, box.maxs, center);
+  VectorMA(cent->lerpOrigin, 0.5f, center, center);
+  const float radius = 0.5f * Distance(box.mins, box.maxs);
+
+  if (CG_CullPointAndRadius(center, radius)) {
+    return;
+  }
+
+  BoxGeometry &geo = geometry[cent->currentState.clientNum];
+  const bool bottom = bottomOnly(pType);
+
+  if (!geo.valid || geo.bottomOnly != bottom ||
+      !VectorCompare(geo.origin, cent->lerpOrigin) ||
+      !VectorCompare(geo.mins, box.mins) ||
+      !VectorCompare(geo.maxs, box.maxs)) {
+    buildGeometry(geo, cent->lerpOrigin, box, bottom);
+  }
+
   // setup colors for polygon vertices
-  for (auto &vert : box.verts) {
-    for (int i = 0; i < 4; i++) {
-      vert.modulate[i] = static_cast<byte>(box.color[i] * 255);
+  byte modulate[4];
+  for (int i = 0; i < 4; i++) {
+    modulate[i] = static_cast<byte>(box.color[i] * 255);
+  }
+
+  for (int i = 0; i < geo.numPolys * 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      geo.verts[i].modulate[j] = modulate[j];
     }
   }
 
-  // set the texture coordinates
-  box.verts[0].st[0] = 0;
-  box.verts[0].st[1] = 0;
-  box.verts[1].st[0] = 0;
-  box.verts[1].st[1] = 1;
-  box.verts[2].st[0] = 1;
-  box.verts[2].st[1] = 1;
-  box.verts[3].st[0] = 1;
-  box.verts[3].st[1] = 0;
+  for (int i = 0; i < geo.numPolys; i++) {
+    polys.add(shader, 4, &geo.verts[i * 4]);
+  }
+}
+
+void PlayerBBox::addToScene() {
+  polys.flush([](qhandle_t polyShader, int numVerts, const polyVert_t *verts,
+                 int numPolys) {
+    trap_R_AddPolysToScene(polyShader, numVerts, verts, numPolys);
+  });
+}
+
+void PlayerBBox::buildGeometry(BoxGeometry &geo, const vec3_t origin,
+                               const BBox &box, bool bottom) {
+  // corner indices of each face, bottom face first so that
+  // it's the only one built for bottom only boxes
+  static const int faces[MAX_BOX_FACES][4] = {
+      {0, 1, 2, 3}, // bottom
+      {7, 6, 5, 4}, // top
+      {3, 2, 6, 7}, // origin -> Y
+      {2, 1, 5, 6}, // origin -> X
+      {0, 3, 7, 4}, // origin -> -X
+      {1, 0, 4, 5}, // origin -> -Y
+  };
+
+  // texture coordinates of face corners
+  static const float st[4][2] = {{0, 0}, {0, 1}, {1, 1}, {1, 0}};
 
   vec3_t corners[8];
   // layout for bbox corners
@@ -129,7 +172,7 @@ void PlayerBBox::drawBBox(clientInfo_t *ci, centity_t *cent) {
   //           |/      |/
   //           1 ----- 2
 
-  VectorAdd(cent->lerpOrigin, box.mins, corners[0]);
+  VectorAdd(origin, box.mins, corners[0]);
 
   // push bottom corners away from origin
   VectorCopy(corners[0], corners[1]);
@@ -141,58 +184,28 @@ void PlayerBBox::drawBBox(clientInfo_t *ci, centity_t *cent) {
   VectorCopy(corners[2], corners[3]);
   corners[3][0] -= box.maxs[0] - box.mins[0];
 
-  // bottom
-  VectorCopy(corners[0], box.verts[0].xyz);
-  VectorCopy(corners[1], box.verts[1].xyz);
-  VectorCopy(corners[2], box.verts[2].xyz);
-  VectorCopy(corners[3], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
-
-  // skip the rest if we only draw bottom for this player
-  if (bottomOnly(pType)) {
-    return;
-  }
-
   // push top corners to the bbox top
   for (int i = 0; i < 4; ++i) {
     VectorCopy(corners[i], corners[i + 4]);
     corners[i + 4][2] += box.maxs[2] - box.mins[2];
   }
 
-  // top
-  VectorCopy(corners[7], box.verts[0].xyz);
-  VectorCopy(corners[6], box.verts[1].xyz);
-  VectorCopy(corners[5], box.verts[2].xyz);
-  VectorCopy(corners[4], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
-
-  // origin -> Y
-  VectorCopy(corners[3], box.verts[0].xyz);
-  VectorCopy(corners[2], box.verts[1].xyz);
-  VectorCopy(corners[6], box.verts[2].xyz);
-  VectorCopy(corners[7], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
-
-  // origin -> X
-  VectorCopy(corners[2], box.verts[0].xyz);
-  VectorCopy(corners[1], box.verts[1].xyz);
-  VectorCopy(corners[5], box.verts[2].xyz);
-  VectorCopy(corners[6], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
-
-  // origin -> -X
-  VectorCopy(corners[0], box.verts[0].xyz);
-  VectorCopy(corners[3], box.verts[1].xyz);
-  VectorCopy(corners[7], box.verts[2].xyz);
-  VectorCopy(corners[4], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
-
-  // origin -> -Y
-  VectorCopy(corners[1], box.verts[0].xyz);
-  VectorCopy(corners[0], box.verts[1].xyz);
-  VectorCopy(corners[4], box.verts[2].xyz);
-  VectorCopy(corners[5], box.verts[3].xyz);
-  trap_R_AddPolyToScene(shader, 4, box.verts);
+  geo.numPolys = bottom ? 1 : MAX_BOX_FACES;
+
+  for (int i = 0; i < geo.numPolys; i++) {
+    for (int j = 0; j < 4; j++) {
+      polyVert_t &vert = geo.verts[i * 4 + j];
+      VectorCopy(corners[faces[i][j]], vert.xyz);
+      vert.st[0] = st[j][0];
+      vert.st[1] = st[j][1];
+    }
+  }
+
+  VectorCopy(origin, geo.origin);
+  VectorCopy(box.mins, geo.mins);
+  VectorCopy(box.maxs, geo.maxs);
+  geo.bottomOnly = bottom;
+  geo.valid = true;
 }
 
 void PlayerBBox::setupBBoxExtents(centity_t *cent, BBox &box) {
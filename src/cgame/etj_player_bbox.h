@@ -24,15 +24,30 @@
 
 #pragma once
 
+#include "etj_poly_batcher.h"
+
 namespace ETJump {
 class PlayerBBox {
   struct BBox {
     vec3_t mins{};
     vec3_t maxs{};
-    polyVert_t verts[4]{};
     vec4_t color{};
   };
 
+  static constexpr int MAX_BOX_FACES = 6;
+
+  // faces of a player's box, only rebuilt when the box moves
+  // or changes shape, colors are refreshed every frame
+  struct BoxGeometry {
+    bool valid = false;
+    bool bottomOnly = false;
+    vec3_t origin{};
+    vec3_t mins{};
+    vec3_t maxs{};
+    int numPolys = 0;
+    polyVert_t verts[MAX_BOX_FACES * 4]{};
+  };
+
   enum class DrawFlags {
     Self = 1,
     Others = 2,
@@ -50,6 +65,10 @@ class PlayerBBox {
   vec4_t colorOther{};
   vec4_t colorFireteam{};
 
+  BoxGeometry geometry[MAX_CLIENTS];
+  // faces of all boxes drawn this frame, submitted in addToScene
+  PolyBatcher polys;
+
   // there's no real easy way to determine these for other players,
   // both crouch and prone use ps.crouchMaxZ for maxs[2] but it's calculated
   // differently based off stance, and since the result is not stored
@@ -60,12 +79,16 @@ class PlayerBBox {
   static constexpr int PRONE_MAXS_OFFSET_Z = 32;
 
   static void setupBBoxExtents(centity_t *cent, BBox &box);
+  static void buildGeometry(BoxGeometry &geo, const vec3_t origin,
+                            const BBox &box, bool bottom);
   static bool bottomOnly(const int &pType);
   static void setBBoxAlpha(centity_t *cent, BBox &box);
   bool canSkipDraw(centity_t *cent, clientInfo_t *ci) const;
 
 public:
   void drawBBox(clientInfo_t *ci, centity_t *cent);
+  // submits the boxes drawn this frame to the scene
+  void addToScene();
 
   PlayerBBox();
   ~PlayerBBox() = default;
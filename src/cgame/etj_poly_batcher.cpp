@@ -0,0 +1,69 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+
+#include "etj_poly_batcher.h"
+
+ETJump::PolyBatcher::PolyBatcher(int maxPolysPerRun)
+    : maxPolysPerRun(std::max(maxPolysPerRun, 1)) {}
+
+void ETJump::PolyBatcher::add(qhandle_t shader, int numVerts,
+                              const polyVert_t *polyVerts) {
+  polys.push_back({shader, numVerts, static_cast<int>(verts.size())});
+  verts.insert(verts.end(), polyVerts, polyVerts + numVerts);
+}
+
+void ETJump::PolyBatcher::buildRuns() {
+  runs.clear();
+  sortedVerts.clear();
+  order.resize(polys.size());
+
+  for (size_t i = 0; i < polys.size(); i++) {
+    order[i] = static_cast<int>(i);
+  }
+
+  std::stable_sort(order.begin(), order.end(), [this](int lhs, int rhs) {
+    if (polys[lhs].shader != polys[rhs].shader) {
+      return polys[lhs].shader < polys[rhs].shader;
+    }
+    return polys[lhs].numVerts < polys[rhs].numVerts;
+  });
+
+  for (const auto index : order) {
+    const Poly &poly = polys[index];
+
+    if (runs.empty() || runs.back().shader != poly.shader ||
+        runs.back().numVerts != poly.numVerts ||
+        runs.back().numPolys == maxPolysPerRun) {
+      runs.push_back({poly.shader, poly.numVerts,
+                      static_cast<int>(sortedVerts.size()), 0});
+    }
+
+    sortedVerts.insert(sortedVerts.end(), verts.begin() + poly.firstVert,
+                       verts.begin() + poly.firstVert + poly.numVerts);
+    runs.back().numPolys++;
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+        Collects polygons during a frame and submits them grouped by
+        shader and vertex count, so a frame with many polygons sharing
+        a shader costs a handful of trap_R_AddPolysToScene calls instead
+        of one trap_R_AddPolyToScene per polygon.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <vector>
+
+#include "../game/q_shared.h"
+#include "tr_types.h"
+
+namespace ETJump {
+class PolyBatcher {
+  struct Poly {
+    qhandle_t shader;
+    int numVerts;
+    int firstVert;
+  };
+
+  struct Run {
+    qhandle_t shader;
+    int numVerts;
+    int firstVert;
+    int numPolys;
+  };
+
+  int maxPolysPerRun;
+  std::vector<Poly> polys;
+  std::vector<polyVert_t> verts;
+  std::vector<int> order;
+  std::vector<polyVert_t> sortedVerts;
+  std::vector<Run> runs;
+
+  void buildRuns();
+
+public:
+  // runs are split at 'maxPolysPerRun' polygons so a single run
+  // can't exhaust the renderer's poly buffer on its own
+  explicit PolyBatcher(int maxPolysPerRun = 256);
+
+  void add(qhandle_t shader, int numVerts, const polyVert_t *polyVerts);
+
+  // calls submit(shader, numVerts, verts, numPolys) for each run of
+  // polygons sharing a shader and vertex count, keeping the order the
+  // polygons were added in within a run, then clears the batch
+  template <typename Submit> void flush(Submit &&submit) {
+    buildRuns();
+
+    for (const auto &run : runs) {
+      submit(run.shader, run.numVerts, &sortedVerts[run.firstVert],
+             run.numPolys);
+    }
+
+    polys.clear();
+    verts.clear();
+  }
+
+  int size() const { return static_cast<int>(polys.size()); }
+};
+} // namespace ETJump
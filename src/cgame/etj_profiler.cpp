@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+
+#include "etj_profiler.h"
+
+ETJump::Profiler::Profiler(int historySize)
+    : historySize(std::max(historySize, 1)) {
+  addSection("frame");
+  addSection("prediction");
+  addSection("pmove");
+  addSection("packet entities");
+  addSection("particles");
+  addSection("local entities");
+  addSection("2D");
+}
+
+int ETJump::Profiler::addSection(const std::string &name) {
+  names.push_back(name);
+  counters.push_back(false);
+  current.push_back(0);
+  samples.resize(names.size() * historySize, 0);
+  return static_cast<int>(names.size()) - 1;
+}
+
+int ETJump::Profiler::addCounter(const std::string &name) {
+  const int id = addSection(name);
+  counters[id] = true;
+  return id;
+}
+
+void ETJump::Profiler::beginFrame(bool enabled) {
+  if (enabled && !active) {
+    std::fill(samples.begin(), samples.end(), 0);
+    head = 0;
+    frames = 0;
+  }
+
+  active = enabled;
+  std::fill(current.begin(), current.end(), 0);
+}
+
+void ETJump::Profiler::endFrame() {
+  if (!active) {
+    return;
+  }
+
+  for (size_t i = 0; i < current.size(); i++) {
+    samples[i * historySize + head] = static_cast<int32_t>(current[i]);
+  }
+
+  head = (head + 1) % historySize;
+  frames = std::min(frames + 1, historySize);
+}
+
+void ETJump::Profiler::add(int section, int64_t microseconds) {
+  if (!active || section < 0 || section >= sectionCount()) {
+    return;
+  }
+
+  current[section] += microseconds;
+}
+
+std::vector<ETJump::Profiler::Stats> ETJump::Profiler::getStats() const {
+  std::vector<Stats> stats;
+  stats.reserve(names.size());
+
+  const int lastSlot = (head + historySize - 1) % historySize;
+
+  for (size_t i = 0; i < names.size(); i++) {
+    const int32_t *history = &samples[i * historySize];
+    Stats s{names[i], 0.0, 0, 0, counters[i]};
+
+    if (frames > 0) {
+      int64_t total = 0;
+
+      // the ring is only partially filled until it wraps,
+      // but unfilled slots are zero and don't affect the max
+      for (int frame = 0; frame < historySize; frame++) {
+        total += history[frame];
+        s.max = std::max(s.max, static_cast<int>(history[frame]));
+      }
+
+      s.average = static_cast<double>(total) / frames;
+      s.last = history[lastSlot];
+    }
+
+    stats.push_back(s);
+  }
+
+  return stats;
+}
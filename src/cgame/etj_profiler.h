@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+        Lightweight per-frame profiler.
+
+        Sections are registered once and timed with scoped timers.
+        Each finished frame is written into a fixed size ring buffer,
+        so stats always cover the last N frames. While disabled, a
+        scope costs a single branch and no clock reads.
+
+        Counters share the same storage, but accumulate plain event
+        counts (e.g. draw calls) instead of microseconds.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ETJump {
+class Profiler {
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<std::string> names;
+  std::vector<bool> counters;
+  // time accumulated for each section during the current frame
+  std::vector<int64_t> current;
+  // section-major ring buffer of frame times in microseconds,
+  // sections are appended without disturbing existing samples
+  std::vector<int32_t> samples;
+  int historySize;
+  // slot the next finished frame is written to
+  int head = 0;
+  int frames = 0;
+  bool active = false;
+
+public:
+  // built-in CG_DrawActiveFrame stages, registered on construction
+  enum Stage {
+    Frame,
+    Prediction,
+    Pmove,
+    PacketEntities,
+    Particles,
+    LocalEntities,
+    Draw2D,
+    NumStages
+  };
+
+  struct Stats {
+    std::string name;
+    // microseconds, or events per frame for counters
+    double average;
+    int max;
+    int last;
+    bool counter;
+  };
+
+  class Scope {
+    Profiler *profiler;
+    int section;
+    Clock::time_point start;
+
+  public:
+    Scope(Profiler *profiler, int section)
+        : profiler(profiler && profiler->active ? profiler : nullptr),
+          section(section) {
+      if (this->profiler) {
+        start = Clock::now();
+      }
+    }
+
+    ~Scope() {
+      if (profiler) {
+        profiler->add(section,
+                      std::chrono::duration_cast<std::chrono::microseconds>(
+                          Clock::now() - start)
+                          .count());
+      }
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+  };
+
+  explicit Profiler(int historySize);
+
+  // returns the id used to time the section
+  int addSection(const std::string &name);
+  // returns the id passed to count()
+  int addCounter(const std::string &name);
+
+  // history is cleared whenever profiling gets switched on
+  void beginFrame(bool enabled);
+  void endFrame();
+
+  void add(int section, int64_t microseconds);
+  void count(int counter, int64_t events = 1) { add(counter, events); }
+
+  bool isActive() const { return active; }
+  int frameCount() const { return frames; }
+  int sectionCount() const { return static_cast<int>(names.size()); }
+
+  // stats over the frames currently in history, in registration order
+  std::vector<Stats> getStats() const;
+};
+} // namespace ETJump
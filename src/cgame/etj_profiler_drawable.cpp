@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+
+#include "etj_profiler_drawable.h"
+#include "../game/etj_string_utilities.h"
+
+namespace ETJump {
+static const int MAX_OVERLAY_SECTIONS = 16;
+
+ProfilerDrawable::ProfilerDrawable(const Profiler *profiler)
+    : profiler(profiler) {}
+
+std::vector<Profiler::Stats> ProfilerDrawable::sortedStats() const {
+  auto stats = profiler->getStats();
+
+  const auto counters = std::stable_partition(
+      stats.begin() + Profiler::NumStages, stats.end(),
+      [](const Profiler::Stats &s) { return !s.counter; });
+
+  std::stable_sort(stats.begin() + Profiler::NumStages, counters,
+                   [](const Profiler::Stats &lhs, const Profiler::Stats &rhs) {
+                     return lhs.average > rhs.average;
+                   });
+
+  return stats;
+}
+
+bool ProfilerDrawable::beforeRender() {
+  if (etj_profiler.integer != 1 || !profiler->isActive()) {
+    return false;
+  }
+
+  return profiler->frameCount() > 0;
+}
+
+void ProfilerDrawable::render() const {
+  const float size = 0.16f;
+  const float rowHeight = static_cast<float>(CG_Text_Height_Ext(
+                              "Yy", size, 0, &cgs.media.limboFont2)) *
+                          1.5f;
+  const float nameWidth = 90.0f;
+  const float columnWidth = 30.0f;
+  const vec4_t stageColor = {1.0f, 1.0f, 0.6f, 1.0f};
+
+  float x = 6.0f;
+  float y = 120.0f;
+
+  ETJump_AdjustPosition(&x);
+
+  DrawString(x, y, size, size, colorWhite, qfalse,
+             stringFormat("profiler (%d frames)", profiler->frameCount())
+                 .c_str(),
+             0, ITEM_TEXTSTYLE_SHADOWED);
+  DrawString(x + nameWidth, y, size, size, colorWhite, qfalse, "avg", 0,
+             ITEM_TEXTSTYLE_SHADOWED);
+  DrawString(x + nameWidth + columnWidth, y, size, size, colorWhite, qfalse,
+             "max", 0, ITEM_TEXTSTYLE_SHADOWED);
+
+  const auto stats = sortedStats();
+  const int count =
+      std::min(static_cast<int>(stats.size()), MAX_OVERLAY_SECTIONS);
+
+  for (int i = 0; i < count; i++) {
+    const auto &s = stats[i];
+    const float *color = i < Profiler::NumStages ? stageColor : colorWhite;
+
+    y += rowHeight;
+
+    DrawString(x, y, size, size, color, qfalse, s.name.c_str(), 0,
+               ITEM_TEXTSTYLE_SHADOWED);
+    const std::string average = s.counter
+                                    ? stringFormat("%.0f", s.average)
+                                    : stringFormat("%.2f", s.average / 1000.0);
+    const std::string max = s.counter ? std::to_string(s.max)
+                                      : stringFormat("%.2f", s.max / 1000.0);
+
+    DrawString(x + nameWidth, y, size, size, color, qfalse, average.c_str(), 0,
+               ITEM_TEXTSTYLE_SHADOWED);
+    DrawString(x + nameWidth + columnWidth, y, size, size, color, qfalse,
+               max.c_str(), 0, ITEM_TEXTSTYLE_SHADOWED);
+  }
+}
+
+void ProfilerDrawable::dump() const {
+  if (profiler->frameCount() == 0) {
+    CG_Printf("No profiler data available, set ^3etj_profiler ^7to enable "
+              "profiling.\n");
+    return;
+  }
+
+  CG_Printf("Frame times over the last %d frames (ms):\n",
+            profiler->frameCount());
+  CG_Printf("^3%-24s %8s %8s %8s\n", "section", "avg", "max", "last");
+
+  const auto stats = sortedStats();
+
+  for (const auto &s : stats) {
+    if (!s.counter) {
+      CG_Printf("%-24s %8.3f %8.3f %8.3f\n", s.name.c_str(),
+                s.average / 1000.0, s.max / 1000.0, s.last / 1000.0);
+    }
+  }
+
+  const bool hasCounters =
+      std::any_of(stats.begin(), stats.end(),
+                  [](const Profiler::Stats &s) { return s.counter; });
+
+  if (!hasCounters) {
+    return;
+  }
+
+  CG_Printf("\nCounters per frame:\n");
+  CG_Printf("^3%-24s %8s %8s %8s\n", "counter", "avg", "max", "last");
+
+  for (const auto &s : stats) {
+    if (s.counter) {
+      CG_Printf("%-24s %8.1f %8d %8d\n", s.name.c_str(), s.average, s.max,
+                s.last);
+    }
+  }
+}
+} // namespace ETJump
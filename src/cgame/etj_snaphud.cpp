@@ -22,6 +22,8 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
+
 #include "etj_snaphud.h"
 #include "etj_utilities.h"
 #include "../game/etj_numeric_utilities.h"
@@ -78,150 +80,11 @@ void Snaphud::InitSnaphud(vec3_t wishvel, int8_t uCmdScale, usercmd_t cmd) {
   yaw = AngleNormalize65536(lroundf(tempYaw));
 }
 
-void Snaphud::UpdateSnapState(void) {
-  snap.maxAccel = (unsigned char)(snap.a + 0.5f);
-  unsigned char xnyAccel =
-      (unsigned char)(snap.a / sqrtf(2.0f) + 0.5f); // xAccel and yAccel
-                                                    // at 45deg ^ ^  ^
-
-  // find the last shortangle in each snapzone which is smaller than
-  // 45deg (= 8192) using
-  //  /asin -> increasing angles
-  //  \acos -> decreasing angles
-  // and concatenate those 2 sorted arrays in the upperhalf of 'zones'
-  // so we can merge them in the lower half afterwards ^^^^^^^^^ =>
-  // s.maxAccel +
-  for (unsigned char i = 0; i <= xnyAccel - 1; ++i) {
-    snap.zones[snap.maxAccel + i] =
-        16383 - (unsigned short)(RAD2SHORT(acosf((i + 0.5f) / snap.a)));
-  }
-  for (unsigned char i = xnyAccel; i <= snap.maxAccel - 1; ++i) {
-    snap.zones[snap.maxAccel + (snap.maxAccel - 1) - (i - xnyAccel)] =
-        (unsigned short)(RAD2SHORT(acosf((i + 0.5f) / snap.a)));
-  }
-
-  // merge 2 sorted arrays in the lowerhalf
-  unsigned char bi = snap.maxAccel;                 // begin i
-  unsigned char ei = snap.maxAccel + xnyAccel;      // end i
-  unsigned char bj = snap.maxAccel + xnyAccel;      // begin j
-  unsigned char ej = snap.maxAccel + snap.maxAccel; // end j
-  unsigned char i = bi;
-  unsigned char j = bj;
-  unsigned char k = 0;
-  unsigned char xAccel_ = snap.maxAccel - (j - bj);
-  unsigned char yAccel_ = i - bi;
-  float absAccel_;
-  snap.minAbsAccel =
-      (float)(2 * snap.maxAccel); // upperbound > sqrt(2).s.maxAccel
-  snap.maxAbsAccel = 0;           // lowerbound
-  while (i < ei && j < ej) {
-    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
-
-    if (absAccel_ < snap.minAbsAccel) {
-      snap.minAbsAccel = absAccel_;
-    }
-
-    if (absAccel_ > snap.maxAbsAccel) {
-      snap.maxAbsAccel = absAccel_;
-    }
-
-    snap.xAccel[k] = xAccel_;
-    snap.yAccel[k] = yAccel_;
-    snap.absAccel[k] = absAccel_;
-    snap.xAccel[2 * snap.maxAccel - k] = yAccel_;
-    snap.yAccel[2 * snap.maxAccel - k] = xAccel_;
-    snap.absAccel[2 * snap.maxAccel - k] = absAccel_;
-
-    if (snap.zones[i] < snap.zones[j]) {
-      snap.zones[k++] = snap.zones[i++];
-      yAccel_ = i - bi;
-    } else {
-      snap.zones[k++] = snap.zones[j++];
-      xAccel_ = snap.maxAccel - (j - bj);
-    }
-  }
-  // store remaining elements
-  while (i < ei) {
-    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
-
-    if (absAccel_ < snap.minAbsAccel) {
-      snap.minAbsAccel = absAccel_;
-    }
-
-    if (absAccel_ > snap.maxAbsAccel) {
-      snap.maxAbsAccel = absAccel_;
-    }
-
-    snap.xAccel[k] = xAccel_;
-    snap.yAccel[k] = yAccel_;
-    snap.absAccel[k] = absAccel_;
-    snap.xAccel[2 * snap.maxAccel - k] = yAccel_;
-    snap.yAccel[2 * snap.maxAccel - k] = xAccel_;
-    snap.absAccel[2 * snap.maxAccel - k] = absAccel_;
-    snap.zones[k++] = snap.zones[i++];
-    yAccel_ = i - bi;
-  }
-  // store remaining elements
-  while (j < ej) {
-    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
-
-    if (absAccel_ < snap.minAbsAccel) {
-      snap.minAbsAccel = absAccel_;
-    }
-
-    if (absAccel_ > snap.maxAbsAccel) {
-      snap.maxAbsAccel = absAccel_;
-    }
-
-    snap.xAccel[k] = xAccel_;
-    snap.yAccel[k] = yAccel_;
-    snap.absAccel[k] = absAccel_;
-    snap.xAccel[2 * snap.maxAccel - k] = yAccel_;
-    snap.yAccel[2 * snap.maxAccel - k] = xAccel_;
-    snap.absAccel[2 * snap.maxAccel - k] = absAccel_;
-    snap.zones[k++] = snap.zones[j++];
-    xAccel_ = snap.maxAccel - (j - bj);
-  }
-
-  // fill in the acceleration of the snapzone at 45deg since we only
-  // searched for shortangles smaller than 45deg (= 8192)
-  absAccel_ = sqrtf(2) * xnyAccel;
-
-  if (absAccel_ < snap.minAbsAccel) {
-    snap.minAbsAccel = absAccel_;
-  }
-
-  if (absAccel_ > snap.maxAbsAccel) {
-    snap.maxAbsAccel = absAccel_;
-  }
-
-  snap.xAccel[k] = xnyAccel;
-  snap.yAccel[k] = xnyAccel;
-  snap.absAccel[k] = absAccel_;
-
-  for (i = 0; i < snap.maxAccel; ++i) {
-    snap.zones[snap.maxAccel + i] = 16383 - snap.zones[snap.maxAccel - 1 - i];
-  }
-
-  snap.zones[2 * snap.maxAccel] = snap.zones[0] + 16384;
-}
-
-void Snaphud::UpdateMaxSnapZones() {
-  // calculate max number of snapzones in 1 quadrant
-  // this needs to be dynamically calculated because
-  // ps->speed can be modified by target_scale_velocity
-  // default: 57 on ground, 7 in air (352 wishspeed)
-  const int maxSnaphudZonesQ1 = static_cast<int>(std::roundf(snap.a) * 2 + 1);
-
-  // need to add rounded xy clipped to normal gravity influence to frame accel
-  // 11 snap zones for ~78deg slope, 9 zones for 60deg slope, etc.
-  // const int maxSnaphudZonesQ1 =
-  //    static_cast<int>(std::roundf(snap.a + gravityAccelxy) * 2 + 1);
-
-  snap.zones.resize(maxSnaphudZonesQ1);
-  snap.xAccel.resize(maxSnaphudZonesQ1);
-  snap.yAccel.resize(maxSnaphudZonesQ1);
-  snap.absAccel.resize(maxSnaphudZonesQ1);
+SnapTableCache &Snaphud::snapTables() {
+  // a handful of entries covers ground/air, walk/crouch/prone and
+  // frametime jitter when not using pmove_fixed
+  static SnapTableCache cache(8);
+  return cache;
 }
 
 bool Snaphud::beforeRender() {
@@ -282,48 +145,80 @@ bool Snaphud::beforeRender() {
     a = 85;
   }
 
-  if (a != snap.a || a == 0.0f) {
-    snap.a = a;
-    UpdateMaxSnapZones();
-    UpdateSnapState();
+  if (!snap || a != snap->a) {
+    snap = snapTables().get(a);
   }
 
   edgesOnly = etj_drawSnapHUD.integer == 2;
   edgeThickness = Numeric::clamp(etj_snapHUDEdgeThickness.integer, 1, 128);
 
-  PrepareDrawables();
+  PrepareDrawables(getFov());
 
   return true;
 }
 
-void Snaphud::PrepareDrawables() {
+void Snaphud::PrepareDrawables(float fov) {
   isCurrentAlt = false;
   drawableSnaps.clear();
 
-  for (int i = 0; i < 2 * snap.maxAccel; ++i) {
-    for (int j = 0; j < 65536; j += 16384) {
-      const int bSnap = snap.zones[i] + 1 + j;
-      const int eSnap = snap.zones[i + 1] + j;
-      const bool active = AngleNormalize65536(yaw - bSnap) <=
-                          AngleNormalize65536(eSnap - bSnap);
-      const bool isAlt = i % 2;
-      isCurrentAlt |= active && isAlt;
-
-      drawableSnaps.push_back(DrawableSnap{bSnap, eSnap, isAlt, active});
+  // zones outside of the visible range would be clipped away when
+  // drawing anyway, so only walk the zones inside it, the active zone
+  // always contains yaw and is never skipped
+  const int halfFov = ANGLE2SHORT(fov * 0.5f) + 1;
+  const int visibleStart = yaw - halfFov;
+  const int visibleRange = 2 * halfFov;
+  const int zoneCount = 2 * snap->maxAccel;
+  const auto zonesBegin = snap->zones.cbegin();
+  const auto zonesEnd = zonesBegin + zoneCount + 1;
+
+  for (int j = 0; j < 65536; j += 16384) {
+    // zones of a quadrant are sorted, the visible range is either at
+    // its wrapped or its unwrapped position relative to the quadrant
+    const int base = AngleNormalize65536(visibleStart - j);
+    for (const int lo : {base, base - 65536}) {
+      const int hi = lo + visibleRange;
+      const int first = std::max(
+          static_cast<int>(std::lower_bound(zonesBegin, zonesEnd, lo) -
+                           zonesBegin) -
+              1,
+          0);
+      const int last = std::min(
+          static_cast<int>(std::lower_bound(zonesBegin, zonesEnd, hi) -
+                           zonesBegin),
+          zoneCount);
+
+      for (int i = first; i < last; ++i) {
+        const int bSnap = snap->zones[i] + 1 + j;
+        const int eSnap = snap->zones[i + 1] + j;
+        const int width = AngleNormalize65536(eSnap - bSnap);
+        const bool active = AngleNormalize65536(yaw - bSnap) <= width;
+        const bool isAlt = i % 2;
+        isCurrentAlt |= active && isAlt;
+
+        const int start = AngleNormalize65536(bSnap - visibleStart);
+        if (start > visibleRange && start + width < 65536) {
+          continue;
+        }
+
+        drawableSnaps.push_back(DrawableSnap{bSnap, eSnap, isAlt, active});
+      }
     }
   }
 }
 
+float Snaphud::getFov() {
+  if (!etj_snapHUDFov.value) {
+    return cg.refdef.fov_x;
+  }
+
+  return Numeric::clamp(etj_snapHUDFov.value, 1, 179);
+}
+
 void Snaphud::render() const {
   float h = etj_snapHUDHeight.value;
   float y = 240 + etj_snapHUDOffsetY.value;
 
-  float fov;
-  if (!etj_snapHUDFov.value) {
-    fov = cg.refdef.fov_x;
-  } else {
-    fov = Numeric::clamp(etj_snapHUDFov.value, 1, 179);
-  }
+  const float fov = getFov();
 
   for (const DrawableSnap &ds : drawableSnaps) {
     int8_t color = ds.alt ? 1 : 0;
@@ -351,7 +246,6 @@ void Snaphud::render() const {
 Snaphud::CurrentSnap Snaphud::getCurrentSnap(const playerState_t &ps,
                                              pmove_t *pm,
                                              const bool upmoveTrueness) {
-  static Snaphud s;
   CurrentSnap cs{};
 
   // get player yaw
@@ -381,16 +275,13 @@ Snaphud::CurrentSnap Snaphud::getCurrentSnap(const playerState_t &ps,
   if (frameAccel > 85) {
     frameAccel = 85;
   }
-  if (frameAccel != s.snap.a) {
-    s.snap.a = frameAccel;
-    s.UpdateMaxSnapZones();
-    s.UpdateSnapState();
-  }
+  const auto entry = snapTables().get(frameAccel);
+  const SnapTable &table = *entry;
 
-  // early out if we have no snapzones yet, this can happen for a brief
+  // early out if we have no snapzones, this can happen for a brief
   // moment when swapping teams since we're transitioning from
   // cg.snap->ps to cg.predictedPlayerstate
-  if (s.snap.zones.size() == 0) {
+  if (table.maxAccel == 0) {
     cs.snap = INVALID_SNAP_DIR;
     return cs;
   }
@@ -408,13 +299,13 @@ Snaphud::CurrentSnap Snaphud::getCurrentSnap(const playerState_t &ps,
   opt = std::fmod(AngleNormalize360(opt), 90);
 
   // get number of snapzones
-  auto snapCount = s.snap.zones.size() - 1;
+  auto snapCount = table.zones.size() - 1;
 
   // get snapzone index which corresponds to the *next* snapzone
   // linear search is good enough here as snapCount is always relatively
   // small
   unsigned int i = 0;
-  while (i < snapCount && opt >= SHORT2DEG(s.snap.zones[i])) {
+  while (i < snapCount && opt >= SHORT2DEG(table.zones[i])) {
     ++i;
   }
 
@@ -424,7 +315,7 @@ Snaphud::CurrentSnap Snaphud::getCurrentSnap(const playerState_t &ps,
   }
 
   // get the snapzone
-  const float snap = SHORT2DEG(s.snap.zones[i]);
+  const float snap = SHORT2DEG(table.zones[i]);
   // snap now contains the yaw value corresponding to the start of the
   // next snapzone, or equivalently the end of the current snapzone
 
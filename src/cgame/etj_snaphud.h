@@ -24,8 +24,10 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "etj_irenderable.h"
+#include "etj_snaphud_table.h"
 #include "cg_local.h"
 
 namespace ETJump {
@@ -51,25 +53,16 @@ public:
 private:
   bool canSkipDraw() const;
   void InitSnaphud(vec3_t wishvel, int8_t uCmdScale, usercmd_t cmd);
-  void UpdateMaxSnapZones();
-  void UpdateSnapState();
-  void PrepareDrawables();
+  void PrepareDrawables(float fov);
+  static float getFov();
   void startListeners();
 
   enum class SnapTrueness { SNAP_JUMPCROUCH = 1, SNAP_GROUND = 2 };
 
-  struct snaphud_t {
-    float a = 0.0f;
-    unsigned char maxAccel;
-    std::vector<unsigned short> zones;
-    std::vector<unsigned char> xAccel;
-    std::vector<unsigned char> yAccel;
-    std::vector<float> absAccel;
-    float minAbsAccel;
-    float maxAbsAccel;
-  };
+  // shared between all snaphud users, see getCurrentSnap
+  static SnapTableCache &snapTables();
 
-  snaphud_t snap;
+  std::shared_ptr<const SnapTable> snap;
 
   int yaw{};
   vec4_t snaphudColors[4]{};
@@ -0,0 +1,220 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "etj_snaphud_table.h"
+#include "../game/q_shared.h"
+
+// Snaphud implementation based on cgame_proxymod
+// HUGE thanks to Jelvan1 for his snaphud code
+// https://github.com/Jelvan1/cgame_proxymod/
+
+namespace ETJump {
+void SnapTable::build(float frameAccel) {
+  a = frameAccel;
+
+  // calculate max number of snapzones in 1 quadrant
+  // this needs to be dynamically calculated because
+  // ps->speed can be modified by target_scale_velocity
+  // default: 57 on ground, 7 in air (352 wishspeed)
+  const int maxSnaphudZonesQ1 = static_cast<int>(std::roundf(a) * 2 + 1);
+
+  // need to add rounded xy clipped to normal gravity influence to frame accel
+  // 11 snap zones for ~78deg slope, 9 zones for 60deg slope, etc.
+  // const int maxSnaphudZonesQ1 =
+  //    static_cast<int>(std::roundf(a + gravityAccelxy) * 2 + 1);
+
+  zones.resize(maxSnaphudZonesQ1);
+  xAccel.resize(maxSnaphudZonesQ1);
+  yAccel.resize(maxSnaphudZonesQ1);
+  absAccel.resize(maxSnaphudZonesQ1);
+
+  maxAccel = (unsigned char)(a + 0.5f);
+  unsigned char xnyAccel =
+      (unsigned char)(a / sqrtf(2.0f) + 0.5f); // xAccel and yAccel
+                                               // at 45deg
+
+  // find the last shortangle in each snapzone which is smaller than
+  // 45deg (= 8192) using
+  //  /asin -> increasing angles
+  //  \acos -> decreasing angles
+  // and concatenate those 2 sorted arrays in the upperhalf of 'zones'
+  // so we can merge them in the lower half afterwards ^^^^^^^^^ =>
+  // s.maxAccel +
+  for (unsigned char i = 0; i <= xnyAccel - 1; ++i) {
+    zones[maxAccel + i] =
+        16383 - (unsigned short)(RAD2SHORT(acosf((i + 0.5f) / a)));
+  }
+  for (unsigned char i = xnyAccel; i <= maxAccel - 1; ++i) {
+    zones[maxAccel + (maxAccel - 1) - (i - xnyAccel)] =
+        (unsigned short)(RAD2SHORT(acosf((i + 0.5f) / a)));
+  }
+
+  // merge 2 sorted arrays in the lowerhalf
+  unsigned char bi = maxAccel;            // begin i
+  unsigned char ei = maxAccel + xnyAccel; // end i
+  unsigned char bj = maxAccel + xnyAccel; // begin j
+  unsigned char ej = maxAccel + maxAccel; // end j
+  unsigned char i = bi;
+  unsigned char j = bj;
+  unsigned char k = 0;
+  unsigned char xAccel_ = maxAccel - (j - bj);
+  unsigned char yAccel_ = i - bi;
+  float absAccel_;
+  minAbsAccel = (float)(2 * maxAccel); // upperbound > sqrt(2).s.maxAccel
+  maxAbsAccel = 0;                     // lowerbound
+  while (i < ei && j < ej) {
+    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
+
+    if (absAccel_ < minAbsAccel) {
+      minAbsAccel = absAccel_;
+    }
+
+    if (absAccel_ > maxAbsAccel) {
+      maxAbsAccel = absAccel_;
+    }
+
+    xAccel[k] = xAccel_;
+    yAccel[k] = yAccel_;
+    absAccel[k] = absAccel_;
+    xAccel[2 * maxAccel - k] = yAccel_;
+    yAccel[2 * maxAccel - k] = xAccel_;
+    absAccel[2 * maxAccel - k] = absAccel_;
+
+    if (zones[i] < zones[j]) {
+      zones[k++] = zones[i++];
+      yAccel_ = i - bi;
+    } else {
+      zones[k++] = zones[j++];
+      xAccel_ = maxAccel - (j - bj);
+    }
+  }
+  // store remaining elements
+  while (i < ei) {
+    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
+
+    if (absAccel_ < minAbsAccel) {
+      minAbsAccel = absAccel_;
+    }
+
+    if (absAccel_ > maxAbsAccel) {
+      maxAbsAccel = absAccel_;
+    }
+
+    xAccel[k] = xAccel_;
+    yAccel[k] = yAccel_;
+    absAccel[k] = absAccel_;
+    xAccel[2 * maxAccel - k] = yAccel_;
+    yAccel[2 * maxAccel - k] = xAccel_;
+    absAccel[2 * maxAccel - k] = absAccel_;
+    zones[k++] = zones[i++];
+    yAccel_ = i - bi;
+  }
+  // store remaining elements
+  while (j < ej) {
+    absAccel_ = sqrtf((float)(xAccel_ * xAccel_ + yAccel_ * yAccel_));
+
+    if (absAccel_ < minAbsAccel) {
+      minAbsAccel = absAccel_;
+    }
+
+    if (absAccel_ > maxAbsAccel) {
+      maxAbsAccel = absAccel_;
+    }
+
+    xAccel[k] = xAccel_;
+    yAccel[k] = yAccel_;
+    absAccel[k] = absAccel_;
+    xAccel[2 * maxAccel - k] = yAccel_;
+    yAccel[2 * maxAccel - k] = xAccel_;
+    absAccel[2 * maxAccel - k] = absAccel_;
+    zones[k++] = zones[j++];
+    xAccel_ = maxAccel - (j - bj);
+  }
+
+  // fill in the acceleration of the snapzone at 45deg since we only
+  // searched for shortangles smaller than 45deg (= 8192)
+  absAccel_ = sqrtf(2) * xnyAccel;
+
+  if (absAccel_ < minAbsAccel) {
+    minAbsAccel = absAccel_;
+  }
+
+  if (absAccel_ > maxAbsAccel) {
+    maxAbsAccel = absAccel_;
+  }
+
+  xAccel[k] = xnyAccel;
+  yAccel[k] = xnyAccel;
+  absAccel[k] = absAccel_;
+
+  for (i = 0; i < maxAccel; ++i) {
+    zones[maxAccel + i] = 16383 - zones[maxAccel - 1 - i];
+  }
+
+  zones[2 * maxAccel] = zones[0] + 16384;
+}
+
+SnapTableCache::SnapTableCache(size_t capacity)
+    : capacity(std::max(capacity, static_cast<size_t>(1))) {
+  tables.reserve(this->capacity);
+  lastUsed.reserve(this->capacity);
+}
+
+std::shared_ptr<const SnapTable> SnapTableCache::get(float frameAccel) {
+  useCounter++;
+
+  for (size_t i = 0; i < tables.size(); i++) {
+    if (tables[i]->a == frameAccel) {
+      lastUsed[i] = useCounter;
+      hitCount++;
+      return tables[i];
+    }
+  }
+
+  missCount++;
+
+  size_t slot;
+  if (tables.size() < capacity) {
+    slot = tables.size();
+    tables.push_back(std::make_shared<SnapTable>());
+    lastUsed.push_back(0);
+  } else {
+    slot = static_cast<size_t>(
+        std::min_element(lastUsed.begin(), lastUsed.end()) - lastUsed.begin());
+
+    // someone still holds the evicted table, leave it alone
+    if (tables[slot].use_count() > 1) {
+      tables[slot] = std::make_shared<SnapTable>();
+    }
+  }
+
+  // rebuilding in place reuses the evicted table's storage
+  tables[slot]->build(frameAccel);
+  lastUsed[slot] = useCounter;
+  return tables[slot];
+}
+} // namespace ETJump
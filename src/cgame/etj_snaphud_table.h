@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ETJump {
+// snapzone tables for a single frame acceleration
+struct SnapTable {
+  float a = 0.0f;
+  unsigned char maxAccel = 0;
+  std::vector<unsigned short> zones;
+  std::vector<unsigned char> xAccel;
+  std::vector<unsigned char> yAccel;
+  std::vector<float> absAccel;
+  float minAbsAccel = 0.0f;
+  float maxAbsAccel = 0.0f;
+
+  // (re)builds the tables for frame acceleration 'frameAccel',
+  // reusing the existing storage where possible
+  void build(float frameAccel);
+};
+
+// Small LRU of snapzone tables keyed by frame acceleration.
+// Frame acceleration only depends on wishspeed, accel and frametime,
+// so during normal play it cycles between a handful of values
+// (ground/air, crouch/walk, frametime jitter without pmove_fixed).
+class SnapTableCache {
+  std::vector<std::shared_ptr<SnapTable>> tables;
+  std::vector<uint32_t> lastUsed;
+  size_t capacity;
+  uint32_t useCounter = 0;
+  int hitCount = 0;
+  int missCount = 0;
+
+public:
+  explicit SnapTableCache(size_t capacity);
+
+  // returned table stays valid for as long as the caller holds on to it,
+  // even if the cache evicts it in the meantime
+  std::shared_ptr<const SnapTable> get(float frameAccel);
+
+  int hits() const { return hitCount; }
+  int misses() const { return missCount; }
+  size_t size() const { return tables.size(); }
+};
+} // namespace ETJump
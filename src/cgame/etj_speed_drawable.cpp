@@ -69,7 +69,7 @@ void DrawSpeed::startListeners() {
 
   consoleCommandsHandler->subscribe(
       "resetmaxspeed",
-      [&](const std::vector<std::string> &args) { resetMaxSpeed(); });
+      [&](const CommandArguments &args) { resetMaxSpeed(); });
 }
 
 bool DrawSpeed::beforeRender() {
@@ -45,7 +45,7 @@ void StrafeQuality::startListeners() {
 
   consoleCommandsHandler->subscribe(
       "resetStrafeQuality",
-      [&](const std::vector<std::string> &args) { resetStrafeQuality(); });
+      [&](const CommandArguments &args) { resetStrafeQuality(); });
   playerEventsHandler->subscribe(
       "respawn",
       [&](const std::vector<std::string> &args) { resetStrafeQuality(); });
@@ -0,0 +1,234 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "etj_trace_broadphase.h"
+
+namespace ETJump {
+// entries covering more cells than this are checked on every query,
+// typically huge brush models that would otherwise be in most cells
+static const int MAX_ENTRY_CELLS = 64;
+// queries covering more cells than this fall back to testing every
+// entry, e.g. long line traces across the map
+static const int MAX_QUERY_CELLS = 128;
+
+TraceBroadphase::TraceBroadphase(float cellSize) : cellSize(cellSize) {}
+
+TraceBroadphase::CellRange
+TraceBroadphase::cellRange(const vec3_t mins, const vec3_t maxs) const {
+  return {static_cast<int>(std::floor(mins[0] / cellSize)),
+          static_cast<int>(std::floor(mins[1] / cellSize)),
+          static_cast<int>(std::floor(maxs[0] / cellSize)),
+          static_cast<int>(std::floor(maxs[1] / cellSize))};
+}
+
+int64_t TraceBroadphase::cellKey(int x, int y) {
+  return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+}
+
+bool TraceBroadphase::overlaps(const Entry &entry, const vec3_t mins,
+                               const vec3_t maxs) {
+  if (!entry.bounded) {
+    return true;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    if (entry.mins[i] > maxs[i] || entry.maxs[i] < mins[i]) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void TraceBroadphase::insert(int index) {
+  Entry &entry = entries[index];
+
+  if (entry.bounded) {
+    entry.cells = cellRange(entry.mins, entry.maxs);
+    const int64_t count =
+        static_cast<int64_t>(entry.cells.x1 - entry.cells.x0 + 1) *
+        (entry.cells.y1 - entry.cells.y0 + 1);
+    entry.inGrid = count <= MAX_ENTRY_CELLS;
+  } else {
+    entry.inGrid = false;
+  }
+
+  if (!entry.inGrid) {
+    overflow.push_back(index);
+    return;
+  }
+
+  for (int x = entry.cells.x0; x <= entry.cells.x1; x++) {
+    for (int y = entry.cells.y0; y <= entry.cells.y1; y++) {
+      cells[cellKey(x, y)].push_back(index);
+    }
+  }
+}
+
+void TraceBroadphase::remove(int index) {
+  const Entry &entry = entries[index];
+
+  // order within a cell doesn't matter, queries sort their results
+  const auto erase = [index](std::vector<int> &list) {
+    const auto it = std::find(list.begin(), list.end(), index);
+    if (it != list.end()) {
+      *it = list.back();
+      list.pop_back();
+    }
+  };
+
+  if (!entry.inGrid) {
+    erase(overflow);
+    return;
+  }
+
+  for (int x = entry.cells.x0; x <= entry.cells.x1; x++) {
+    for (int y = entry.cells.y0; y <= entry.cells.y1; y++) {
+      erase(cells[cellKey(x, y)]);
+    }
+  }
+}
+
+void TraceBroadphase::clear() {
+  entries.clear();
+  overflow.clear();
+
+  for (auto &cell : cells) {
+    cell.second.clear();
+  }
+}
+
+int TraceBroadphase::add(const vec3_t mins, const vec3_t maxs) {
+  Entry entry{};
+  VectorCopy(mins, entry.mins);
+  VectorCopy(maxs, entry.maxs);
+  entry.bounded = true;
+  entries.push_back(entry);
+
+  const int index = static_cast<int>(entries.size()) - 1;
+  insert(index);
+  return index;
+}
+
+int TraceBroadphase::addUnbounded() {
+  Entry entry{};
+  entry.bounded = false;
+  entries.push_back(entry);
+
+  const int index = static_cast<int>(entries.size()) - 1;
+  insert(index);
+  return index;
+}
+
+void TraceBroadphase::update(int index, const vec3_t mins, const vec3_t maxs) {
+  Entry &entry = entries[index];
+
+  if (entry.bounded && entry.inGrid) {
+    const CellRange range = cellRange(mins, maxs);
+
+    if (range == entry.cells) {
+      VectorCopy(mins, entry.mins);
+      VectorCopy(maxs, entry.maxs);
+      return;
+    }
+  }
+
+  remove(index);
+  VectorCopy(mins, entry.mins);
+  VectorCopy(maxs, entry.maxs);
+  entry.bounded = true;
+  insert(index);
+}
+
+void TraceBroadphase::setUnbounded(int index) {
+  if (!entries[index].bounded) {
+    return;
+  }
+
+  remove(index);
+  entries[index].bounded = false;
+  insert(index);
+}
+
+void TraceBroadphase::query(const vec3_t mins, const vec3_t maxs,
+                            std::vector<int> &result) {
+  result.clear();
+
+  const CellRange range = cellRange(mins, maxs);
+  const int64_t count = static_cast<int64_t>(range.x1 - range.x0 + 1) *
+                        (range.y1 - range.y0 + 1);
+
+  if (count > MAX_QUERY_CELLS) {
+    for (int i = 0; i < size(); i++) {
+      if (overlaps(entries[i], mins, maxs)) {
+        result.push_back(i);
+      }
+    }
+    return;
+  }
+
+  if (stamps.size() < entries.size()) {
+    stamps.resize(entries.size(), 0);
+  }
+
+  if (++currentStamp == 0) {
+    std::fill(stamps.begin(), stamps.end(), 0);
+    currentStamp = 1;
+  }
+
+  const auto visit = [&](int index) {
+    if (stamps[index] == currentStamp) {
+      return;
+    }
+    stamps[index] = currentStamp;
+
+    if (overlaps(entries[index], mins, maxs)) {
+      result.push_back(index);
+    }
+  };
+
+  for (const int index : overflow) {
+    visit(index);
+  }
+
+  for (int x = range.x0; x <= range.x1; x++) {
+    for (int y = range.y0; y <= range.y1; y++) {
+      const auto cell = cells.find(cellKey(x, y));
+      if (cell == cells.end()) {
+        continue;
+      }
+
+      for (const int index : cell->second) {
+        visit(index);
+      }
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+}
+} // namespace ETJump
@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+        Uniform 2D grid over axis aligned bounding boxes.
+
+        Used as a broadphase for client side entity traces, so only
+        entities whose bounds overlap a trace are handed to the
+        collision system. Entries are identified by the order they
+        were added in, and queries return them in that same order so
+        callers see the exact same iteration order as a linear scan.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "../game/q_shared.h"
+
+namespace ETJump {
+class TraceBroadphase {
+  struct CellRange {
+    int x0, y0, x1, y1;
+
+    bool operator==(const CellRange &other) const {
+      return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 &&
+             y1 == other.y1;
+    }
+  };
+
+  struct Entry {
+    vec3_t mins;
+    vec3_t maxs;
+    CellRange cells;
+    // unbounded entries and entries spanning too many cells
+    // live in 'overflow' instead of the grid
+    bool inGrid;
+    bool bounded;
+  };
+
+  float cellSize;
+  std::vector<Entry> entries;
+  std::unordered_map<int64_t, std::vector<int>> cells;
+  std::vector<int> overflow;
+  // dedupes entries spanning several cells during a query
+  std::vector<uint32_t> stamps;
+  uint32_t currentStamp = 0;
+
+  CellRange cellRange(const vec3_t mins, const vec3_t maxs) const;
+  static int64_t cellKey(int x, int y);
+  static bool overlaps(const Entry &entry, const vec3_t mins,
+                       const vec3_t maxs);
+
+  void insert(int index);
+  void remove(int index);
+
+public:
+  explicit TraceBroadphase(float cellSize = 512.0f);
+
+  // removes all entries, cell storage is kept for reuse
+  void clear();
+
+  // returns the index of the new entry, which is always the number
+  // of entries added since the last clear()
+  int add(const vec3_t mins, const vec3_t maxs);
+  // entry returned by every query, for entities whose bounds
+  // can't be determined up front
+  int addUnbounded();
+
+  // moves an entry, only touches the grid if its cells changed
+  void update(int index, const vec3_t mins, const vec3_t maxs);
+  void setUnbounded(int index);
+
+  // indices of all entries overlapping the box, in ascending order
+  void query(const vec3_t mins, const vec3_t maxs,
+             std::vector<int> &result);
+
+  int size() const { return static_cast<int>(entries.size()); }
+};
+} // namespace ETJump
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "etj_trace_cache.h"
+
+namespace ETJump {
+constexpr int TraceCache::MAX_TRACES;
+
+TraceCache::TraceCache(TraceFunc traceFunc)
+    : traceFunc(std::move(traceFunc)) {}
+
+void TraceCache::clear() {
+  numEntries = 0;
+  nextEntry = 0;
+}
+
+void TraceCache::store(const vec3_t start, const vec3_t end, int skipNumber,
+                       int contents, const trace_t &trace) {
+  Entry &entry = entries[nextEntry];
+  nextEntry = (nextEntry + 1) % MAX_TRACES;
+  numEntries = std::min(numEntries + 1, MAX_TRACES);
+
+  VectorCopy(start, entry.start);
+  VectorCopy(end, entry.end);
+  entry.skipNumber = skipNumber;
+  entry.contents = contents;
+  entry.trace = trace;
+}
+
+void TraceCache::trace(trace_t *result, const vec3_t start, const vec3_t end,
+                       int skipNumber, int contents) {
+  for (int i = 0; i < numEntries; i++) {
+    const Entry &entry = entries[i];
+
+    if (entry.skipNumber == skipNumber && entry.contents == contents &&
+        VectorCompare(entry.start, start) && VectorCompare(entry.end, end)) {
+      *result = entry.trace;
+      hitCount++;
+      return;
+    }
+  }
+
+  missCount++;
+  traceFunc(result, start, end, skipNumber, contents);
+  store(start, end, skipNumber, contents, *result);
+}
+
+void TraceCache::groundTrace(trace_t *result, const vec3_t start,
+                             float distance, float epsilon, int skipNumber,
+                             int contents) {
+  for (int i = 0; i < numEntries; i++) {
+    const Entry &entry = entries[i];
+    const trace_t &cached = entry.trace;
+
+    if (entry.skipNumber != skipNumber || entry.contents != contents ||
+        cached.fraction == 1.0f || cached.startsolid) {
+      continue;
+    }
+
+    // only straight down traces of full length
+    if (entry.start[0] != entry.end[0] || entry.start[1] != entry.end[1] ||
+        std::abs(entry.start[2] - entry.end[2] - distance) > 1.0f) {
+      continue;
+    }
+
+    if (std::abs(entry.start[0] - start[0]) > epsilon ||
+        std::abs(entry.start[1] - start[1]) > epsilon) {
+      continue;
+    }
+
+    // the space between the cached start and the ground is known to be
+    // empty, so any start along it hits the same ground
+    if (start[2] > entry.start[2] || start[2] < cached.endpos[2]) {
+      continue;
+    }
+
+    *result = cached;
+    result->endpos[0] = start[0];
+    result->endpos[1] = start[1];
+    result->fraction = (start[2] - cached.endpos[2]) / distance;
+    hitCount++;
+    return;
+  }
+
+  vec3_t end;
+  VectorCopy(start, end);
+  end[2] -= distance;
+
+  trace(result, start, end, skipNumber, contents);
+}
+} // namespace ETJump
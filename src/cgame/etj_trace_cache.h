@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+        Small cache of point traces against static world geometry.
+
+        The trace function must not clip against entities. Movers and
+        other players are interpolated again every render frame, so
+        callers clip the returned trace against them themselves. World
+        results never go stale within a map, so they are reused across
+        frames, e.g. while a player stands still or falls straight down.
+*/
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <functional>
+
+#include "../game/q_shared.h"
+
+namespace ETJump {
+class TraceCache {
+public:
+  using TraceFunc =
+      std::function<void(trace_t *result, const vec3_t start,
+                         const vec3_t end, int skipNumber, int contents)>;
+
+  static constexpr int MAX_TRACES = 8;
+
+  explicit TraceCache(TraceFunc traceFunc);
+
+  // drops all cached traces, the world changes with the map
+  void clear();
+
+  void trace(trace_t *result, const vec3_t start, const vec3_t end,
+             int skipNumber, int contents);
+
+  // traces 'distance' units straight down from start. A cached ground
+  // hit is reused while start stays within 'epsilon' of it horizontally
+  // and lies on the segment that was already traced above the ground.
+  void groundTrace(trace_t *result, const vec3_t start, float distance,
+                   float epsilon, int skipNumber, int contents);
+
+  int hits() const { return hitCount; }
+  int misses() const { return missCount; }
+
+private:
+  struct Entry {
+    vec3_t start;
+    vec3_t end;
+    int skipNumber;
+    int contents;
+    trace_t trace;
+  };
+
+  void store(const vec3_t start, const vec3_t end, int skipNumber,
+             int contents, const trace_t &trace);
+
+  TraceFunc traceFunc;
+  Entry entries[MAX_TRACES]{};
+  int numEntries = 0;
+  int nextEntry = 0;
+  int hitCount = 0;
+  int missCount = 0;
+};
+} // namespace ETJump
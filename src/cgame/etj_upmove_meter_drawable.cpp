@@ -71,7 +71,7 @@ void UpmoveMeter::startListeners() {
 
   consoleCommandsHandler->subscribe(
       "resetUpmoveMeter",
-      [&](const std::vector<std::string> &args) { resetUpmoveMeter(); });
+      [&](const CommandArguments &args) { resetUpmoveMeter(); });
 
   playerEventsHandler->subscribe(
       "respawn",
@@ -0,0 +1,47 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "etj_client_command_registry.h"
+
+bool ETJump::ClientCommandRegistry::add(const std::string &name,
+                                        ClientCommandPhase phase,
+                                        FloodProtection floodProtection,
+                                        const std::string &help,
+                                        Handler handler) {
+  if (name.empty() || !handler) {
+    return false;
+  }
+
+  return _commands
+      .emplace(name,
+               Command{name, phase, floodProtection, help, std::move(handler)})
+      .second;
+}
+
+const ETJump::ClientCommandRegistry::Command *
+ETJump::ClientCommandRegistry::find(const std::string &name) const {
+  const auto match = _commands.find(name);
+  return match != _commands.end() ? &match->second : nullptr;
+}
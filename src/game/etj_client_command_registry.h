@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "etj_string_utilities.h"
+
+typedef struct gentity_s gentity_t;
+
+namespace ETJump {
+enum class ClientCommandPhase {
+  // accepted before the client has fully connected
+  Connecting,
+  // accepted at any time once connected, including intermission
+  Anytime,
+  // rejected during intermission
+  NoIntermission,
+};
+
+enum class FloodProtection {
+  None,
+  // counts towards the client's flood limit
+  Command,
+  // counts towards the flood limit and is dropped for muted clients
+  Chat,
+};
+
+// single lookup table for every command a client can send to the server,
+// commands are matched case-insensitively without lowercasing them first
+class ClientCommandRegistry {
+public:
+  using Handler = std::function<void(gentity_t *ent)>;
+
+  struct Command {
+    std::string name;
+    ClientCommandPhase phase;
+    FloodProtection floodProtection;
+    // printed when the command is called with '?' as the first argument,
+    // commands without help text get the '?' passed through
+    std::string help;
+    Handler handler;
+  };
+
+  // returns false if a command with the same name is already registered,
+  // the first registration wins
+  bool add(const std::string &name, ClientCommandPhase phase,
+           FloodProtection floodProtection, const std::string &help,
+           Handler handler);
+
+  // returns nullptr if the command is not registered
+  const Command *find(const std::string &name) const;
+
+  size_t size() const { return _commands.size(); }
+
+private:
+  std::unordered_map<std::string, Command, StringUtil::CaseInsensitiveHash,
+                     StringUtil::CaseInsensitiveEqual>
+      _commands;
+};
+} // namespace ETJump
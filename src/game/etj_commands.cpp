@@ -30,6 +30,7 @@
 #include "etj_save_system.h"
 #include "etj_session.h"
 #include "etj_custom_map_votes.h"
+#include "etj_database_maintenance.h"
 #include "g_local.h"
 #include "etj_map_statistics.h"
 #include "etj_numeric_utilities.h"
@@ -39,19 +40,14 @@
 #include "etj_printer.h"
 #include "etj_timerun_v2.h"
 #include "etj_chat_replay.h"
+#include "etj_client_command_registry.h"
 
 typedef std::function<bool(gentity_t *ent, Arguments argv)> Command;
 typedef std::pair<std::function<bool(gentity_t *ent, Arguments argv)>, char>
     AdminCommandPair;
-typedef std::map<std::string,
-                 std::function<bool(gentity_t *ent, Arguments argv)>>::
-    const_iterator ConstCommandIterator;
 typedef std::map<std::string,
                  std::pair<std::function<bool(gentity_t *ent, Arguments argv)>,
                            char>>::const_iterator ConstAdminCommandIterator;
-typedef std::map<std::string,
-                 std::function<bool(gentity_t *ent, Arguments argv)>>::iterator
-    CommandIterator;
 typedef std::map<std::string,
                  std::pair<std::function<bool(gentity_t *ent, Arguments argv)>,
                            char>>::iterator AdminCommandIterator;
@@ -83,6 +79,7 @@ const char SETLEVEL = 's';
 const char MOVERSCALE = 'v';
 const char TIMERUN_MANAGEMENT = 'T';
 const char CUSTOMVOTES = 'c';
+const char DATABASE = 'D';
 } // namespace CommandFlags
 
 namespace ETJump {
@@ -2243,6 +2240,54 @@ bool TimerunDeleteSeason(gentity_t *ent, Arguments argv) {
   return true;
 }
 
+bool MaintainDatabases(gentity_t *ent, Arguments argv) {
+  const int clientNum = ClientNum(ent);
+
+  auto def = std::move(
+      ETJump::CommandParser::CommandDefinition::create(
+          "database", "Prints the database maintenance status, or starts a "
+                      "maintenance pass right away\n    !database "
+                      "[--backup] [--optimize]")
+          .addOption("backup", "b",
+                     "Take an online backup of every database next to it",
+                     ETJump::CommandParser::OptionDefinition::Type::Boolean,
+                     false)
+          .addOption("optimize", "o",
+                     "Analyze, vacuum and checkpoint every database",
+                     ETJump::CommandParser::OptionDefinition::Type::Boolean,
+                     false));
+
+  auto optCommand = getOptCommand("database", clientNum, def, argv);
+  if (!optCommand.hasValue()) {
+    return true;
+  }
+
+  auto command = std::move(optCommand.value());
+  auto &maintenance = *game.databaseMaintenance;
+
+  if (command.options.count("backup") > 0) {
+    Printer::SendChatMessage(
+        clientNum, maintenance.requestBackup()
+                       ? "^3database: ^7backup started, check ^3!database "
+                         "^7for progress."
+                       : "^3database: ^7a backup is already running.");
+  }
+
+  if (command.options.count("optimize") > 0) {
+    Printer::SendChatMessage(
+        clientNum, maintenance.requestOptimize()
+                       ? "^3database: ^7optimize started, check ^3!database "
+                         "^7for progress."
+                       : "^3database: ^7optimize is already running.");
+  }
+
+  if (command.options.empty()) {
+    Printer::SendConsoleMessage(clientNum, maintenance.status());
+  }
+
+  return true;
+}
+
 bool RockTheVote(gentity_t *ent, Arguments argv) {
   std::string cmd = "callvote rtv";
 
@@ -2387,7 +2432,7 @@ bool editCustomVote(gentity_t *ent, Arguments argv) {
 
 } // namespace AdminCommands
 
-Commands::Commands() {
+Commands::Commands(ETJump::ClientCommandRegistry &registry) {
   // using AdminCommands::AdminCommand;
   // adminCommands_["addlevel"] = AdminCommand(AdminCommands::AddLevel,
   // 'a');
@@ -2481,6 +2526,8 @@ Commands::Commands() {
       AdminCommands::TimerunEditSeason, CommandFlags::TIMERUN_MANAGEMENT);
   adminCommands_["delete-season"] = AdminCommandPair(
       AdminCommands::TimerunDeleteSeason, CommandFlags::TIMERUN_MANAGEMENT);
+  adminCommands_["database"] = AdminCommandPair(
+      AdminCommands::MaintainDatabases, CommandFlags::DATABASE);
   adminCommands_["records"] =
       AdminCommandPair(ClientCommands::Records, CommandFlags::BASIC);
   adminCommands_["ranks"] =
@@ -2504,35 +2551,31 @@ Commands::Commands() {
   adminCommands_["edit-customvote"] = AdminCommandPair(
       AdminCommands::editCustomVote, CommandFlags::CUSTOMVOTES);
 
-  commands_["backup"] = ClientCommands::BackupLoad;
-  commands_["save"] = ClientCommands::Save;
-  commands_["load"] = ClientCommands::Load;
-  commands_["unload"] = ClientCommands::Unload;
-  //    commands_["race"] = ClientCommands::Race;
-  commands_["listinfo"] = ClientCommands::listCustomVotes;
-  commands_["customvotes"] = ClientCommands::listCustomVotes;
-  commands_["records"] = ClientCommands::Records;
-  commands_["times"] = ClientCommands::Records;
-  commands_["ranks"] = ClientCommands::Records;
-  commands_["top"] = ClientCommands::Records;
-  commands_["loadcheckpoints"] = ClientCommands::LoadCheckpoints;
-  commands_["load-checkpoints"] = ClientCommands::LoadCheckpoints;
-  commands_["rankings"] = ClientCommands::Rankings;
-  commands_["seasons"] = ClientCommands::ListSeasons;
-  commands_["getchatreplay"] = ClientCommands::GetChatReplay;
-}
-
-bool Commands::ClientCommand(gentity_t *ent, const std::string &commandStr) {
-  G_DPrintf("Commands::ClientCommand called for %d\n", ClientNum(ent));
-
-  ConstCommandIterator command = commands_.find(commandStr);
-  if (command == commands_.end()) {
-    return false;
+  const std::pair<const char *, Command> clientCommands[] = {
+      {"backup", ClientCommands::BackupLoad},
+      {"save", ClientCommands::Save},
+      {"load", ClientCommands::Load},
+      {"unload", ClientCommands::Unload},
+      //    {"race", ClientCommands::Race},
+      {"listinfo", ClientCommands::listCustomVotes},
+      {"customvotes", ClientCommands::listCustomVotes},
+      {"records", ClientCommands::Records},
+      {"times", ClientCommands::Records},
+      {"ranks", ClientCommands::Records},
+      {"top", ClientCommands::Records},
+      {"loadcheckpoints", ClientCommands::LoadCheckpoints},
+      {"load-checkpoints", ClientCommands::LoadCheckpoints},
+      {"rankings", ClientCommands::Rankings},
+      {"seasons", ClientCommands::ListSeasons},
+      {"getchatreplay", ClientCommands::GetChatReplay},
+  };
+
+  for (const auto &command : clientCommands) {
+    const auto handler = command.second;
+    registry.add(command.first, ETJump::ClientCommandPhase::NoIntermission,
+                 ETJump::FloodProtection::None, "",
+                 [handler](gentity_t *ent) { handler(ent, GetArgs()); });
   }
-
-  command->second(ent, GetArgs());
-
-  return true;
 }
 
 bool Commands::List(gentity_t *ent) {
@@ -29,18 +29,19 @@
 #include <map>
 #include <functional>
 
+namespace ETJump {
+class ClientCommandRegistry;
+} // namespace ETJump
+
 class Commands {
 public:
-  Commands();
-  bool ClientCommand(gentity_t *ent, const std::string &command);
+  explicit Commands(ETJump::ClientCommandRegistry &registry);
   bool AdminCommand(gentity_t *ent);
   bool List(gentity_t *ent);
   char FindCommandFlag(const std::string &command);
   void ListCommandFlags(gentity_t *ent);
 
 private:
-  std::map<std::string, std::function<bool(gentity_t *ent, Arguments argv)>>
-      commands_;
   std::map<std::string,
            std::pair<std::function<bool(gentity_t *ent, Arguments argv)>, char>>
       adminCommands_;
@@ -945,6 +945,9 @@ bool Database::InitDatabase(char const *config) {
     return false;
   }
 
+  // only takes effect on a new database, lets the maintenance pass
+  // shrink it without a full VACUUM
+  sqlite3_exec(db_, "PRAGMA auto_vacuum=INCREMENTAL;", NULL, NULL, NULL);
   sqlite3_exec(db_, "PRAGMA journal_mode=WAL;", NULL, NULL, NULL);
 
   if (!CreateUsersTable() || !CreateBansTable() || !CreateNamesTable()) {
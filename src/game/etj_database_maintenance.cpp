@@ -0,0 +1,448 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <cstdio>
+#include <sqlite3.h>
+
+#include "etj_database_maintenance.h"
+
+#include "etj_log.h"
+#include "etj_string_utilities.h"
+#include "etj_synchronization_context.h"
+#include "etj_time_utilities.h"
+
+namespace ETJump {
+// incremental vacuum holds the write lock while it runs, so each pass only
+// returns this many free pages to the file system
+static const int MAX_VACUUM_PAGES = 1024;
+// how long the optimize pass waits for the game's own connections
+static const int BUSY_TIMEOUT_MS = 1000;
+// rows ANALYZE samples per index, large tables are not scanned in full
+static const int ANALYSIS_LIMIT = 1000;
+// a backup that started over this many times copies the rest in one step,
+// otherwise a busy database might never finish
+static const int MAX_BACKUP_RESTARTS = 5;
+
+namespace {
+class StepResult : public SynchronizationContext::ResultBase {
+public:
+  StepResult(bool done, std::string message)
+      : done(done), message(std::move(message)) {}
+
+  bool done;
+  std::string message;
+};
+
+std::runtime_error sqliteError(sqlite3 *db, const std::string &what) {
+  return std::runtime_error(stringFormat(
+      "%s: %s", what, db != nullptr ? sqlite3_errmsg(db) : "out of memory"));
+}
+
+sqlite3 *openDatabase(const std::string &path, int flags) {
+  sqlite3 *db = nullptr;
+  if (sqlite3_open_v2(path.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+    auto error = sqliteError(db, stringFormat("could not open `%s`", path));
+    sqlite3_close(db);
+    throw error;
+  }
+  return db;
+}
+
+void execute(sqlite3 *db, const std::string &query) {
+  if (sqlite3_exec(db, query.c_str(), nullptr, nullptr, nullptr) !=
+      SQLITE_OK) {
+    throw sqliteError(db, stringFormat("`%s` failed", query));
+  }
+}
+
+int pragmaValue(sqlite3 *db, const std::string &pragma) {
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db, ("PRAGMA " + pragma + ";").c_str(), -1, &stmt,
+                         nullptr) != SQLITE_OK) {
+    throw sqliteError(db, stringFormat("could not read `%s`", pragma));
+  }
+
+  const int value =
+      sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+  sqlite3_finalize(stmt);
+  return value;
+}
+
+std::string formatTimestamp(long long timestamp) {
+  return Time::fromInt(static_cast<int>(timestamp / 1000)).toDateTimeString() +
+         " UTC";
+}
+
+std::string scheduleString(long long interval, long long last) {
+  const std::string lastRun =
+      last > 0 ? "last " + formatTimestamp(last) : "never ran";
+
+  if (interval <= 0) {
+    return "not scheduled, " + lastRun;
+  }
+
+  return stringFormat("every %s, %s",
+                      getPluralizedString(interval / 3600000, "hour"),
+                      lastRun);
+}
+} // namespace
+
+// Everything in a job except the constant fields is only touched by the
+// step that is running on the worker, or after the worker has stopped.
+struct DatabaseMaintenance::Job {
+  Job(Pass pass, size_t target, std::string path, int pagesPerStep)
+      : pass(pass), target(target), path(std::move(path)),
+        pagesPerStep(pagesPerStep) {}
+
+  ~Job() {
+    close();
+
+    // an interrupted backup leaves nothing but the temporary copy behind
+    if (pass == Pass::Backup && !finished) {
+      std::remove(temporaryPath().c_str());
+    }
+  }
+
+  std::unique_ptr<SynchronizationContext::ResultBase> step() {
+    return pass == Pass::Backup ? backupStep() : optimize();
+  }
+
+  const Pass pass;
+  const size_t target;
+  const std::string path;
+  const int pagesPerStep;
+
+private:
+  std::string temporaryPath() const { return backupPath(path) + ".tmp"; }
+
+  void close() {
+    if (backup != nullptr) {
+      sqlite3_backup_finish(backup);
+      backup = nullptr;
+    }
+    sqlite3_close(destination);
+    destination = nullptr;
+    sqlite3_close(source);
+    source = nullptr;
+  }
+
+  // Copies the next few pages into the temporary file and swaps it in
+  // place once the whole database has been copied. The source is only
+  // read-locked for the duration of a single step. If another connection
+  // writes to it in between, sqlite starts over from the first page on
+  // the next step, so after MAX_BACKUP_RESTARTS the rest is copied in a
+  // single step. In WAL mode that still doesn't block the game's writes.
+  std::unique_ptr<StepResult> backupStep() {
+    if (backup == nullptr) {
+      std::remove(temporaryPath().c_str());
+
+      source = openDatabase(path, SQLITE_OPEN_READWRITE);
+      destination = openDatabase(temporaryPath(),
+                                 SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+      backup = sqlite3_backup_init(destination, "main", source, "main");
+      if (backup == nullptr) {
+        throw sqliteError(destination, "could not start backup");
+      }
+    }
+
+    const int rc = sqlite3_backup_step(
+        backup, restarts < MAX_BACKUP_RESTARTS ? pagesPerStep : -1);
+    const int total = sqlite3_backup_pagecount(backup);
+    const int copied = total - sqlite3_backup_remaining(backup);
+
+    // every step that gets to read the source copies new pages, unless
+    // the copy started over from the first page
+    const bool readSource = rc != SQLITE_BUSY && rc != SQLITE_LOCKED;
+    if (readSource && copiedPages > 0 && copied <= copiedPages) {
+      restarts++;
+    }
+    if (readSource) {
+      copiedPages = copied;
+    }
+
+    // SQLITE_OK means there are pages left to copy, busy or locked means
+    // the source couldn't be read this time, both continue on the next step
+    if (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+      return std::make_unique<StepResult>(
+          false, stringFormat("copying, %d of %d pages%s", copied, total,
+                              restartString()));
+    }
+
+    if (rc != SQLITE_DONE) {
+      throw sqliteError(destination, "backup failed");
+    }
+
+    close();
+
+    const auto target = backupPath(path);
+    std::remove(target.c_str());
+    if (std::rename(temporaryPath().c_str(), target.c_str()) != 0) {
+      throw std::runtime_error(
+          stringFormat("could not move backup to `%s`", target));
+    }
+
+    finished = true;
+
+    return std::make_unique<StepResult>(
+        true, stringFormat("wrote %d pages to `%s`%s", total, target,
+                           restartString()));
+  }
+
+  std::string restartString() const {
+    return restarts > 0
+               ? ", restarted " + getPluralizedString(restarts, "time")
+               : "";
+  }
+
+  std::unique_ptr<StepResult> optimize() {
+    source = openDatabase(path, SQLITE_OPEN_READWRITE);
+    sqlite3_busy_timeout(source, BUSY_TIMEOUT_MS);
+
+    // PRAGMA optimize only looks at tables this connection has queried,
+    // which is none, so run a sampled ANALYZE instead
+    execute(source, stringFormat("PRAGMA analysis_limit=%d;", ANALYSIS_LIMIT));
+    execute(source, "ANALYZE;");
+
+    // only databases created with incremental auto vacuum can shrink
+    // without a full VACUUM, which would lock them for far too long
+    if (pragmaValue(source, "auto_vacuum") == 2) {
+      execute(source,
+              stringFormat("PRAGMA incremental_vacuum(%d);", MAX_VACUUM_PAGES));
+    }
+
+    // passive never waits on readers or writers, whatever it can't
+    // copy back now is left for the next pass
+    int walFrames = -1;
+    int checkpointed = -1;
+    if (sqlite3_wal_checkpoint_v2(source, nullptr, SQLITE_CHECKPOINT_PASSIVE,
+                                  &walFrames, &checkpointed) != SQLITE_OK) {
+      throw sqliteError(source, "checkpoint failed");
+    }
+
+    const int freePages = pragmaValue(source, "freelist_count");
+    const int pages = pragmaValue(source, "page_count");
+
+    close();
+    finished = true;
+
+    std::string message = "analyzed";
+    if (walFrames >= 0) {
+      message += stringFormat(", checkpointed %d of %d WAL frames",
+                              checkpointed, walFrames);
+    }
+    message += stringFormat(", %d of %d pages free", freePages, pages);
+
+    return std::make_unique<StepResult>(true, message);
+  }
+
+  sqlite3 *source{};
+  sqlite3 *destination{};
+  sqlite3_backup *backup{};
+  // pages copied after the previous backup step
+  int copiedPages{};
+  int restarts{};
+  bool finished{};
+};
+
+DatabaseMaintenance::DatabaseMaintenance(
+    std::vector<Target> targets, Options options, std::unique_ptr<Log> logger,
+    std::unique_ptr<SynchronizationContext> context)
+    : _targets(std::move(targets)), _options(options),
+      _logger(std::move(logger)), _sc(std::move(context)),
+      _status(_targets.size()), _lastBackup(options.lastBackup),
+      _lastOptimize(options.lastOptimize) {}
+
+DatabaseMaintenance::~DatabaseMaintenance() { shutdown(); }
+
+void DatabaseMaintenance::initialize() {
+  if (_running) {
+    return;
+  }
+
+  _sc->startWorkerThreads(1);
+  _running = true;
+}
+
+void DatabaseMaintenance::shutdown() {
+  if (!_running) {
+    return;
+  }
+
+  // waits for the step that is running, the rest of the pass is dropped
+  _sc->stopWorkerThreads();
+  _running = false;
+  _stepPending = false;
+  _jobs.clear();
+}
+
+void DatabaseMaintenance::runFrame() {
+  if (!_running) {
+    return;
+  }
+
+  _sc->processCompletedTasks();
+
+  // the previous step is still running, check again next frame
+  if (_stepPending) {
+    return;
+  }
+
+  if (_jobs.empty()) {
+    schedule();
+  }
+
+  if (!_jobs.empty()) {
+    postStep();
+  }
+}
+
+bool DatabaseMaintenance::requestBackup() {
+  if (!_running || _targets.empty() || isQueued(Pass::Backup)) {
+    return false;
+  }
+
+  enqueue(Pass::Backup);
+  return true;
+}
+
+bool DatabaseMaintenance::requestOptimize() {
+  if (!_running || _targets.empty() || isQueued(Pass::Optimize)) {
+    return false;
+  }
+
+  enqueue(Pass::Optimize);
+  return true;
+}
+
+bool DatabaseMaintenance::isIdle() const {
+  return _jobs.empty() && !_stepPending;
+}
+
+std::string DatabaseMaintenance::status() const {
+  std::string buffer = "^7Database maintenance\n";
+  buffer += stringFormat("  ^7backups: ^z%s\n",
+                         scheduleString(_options.backupInterval, _lastBackup));
+  buffer += stringFormat(
+      "  ^7optimize: ^z%s\n",
+      scheduleString(_options.optimizeInterval, _lastOptimize));
+
+  for (size_t i = 0; i < _targets.size(); i++) {
+    buffer += stringFormat("  ^3%s ^z(%s)\n", _targets[i].name,
+                           _targets[i].path);
+    buffer += stringFormat("    ^7backup: ^z%s\n", _status[i].backup);
+    buffer += stringFormat("    ^7optimize: ^z%s\n", _status[i].optimize);
+  }
+
+  if (_targets.empty()) {
+    buffer += "  ^zno databases configured\n";
+  }
+
+  return buffer;
+}
+
+void DatabaseMaintenance::schedule() {
+  const auto now = getCurrentTimestamp();
+
+  if (_options.backupInterval > 0 &&
+      now - _lastBackup >= _options.backupInterval) {
+    enqueue(Pass::Backup);
+  }
+
+  if (_options.optimizeInterval > 0 &&
+      now - _lastOptimize >= _options.optimizeInterval) {
+    enqueue(Pass::Optimize);
+  }
+}
+
+void DatabaseMaintenance::enqueue(Pass pass) {
+  for (size_t i = 0; i < _targets.size(); i++) {
+    _jobs.push_back(std::make_shared<Job>(pass, i, _targets[i].path,
+                                          _options.backupPagesPerStep));
+  }
+}
+
+bool DatabaseMaintenance::isQueued(Pass pass) const {
+  for (const auto &job : _jobs) {
+    if (job->pass == pass) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DatabaseMaintenance::postStep() {
+  auto job = _jobs.front();
+  _stepPending = true;
+
+  _sc->postTask(
+      [job]() { return job->step(); },
+      [this](std::unique_ptr<SynchronizationContext::ResultBase> result) {
+        auto stepResult = dynamic_cast<StepResult *>(result.get());
+        completeStep(stepResult->done, false, stepResult->message);
+      },
+      [this](const std::runtime_error &e) {
+        completeStep(true, true, e.what());
+      });
+}
+
+void DatabaseMaintenance::completeStep(bool done, bool failed,
+                                       const std::string &message) {
+  _stepPending = false;
+
+  if (_jobs.empty()) {
+    return;
+  }
+
+  const auto job = _jobs.front();
+  const auto &name = _targets[job->target].name;
+  const bool isBackup = job->pass == Pass::Backup;
+  auto &status =
+      isBackup ? _status[job->target].backup : _status[job->target].optimize;
+
+  if (!done) {
+    status = message;
+    return;
+  }
+
+  const auto now = getCurrentTimestamp();
+  status = stringFormat("%s%s (%s)", failed ? "failed: " : "", message,
+                        formatTimestamp(now));
+
+  if (failed) {
+    _logger->error("%s of `%s` failed: %s", isBackup ? "Backup" : "Optimize",
+                   name, message);
+  } else {
+    _logger->info("%s of `%s` done: %s", isBackup ? "Backup" : "Optimize",
+                  name, message);
+  }
+
+  _jobs.pop_front();
+
+  // failed passes count as well, they are retried on the next interval
+  // rather than on every frame
+  if (!isQueued(job->pass)) {
+    (isBackup ? _lastBackup : _lastOptimize) = now;
+  }
+}
+} // namespace ETJump
@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ETJump {
+class Log;
+class SynchronizationContext;
+
+// Keeps the sqlite databases healthy while the server is running: online
+// backups through the sqlite backup API and periodic ANALYZE, incremental
+// vacuum and WAL checkpoint passes. All database work runs on the
+// synchronization context's worker, one small step at a time, so the
+// frame only ever checks for finished steps and posts the next one.
+class DatabaseMaintenance {
+public:
+  struct Target {
+    // short name used in the status output, e.g. `users`
+    std::string name;
+    std::string path;
+  };
+
+  struct Options {
+    // milliseconds between scheduled passes, 0 disables the schedule
+    long long backupInterval = 0;
+    long long optimizeInterval = 0;
+    // how many pages a single backup step copies
+    int backupPagesPerStep = 64;
+    // timestamps of the previous passes, carried over map changes
+    long long lastBackup = 0;
+    long long lastOptimize = 0;
+  };
+
+  DatabaseMaintenance(std::vector<Target> targets, Options options,
+                      std::unique_ptr<Log> logger,
+                      std::unique_ptr<SynchronizationContext> context);
+  ~DatabaseMaintenance();
+
+  void initialize();
+  void shutdown();
+  void runFrame();
+
+  // Queue a pass over every target. Returns false if the same pass is
+  // already queued or running.
+  bool requestBackup();
+  bool requestOptimize();
+
+  bool isIdle() const;
+  std::string status() const;
+
+  long long lastBackup() const { return _lastBackup; }
+  long long lastOptimize() const { return _lastOptimize; }
+
+  static std::string backupPath(const std::string &path) {
+    return path + ".backup";
+  }
+
+private:
+  enum class Pass { Backup, Optimize };
+
+  struct Job;
+
+  struct TargetStatus {
+    std::string backup = "never";
+    std::string optimize = "never";
+  };
+
+  void schedule();
+  void enqueue(Pass pass);
+  bool isQueued(Pass pass) const;
+  void postStep();
+  void completeStep(bool done, bool failed, const std::string &message);
+
+  std::vector<Target> _targets;
+  Options _options;
+  std::unique_ptr<Log> _logger;
+  std::unique_ptr<SynchronizationContext> _sc;
+
+  // only the front job has a step on the worker at any time
+  std::deque<std::shared_ptr<Job>> _jobs;
+  std::vector<TargetStatus> _status;
+  bool _stepPending{false};
+  bool _running{false};
+  long long _lastBackup;
+  long long _lastOptimize;
+};
+} // namespace ETJump
@@ -35,7 +35,12 @@ DatabaseV2::DatabaseV2(const std::string& name, const std::string &fileName)
   : sql(sqlite::database(fileName)), _name(name) {
   logger.info(
       stringFormat("Initializing `%s` at `%s`", name, fileName));
+  // only takes effect on a new database, lets the maintenance pass
+  // shrink it without a full VACUUM
+  sql << "PRAGMA auto_vacuum=INCREMENTAL;";
   sql << "PRAGMA journal_mode=WAL;";
+  // the maintenance pass briefly holds the write lock while it analyzes
+  sql << "PRAGMA busy_timeout=5000;";
 
   sql.define("lsanitize",
              [](std::string s) { return ETJump::sanitize(s, true); });
@@ -45,6 +50,20 @@ DatabaseV2::DatabaseV2(const std::string& name, const std::string &fileName)
 
 DatabaseV2::~DatabaseV2() = default;
 
+sqlite::database_binder &DatabaseV2::statement(const std::string &query) {
+  auto it = _statements.find(query);
+  if (it != _statements.end()) {
+    return *it->second;
+  }
+
+  auto binder = std::make_unique<sqlite::database_binder>(sql << query);
+  // a statement that is never executed would otherwise run when the
+  // cache is destroyed, marking it used also resets it on first bind
+  binder->used(true);
+
+  return *_statements.emplace(query, std::move(binder)).first->second;
+}
+
 void DatabaseV2::addMigration(const Migration &migration) {
   _migrations.push_back(migration);
 }
@@ -23,7 +23,9 @@
  */
 
 #pragma once
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <sqlite_modern_cpp.h>
 
 #include "etj_container_utilities.h"
@@ -53,6 +55,14 @@ public:
     }), ",");
   }
 
+  // Returns a statement for the query that is prepared on first use and
+  // reused on later calls with the same text. Binding the first value
+  // resets the previous execution, so only use this for queries with
+  // fixed text, and only from one thread at a time. Every distinct text
+  // stays prepared until the database is closed, so queries built with
+  // stringFormat go through sql instead.
+  sqlite::database_binder &statement(const std::string &query);
+
   // expose the database object directly
   // as it provides a reasonable interface
   // to database
@@ -61,5 +71,8 @@ public:
 private:
   std::string _name;
   std::vector<Migration> _migrations;
+  // declared after sql so the statements are finalized first
+  std::unordered_map<std::string, std::unique_ptr<sqlite::database_binder>>
+      _statements;
 };
 }
@@ -31,7 +31,7 @@
 #include "etj_string_utilities.h"
 
 ETJump::File::File(const std::string &path, Mode mode)
-    : _path(path), _handle(INVALID_FILE_HANDLE), _mode(mode) {
+    : _path(path), _handle(INVALID_FILE_HANDLE), _position(0), _mode(mode) {
   fsMode_t fsMode;
   switch (_mode) {
     case Mode::Read:
@@ -68,14 +68,35 @@ std::vector<char> ETJump::File::read(int bytes) {
     throw std::logic_error(
         "Cannot read from a file when mode is not Mode::Read.");
   }
-  auto readBytes =
-      bytes == READ_ALL_BYTES ? _length : (_length >= bytes ? bytes : _length);
+  const int remaining = _length - _position;
+  auto readBytes = bytes == READ_ALL_BYTES
+                       ? remaining
+                       : (remaining >= bytes ? bytes : remaining);
   auto buffer = std::vector<char>(readBytes);
 
   trap_FS_Read(buffer.data(), readBytes, _handle);
+  _position += readBytes;
   return buffer;
 }
 
+int ETJump::File::read(char *buffer, int bytes) {
+  if (_mode != Mode::Read) {
+    throw std::logic_error(
+        "Cannot read from a file when mode is not Mode::Read.");
+  }
+  const int remaining = _length - _position;
+  const int readBytes = remaining >= bytes ? bytes : remaining;
+  if (readBytes <= 0) {
+    return 0;
+  }
+
+  trap_FS_Read(buffer, readBytes, _handle);
+  _position += readBytes;
+  return readBytes;
+}
+
+int ETJump::File::length() const { return _length; }
+
 void ETJump::File::write(const std::string &data) const {
   write(data.c_str(), data.length());
 }
@@ -68,6 +68,13 @@ public:
   // if file length < bytes, reads length bytes
   std::vector<char> read(int bytes = READ_ALL_BYTES);
 
+  // reads up to `bytes` bytes into a caller owned buffer, continuing
+  // from where the previous read left off.
+  // returns the number of bytes read, 0 at end of file
+  int read(char *buffer, int bytes);
+
+  int length() const;
+
   // writes all data to the file
   // throws std::logic_error if mode is Read
   // throws WriteFailedException if written bytes count != data bytes
@@ -87,6 +94,7 @@ private:
   std::string _path;
   FileHandle _handle;
   int _length;
+  int _position;
   Mode _mode;
 };
 } // namespace ETJump
@@ -38,7 +38,13 @@ void ETJump::FileSystem::copy(const std::string &src, const std::string &dst) {
     return;
   File srcFile(src, File::Mode::Read);
   File dstFile(dst, File::Mode::Write);
-  dstFile.write(srcFile.read());
+
+  // copy in fixed size chunks so memory use doesn't scale with file size
+  std::vector<char> buffer(COPY_CHUNK_SIZE);
+  int bytesRead;
+  while ((bytesRead = srcFile.read(buffer.data(), COPY_CHUNK_SIZE)) > 0) {
+    dstFile.write(buffer.data(), bytesRead);
+  }
 }
 
 void ETJump::FileSystem::move(const std::string &src, const std::string &dst) {
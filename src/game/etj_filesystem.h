@@ -37,6 +37,8 @@
 namespace ETJump {
 class FileSystem {
 public:
+  static const int COPY_CHUNK_SIZE = 1 << 16;
+
   static void copy(const std::string &src, const std::string &dst);
   static void move(const std::string &src, const std::string &dst);
   static bool remove(const std::string &path);
@@ -28,9 +28,11 @@
 
 namespace ETJump {
 class TimerunV2;
+class DatabaseMaintenance;
 class RockTheVote;
 class Tokens;
 class ChatReplay;
+class ClientCommandRegistry;
 } // namespace ETJump
 
 class Levels;
@@ -43,6 +45,7 @@ class MapStatistics;
 struct Game {
   Game() {}
 
+  std::shared_ptr<ETJump::ClientCommandRegistry> clientCommands;
   std::shared_ptr<Levels> levels;
   std::shared_ptr<Commands> commands;
   std::shared_ptr<CustomMapVotes> customMapVotes;
@@ -52,4 +55,5 @@ struct Game {
   std::shared_ptr<ETJump::TimerunV2> timerunV2;
   std::shared_ptr<ETJump::RockTheVote> rtv;
   std::shared_ptr<ETJump::ChatReplay> chatReplay;
+  std::shared_ptr<ETJump::DatabaseMaintenance> databaseMaintenance;
 };
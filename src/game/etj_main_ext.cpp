@@ -29,6 +29,7 @@
 #include "etj_save_system.h"
 #include "etj_levels.h"
 #include "etj_database.h"
+#include "etj_database_maintenance.h"
 #include "etj_custom_map_votes.h"
 #include "etj_utilities.h"
 #include "etj_motd.h"
@@ -40,6 +41,9 @@
 #include "etj_timerun_v2.h"
 #include "etj_rtv.h"
 #include "etj_chat_replay.h"
+#include "etj_client_command_registry.h"
+#include "etj_log.h"
+#include "etj_synchronization_context.h"
 
 Game game;
 
@@ -140,6 +144,7 @@ void ChangeMap() {
 void RunFrame(int levelTime) {
   game.mapStatistics->runFrame(levelTime);
   game.timerunV2->runFrame();
+  game.databaseMaintenance->runFrame();
 
   if (game.rtv->checkAutoRtv()) {
     game.rtv->callAutoRtv();
@@ -148,9 +153,55 @@ void RunFrame(int levelTime) {
   ETJump::Log::processMessages();
 }
 
+namespace ETJump {
+// the maintenance schedule outlives the module, which is reloaded on every
+// map change, through this cvar like the client session data
+static const char *const DATABASE_MAINTENANCE_STATE = "dbmaintenance";
+static const long long HOUR_MS = 60 * 60 * 1000;
+
+static std::unique_ptr<DatabaseMaintenance> createDatabaseMaintenance() {
+  std::vector<DatabaseMaintenance::Target> targets;
+  if (strlen(g_userConfig.string) > 0) {
+    targets.push_back({"users", GetPath(g_userConfig.string)});
+  }
+  targets.push_back({"timerunv2", GetPath(g_timeruns2Database.string)});
+
+  DatabaseMaintenance::Options options;
+  options.backupInterval = std::max(g_dbBackupInterval.integer, 0) * HOUR_MS;
+  options.optimizeInterval =
+      std::max(g_dbOptimizeInterval.integer, 0) * HOUR_MS;
+
+  char state[MAX_CVAR_VALUE_STRING];
+  trap_Cvar_VariableStringBuffer(DATABASE_MAINTENANCE_STATE, state,
+                                 sizeof(state));
+  sscanf(state, "%lld %lld", &options.lastBackup, &options.lastOptimize);
+
+  return std::make_unique<DatabaseMaintenance>(
+      std::move(targets), options, std::make_unique<Log>("dbmaintenance"),
+      std::make_unique<SynchronizationContext>());
+}
+
+static void saveDatabaseMaintenanceState() {
+  trap_Cvar_Set(DATABASE_MAINTENANCE_STATE,
+                va("%lld %lld", game.databaseMaintenance->lastBackup(),
+                   game.databaseMaintenance->lastOptimize()));
+}
+} // namespace ETJump
+
 void OnGameInit() {
+  game.clientCommands = std::make_shared<ETJump::ClientCommandRegistry>();
+  G_RegisterClientCommands(*game.clientCommands);
+  game.clientCommands->add(
+      ETJump::Constants::Authentication::AUTHENTICATE,
+      ETJump::ClientCommandPhase::Connecting, ETJump::FloodProtection::None,
+      "", [](gentity_t *ent) {
+        ETJump::session->GuidReceived(ent);
+        game.timerunV2->clientConnect(ClientNum(ent),
+                                      ETJump::session->GetId(ClientNum(ent)));
+      });
+
   game.levels = std::make_shared<Levels>();
-  game.commands = std::make_shared<Commands>();
+  game.commands = std::make_shared<Commands>(*game.clientCommands);
   game.mapStatistics = std::make_shared<MapStatistics>();
   game.customMapVotes =
       std::make_shared<CustomMapVotes>(game.mapStatistics.get());
@@ -197,6 +248,9 @@ void OnGameInit() {
   game.motd->Initialize();
   game.timerunV2->initialize();
 
+  game.databaseMaintenance = ETJump::createDatabaseMaintenance();
+  game.databaseMaintenance->initialize();
+
   if (g_tokensMode.integer) {
     // Utilities::WriteFile handles the correct path
     // (etjump/...)
@@ -227,7 +281,12 @@ void OnGameShutdown() {
   if (game.timerunV2) {
     game.timerunV2->shutdown();
   }
+  if (game.databaseMaintenance) {
+    game.databaseMaintenance->shutdown();
+    ETJump::saveDatabaseMaintenanceState();
+  }
 
+  game.clientCommands = nullptr;
   game.levels = nullptr;
   game.commands = nullptr;
   game.customMapVotes = nullptr;
@@ -237,6 +296,7 @@ void OnGameShutdown() {
   game.timerunV2 = nullptr;
   game.rtv = nullptr;
   game.chatReplay = nullptr;
+  game.databaseMaintenance = nullptr;
   ETJump::Log::processMessages();
 }
 
@@ -244,17 +304,10 @@ qboolean OnConnectedClientCommand(gentity_t *ent) {
   G_DPrintf("OnClientCommand called for %d (%s): %s\n", ClientNum(ent),
             ConcatArgs(0), ent->client->pers.netname);
 
-  auto argv = GetArgs();
-  auto command = ETJump::StringUtil::toLowerCase((*argv)[0]);
-
   if (ent->client->pers.connected != CON_CONNECTED) {
     return qfalse;
   }
 
-  if (game.commands->ClientCommand(ent, command)) {
-    return qtrue;
-  }
-
   if (game.commands->AdminCommand(ent)) {
     return qtrue;
   }
@@ -262,24 +315,6 @@ qboolean OnConnectedClientCommand(gentity_t *ent) {
   return qfalse;
 }
 
-// Returning qtrue means no other commands will be checked
-qboolean OnClientCommand(gentity_t *ent) {
-  G_DPrintf("OnClientCommand called for %d (%s): %s\n", ClientNum(ent),
-            ConcatArgs(0), ent->client->pers.netname);
-
-  auto argv = GetArgs();
-  auto command = ETJump::StringUtil::toLowerCase((*argv)[0]);
-
-  if (command == ETJump::Constants::Authentication::AUTHENTICATE) {
-    ETJump::session->GuidReceived(ent);
-    game.timerunV2->clientConnect(ClientNum(ent),
-                                  ETJump::session->GetId(ClientNum(ent)));
-    return qtrue;
-  }
-
-  return qfalse;
-}
-
 /*
 =======================
 Server console commands
@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 
 #include "etj_string_utilities.h"
 
@@ -85,32 +86,110 @@ std::string ETJump::getBestMatch(const std::vector<std::string> &words,
   return smallest->first;
 }
 
-static void SanitizeConstString(const char *in, char *out, bool toLower) {
-  while (*in) {
-    if (*in == 27 || *in == '^') {
-      in++; // skip color code
-      if (*in) {
-        in++;
-      }
-      continue;
+namespace {
+enum SanitizeClass : uint8_t {
+  Keep,
+  Drop,
+  Space,
+  ColorEscape,
+  End,
+};
+
+struct SanitizeTable {
+  uint8_t classes[256];
+  char lower[256];
+  char same[256];
+};
+
+constexpr SanitizeTable buildSanitizeTable(bool engineRules) {
+  SanitizeTable table{};
+  for (int c = 0; c < 256; c++) {
+    if (c == 0) {
+      table.classes[c] = End;
+    } else if (c == ' ') {
+      table.classes[c] = Space;
+    } else if (c == '^' || (c == 27 && !engineRules)) {
+      table.classes[c] = ColorEscape;
+    } else if (c < 32 || c >= 128 || (c == 127 && engineRules)) {
+      // the old loops compared signed chars, so bytes over 127 were
+      // dropped along with the control characters
+      table.classes[c] = Drop;
+    } else {
+      table.classes[c] = Keep;
     }
 
-    if (*in < 32) {
-      in++;
-      continue;
-    }
+    table.same[c] = static_cast<char>(c);
+    table.lower[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + 32 : c);
+  }
+  return table;
+}
 
-    *out++ = (toLower) ? tolower(*in++) : *in++;
+constexpr SanitizeTable etjumpSanitizeTable = buildSanitizeTable(false);
+constexpr SanitizeTable engineSanitizeTable = buildSanitizeTable(true);
+} // namespace
+
+size_t ETJump::sanitizeInto(const char *text, size_t len, char *out,
+                            const SanitizeOptions &options) {
+  const auto &table =
+      options.engineColorRules ? engineSanitizeTable : etjumpSanitizeTable;
+  const char *map = options.toLower ? table.lower : table.same;
+  const auto in = reinterpret_cast<const unsigned char *>(text);
+
+  size_t written = 0;
+  // a folded space is only written once something follows it, it always
+  // trails at least one consumed byte so writing in place stays safe
+  bool pendingSpace = false;
+
+  for (size_t i = 0; i < len; i++) {
+    const unsigned char c = in[i];
+
+    switch (table.classes[c]) {
+      case Keep:
+        if (pendingSpace) {
+          out[written++] = ' ';
+          pendingSpace = false;
+        }
+        out[written++] = map[c];
+        break;
+      case Space:
+        if (!options.foldWhitespace) {
+          out[written++] = ' ';
+        } else if (written > 0) {
+          pendingSpace = true;
+        }
+        break;
+      case ColorEscape: {
+        const unsigned char next = i + 1 < len ? in[i + 1] : 0;
+        if (!options.engineColorRules) {
+          // skip the color code, unless the string ends here
+          if (next) {
+            i++;
+          }
+        } else if (next && next != '^') {
+          i++;
+        } else {
+          if (pendingSpace) {
+            out[written++] = ' ';
+            pendingSpace = false;
+          }
+          out[written++] = '^';
+        }
+        break;
+      }
+      case End:
+        return written;
+      default:
+        break;
+    }
   }
 
-  *out = 0;
+  return written;
 }
 
 std::string ETJump::sanitize(const std::string &text, bool toLower) {
-  auto len = text.length();
-  std::vector<char> out(len + 1);
-  SanitizeConstString(text.c_str(), out.data(), toLower ? true : false);
-  return std::string(out.data());
+  std::string out(text.size(), '\0');
+  out.resize(sanitizeInto(text.data(), text.size(), &out[0], {toLower}));
+  return out;
 }
 
 std::string ETJump::getValue(const char *value,
@@ -315,6 +394,17 @@ bool ETJump::StringUtil::iEqual(const std::string &str1,
                     });
 }
 
+size_t ETJump::StringUtil::CaseInsensitiveHash::operator()(
+    const std::string &str) const {
+  // FNV-1a over the lowercased characters
+  size_t hash = 2166136261u;
+  for (const auto c : str) {
+    hash ^= static_cast<size_t>(std::tolower(static_cast<unsigned char>(c)));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
 unsigned ETJump::StringUtil::countExtraPadding(const std::string &input) {
   return input.length() - sanitize(input).length();
 }
@@ -41,6 +41,23 @@ std::string hash(const std::string &input);
 std::string getBestMatch(const std::vector<std::string> &words,
                          const std::string &current);
 std::string sanitize(const std::string &text, bool toLower = false);
+
+struct SanitizeOptions {
+  bool toLower = false;
+  // collapses runs of spaces into one and drops leading and trailing ones
+  bool foldWhitespace = false;
+  // Q_CleanStr rules: "^^" leaves a literal caret and only printable
+  // ASCII is kept. By default every '^' or escape eats the next
+  // character and only control characters are dropped.
+  bool engineColorRules = false;
+};
+
+// Writes up to len characters of text to out with color codes and
+// control characters removed, stopping early at a null byte. out must
+// hold len bytes and may point to text itself. Nothing is allocated and
+// out is not null terminated, the sanitized length is returned.
+size_t sanitizeInto(const char *text, size_t len, char *out,
+                    const SanitizeOptions &options = {});
 // returns the value if it's specified, else the default value
 std::string getValue(const char *value, const std::string &defaultValue = "");
 std::string getValue(const std::string &value,
@@ -104,6 +121,16 @@ bool contains(const std::string &str, const std::string &text);
 // case-insensitive string comparison, optionally with sanitized strings
 bool iEqual(const std::string &str1, const std::string &str2,
             bool sanitized = false);
+// hash and key equality for unordered containers matching keys
+// case-insensitively, without lowercasing the key first
+struct CaseInsensitiveHash {
+  size_t operator()(const std::string &str) const;
+};
+struct CaseInsensitiveEqual {
+  bool operator()(const std::string &lhs, const std::string &rhs) const {
+    return iEqual(lhs, rhs);
+  }
+};
 // Counts the extra padding needed when using format specifiers like
 // %-20s with text that contains ET color codes
 unsigned countExtraPadding(const std::string &input);
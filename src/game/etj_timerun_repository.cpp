@@ -81,29 +81,41 @@ ETJump::Timerun::Record getRecordFromStandardQueryResult(
   return record;
 }
 
-void ETJump::TimerunRepository::initialize() { migrate(); }
+void ETJump::TimerunRepository::initialize() {
+  migrate();
+
+  // season lists are bound through this table instead of being spliced
+  // into the query text, so those queries can be prepared once
+  _database->sql << R"(
+    create temp table if not exists bound_season_ids (
+      id integer primary key
+    );
+  )";
+}
 
 void ETJump::TimerunRepository::shutdown() { _database = nullptr; }
 
 std::vector<ETJump::Timerun::Record>
 ETJump::TimerunRepository::getRecordsForPlayer(
     const std::vector<int> activeSeasons, const std::string &map, int userId) {
-  auto parameters = StringUtil::join(
-      Container::map(activeSeasons,
-                     [](int season) { return std::to_string(season); }),
-      ", ");
-
-  auto binder = _database->sql
-                << stringFormat(R"(
-          select
-            %s
-          from record
-          where season_id in (%s) and
-            map=? and
-            user_id=?;
-        )",
-                                _defaultRecordFieldsStr, parameters)
-                << map << userId;
+  bindSeasonIds(activeSeasons);
+
+  auto &binder = _database->statement(R"(
+    select
+      season_id,
+      map,
+      run,
+      user_id,
+      time,
+      checkpoints,
+      record_date,
+      player_name,
+      metadata
+    from record
+    where season_id in (select id from temp.bound_season_ids) and
+      map=? and
+      user_id=?;
+  )") << map << userId;
 
   auto records = getRecordsFromQuery(binder);
 
@@ -113,10 +125,9 @@ ETJump::TimerunRepository::getRecordsForPlayer(
 ETJump::Timerun::Season
 ETJump::TimerunRepository::addSeason(Timerun::AddSeasonParams params) {
   int count = 0;
-  _database->sql << R"(
-                      select count(name) from season where name=? collate nocase;
-                    )"
-                 << params.name >>
+  _database->statement(R"(
+    select count(name) from season where name=? collate nocase;
+  )") << params.name >>
       count;
 
   if (count > 0) {
@@ -130,7 +141,7 @@ ETJump::TimerunRepository::addSeason(Timerun::AddSeasonParams params) {
     }
   }
 
-  std::string insert = R"(
+  auto &insert = _database->statement(R"(
                     insert into season (
                       name,
                       start_time,
@@ -140,15 +151,15 @@ ETJump::TimerunRepository::addSeason(Timerun::AddSeasonParams params) {
                       ?,
                       ?
                     );
-                  )";
+                  )");
 
   if (params.endTime.hasValue())
-    _database->sql << insert << params.name
-                   << params.startTime.toDateTimeString()
-                   << (*params.endTime).toDateTimeString();
+    insert << params.name << params.startTime.toDateTimeString()
+           << (*params.endTime).toDateTimeString();
   else
-    _database->sql << insert << params.name
-                   << params.startTime.toDateTimeString() << nullptr;
+    insert << params.name << params.startTime.toDateTimeString() << nullptr;
+
+  insert.execute();
 
   return Timerun::Season{static_cast<int>(_database->sql.last_insert_rowid()),
                          params.name, params.startTime, params.endTime};
@@ -160,7 +171,9 @@ ETJump::TimerunRepository::getRecordsForPlayer(
     const std::string &run, int userId) {
   auto records = std::vector<Timerun::Record>();
 
-  _database->sql << stringFormat(R"(
+  bindSeasonIds(activeSeasons);
+
+  _database->statement(R"(
     select
       season_id,
       map,
@@ -172,13 +185,12 @@ ETJump::TimerunRepository::getRecordsForPlayer(
       player_name,
       metadata
     from record
-    where season_id in (%s) and
+    where season_id in (select id from temp.bound_season_ids) and
       map=? and
       run=? and
       user_id=?;
-    )",
-                                 StringUtil::join(activeSeasons, ", "))
-                 << map << run << userId >>
+    )") << map
+          << run << userId >>
       [&records](int seasonId, std::string map, std::string runName, int userId,
                  int time, std::string checkpointsString,
                  std::string recordDate, std::string playerName,
@@ -200,7 +212,7 @@ ETJump::TimerunRepository::getRecordsForRun(const std::string &map,
 }
 
 void ETJump::TimerunRepository::insertRecord(const Timerun::Record &record) {
-  _database->sql << R"(
+  auto &insert = _database->statement(R"(
     insert into record (
       season_id,
       map,
@@ -222,15 +234,17 @@ void ETJump::TimerunRepository::insertRecord(const Timerun::Record &record) {
       ?,
       ?
     );
-  )" << record.seasonId
-                 << record.map << record.run << record.userId << record.time
-                 << StringUtil::join(record.checkpoints, ",")
-                 << record.recordDate.toDateTimeString() << record.playerName
-                 << serializeMetadata(record.metadata);
+  )");
+
+  insert << record.seasonId << record.map << record.run << record.userId
+         << record.time << StringUtil::join(record.checkpoints, ",")
+         << record.recordDate.toDateTimeString() << record.playerName
+         << serializeMetadata(record.metadata);
+  insert.execute();
 }
 
 void ETJump::TimerunRepository::updateRecord(const Timerun::Record &record) {
-  _database->sql << R"(
+  auto &update = _database->statement(R"(
     update
       record
     set
@@ -244,18 +258,20 @@ void ETJump::TimerunRepository::updateRecord(const Timerun::Record &record) {
       map=? and
       run=? and
       user_id=?;
-  )" << record.time
-                 << StringUtil::join(record.checkpoints, ",")
-                 << record.recordDate.toDateTimeString() << record.playerName
-                 << serializeMetadata(record.metadata) << record.seasonId
-                 << record.map << record.run << record.userId;
+  )");
+
+  update << record.time << StringUtil::join(record.checkpoints, ",")
+         << record.recordDate.toDateTimeString() << record.playerName
+         << serializeMetadata(record.metadata) << record.seasonId << record.map
+         << record.run << record.userId;
+  update.execute();
 }
 
 ETJump::opt<ETJump::Timerun::Record>
 ETJump::TimerunRepository::getTopRecord(int seasonId, const std::string &map,
                                         const std::string &run) {
   opt<Timerun::Record> record;
-  _database->sql << R"(
+  _database->statement(R"(
     select
       season_id,
       map,
@@ -273,8 +289,8 @@ ETJump::TimerunRepository::getTopRecord(int seasonId, const std::string &map,
       run=?
     order by time asc
     limit 1
-    )" << seasonId
-                 << map << run >>
+    )") << seasonId
+          << map << run >>
       [&record](int seasonId, std::string map, std::string runName, int userId,
                 int time, std::string checkpointsString, std::string recordDate,
                 std::string playerName, std::string metadataString) {
@@ -289,43 +305,39 @@ ETJump::TimerunRepository::getTopRecord(int seasonId, const std::string &map,
 std::vector<ETJump::Timerun::Record>
 ETJump::TimerunRepository::getTopRecords(const std::vector<int> &seasonIds,
                                          const std::string &map,
-                                         const std::string &run) const {
-  auto seasonIdsPlaceholder = DatabaseV2::createPlaceholderString(seasonIds);
-
-  std::string query = stringFormat(
-      R"(
-        select *
-        from (select season_id,
-                     map,
-                     run,
-                     user_id,
-                     time,
-                     checkpoints,
-                     record_date,
-                     player_name,
-                     metadata,
-                     rank() over (partition by season_id, map, run order by time asc) as rank
-              FROM record
-              where season_id in (%s)
+                                         const std::string &run) {
+  bindSeasonIds(seasonIds);
+
+  auto &binder = _database->statement(R"(
+        select record.season_id,
+               record.map,
+               record.run,
+               record.user_id,
+               record.time,
+               record.checkpoints,
+               record.record_date,
+               record.player_name,
+               record.metadata
+        from record
+        join (select season_id, min(time) as best_time
+              from record
+              where season_id in (select id from temp.bound_season_ids)
                 and map = ?
-                and run = ?) as ranked_records
-        where rank = 1;
-      )",
-      seasonIdsPlaceholder);
-
-  auto binder = _database->sql << query;
-
-  for (const auto &seasonId : seasonIds) {
-    binder << seasonId;
-  }
+                and run = ?
+              group by season_id) as best
+          on record.season_id = best.season_id
+         and record.time = best.best_time
+        where record.map = ?
+          and record.run = ?;
+      )");
 
-  binder << map << run;
+  binder << map << run << map << run;
 
   std::vector<Timerun::Record> records;
   binder >> [&records](int seasonId, std::string map, std::string runName,
                        int userId, int time, std::string checkpointsString,
                        std::string recordDate, std::string playerName,
-                       std::string metadataString, int rank) {
+                       std::string metadataString) {
     records.push_back(getRecordFromStandardQueryResult(
         seasonId, map, runName, userId, time, checkpointsString, recordDate,
         playerName, metadataString));
@@ -340,7 +352,7 @@ void ETJump::TimerunRepository::editSeason(
   Time startTime;
   ETJump::opt<Time> endTime;
 
-  _database->sql << R"(
+  _database->statement(R"(
     select
       id,
       start_time,
@@ -348,7 +360,7 @@ void ETJump::TimerunRepository::editSeason(
     from season
     where name=?
     collate nocase
-  )" << params.name >>
+  )") << params.name >>
       [&](int sid, std::string s, std::unique_ptr<std::string> e) {
         seasonId = sid;
         startTime = Time::fromString(s);
@@ -457,7 +469,7 @@ ETJump::TimerunRepository::getRunsForName(const std::string &map,
 }
 
 std::vector<ETJump::Timerun::Record> ETJump::TimerunRepository::getRecords() {
-  auto binder = _database->sql << R"(
+  auto &binder = _database->statement(R"(
     select
       season_id,
       map,
@@ -470,7 +482,7 @@ std::vector<ETJump::Timerun::Record> ETJump::TimerunRepository::getRecords() {
       metadata
     from record
     order by season_id, map, run, time;
-  )";
+  )");
 
   return getRecordsFromQuery(binder);
 }
@@ -534,9 +546,8 @@ std::vector<ETJump::Timerun::Record> ETJump::TimerunRepository::getRecords(
     runBinder = runs.size() == 1 ? runs[0] : "%" + run + "%";
   }
 
-  const std::string seasonPlaceholders = StringUtil::join(
-      Container::map(seasons, [](const auto &s) { return "season_id=?"; }),
-      " or ");
+  bindSeasonIds(
+      Container::map(seasons, [](const Timerun::Season &s) { return s.id; }));
 
   const std::string query = stringFormat(R"(
     select
@@ -551,41 +562,23 @@ std::vector<ETJump::Timerun::Record> ETJump::TimerunRepository::getRecords(
       metadata
     from record
     where 
-      (%s) and
+      season_id in (select id from temp.bound_season_ids) and
       map=?
       %s
     collate nocase
     order by season_id, map, run, time asc
   )",
-                                         seasonPlaceholders, runPlaceholder);
+                                         runPlaceholder);
 
   auto binder = _database->sql << query;
 
-  for (const auto &s : seasons) {
-    binder << s.id;
-  }
-
   binder << StringUtil::toLowerCase(!maps.empty() ? maps[0] : map);
 
   if (runSpecified) {
     binder << runBinder;
   }
 
-  auto records = getRecordsFromQuery(binder);
-
-  binder >> [&records](int seasonId, std::string map, std::string runName,
-                       int userId, int time, std::string checkpointsString,
-                       std::string recordDate, std::string playerName,
-                       std::string metadataString) {
-    const auto record = getRecordFromStandardQueryResult(
-        seasonId, std::move(map), std::move(runName), userId, time,
-        std::move(checkpointsString), std::move(recordDate),
-        std::move(playerName), std::move(metadataString));
-
-    records.push_back(record);
-  };
-
-  return records;
+  return getRecordsFromQuery(binder);
 }
 
 std::vector<ETJump::Timerun::Season>
@@ -615,7 +608,7 @@ ETJump::TimerunRepository::getSeasonsForName(const std::string &name,
       collate nocase
     )";
 
-    _database->sql << query << name >> handler;
+    _database->statement(query) << name >> handler;
   } else {
     query = R"(
       select
@@ -628,7 +621,7 @@ ETJump::TimerunRepository::getSeasonsForName(const std::string &name,
       collate nocase
     )";
 
-    _database->sql << query << "%" + name + "%" >> handler;
+    _database->statement(query) << "%" + name + "%" >> handler;
   }
 
   return seasons;
@@ -639,7 +632,7 @@ ETJump::TimerunRepository::getRecord(const std::string &map,
                                      const std::string &run, int rank) {
   opt<Timerun::Record> record;
 
-  _database->sql << R"(
+  _database->statement(R"(
     select *
       from (
         select
@@ -657,8 +650,8 @@ ETJump::TimerunRepository::getRecord(const std::string &map,
         where season_id=1 and map=? and lsanitize(run)=?
       ) as ranked_records
       where rank = ?;
-  )" << map << run
-                 << rank >>
+  )") << map
+          << run << rank >>
       [&record](int seasonId, std::string map, std::string runName, int userId,
                 int time, std::string checkpointsString, std::string recordDate,
                 std::string playerName, std::string metadataString, int rank) {
@@ -673,14 +666,14 @@ ETJump::TimerunRepository::getRecord(const std::string &map,
 std::vector<ETJump::Timerun::Season> ETJump::TimerunRepository::getSeasons() {
   std::vector<Timerun::Season> seasons;
 
-  _database->sql << R"(
+  _database->statement(R"(
     select
       id,
       name,
       start_time,
       end_time
     from season;
-  )" >>
+  )") >>
       [this, &seasons](int id, std::string name, std::string startTimeStr,
                        std::string endTimeStr) {
         auto startTime = Time::fromString(startTimeStr);
@@ -700,9 +693,9 @@ void ETJump::TimerunRepository::deleteSeason(const std::string &name) {
     throw std::runtime_error("Cannot delete default season.");
   }
   int id = 0;
-  _database->sql << "select coalesce((select id from season where name=? "
-                    "collate nocase), -1);"
-                 << name >>
+  _database->statement("select coalesce((select id from season where name=? "
+                       "collate nocase), -1);")
+          << name >>
       id;
   if (id < 0) {
     throw std::runtime_error(stringFormat("Season `%s` does not exist.", name));
@@ -713,8 +706,14 @@ void ETJump::TimerunRepository::deleteSeason(const std::string &name) {
     throw std::runtime_error("Cannot delete default season.");
   }
 
-  _database->sql << "delete from record where season_id=?;" << id;
-  _database->sql << "delete from season where id=?" << id;
+  auto &deleteRecords =
+      _database->statement("delete from record where season_id=?;");
+  deleteRecords << id;
+  deleteRecords.execute();
+
+  auto &deleteSeason = _database->statement("delete from season where id=?");
+  deleteSeason << id;
+  deleteSeason.execute();
 }
 
 void ETJump::TimerunRepository::tryToMigrateRecords() {
@@ -819,6 +818,27 @@ void ETJump::TimerunRepository::migrate() {
   }
 }
 
+void ETJump::TimerunRepository::bindSeasonIds(
+    const std::vector<int> &seasonIds) {
+  // active seasons rarely change, so most calls find them already bound
+  if (_seasonIdsBound && _boundSeasonIds == seasonIds) {
+    return;
+  }
+
+  _seasonIdsBound = false;
+  _database->statement("delete from temp.bound_season_ids;").execute();
+
+  auto &insert = _database->statement(
+      "insert or ignore into temp.bound_season_ids (id) values (?);");
+  for (const auto &seasonId : seasonIds) {
+    insert << seasonId;
+    insert.execute();
+  }
+
+  _boundSeasonIds = seasonIds;
+  _seasonIdsBound = true;
+}
+
 std::string ETJump::TimerunRepository::serializeMetadata(
     std::map<std::string, std::string> metadata) {
   std::string result;
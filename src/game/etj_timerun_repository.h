@@ -59,7 +59,7 @@ public:
                                     const std::string &run);
   std::vector<Timerun::Record> getTopRecords(const std::vector<int> &seasonIds,
                                              const std::string &map,
-                                             const std::string &run) const;
+                                             const std::string &run);
   void editSeason(const Timerun::EditSeasonParams &params);
   std::vector<std::string> getMapsForName(const std::string &map, bool exact);
   std::vector<std::string> getRunsForName(const std::string &map,
@@ -78,6 +78,8 @@ public:
 private:
   void tryToMigrateRecords();
   void migrate();
+  // fills temp.bound_season_ids for the queries filtering on a season list
+  void bindSeasonIds(const std::vector<int> &seasonIds);
 
   const std::vector<std::string> _defaultSeasonFields{"id", "name",
                                                       "start_time", "end_time"};
@@ -109,5 +111,8 @@ private:
   std::string serializeMetadata(std::map<std::string, std::string> metadata);
   std::unique_ptr<DatabaseV2> _database;
   std::unique_ptr<DatabaseV2> _oldDatabase;
+
+  std::vector<int> _boundSeasonIds;
+  bool _seasonIdsBound{false};
 };
 } // namespace ETJump
@@ -11,6 +11,7 @@
 #include "etj_rtv.h"
 #include "etj_utilities.h"
 #include "etj_chat_replay.h"
+#include "etj_client_command_registry.h"
 
 namespace ETJump {
 enum class VotingTypes {
@@ -185,45 +186,11 @@ Remove case and control characters
 */
 
 void SanitizeString(char *in, char *out, qboolean fToLower) {
-  while (*in) {
-    if (*in == 27 || *in == '^') {
-      in++; // skip color code
-      if (*in) {
-        in++;
-      }
-      continue;
-    }
-
-    if (*in < 32) {
-      in++;
-      continue;
-    }
-
-    *out++ = (fToLower) ? tolower(*in++) : *in++;
-  }
-
-  *out = 0;
+  SanitizeConstString(in, out, fToLower);
 }
 
 void SanitizeConstString(const char *in, char *out, qboolean fToLower) {
-  while (*in) {
-    if (*in == 27 || *in == '^') {
-      in++; // skip color code
-      if (*in) {
-        in++;
-      }
-      continue;
-    }
-
-    if (*in < 32) {
-      in++;
-      continue;
-    }
-
-    *out++ = (fToLower) ? tolower(*in++) : *in++;
-  }
-
-  *out = 0;
+  out[ETJump::sanitizeInto(in, strlen(in), out, {fToLower != qfalse})] = 0;
 }
 
 int CleanStrlen(const char *in) {
@@ -4778,7 +4745,58 @@ typedef struct {
   void (*function)(gentity_t *ent);
 } command_t;
 
+static void G_SayBuddy(gentity_t *ent, qboolean encoded) {
+  fireteamData_t *ft;
+
+  if (G_IsOnFireteam(ClientNum(ent), &ft)) {
+    Cmd_Say_f(ent, SAY_BUDDY, qfalse, encoded);
+  }
+}
+
+static void G_VoiceBuddy(gentity_t *ent) {
+  fireteamData_t *ft;
+
+  if (G_IsOnFireteam(ClientNum(ent), &ft)) {
+    Cmd_Voice_f(ent, SAY_BUDDY, qfalse, qfalse);
+  }
+}
+
+static void G_ForceTapout(gentity_t *ent) {
+  if (ent->client->ps.stats[STAT_HEALTH] <= 0 &&
+      (ent->client->sess.sessionTeam == TEAM_AXIS ||
+       ent->client->sess.sessionTeam == TEAM_ALLIES)) {
+    limbo(ent, qtrue);
+  }
+}
+
+static const command_t chatCommands[] = {
+    {"say", qtrue,
+     [](gentity_t *ent) { Cmd_Say_f(ent, SAY_ALL, qfalse, qfalse); }},
+    {"enc_say", qtrue,
+     [](gentity_t *ent) { Cmd_Say_f(ent, SAY_ALL, qfalse, qtrue); }},
+    {"say_team", qtrue,
+     [](gentity_t *ent) { Cmd_Say_f(ent, SAY_TEAM, qfalse, qfalse); }},
+    {"enc_say_team", qtrue,
+     [](gentity_t *ent) { Cmd_Say_f(ent, SAY_TEAM, qfalse, qtrue); }},
+    {"vsay", qtrue,
+     [](gentity_t *ent) { Cmd_Voice_f(ent, SAY_ALL, qfalse, qfalse); }},
+    {"vsay_team", qtrue,
+     [](gentity_t *ent) { Cmd_Voice_f(ent, SAY_TEAM, qfalse, qfalse); }},
+    {"say_buddy", qtrue, [](gentity_t *ent) { G_SayBuddy(ent, qfalse); }},
+    {"enc_say_buddy", qtrue, [](gentity_t *ent) { G_SayBuddy(ent, qtrue); }},
+    {"vsay_buddy", qtrue, G_VoiceBuddy},
+};
+
 static const command_t anyTimeCommands[] = {
+    // OSP - these are not advertised in the help screen
+    {"forcetapout", qfalse, G_ForceTapout},
+    {"wstats", qfalse, [](gentity_t *ent) { G_statsPrint(ent, 1); }},
+    // Player game stats
+    {"sgstats", qfalse, [](gentity_t *ent) { G_statsPrint(ent, 2); }},
+    // "Topshots" accuracy rankings
+    {"stshots", qfalse,
+     [](gentity_t *ent) { G_weaponStatsLeaders_cmd(ent, qtrue, qtrue); }},
+
     {"score", qfalse, Cmd_Score_f},
     {"vote", qtrue, Cmd_Vote_f},
     {"fireteam", qfalse, Cmd_FireTeam_MP_f},
@@ -4799,6 +4817,13 @@ static const command_t anyTimeCommands[] = {
 };
 
 static const command_t noIntermissionCommands[] = {
+    {"follownext", qfalse, [](gentity_t *ent) { Cmd_FollowCycle_f(ent, 1); }},
+    {"followprev", qfalse, [](gentity_t *ent) { Cmd_FollowCycle_f(ent, -1); }},
+    {"mod_information", qfalse,
+     [](gentity_t *ent) {
+       C_ConsolePrintTo(
+           ent, va("%s %s %s", GAME_NAME, GAME_VERSION_DATED, __TIME__));
+     }},
     {"class", qfalse, Cmd_Class_f},
     {"give", qfalse, Cmd_Give_f},
     {"god", qfalse, Cmd_God_f},
@@ -4856,146 +4881,87 @@ qboolean ClientIsFlooding(gentity_t *ent) {
   return qfalse;
 }
 
-void ClientCommand(int clientNum) {
-  gentity_t *ent;
-  char cmd[MAX_TOKEN_CHARS];
-  int i;
-  qboolean enc = qfalse; // used for enc_say, enc_say_team, enc_say_buddy
-  fireteamData_t *ft;
-
-  ent = g_entities + clientNum;
-
-  if (!ent->client) {
-    return; // not fully in game yet
+template <size_t N>
+static void G_RegisterCommandTable(ETJump::ClientCommandRegistry &registry,
+                                   const command_t (&commands)[N],
+                                   ETJump::ClientCommandPhase phase,
+                                   ETJump::FloodProtection floodProtection) {
+  for (const auto &command : commands) {
+    registry.add(command.cmd, phase,
+                 command.floodProtected ? floodProtection
+                                        : ETJump::FloodProtection::None,
+                 "", command.function);
   }
-  trap_Argv(0, cmd, sizeof(cmd));
+}
 
-  if (OnClientCommand(ent)) {
-    return;
-  }
+void G_RegisterClientCommands(ETJump::ClientCommandRegistry &registry) {
+  using ETJump::ClientCommandPhase;
+  using ETJump::FloodProtection;
+
+  // registration order matters for duplicate names, the first table
+  // that registers a command owns it
+  G_RegisterCommandTable(registry, chatCommands, ClientCommandPhase::Anytime,
+                         FloodProtection::Chat);
+  G_RegisterCommandTable(registry, anyTimeCommands,
+                         ClientCommandPhase::Anytime, FloodProtection::Command);
+  G_RegisterCommandTable(registry, noIntermissionCommands,
+                         ClientCommandPhase::NoIntermission,
+                         FloodProtection::Command);
+  G_RegisterExtendedCommands(registry);
+}
 
-  if (ent->client->pers.connected != CON_CONNECTED) {
+static void G_DispatchClientCommand(
+    gentity_t *ent, const ETJump::ClientCommandRegistry::Command &command,
+    const char *cmd) {
+  if (command.floodProtection != ETJump::FloodProtection::None &&
+      ClientIsFlooding(ent)) {
+    CP(va("print \"^1Spam Protection:^7 command %s^7 ignored\n\"", cmd));
     return;
   }
 
-  // Let's handle rest of the commands after checking if we're really
-  // connected.
-
-  // handle say/vsay commands
-  enc = !Q_stricmp(cmd, "enc_say") ? qtrue : qfalse;
-  if (!Q_stricmp(cmd, "say") || enc) {
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Say_f(ent, SAY_ALL, qfalse, enc);
-    }
-    return;
-  }
-  enc = !Q_stricmp(cmd, "enc_say_team") ? qtrue : qfalse;
-  if (!Q_stricmp(cmd, "say_team") || enc) {
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Say_f(ent, SAY_TEAM, qfalse, enc);
-    }
-    return;
-  }
-  if (!Q_stricmp(cmd, "vsay")) {
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Voice_f(ent, SAY_ALL, qfalse, qfalse);
-    }
-    return;
-  }
-  if (!Q_stricmp(cmd, "vsay_team")) {
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Voice_f(ent, SAY_TEAM, qfalse, qfalse);
-    }
+  if (command.floodProtection == ETJump::FloodProtection::Chat &&
+      ent->client->sess.muted) {
     return;
   }
 
-  enc = !Q_stricmp(cmd, "enc_say_buddy") ? qtrue : qfalse;
-  if (!Q_stricmp(cmd, "say_buddy") || enc) {
-    if (!G_IsOnFireteam(clientNum, &ft)) {
+  if (!command.help.empty()) {
+    char arg[MAX_TOKEN_CHARS];
+    trap_Argv(1, arg, sizeof(arg));
+    if (!Q_stricmp(arg, "?")) {
+      CP(va("print \"\n^3%s%s\n\n\"", command.name.c_str(),
+            command.help.c_str()));
       return;
     }
-
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Say_f(ent, SAY_BUDDY, qfalse, enc);
-    }
-    return;
   }
-  if (!Q_stricmp(cmd, "vsay_buddy")) {
-    if (!G_IsOnFireteam(clientNum, &ft)) {
-      return;
-    }
 
-    if (ClientIsFlooding(ent)) {
-      CP(va("print \"^1Spam Protection:^7 command %s^7 "
-            "ignored\n\"",
-            cmd));
-    } else if (!ent->client->sess.muted) {
-      Cmd_Voice_f(ent, SAY_BUDDY, qfalse, qfalse);
-    }
-    return;
-  }
+  command.handler(ent);
+}
 
-  // forcetapout
-  if (!Q_stricmp(cmd, "forcetapout")) {
-    if (ent->client->ps.stats[STAT_HEALTH] <= 0 &&
-        (ent->client->sess.sessionTeam == TEAM_AXIS ||
-         ent->client->sess.sessionTeam == TEAM_ALLIES)) {
-      limbo(ent, qtrue);
-    }
-    return;
-  }
+void ClientCommand(int clientNum) {
+  gentity_t *ent;
+  char cmd[MAX_TOKEN_CHARS];
 
-  // OSP - do these outside as we don't want to advertise it in the help
-  // screen
-  if (!Q_stricmp(cmd, "wstats")) {
-    G_statsPrint(ent, 1);
-    return;
+  ent = g_entities + clientNum;
+
+  if (!ent->client) {
+    return; // not fully in game yet
   }
-  if (!Q_stricmp(cmd, "sgstats")) // Player game stats
-  {
-    G_statsPrint(ent, 2);
+  trap_Argv(0, cmd, sizeof(cmd));
+
+  const auto command = game.clientCommands->find(cmd);
+
+  if (command && command->phase == ETJump::ClientCommandPhase::Connecting) {
+    G_DispatchClientCommand(ent, *command, cmd);
     return;
   }
-  if (!Q_stricmp(cmd, "stshots")) // "Topshots" accuracy rankings
-  {
-    G_weaponStatsLeaders_cmd(ent, qtrue, qtrue);
+
+  if (ent->client->pers.connected != CON_CONNECTED) {
     return;
   }
 
-  // regular anytime commands
-  for (i = 0; i < static_cast<int>(sizeof(anyTimeCommands) /
-                                   sizeof(anyTimeCommands[0]));
-       i++) {
-    if (!Q_stricmp(cmd, anyTimeCommands[i].cmd)) {
-      if (anyTimeCommands[i].floodProtected && ClientIsFlooding(ent)) {
-        CP(va("print \"^1Spam Protection:^7 "
-              "command %s^7 ignored\n\"",
-              cmd));
-      } else {
-        anyTimeCommands[i].function(ent);
-      }
-      return;
-    }
+  if (command && command->phase == ETJump::ClientCommandPhase::Anytime) {
+    G_DispatchClientCommand(ent, *command, cmd);
+    return;
   }
 
   // ignore all other commands when at intermission
@@ -5006,19 +4972,8 @@ void ClientCommand(int clientNum) {
     return;
   }
 
-  // follow
-  if (!Q_stricmp(cmd, "follownext")) {
-    Cmd_FollowCycle_f(ent, 1);
-    return;
-  }
-  if (!Q_stricmp(cmd, "followprev")) {
-    Cmd_FollowCycle_f(ent, -1);
-    return;
-  }
-
-  if (!Q_stricmp(cmd, "mod_information")) {
-    C_ConsolePrintTo(ent,
-                     va("%s %s %s", GAME_NAME, GAME_VERSION_DATED, __TIME__));
+  if (command) {
+    G_DispatchClientCommand(ent, *command, cmd);
     return;
   }
 
@@ -5026,26 +4981,6 @@ void ClientCommand(int clientNum) {
     return;
   }
 
-  // regular no intermission commands
-  for (i = 0; i < static_cast<int>(sizeof(noIntermissionCommands) /
-                                   sizeof(noIntermissionCommands[0]));
-       i++) {
-    if (!Q_stricmp(cmd, noIntermissionCommands[i].cmd)) {
-      if (noIntermissionCommands[i].floodProtected && ClientIsFlooding(ent)) {
-        CP(va("print \"^1Spam Protection:^7 "
-              "command %s^7 ignored\n\"",
-              cmd));
-      } else {
-        noIntermissionCommands[i].function(ent);
-      }
-      return;
-    }
-  }
-
-  if (G_commandCheck(ent, cmd, qtrue)) {
-    return;
-  }
-
   CP(va("print \"Unknown command %s^7.\n\"", cmd));
 }
 
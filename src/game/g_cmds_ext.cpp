@@ -4,6 +4,7 @@
 #include "g_local.h"
 #include "etj_string_utilities.h"
 #include "etj_printer.h"
+#include "etj_client_command_registry.h"
 
 int iWeap = WS_MAX;
 
@@ -115,22 +116,23 @@ static const cmd_reference_t aCommandInfo[] = {
     {nullptr, qfalse, qtrue, nullptr, nullptr}};
 
 // OSP-specific Commands
-qboolean G_commandCheck(gentity_t *ent, char *cmd, qboolean fDoAnytime) {
-  unsigned int i, cCommands = sizeof(aCommandInfo) / sizeof(aCommandInfo[0]);
-  const cmd_reference_t *pCR;
-
-  for (i = 0; i < cCommands; i++) {
-    pCR = &aCommandInfo[i];
-    if (NULL != pCR->pCommand && pCR->fAnytime == fDoAnytime &&
-        0 == Q_stricmp(cmd, pCR->pszCommandName)) {
-      if (!G_commandHelp(ent, cmd, i)) {
-        pCR->pCommand(ent, i, pCR->fValue);
-      }
-      return (qtrue);
+void G_RegisterExtendedCommands(ETJump::ClientCommandRegistry &registry) {
+  const unsigned int cCommands =
+      sizeof(aCommandInfo) / sizeof(aCommandInfo[0]);
+
+  for (unsigned int i = 0; i < cCommands; i++) {
+    const cmd_reference_t *pCR = &aCommandInfo[i];
+    // entries without a handler are client side commands that are only
+    // listed in the help screen, non-anytime entries were never dispatched
+    if (NULL == pCR->pCommand || !pCR->fAnytime) {
+      continue;
     }
-  }
 
-  return (qfalse);
+    registry.add(
+        pCR->pszCommandName, ETJump::ClientCommandPhase::NoIntermission,
+        ETJump::FloodProtection::None, pCR->pszHelpInfo,
+        [pCR, i](gentity_t *ent) { pCR->pCommand(ent, i, pCR->fValue); });
+  }
 }
 
 // Prints specific command help info.
@@ -1485,6 +1485,10 @@ qboolean G_AllowFollow(gentity_t *ent, gentity_t *other);
 qboolean G_DesiredFollow(gentity_t *ent, gentity_t *other);
 void Cmd_FollowCycle_f(gentity_t *ent, int dir);
 qboolean ClientIsFlooding(gentity_t *ent);
+namespace ETJump {
+class ClientCommandRegistry;
+} // namespace ETJump
+void G_RegisterClientCommands(ETJump::ClientCommandRegistry &registry);
 char *ConcatArgs(int start);
 
 //
@@ -2054,6 +2058,9 @@ extern vmCvar_t g_timerunsDatabase;
 extern vmCvar_t g_timeruns2Database;
 // End of timeruns support
 
+extern vmCvar_t g_dbBackupInterval;
+extern vmCvar_t g_dbOptimizeInterval;
+
 // tokens
 extern vmCvar_t g_tokensMode;
 extern vmCvar_t g_tokensPath;
@@ -2625,6 +2632,7 @@ void G_wipeCvars(void);
 //
 qboolean G_commandHelp(gentity_t *ent, const char *pszCommand,
                        unsigned int dwCommand);
+void G_RegisterExtendedCommands(ETJump::ClientCommandRegistry &registry);
 qboolean G_cmdDebounce(gentity_t *ent, const char *pszCommand);
 void G_commands_cmd(gentity_t *ent, unsigned int dwCommand, qboolean fValue);
 void G_players_cmd(gentity_t *ent, unsigned int dwCommand, qboolean fDump);
@@ -2771,7 +2779,6 @@ void G_AddIpMute(char *ip);
 void G_RemoveIPMute(char *ip);
 qboolean G_isIPMuted(const char *ip);
 void G_ClearIPMutes();
-qboolean G_commandCheck(gentity_t *ent, char *cmd, qboolean fDoAnytime);
 // g_admin.c
 const char *G_SHA1(const char *string);
 char *Q_SayConcatArgs(int start);
@@ -2822,7 +2829,6 @@ void OnClientConnect(int clientNum, qboolean firstTime, qboolean isBot);
 void OnClientBegin(gentity_t *ent);
 void OnClientDisconnect(gentity_t *ent);
 qboolean OnConnectedClientCommand(gentity_t *ent);
-qboolean OnClientCommand(gentity_t *ent);
 qboolean OnConsoleCommand();
 void OnGameInit();
 void OnGameShutdown();
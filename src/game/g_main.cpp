@@ -239,6 +239,10 @@ vmCvar_t g_timerunsDatabase;
 vmCvar_t g_timeruns2Database;
 // End of timeruns support
 
+// hours between database maintenance passes, 0 disables them
+vmCvar_t g_dbBackupInterval;
+vmCvar_t g_dbOptimizeInterval;
+
 vmCvar_t g_chatOptions;
 
 // tokens
@@ -491,6 +495,9 @@ cvarTable_t gameCvarTable[] = {
      CVAR_ARCHIVE},
     // End of timeruns support
 
+    {&g_dbBackupInterval, "g_dbBackupInterval", "0", CVAR_ARCHIVE},
+    {&g_dbOptimizeInterval, "g_dbOptimizeInterval", "24", CVAR_ARCHIVE},
+
     {&g_chatOptions, "g_chatOptions", "1", CVAR_ARCHIVE},
 
     // tokens
@@ -549,9 +549,7 @@ const char *EscapeString(const char *in) {
 }
 
 std::string SanitizeConstString(const std::string &s, bool toLower) {
-  char sanitized[MAX_TOKEN_CHARS];
-  SanitizeConstString(s.c_str(), sanitized, toLower ? qtrue : qfalse);
-  return sanitized;
+  return ETJump::sanitize(s, toLower);
 }
 
 BufferPrinter::BufferPrinter(gentity_t *ent) : ent_(ent), buffer_("") {}
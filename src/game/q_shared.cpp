@@ -4,6 +4,8 @@
 #include "q_shared.h"
 #include <cstring>
 
+#include "etj_string_utilities.h"
+
 float Com_Clamp(float min, float max, float value) {
   if (value < min) {
     return min;
@@ -882,21 +884,9 @@ int Q_PrintStrlen(const char *string) {
 }
 
 char *Q_CleanStr(char *string) {
-  char *d;
-  char *s;
-  int c;
-
-  s = string;
-  d = string;
-  while ((c = *s) != 0) {
-    if (Q_IsColorString(s)) {
-      s++;
-    } else if (c >= 0x20 && c <= 0x7E) {
-      *d++ = c;
-    }
-    s++;
-  }
-  *d = '\0';
+  ETJump::SanitizeOptions options;
+  options.engineColorRules = true;
+  string[ETJump::sanitizeInto(string, strlen(string), string, options)] = '\0';
 
   return string;
 }
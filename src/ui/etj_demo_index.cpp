@@ -0,0 +1,421 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+
+#include "etj_demo_index.h"
+#include "../game/etj_string_utilities.h"
+
+namespace ETJump {
+static const char *INDEX_HEADER = "etjdemoindex";
+static const int INDEX_VERSION = 1;
+
+// dd-mm-yyyy-hhmmss -> yyyymmddhhmmss
+static bool parseTimestamp(const std::string &str, int64_t &timestamp) {
+  int day, mon, year, hours, min, sec;
+  int consumed = 0;
+  if (std::sscanf(str.c_str(), "%2d-%2d-%4d-%2d%2d%2d%n", &day, &mon, &year,
+                  &hours, &min, &sec, &consumed) != 6 ||
+      consumed != static_cast<int>(str.length())) {
+    return false;
+  }
+
+  timestamp = static_cast<int64_t>(year) * 10000000000LL +
+              static_cast<int64_t>(mon) * 100000000LL +
+              static_cast<int64_t>(day) * 1000000LL + hours * 10000LL +
+              min * 100LL + sec;
+  return true;
+}
+
+// mm.ss.mmm -> milliseconds
+static bool parseRunTime(const std::string &str, int &runTime) {
+  if (str.empty() || std::count(str.begin(), str.end(), '.') != 2 ||
+      !std::all_of(str.begin(), str.end(),
+                   [](char c) { return (c >= '0' && c <= '9') || c == '.'; })) {
+    return false;
+  }
+
+  int min, sec, ms;
+  int consumed = 0;
+  if (std::sscanf(str.c_str(), "%d.%2d.%3d%n", &min, &sec, &ms, &consumed) !=
+          3 ||
+      consumed != static_cast<int>(str.length())) {
+    return false;
+  }
+
+  runTime = (min * 60 + sec) * 1000 + ms;
+  return true;
+}
+
+static int compareNoCase(const std::string &lhs, const std::string &rhs) {
+  const auto len = std::min(lhs.length(), rhs.length());
+  for (size_t i = 0; i < len; i++) {
+    const int l = std::tolower(static_cast<unsigned char>(lhs[i]));
+    const int r = std::tolower(static_cast<unsigned char>(rhs[i]));
+    if (l != r) {
+      return l - r;
+    }
+  }
+  return static_cast<int>(lhs.length()) - static_cast<int>(rhs.length());
+}
+
+template <typename T>
+static int compareValues(const T &lhs, const T &rhs) {
+  if (lhs < rhs) {
+    return -1;
+  }
+  if (rhs < lhs) {
+    return 1;
+  }
+  return 0;
+}
+
+// demos without a run time sort after timed ones
+static int sortableRunTime(int runTime) {
+  return runTime < 0 ? std::numeric_limits<int>::max() : runTime;
+}
+} // namespace ETJump
+
+bool ETJump::DemoIndex::parseName(const std::string &filename,
+                                  DemoMetadata &metadata,
+                                  const std::vector<std::string> &knownMaps) {
+  metadata = DemoMetadata{};
+
+  std::string base = filename;
+  const auto ext = base.rfind(".dm_");
+  if (ext != std::string::npos) {
+    base.erase(ext);
+  }
+
+  if (base.empty() || base.back() != ']') {
+    return false;
+  }
+
+  const auto stampStart = base.rfind('[');
+  if (stampStart == std::string::npos ||
+      !parseTimestamp(base.substr(stampStart + 1, base.length() - stampStart -
+                                                      2),
+                      metadata.timestamp)) {
+    return false;
+  }
+  base.erase(stampStart);
+
+  const auto timeSep = base.rfind('_');
+  if (timeSep != std::string::npos &&
+      parseRunTime(base.substr(timeSep + 1), metadata.runTime)) {
+    base.erase(timeSep);
+  }
+
+  // player and run names can contain underscores as well as map names,
+  // so prefer the longest known map name that fits between them
+  const std::string lowerBase = StringUtil::toLowerCase(base);
+  size_t mapStart = std::string::npos;
+  size_t mapLength = 0;
+  for (const auto &map : knownMaps) {
+    if (map.length() <= mapLength) {
+      continue;
+    }
+
+    const auto needle = "_" + StringUtil::toLowerCase(map);
+    auto pos = lowerBase.find(needle);
+    while (pos != std::string::npos) {
+      const auto end = pos + needle.length();
+      if (pos > 0 && (end == lowerBase.length() || lowerBase[end] == '_')) {
+        mapStart = pos + 1;
+        mapLength = map.length();
+        break;
+      }
+      pos = lowerBase.find(needle, pos + 1);
+    }
+  }
+
+  if (mapStart != std::string::npos) {
+    metadata.player = base.substr(0, mapStart - 1);
+    metadata.map = base.substr(mapStart, mapLength);
+    const auto runStart = mapStart + mapLength + 1;
+    metadata.run = runStart < base.length() ? base.substr(runStart) : "";
+    return true;
+  }
+
+  // unknown map, assume no underscores in player or map name
+  const auto playerEnd = base.find('_');
+  if (playerEnd == std::string::npos) {
+    metadata.player = base;
+    return true;
+  }
+
+  metadata.player = base.substr(0, playerEnd);
+  const auto mapEnd = base.find('_', playerEnd + 1);
+  if (mapEnd == std::string::npos) {
+    metadata.map = base.substr(playerEnd + 1);
+    return true;
+  }
+
+  metadata.map = base.substr(playerEnd + 1, mapEnd - playerEnd - 1);
+  metadata.run = base.substr(mapEnd + 1);
+  return true;
+}
+
+void ETJump::DemoIndex::setKnownMaps(std::vector<std::string> maps) {
+  if (maps == knownMaps) {
+    return;
+  }
+
+  knownMaps = std::move(maps);
+
+  for (auto &folder : folders) {
+    for (auto &entry : folder.second) {
+      parseName(entry.name, entry.metadata, knownMaps);
+    }
+  }
+
+  dirty = true;
+  viewDirty = true;
+}
+
+ETJump::DemoIndex::Entry
+ETJump::DemoIndex::makeEntry(const std::string &name) const {
+  Entry entry;
+  entry.name = name;
+  entry.displayName = sanitize(name, false);
+  entry.searchName = sanitize(name, true);
+  parseName(name, entry.metadata, knownMaps);
+  return entry;
+}
+
+bool ETJump::DemoIndex::update(const std::string &folder,
+                               const std::vector<std::string> &files) {
+  auto &entries = folders[folder];
+  bool changed = false;
+
+  const std::unordered_set<std::string> listed(files.begin(), files.end());
+  const auto removed =
+      std::remove_if(entries.begin(), entries.end(), [&](const Entry &entry) {
+        return listed.find(entry.name) == listed.end();
+      });
+  if (removed != entries.end()) {
+    entries.erase(removed, entries.end());
+    changed = true;
+  }
+
+  std::unordered_set<std::string> indexed;
+  indexed.reserve(entries.size());
+  for (const auto &entry : entries) {
+    indexed.insert(entry.name);
+  }
+
+  for (const auto &file : files) {
+    if (indexed.insert(file).second) {
+      entries.push_back(makeEntry(file));
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    dirty = true;
+    if (folder == viewFolder) {
+      viewDirty = true;
+    }
+  }
+
+  return changed;
+}
+
+std::string ETJump::DemoIndex::serialize() const {
+  std::ostringstream out;
+  out << INDEX_HEADER << ' ' << INDEX_VERSION << '\n';
+
+  for (const auto &folder : folders) {
+    for (const auto &entry : folder.second) {
+      const auto &meta = entry.metadata;
+      out << folder.first << '\t' << entry.name << '\t' << meta.player << '\t'
+          << meta.map << '\t' << meta.run << '\t' << meta.runTime << '\t'
+          << meta.timestamp << '\n';
+    }
+  }
+
+  return out.str();
+}
+
+bool ETJump::DemoIndex::deserialize(const std::string &data) {
+  folders.clear();
+  viewDirty = true;
+  dirty = false;
+
+  std::istringstream in(data);
+  std::string line;
+  if (!std::getline(in, line) ||
+      line != stringFormat("%s %d", INDEX_HEADER, INDEX_VERSION)) {
+    return false;
+  }
+
+  while (std::getline(in, line)) {
+    const auto fields = StringUtil::split(line, "\t");
+    if (fields.size() != 7) {
+      folders.clear();
+      return false;
+    }
+
+    Entry entry;
+    entry.name = fields[1];
+    entry.displayName = sanitize(entry.name, false);
+    entry.searchName = sanitize(entry.name, true);
+    entry.metadata.player = fields[2];
+    entry.metadata.map = fields[3];
+    entry.metadata.run = fields[4];
+
+    try {
+      entry.metadata.runTime = std::stoi(fields[5]);
+      entry.metadata.timestamp = std::stoll(fields[6]);
+    } catch (const std::logic_error &) {
+      folders.clear();
+      return false;
+    }
+
+    folders[fields[0]].push_back(std::move(entry));
+  }
+
+  return true;
+}
+
+bool ETJump::DemoIndex::isDirty() const { return dirty; }
+
+void ETJump::DemoIndex::clearDirty() { dirty = false; }
+
+void ETJump::DemoIndex::setView(const std::string &folder, SortKey key,
+                                bool desc, const std::string &filterText) {
+  const auto lowerFilter = StringUtil::toLowerCase(trim(filterText));
+  if (folder == viewFolder && key == sortKey && desc == descending &&
+      lowerFilter == filter) {
+    return;
+  }
+
+  viewFolder = folder;
+  sortKey = key;
+  descending = desc;
+  filter = lowerFilter;
+  viewDirty = true;
+}
+
+ETJump::DemoIndex::SortKey ETJump::DemoIndex::getSortKey() const {
+  return sortKey;
+}
+
+bool ETJump::DemoIndex::isDescending() const { return descending; }
+
+bool ETJump::DemoIndex::matchesFilter(const Entry &entry) const {
+  if (filter.empty()) {
+    return true;
+  }
+
+  static const std::vector<std::pair<std::string, std::string DemoMetadata::*>>
+      fields{{"map:", &DemoMetadata::map},
+             {"run:", &DemoMetadata::run},
+             {"player:", &DemoMetadata::player}};
+
+  for (const auto &field : fields) {
+    if (StringUtil::startsWith(filter, field.first)) {
+      const auto value =
+          StringUtil::toLowerCase(sanitize(entry.metadata.*field.second));
+      return StringUtil::contains(value, filter.substr(field.first.length()));
+    }
+  }
+
+  return StringUtil::contains(entry.searchName, filter);
+}
+
+void ETJump::DemoIndex::rebuildView() {
+  rows.clear();
+  viewDirty = false;
+
+  const auto folder = folders.find(viewFolder);
+  if (folder == folders.end()) {
+    return;
+  }
+
+  rows.reserve(folder->second.size());
+  for (const auto &entry : folder->second) {
+    if (matchesFilter(entry)) {
+      rows.push_back(&entry);
+    }
+  }
+
+  const auto compare = [this](const Entry *lhs, const Entry *rhs) {
+    const auto &l = lhs->metadata;
+    const auto &r = rhs->metadata;
+    int result = 0;
+
+    switch (sortKey) {
+      case SortKey::Map:
+        result = compareNoCase(l.map, r.map);
+        break;
+      case SortKey::Run:
+        result = compareNoCase(l.run, r.run);
+        if (result == 0) {
+          result = compareValues(sortableRunTime(l.runTime),
+                                 sortableRunTime(r.runTime));
+        }
+        break;
+      case SortKey::Time:
+        result = compareValues(sortableRunTime(l.runTime),
+                               sortableRunTime(r.runTime));
+        break;
+      case SortKey::Date:
+        result = compareValues(l.timestamp, r.timestamp);
+        break;
+      case SortKey::Name:
+        break;
+    }
+
+    if (result == 0) {
+      result = lhs->name.compare(rhs->name);
+    }
+
+    return descending ? result > 0 : result < 0;
+  };
+
+  std::sort(rows.begin(), rows.end(), compare);
+}
+
+int ETJump::DemoIndex::size() {
+  if (viewDirty) {
+    rebuildView();
+  }
+
+  return static_cast<int>(rows.size());
+}
+
+const ETJump::DemoIndex::Entry *ETJump::DemoIndex::get(int index) {
+  if (index < 0 || index >= size()) {
+    return nullptr;
+  }
+
+  return rows[index];
+}
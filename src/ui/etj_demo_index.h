@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#ifdef min
+  #undef min
+#endif
+#ifdef max
+  #undef max
+#endif
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ETJump {
+// metadata parsed from the autodemo naming scheme
+// <player>_<map>_<run>_<mm.ss.mmm>[dd-mm-yyyy-hhmmss] for timerun demos
+// <player>_<map>_<name>[dd-mm-yyyy-hhmmss] for manually saved demos
+struct DemoMetadata {
+  std::string player;
+  std::string map;
+  std::string run;
+  // milliseconds, -1 if not a timerun demo
+  int runTime{-1};
+  // yyyymmddhhmmss, 0 if the name has no timestamp
+  int64_t timestamp{0};
+};
+
+// Persistent index of the demo library. Folder listings are diffed
+// against the stored entries so that only new demos need to be parsed,
+// and the browser reads sorted/filtered rows straight from the index.
+class DemoIndex {
+public:
+  enum class SortKey { Name, Map, Run, Time, Date };
+
+  struct Entry {
+    // file name, including extension
+    std::string name;
+    std::string displayName;
+    // lowercase sanitized name, used for filtering
+    std::string searchName;
+    DemoMetadata metadata;
+  };
+
+private:
+  std::unordered_map<std::string, std::vector<Entry>> folders;
+  std::vector<std::string> knownMaps;
+  bool dirty{false};
+
+  std::string viewFolder;
+  SortKey sortKey{SortKey::Name};
+  bool descending{false};
+  std::string filter;
+  std::vector<const Entry *> rows;
+  bool viewDirty{true};
+
+  Entry makeEntry(const std::string &name) const;
+  void rebuildView();
+  bool matchesFilter(const Entry &entry) const;
+
+public:
+  // parses metadata from a demo file name, returns false if the name
+  // doesn't follow the autodemo naming scheme
+  static bool parseName(const std::string &filename, DemoMetadata &metadata,
+                        const std::vector<std::string> &knownMaps = {});
+
+  // map names used to resolve player/map/run boundaries, as player
+  // and run names may contain underscores too
+  void setKnownMaps(std::vector<std::string> maps);
+
+  // diffs the folder listing against the index,
+  // returns true if anything changed
+  bool update(const std::string &folder, const std::vector<std::string> &files);
+
+  std::string serialize() const;
+  // returns false if the data isn't a valid index,
+  // in which case the index is left empty
+  bool deserialize(const std::string &data);
+
+  // true if the index has changed since last serialization
+  bool isDirty() const;
+  void clearDirty();
+
+  // the filter is a case-insensitive substring match against the name,
+  // "map:", "run:" and "player:" prefixes match against that field only
+  void setView(const std::string &folder, SortKey key, bool desc,
+               const std::string &filterText);
+  SortKey getSortKey() const;
+  bool isDescending() const;
+
+  int size();
+  const Entry *get(int index);
+};
+} // namespace ETJump
@@ -0,0 +1,376 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "etj_menu_token_cache.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace ETJump {
+static const uint32_t CACHE_MAGIC = 0x434d5445; // "ETMC"
+static const uint32_t CACHE_VERSION = 2;
+static const int HANDLE_BASE = 0x10000;
+
+template <typename T> static void writeValue(std::string &out, const T &value) {
+  out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+static void writeString(std::string &out, const std::string &str) {
+  writeValue(out, static_cast<uint32_t>(str.size()));
+  out.append(str);
+}
+
+template <typename T>
+static bool readValue(const std::string &data, size_t &pos, T &value) {
+  if (data.size() - pos < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, data.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+static bool readString(const std::string &data, size_t &pos,
+                       std::string &str) {
+  uint32_t len;
+  if (!readValue(data, pos, len) || data.size() - pos < len) {
+    return false;
+  }
+  str.assign(data, pos, len);
+  pos += len;
+  return true;
+}
+
+uint32_t MenuTokenCache::hash(const std::string &data) {
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (const auto c : data) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+std::vector<std::string> MenuTokenCache::findIncludes(const std::string &data) {
+  static const char directive[] = "include";
+  std::vector<std::string> includes;
+  size_t pos = 0;
+
+  while (pos < data.size()) {
+    size_t end = data.find('\n', pos);
+    if (end == std::string::npos) {
+      end = data.size();
+    }
+
+    size_t i = pos;
+    while (i < end && std::isspace(static_cast<unsigned char>(data[i]))) {
+      i++;
+    }
+
+    if (i < end && data[i] == '#') {
+      i++;
+      while (i < end && (data[i] == ' ' || data[i] == '\t')) {
+        i++;
+      }
+
+      if (data.compare(i, sizeof(directive) - 1, directive) == 0) {
+        i += sizeof(directive) - 1;
+        while (i < end && (data[i] == ' ' || data[i] == '\t')) {
+          i++;
+        }
+
+        if (i < end && (data[i] == '"' || data[i] == '<')) {
+          const char close = data[i] == '"' ? '"' : '>';
+          const size_t closePos = data.find(close, i + 1);
+          if (closePos != std::string::npos && closePos < end) {
+            includes.emplace_back(data.substr(i + 1, closePos - i - 1));
+          }
+        }
+      }
+    }
+
+    pos = end + 1;
+  }
+
+  return includes;
+}
+
+void MenuTokenCache::reset(const std::string &cacheKey) {
+  key = cacheKey;
+  sources.clear();
+  streams.clear();
+  currentStream = nullptr;
+  strings.clear();
+  stringOffsets.clear();
+  readers.clear();
+}
+
+void MenuTokenCache::addSource(const std::string &path,
+                               const ReadFile &readFile) {
+  for (const auto &source : sources) {
+    if (source.path == path) {
+      return;
+    }
+  }
+
+  std::string data;
+  if (!readFile(path, data)) {
+    sources.push_back({path, -1, 0});
+    return;
+  }
+
+  sources.push_back({path, static_cast<int>(data.size()), hash(data)});
+
+  for (const auto &include : findIncludes(data)) {
+    addSource(include, readFile);
+  }
+}
+
+bool MenuTokenCache::isValid(const std::string &cacheKey,
+                             const ReadFile &readFile) const {
+  if (key != cacheKey || sources.empty()) {
+    return false;
+  }
+
+  std::string data;
+  for (const auto &source : sources) {
+    if (!readFile(source.path, data)) {
+      if (source.size != -1) {
+        return false;
+      }
+      continue;
+    }
+
+    if (source.size != static_cast<int>(data.size()) ||
+        source.hash != hash(data)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+uint32_t MenuTokenCache::intern(const char *str) {
+  const auto it = stringOffsets.find(str);
+  if (it != stringOffsets.end()) {
+    return it->second;
+  }
+
+  const auto offset = static_cast<uint32_t>(strings.size());
+  strings.append(str);
+  strings.push_back('\0');
+  stringOffsets.emplace(str, offset);
+  return offset;
+}
+
+void MenuTokenCache::beginStream(const std::string &file) {
+  currentStream = &streams[file];
+  currentStream->clear();
+}
+
+void MenuTokenCache::addToken(const Token &token) {
+  if (!currentStream) {
+    return;
+  }
+
+  currentStream->push_back({token.type, token.subtype, token.intValue,
+                            token.floatValue, token.line,
+                            intern(token.string ? token.string : ""),
+                            intern(token.file ? token.file : "")});
+}
+
+bool MenuTokenCache::hasStream(const std::string &file) const {
+  return streams.find(file) != streams.end();
+}
+
+const std::vector<MenuTokenCache::Source> &
+MenuTokenCache::getSources() const {
+  return sources;
+}
+
+std::string MenuTokenCache::serialize() const {
+  std::string out;
+
+  writeValue(out, CACHE_MAGIC);
+  writeValue(out, CACHE_VERSION);
+  writeString(out, key);
+
+  writeValue(out, static_cast<uint32_t>(sources.size()));
+  for (const auto &source : sources) {
+    writeString(out, source.path);
+    writeValue(out, static_cast<int32_t>(source.size));
+    writeValue(out, source.hash);
+  }
+
+  writeValue(out, static_cast<uint32_t>(streams.size()));
+  for (const auto &stream : streams) {
+    writeString(out, stream.first);
+    writeValue(out, static_cast<uint32_t>(stream.second.size()));
+    out.append(reinterpret_cast<const char *>(stream.second.data()),
+               stream.second.size() * sizeof(StoredToken));
+  }
+
+  writeString(out, strings);
+  return out;
+}
+
+bool MenuTokenCache::deserialize(const std::string &data) {
+  size_t pos = 0;
+  uint32_t magic, version, count;
+
+  reset("");
+
+  if (!readValue(data, pos, magic) || magic != CACHE_MAGIC ||
+      !readValue(data, pos, version) || version != CACHE_VERSION) {
+    return false;
+  }
+
+  std::string cacheKey;
+  if (!readString(data, pos, cacheKey) || !readValue(data, pos, count)) {
+    return false;
+  }
+
+  std::vector<Source> cacheSources(count);
+  for (auto &source : cacheSources) {
+    int32_t size;
+    if (!readString(data, pos, source.path) || !readValue(data, pos, size) ||
+        !readValue(data, pos, source.hash)) {
+      return false;
+    }
+    source.size = size;
+  }
+
+  if (!readValue(data, pos, count)) {
+    return false;
+  }
+
+  std::unordered_map<std::string, std::vector<StoredToken>> cacheStreams;
+  for (uint32_t i = 0; i < count; i++) {
+    std::string file;
+    uint32_t numTokens;
+    if (!readString(data, pos, file) || !readValue(data, pos, numTokens) ||
+        (data.size() - pos) / sizeof(StoredToken) < numTokens) {
+      return false;
+    }
+
+    auto &tokens = cacheStreams[file];
+    tokens.resize(numTokens);
+    std::memcpy(tokens.data(), data.data() + pos,
+                numTokens * sizeof(StoredToken));
+    pos += numTokens * sizeof(StoredToken);
+  }
+
+  std::string cacheStrings;
+  if (!readString(data, pos, cacheStrings) || pos != data.size()) {
+    return false;
+  }
+
+  // every token must point to a terminated string in the table
+  if (!cacheStrings.empty() && cacheStrings.back() != '\0') {
+    return false;
+  }
+  for (const auto &stream : cacheStreams) {
+    for (const auto &token : stream.second) {
+      if (token.string >= cacheStrings.size() ||
+          token.file >= cacheStrings.size()) {
+        return false;
+      }
+    }
+  }
+
+  key = std::move(cacheKey);
+  sources = std::move(cacheSources);
+  streams = std::move(cacheStreams);
+  strings = std::move(cacheStrings);
+  return true;
+}
+
+bool MenuTokenCache::isHandle(int handle) { return handle > HANDLE_BASE; }
+
+int MenuTokenCache::open(const std::string &file) {
+  const auto it = streams.find(file);
+  if (it == streams.end()) {
+    return 0;
+  }
+
+  const int handle = HANDLE_BASE + ++nextHandle;
+  readers[handle] = {file, &it->second, 0};
+  return handle;
+}
+
+bool MenuTokenCache::close(int handle) { return readers.erase(handle) > 0; }
+
+bool MenuTokenCache::read(int handle, Token &token) {
+  const auto it = readers.find(handle);
+  if (it == readers.end()) {
+    return false;
+  }
+
+  auto &reader = it->second;
+  if (reader.pos >= reader.tokens->size()) {
+    return false;
+  }
+
+  const auto &stored = (*reader.tokens)[reader.pos++];
+  token.type = stored.type;
+  token.subtype = stored.subtype;
+  token.intValue = stored.intValue;
+  token.floatValue = stored.floatValue;
+  token.line = stored.line;
+  token.string = strings.c_str() + stored.string;
+  token.file = strings.c_str() + stored.file;
+  return true;
+}
+
+bool MenuTokenCache::unread(int handle) {
+  const auto it = readers.find(handle);
+  if (it == readers.end() || it->second.pos == 0) {
+    return false;
+  }
+
+  it->second.pos--;
+  return true;
+}
+
+bool MenuTokenCache::fileAndLine(int handle, std::string &file,
+                                 int &line) const {
+  const auto it = readers.find(handle);
+  if (it == readers.end()) {
+    return false;
+  }
+
+  const auto &reader = it->second;
+  file = reader.file;
+  line = 0;
+  if (reader.pos > 0) {
+    const auto &token = (*reader.tokens)[reader.pos - 1];
+    line = token.line;
+    if (strings[token.file]) {
+      file = strings.c_str() + token.file;
+    }
+  }
+  return true;
+}
+} // namespace ETJump
@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ETJump {
+// Preprocessed token streams of menu files. The engine preprocessor
+// re-reads every #include and expands every macro for each menu file,
+// so the resulting tokens are stored in a binary cache and later loads
+// parse the menus straight from memory. The cache is keyed on the
+// content of every source file, and is rebuilt if any of them changes.
+class MenuTokenCache {
+public:
+  struct Token {
+    int type;
+    int subtype;
+    int intValue;
+    float floatValue;
+    int line;
+    const char *string;
+    // file the token was read from, differs from the stream's file
+    // for tokens coming from #included files
+    const char *file;
+  };
+
+  // a file the cached tokens were produced from,
+  // size is -1 if the file did not exist when the cache was built
+  struct Source {
+    std::string path;
+    int size;
+    uint32_t hash;
+  };
+
+  // returns false if the file does not exist
+  using ReadFile =
+      std::function<bool(const std::string &path, std::string &data)>;
+
+  static uint32_t hash(const std::string &data);
+
+  // paths of files included with #include "file" directives
+  static std::vector<std::string> findIncludes(const std::string &data);
+
+  // drops everything and starts an empty cache for the given key
+  void reset(const std::string &key);
+
+  // records the file and everything it includes as sources of the cache
+  void addSource(const std::string &path, const ReadFile &readFile);
+
+  // true if the cache was built with the same key,
+  // and none of the source files have changed since
+  bool isValid(const std::string &key, const ReadFile &readFile) const;
+
+  void beginStream(const std::string &file);
+  void addToken(const Token &token);
+  bool hasStream(const std::string &file) const;
+
+  const std::vector<Source> &getSources() const;
+
+  std::string serialize() const;
+  // returns false if the data isn't a valid cache,
+  // in which case the cache is left empty
+  bool deserialize(const std::string &data);
+
+  // handles for reading the streams, kept clear of engine source handles
+  static bool isHandle(int handle);
+  // returns 0 if there is no stream for the file
+  int open(const std::string &file);
+  bool close(int handle);
+  bool read(int handle, Token &token);
+  bool unread(int handle);
+  bool fileAndLine(int handle, std::string &file, int &line) const;
+
+private:
+  struct StoredToken {
+    int32_t type;
+    int32_t subtype;
+    int32_t intValue;
+    float floatValue;
+    int32_t line;
+    // offsets into the string table
+    uint32_t string;
+    uint32_t file;
+  };
+
+  struct Reader {
+    std::string file;
+    const std::vector<StoredToken> *tokens;
+    size_t pos;
+  };
+
+  uint32_t intern(const char *str);
+
+  std::string key;
+  std::vector<Source> sources;
+  std::unordered_map<std::string, std::vector<StoredToken>> streams;
+  std::vector<StoredToken> *currentStream{nullptr};
+  // null terminated token strings
+  std::string strings;
+  std::unordered_map<std::string, uint32_t> stringOffsets;
+
+  std::unordered_map<int, Reader> readers;
+  int nextHandle{0};
+};
+} // namespace ETJump
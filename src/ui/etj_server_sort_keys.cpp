@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "etj_server_sort_keys.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace ETJump {
+static std::string toLower(const std::string &str) {
+  std::string lower(str);
+  for (auto &c : lower) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return lower;
+}
+
+template <typename T> static int compareValues(const T &lhs, const T &rhs) {
+  if (lhs < rhs) {
+    return -1;
+  }
+  if (rhs < lhs) {
+    return 1;
+  }
+  return 0;
+}
+
+bool ServerSortKeys::toColumn(int sortKey, Column &column) {
+  // SORT_FILTERS and SORT_FAVOURITES depend on engine side state
+  if (sortKey < static_cast<int>(Column::Host) ||
+      sortKey > static_cast<int>(Column::Ping)) {
+    return false;
+  }
+
+  column = static_cast<Column>(sortKey);
+  return true;
+}
+
+void ServerSortKeys::set(int server, const std::string &hostName,
+                         const std::string &mapName, int clients,
+                         int gameType, int ping) {
+  if (server < 0) {
+    return;
+  }
+
+  if (server >= static_cast<int>(keys.size())) {
+    keys.resize(server + 1);
+  }
+
+  Key &key = keys[server];
+  key.hostName = toLower(hostName);
+  key.mapName = toLower(mapName);
+  key.clients = clients;
+  key.gameType = gameType;
+  key.ping = ping;
+}
+
+void ServerSortKeys::clear() { keys.clear(); }
+
+const ServerSortKeys::Key &ServerSortKeys::get(int server) const {
+  if (server < 0 || server >= static_cast<int>(keys.size())) {
+    return emptyKey;
+  }
+  return keys[server];
+}
+
+int ServerSortKeys::compare(Column column, bool descending, int lhs,
+                            int rhs) const {
+  const Key &a = get(lhs);
+  const Key &b = get(rhs);
+  int res = 0;
+
+  switch (column) {
+    case Column::Host:
+      res = compareValues(a.hostName, b.hostName);
+      break;
+    case Column::Map:
+      res = compareValues(a.mapName, b.mapName);
+      break;
+    case Column::Clients:
+      res = compareValues(a.clients, b.clients);
+      break;
+    case Column::Game:
+      res = compareValues(a.gameType, b.gameType);
+      break;
+    case Column::Ping:
+      res = compareValues(a.ping, b.ping);
+      break;
+  }
+
+  return descending ? -res : res;
+}
+
+void ServerSortKeys::sort(int *servers, int count, Column column,
+                          bool descending) const {
+  std::stable_sort(servers, servers + count,
+                   [this, column, descending](int lhs, int rhs) {
+                     return compare(column, descending, lhs, rhs) < 0;
+                   });
+}
+
+int ServerSortKeys::insertionPoint(const int *servers, int count, int server,
+                                   Column column, bool descending) const {
+  const auto it = std::upper_bound(
+      servers, servers + count, server,
+      [this, column, descending](int lhs, int rhs) {
+        return compare(column, descending, lhs, rhs) < 0;
+      });
+  return static_cast<int>(it - servers);
+}
+} // namespace ETJump
@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 ETJump team <zero@etjump.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ETJump {
+// Server browser sort keys, cached per server when its info is read so
+// that sorting and inserting into the display list doesn't need to go
+// through the engine for every comparison.
+class ServerSortKeys {
+public:
+  // matches SORT_HOST...SORT_PING
+  enum class Column { Host, Map, Clients, Game, Ping };
+
+  struct Key {
+    // lowercase, expected to be stripped of color codes by the caller
+    std::string hostName;
+    std::string mapName;
+    int clients{0};
+    int gameType{0};
+    int ping{0};
+  };
+
+  // returns false if the UI sort column is not one of the cached ones,
+  // in which case the caller must fall back to comparing in the engine
+  static bool toColumn(int sortKey, Column &column);
+
+  void set(int server, const std::string &hostName, const std::string &mapName,
+           int clients, int gameType, int ping);
+  void clear();
+
+  // same contract as the engine comparison, -1, 0 or 1, with the
+  // result flipped when sorting in descending order
+  int compare(Column column, bool descending, int lhs, int rhs) const;
+
+  // stable sort, servers comparing equal keep their previous order
+  void sort(int *servers, int count, Column column, bool descending) const;
+
+  // position at which the server should be inserted to keep the list
+  // ordered, after any servers comparing equal to it
+  int insertionPoint(const int *servers, int count, int server, Column column,
+                     bool descending) const;
+
+private:
+  const Key &get(int server) const;
+
+  std::vector<Key> keys;
+  Key emptyKey;
+};
+} // namespace ETJump
@@ -103,6 +103,10 @@ extern vmCvar_t ui_browserShowWeaponsRestricted;
 extern vmCvar_t ui_browserShowTeamBalanced;
 extern vmCvar_t ui_browserShowETJump;
 
+extern vmCvar_t ui_demoSortKey;
+extern vmCvar_t ui_demoSortDir;
+extern vmCvar_t ui_demoFilter;
+
 extern vmCvar_t ui_serverStatusTimeOut;
 extern vmCvar_t ui_limboOptions;
 
@@ -14,6 +14,8 @@ USER INTERFACE MAIN
 #include "../game/etj_string_utilities.h"
 #include "../cgame/etj_utilities.h"
 #include "../game/etj_numeric_utilities.h"
+#include "etj_demo_index.h"
+#include "etj_server_sort_keys.h"
 
 // NERVE - SMF
 #define AXIS_TEAM 0
@@ -1124,7 +1126,7 @@ qboolean UI_ParseMenu(const char *menuFile) {
 
   Com_DPrintf("Parsing menu file: %s\n", menuFile);
 
-  handle = trap_PC_LoadSource(menuFile);
+  handle = Menu_LoadSource(menuFile);
   if (!handle) {
     return qfalse;
   }
@@ -1229,28 +1231,57 @@ qboolean Load_Menu(int handle) {
   return qfalse;
 }
 
+/*
+===============
+UI_AddGlobalDefine
+
+Global defines live in the engine and are shared with cgame until
+the next UI init, so the active ones are kept in ui_pcGlobalDefines
+for the menu token cache keys of both modules.
+===============
+*/
+static void UI_AddGlobalDefine(const char *define) {
+  char defines[MAX_CVAR_VALUE_STRING];
+
+  trap_PC_AddGlobalDefine(define);
+  trap_Cvar_VariableStringBuffer("ui_pcGlobalDefines", defines,
+                                 sizeof(defines));
+
+  if (!strstr(va("%s ", defines), va(" %s ", define))) {
+    trap_Cvar_Set("ui_pcGlobalDefines", va("%s %s", defines, define));
+  }
+}
+
 void UI_LoadMenus(const char *menuFile, qboolean reset) {
   pc_token_t token;
   int handle;
   int start;
   uiClientState_t cstate;
+  qboolean cached;
+  char defines[MAX_CVAR_VALUE_STRING];
 
   start = trap_Milliseconds();
   trap_GetClientState(&cstate);
 
   if (cstate.connState <= CA_DISCONNECTED) {
-    trap_PC_AddGlobalDefine("FUI");
+    UI_AddGlobalDefine("FUI");
   }
 
   if (uiInfo.legacyClient) {
-    trap_PC_AddGlobalDefine("LEGACY");
+    UI_AddGlobalDefine("LEGACY");
   }
 
-  handle = trap_PC_LoadSource(menuFile);
+  // global defines change the preprocessed tokens,
+  // so they are part of the cache key
+  trap_Cvar_VariableStringBuffer("ui_pcGlobalDefines", defines,
+                                 sizeof(defines));
+  Menu_BeginTokenCache(va("%s%s", menuFile, defines));
+
+  handle = Menu_LoadSource(menuFile);
   if (!handle) {
     trap_Error(va(S_COLOR_YELLOW "menu file not found: %s, using default\n",
                   menuFile));
-    handle = trap_PC_LoadSource("ui/menus.txt");
+    handle = Menu_LoadSource("ui/menus.txt");
     if (!handle) {
       trap_Error(S_COLOR_RED "default menu file not "
                              "found: ui_mp/menus.txt, "
@@ -1285,10 +1316,12 @@ void UI_LoadMenus(const char *menuFile, qboolean reset) {
     }
   }
 
-  Com_DPrintf("UI menu load time = %d milli seconds\n",
-              trap_Milliseconds() - start);
-
   trap_PC_FreeSource(handle);
+  cached = Menu_EndTokenCache();
+
+  Com_DPrintf("UI menus %s in %d msec\n",
+              cached ? "loaded from cache" : "parsed",
+              trap_Milliseconds() - start);
 }
 
 void UI_Load() {
@@ -2915,6 +2948,10 @@ static qboolean UI_OwnerDrawHandleKey(int ownerDraw, int flags, float *special,
 
 static float UI_GetValue(int ownerDraw, int type) { return 0; }
 
+// sort keys of the servers in the display list, refreshed whenever
+// a server is (re)inserted with new info
+static ETJump::ServerSortKeys serverSortKeys;
+
 /*
 =================
 UI_ServersQsortCompare
@@ -2932,6 +2969,7 @@ UI_ServersSort
 =================
 */
 void UI_ServersSort(int column, qboolean force) {
+  ETJump::ServerSortKeys::Column sortColumn;
 
   if (!force) {
     if (uiInfo.serverStatus.sortKey == column) {
@@ -2940,6 +2978,14 @@ void UI_ServersSort(int column, qboolean force) {
   }
 
   uiInfo.serverStatus.sortKey = column;
+
+  if (ETJump::ServerSortKeys::toColumn(column, sortColumn)) {
+    serverSortKeys.sort(&uiInfo.serverStatus.displayServers[0],
+                        uiInfo.serverStatus.numDisplayServers, sortColumn,
+                        uiInfo.serverStatus.sortDir != 0);
+    return;
+  }
+
   qsort(&uiInfo.serverStatus.displayServers[0],
         uiInfo.serverStatus.numDisplayServers, sizeof(int),
         UI_ServersQsortCompare);
@@ -3095,6 +3141,139 @@ static void UI_LoadMovies() {
   }
 }
 
+/*
+===============
+UI_GetFileList
+
+Grows the listing buffer until the whole directory fits,
+engine silently truncates the list when the buffer is full
+===============
+*/
+static std::vector<std::string> UI_GetFileList(const std::string &path,
+                                               const char *extension) {
+  static const int initialBufferSize = 200000;
+  static const int maxBufferSize = 1 << 24;
+  std::vector<std::string> names;
+
+  for (int bufferSize = initialBufferSize; bufferSize <= maxBufferSize;
+       bufferSize *= 2) {
+    auto buffer = std::unique_ptr<char[]>(new char[bufferSize]);
+    const int numFiles =
+        trap_FS_GetFileList(path.c_str(), extension, buffer.get(), bufferSize);
+
+    names.clear();
+    names.reserve(numFiles);
+    int usedBytes = 0;
+    const char *namePtr = buffer.get();
+    for (int i = 0; i < numFiles; i++) {
+      names.emplace_back(namePtr);
+      usedBytes += names.back().length() + 1;
+      namePtr += names.back().length() + 1;
+    }
+
+    // next name might not have fit, retry with a larger buffer
+    if (usedBytes + MAX_OSPATH < bufferSize) {
+      break;
+    }
+  }
+
+  return names;
+}
+
+/*
+===============
+UI_LoadDemoIndex
+===============
+*/
+static ETJump::DemoIndex demoLibrary;
+static const char *DEMO_INDEX_FILE = "demos/demoindex.dat";
+
+static void UI_LoadDemoIndex() {
+  static bool loaded = false;
+
+  if (!loaded) {
+    fileHandle_t f;
+    const int len = trap_FS_FOpenFile(DEMO_INDEX_FILE, &f, FS_READ);
+    if (len > 0) {
+      std::string data(len, '\0');
+      trap_FS_Read(&data[0], len, f);
+      if (!demoLibrary.deserialize(data)) {
+        Com_Printf("Demo index is outdated or corrupted, rebuilding.\n");
+      }
+    }
+    if (len >= 0) {
+      trap_FS_FCloseFile(f);
+    }
+    loaded = true;
+  }
+
+  std::vector<std::string> maps;
+  maps.reserve(uiInfo.mapCount);
+  for (int i = 0; i < uiInfo.mapCount; i++) {
+    if (uiInfo.mapList[i].mapLoadName) {
+      maps.emplace_back(uiInfo.mapList[i].mapLoadName);
+    }
+  }
+  demoLibrary.setKnownMaps(std::move(maps));
+}
+
+static void UI_SaveDemoIndex() {
+  if (!demoLibrary.isDirty()) {
+    return;
+  }
+
+  fileHandle_t f;
+  if (trap_FS_FOpenFile(DEMO_INDEX_FILE, &f, FS_WRITE) < 0) {
+    return;
+  }
+
+  const auto data = demoLibrary.serialize();
+  trap_FS_Write(data.c_str(), data.length(), f);
+  trap_FS_FCloseFile(f);
+  demoLibrary.clearDirty();
+}
+
+/*
+===============
+UI_UpdateDemoView
+===============
+*/
+static void UI_UpdateDemoView() {
+  // the view cvars are refreshed once per frame in UI_UpdateCvars, the
+  // feeder calls this several times per frame
+  const int sortKey =
+      Numeric::clamp(ui_demoSortKey.integer,
+                     static_cast<int>(ETJump::DemoIndex::SortKey::Name),
+                     static_cast<int>(ETJump::DemoIndex::SortKey::Date));
+
+  demoLibrary.setView(
+      ETJump::StringUtil::join(uiInfo.currentDemoPath, PATH_SEP_STRING),
+      static_cast<ETJump::DemoIndex::SortKey>(sortKey),
+      ui_demoSortDir.integer != 0, ui_demoFilter.string);
+}
+
+/*
+===============
+UI_DemoListCount
+===============
+*/
+static int UI_DemoListCount() {
+  UI_UpdateDemoView();
+  return static_cast<int>(uiInfo.demoObjects.size()) + demoLibrary.size();
+}
+
+/*
+===============
+UI_DemoFileEntry
+
+Returns the index entry of a demo list row,
+or nullptr if the row is a folder or out of bounds
+===============
+*/
+static const ETJump::DemoIndex::Entry *UI_DemoFileEntry(int index) {
+  return demoLibrary.get(index - static_cast<int>(uiInfo.demoObjects.size()));
+}
+
 /*
 ===============
 UI_LoadDemos
@@ -3106,41 +3285,26 @@ static void UI_LoadDemos() {
   }
   std::string path =
       ETJump::StringUtil::join(uiInfo.currentDemoPath, PATH_SEP_STRING);
-  const auto bufferSize = 200000;
-  auto dirList = std::unique_ptr<char[]>(new char[bufferSize]);
-  auto demoList = std::unique_ptr<char[]>(new char[bufferSize]);
 
   auto demoExt =
       ETJump::stringFormat("dm_%d", (int)trap_Cvar_VariableValue("protocol"));
 
-  auto numDirectories =
-      trap_FS_GetFileList(path.c_str(), "/", dirList.get(), bufferSize);
-  auto numFiles = trap_FS_GetFileList(path.c_str(), demoExt.c_str(),
-                                      demoList.get(), bufferSize);
-
   std::vector<FileSystemObjectInfo> directories;
-  char *dirPtr = dirList.get();
-  for (auto i = 0; i < numDirectories; ++i) {
+  for (const auto &name : UI_GetFileList(path, "/")) {
+    if (name == "." || name == "..") {
+      continue;
+    }
     FileSystemObjectInfo objectInfo;
     objectInfo.type = FileSystemObjectType::Folder;
-    objectInfo.name = std::string(dirPtr);
+    objectInfo.name = name;
     objectInfo.displayName = "^7" + ETJump::sanitize(objectInfo.name, false);
-    if (objectInfo.name != "." && objectInfo.name != "..") {
-      directories.push_back(objectInfo);
-    }
-    dirPtr += objectInfo.name.length() + 1;
+    directories.push_back(objectInfo);
   }
 
-  std::vector<FileSystemObjectInfo> files;
-  auto namePtr = demoList.get();
-  for (auto i = 0; i < numFiles; ++i) {
-    FileSystemObjectInfo objectInfo;
-    objectInfo.type = FileSystemObjectType::Item;
-    objectInfo.name = std::string(namePtr);
-    objectInfo.displayName = ETJump::sanitize(objectInfo.name, false);
-    files.push_back(objectInfo);
-    namePtr += objectInfo.name.length() + 1;
-  }
+  // only new demos get parsed, the rest comes from the index
+  UI_LoadDemoIndex();
+  demoLibrary.update(path, UI_GetFileList(path, demoExt.c_str()));
+  UI_SaveDemoIndex();
 
   uiInfo.demoObjects = std::vector<FileSystemObjectInfo>();
   const auto comparer = [](const FileSystemObjectInfo &lhs,
@@ -3148,7 +3312,6 @@ static void UI_LoadDemos() {
     return lhs.name < rhs.name;
   };
   std::sort(std::begin(directories), std::end(directories), comparer);
-  std::sort(std::begin(files), std::end(files), comparer);
   if (uiInfo.currentDemoPath.size() > 1) {
     FileSystemObjectInfo back;
     back.type = FileSystemObjectType::Folder;
@@ -3174,8 +3337,8 @@ static void UI_LoadDemos() {
 
   std::copy(std::begin(directories), std::end(directories),
             std::back_inserter(uiInfo.demoObjects));
-  std::copy(std::begin(files), std::end(files),
-            std::back_inserter(uiInfo.demoObjects));
+
+  UI_UpdateDemoView();
 }
 
 /*
@@ -3559,51 +3722,67 @@ void UI_RunMenuScript(const char **args) {
       if (uiInfo.demoIndex >= 0 &&
           uiInfo.demoIndex < static_cast<int>(uiInfo.demoObjects.size())) {
         const auto &selected = uiInfo.demoObjects[uiInfo.demoIndex];
-        if (selected.type == FileSystemObjectType::Folder) {
-          if (selected.name == ".") {
-            uiInfo.currentDemoPath.pop_back();
-          } else if (selected.name == "..") {
-            uiInfo.currentDemoPath.clear();
-            uiInfo.currentDemoPath.emplace_back("demos");
-          } else {
-            uiInfo.currentDemoPath.push_back(selected.name);
-          }
-          UI_LoadDemos();
+        if (selected.name == ".") {
+          uiInfo.currentDemoPath.pop_back();
+        } else if (selected.name == "..") {
+          uiInfo.currentDemoPath.clear();
+          uiInfo.currentDemoPath.emplace_back("demos");
         } else {
-          // pop front because demo command automatically
-          // appends demos/ to the beginning of the path
-          const auto &front = uiInfo.currentDemoPath.front();
-          uiInfo.currentDemoPath.pop_front();
-
-          std::string demoPath;
-
-          // only append '/' in front of the name if we're inside a subfolder
-          // otherwise the demo command will be '/demo /demoname.dm_84'
-          // and ET: Legacy will try to open it as an absolute
-          // system file system path and will fail on Linux
-          if (uiInfo.currentDemoPath.empty()) {
-            demoPath = uiInfo.demoObjects[uiInfo.demoIndex].name;
-          } else {
-            demoPath = ETJump::StringUtil::join(uiInfo.currentDemoPath, "/") +
-                       "/" + uiInfo.demoObjects[uiInfo.demoIndex].name;
-          }
-
-          uiInfo.currentDemoPath.push_front(front);
-          trap_Cmd_ExecuteText(EXEC_APPEND,
-                               va("demo \"%s\"\n", demoPath.c_str()));
+          uiInfo.currentDemoPath.push_back(selected.name);
+        }
+        UI_LoadDemos();
+      } else if (const auto selected = UI_DemoFileEntry(uiInfo.demoIndex)) {
+        // pop front because demo command automatically
+        // appends demos/ to the beginning of the path
+        const auto front = uiInfo.currentDemoPath.front();
+        uiInfo.currentDemoPath.pop_front();
+
+        std::string demoPath;
+
+        // only append '/' in front of the name if we're inside a subfolder
+        // otherwise the demo command will be '/demo /demoname.dm_84'
+        // and ET: Legacy will try to open it as an absolute
+        // system file system path and will fail on Linux
+        if (uiInfo.currentDemoPath.empty()) {
+          demoPath = selected->name;
+        } else {
+          demoPath = ETJump::StringUtil::join(uiInfo.currentDemoPath, "/") +
+                     "/" + selected->name;
         }
+
+        uiInfo.currentDemoPath.push_front(front);
+        trap_Cmd_ExecuteText(EXEC_APPEND,
+                             va("demo \"%s\"\n", demoPath.c_str()));
       }
       return;
     }
     if (Q_stricmp(name, "deleteDemo") == 0) {
-      if (uiInfo.demoIndex >= 0 &&
-          uiInfo.demoIndex < static_cast<int>(uiInfo.demoObjects.size())) {
+      if (const auto selected = UI_DemoFileEntry(uiInfo.demoIndex)) {
         auto demoPath = ETJump::StringUtil::join(uiInfo.currentDemoPath, "/") +
-                        "/" + uiInfo.demoObjects[uiInfo.demoIndex].name;
+                        "/" + selected->name;
         trap_FS_Delete(demoPath.c_str());
       }
       return;
     }
+    if (Q_stricmp(name, "DemoSort") == 0) {
+      int sortKey;
+      if (Int_Parse(args, &sortKey)) {
+        trap_Cvar_Update(&ui_demoSortKey);
+        trap_Cvar_Update(&ui_demoSortDir);
+
+        // if same column we're already sorting on then flip the direction
+        if (sortKey == ui_demoSortKey.integer) {
+          trap_Cvar_Set("ui_demoSortDir", ui_demoSortDir.integer ? "0" : "1");
+        } else {
+          trap_Cvar_Set("ui_demoSortKey", va("%i", sortKey));
+          trap_Cvar_Set("ui_demoSortDir", "0");
+        }
+        trap_Cvar_Update(&ui_demoSortKey);
+        trap_Cvar_Update(&ui_demoSortDir);
+        UI_UpdateDemoView();
+      }
+      return;
+    }
     if (Q_stricmp(name, "closeJoin") == 0) {
       if (uiInfo.serverStatus.refreshActive) {
         UI_StopServerRefresh();
@@ -4944,6 +5123,17 @@ UI_BinaryServerInsertion
 */
 static void UI_BinaryServerInsertion(int num) {
   int mid, offset, res, len;
+  ETJump::ServerSortKeys::Column sortColumn;
+
+  if (ETJump::ServerSortKeys::toColumn(uiInfo.serverStatus.sortKey,
+                                       sortColumn)) {
+    UI_InsertServerIntoDisplayList(
+        num, serverSortKeys.insertionPoint(
+                 uiInfo.serverStatus.displayServers,
+                 uiInfo.serverStatus.numDisplayServers, num, sortColumn,
+                 uiInfo.serverStatus.sortDir != 0));
+    return;
+  }
 
   // use binary search to insert server
   len = uiInfo.serverStatus.numDisplayServers;
@@ -4987,6 +5177,7 @@ static void UI_BuildServerDisplayList(int force) {
   int i, count, clients, maxClients, ping, game, len, friendlyFire, maxlives,
       punkbuster, antilag, password, weaponrestricted, balancedteams;
   char info[MAX_STRING_CHARS];
+  char hostName[MAX_STRING_CHARS];
   // qboolean startRefresh = qtrue; // TTimo: unused
 
   game = 0; // NERVE - SMF - shut up compiler warning
@@ -5020,6 +5211,7 @@ static void UI_BuildServerDisplayList(int force) {
     // clear number of displayed servers
     uiInfo.serverStatus.numDisplayServers = 0;
     uiInfo.serverStatus.numPlayersOnServers = 0;
+    serverSortKeys.clear();
     // set list box index to zero
     Menu_SetFeederSelection(nullptr, FEEDER_SERVERS, 0, nullptr);
     // mark all servers as visible, so we store ping updates for them
@@ -5189,6 +5381,12 @@ static void UI_BuildServerDisplayList(int force) {
         }
       }
 
+      Q_strncpyz(hostName, Info_ValueForKey(info, "hostname"),
+                 sizeof(hostName));
+      Q_CleanStr(hostName);
+      serverSortKeys.set(i, hostName, Info_ValueForKey(info, "mapname"),
+                         clients, Q_atoi(Info_ValueForKey(info, "gametype")),
+                         ping);
       UI_BinaryServerInsertion(i);
       // done with this server
       if (ping > 0) {
@@ -5669,7 +5867,7 @@ static int UI_FeederCount(float feederID) {
   } else if (feederID == FEEDER_MODS) {
     return uiInfo.modCount;
   } else if (feederID == FEEDER_DEMOS) {
-    return uiInfo.demoObjects.size();
+    return UI_DemoListCount();
   }
   return 0;
 }
@@ -5962,20 +6160,22 @@ const char *UI_FeederItemText(float feederID, int index, int column,
     }
   } else if (feederID == FEEDER_DEMOS) {
     if (index >= 0 && index < static_cast<int>(uiInfo.demoObjects.size())) {
-      if (uiInfo.demoObjects[index].type == FileSystemObjectType::Folder) {
-        *numhandles = 1;
+      *numhandles = 1;
 
-        if (uiInfo.demoObjects[index].name == ".") {
-          handles[0] = uiInfo.uiDC.Assets.replayUp;
-        } else if (uiInfo.demoObjects[index].name == "..") {
-          handles[0] = uiInfo.uiDC.Assets.replayHome;
-        } else {
-          handles[0] = uiInfo.uiDC.Assets.replayDirectory;
-        }
+      if (uiInfo.demoObjects[index].name == ".") {
+        handles[0] = uiInfo.uiDC.Assets.replayUp;
+      } else if (uiInfo.demoObjects[index].name == "..") {
+        handles[0] = uiInfo.uiDC.Assets.replayHome;
+      } else {
+        handles[0] = uiInfo.uiDC.Assets.replayDirectory;
       }
 
       return uiInfo.demoObjects[index].displayName.c_str();
     }
+
+    if (const auto entry = UI_DemoFileEntry(index)) {
+      return entry->displayName.c_str();
+    }
   } else if (feederID == FEEDER_PROFILES) {
     if (index >= 0 && index < uiInfo.profileCount) {
       char buff[MAX_CVAR_VALUE_STRING];
@@ -6751,6 +6951,7 @@ void _UI_Init(int legacyClient, int clientVersion) {
   UI_RegisterCvars();
   UI_InitMemory();
   trap_PC_RemoveAllGlobalDefines();
+  trap_Cvar_Set("ui_pcGlobalDefines", "");
 
   trap_Cvar_Set("ui_menuFiles",
                 "ui/menus.txt"); // NERVE - SMF - we need to hardwire for wolfMP
@@ -7741,6 +7942,10 @@ vmCvar_t ui_browserShowWeaponsRestricted;
 vmCvar_t ui_browserShowTeamBalanced;
 vmCvar_t ui_browserShowETJump;
 
+vmCvar_t ui_demoSortKey;
+vmCvar_t ui_demoSortDir;
+vmCvar_t ui_demoFilter;
+
 vmCvar_t ui_serverStatusTimeOut;
 
 vmCvar_t ui_Q3Model;
@@ -7903,6 +8108,10 @@ cvarTable_t cvarTable[] = {
      CVAR_ARCHIVE},
     {&ui_browserShowETJump, "ui_browserShowETJump", "0", CVAR_ARCHIVE},
 
+    {&ui_demoSortKey, "ui_demoSortKey", "0", CVAR_ARCHIVE},
+    {&ui_demoSortDir, "ui_demoSortDir", "0", CVAR_ARCHIVE},
+    {&ui_demoFilter, "ui_demoFilter", "", 0},
+
     {&ui_serverStatusTimeOut, "ui_serverStatusTimeOut", "7000", CVAR_ARCHIVE},
 
     {&ui_Q3Model, "ui_Q3Model", "1", 0},
@@ -7,6 +7,7 @@
 
 #include "ui_shared.h"
 #include "ui_local.h" // For CS settings/retrieval
+#include "etj_menu_token_cache.h"
 
 #define SCROLL_TIME_START 500
 #define SCROLL_TIME_ADJUST 150
@@ -7754,6 +7755,130 @@ void Menu_PaintAll() {
 
 void Menu_Reset() { menuCount = 0; }
 
+static ETJump::MenuTokenCache menuTokenCache;
+static std::string menuTokenCacheKey;
+static bool menuTokenCacheValid = false;
+static bool menuTokenCacheDirty = false;
+
+static bool Menu_ReadSourceFile(const std::string &path, std::string &data) {
+  fileHandle_t f;
+  const int len = trap_FS_FOpenFile(path.c_str(), &f, FS_READ);
+  if (len < 0 || !f) {
+    return false;
+  }
+
+  data.assign(len, '\0');
+  if (len > 0) {
+    trap_FS_Read(&data[0], len, f);
+  }
+  trap_FS_FCloseFile(f);
+  return true;
+}
+
+static std::string Menu_TokenCacheFile(const std::string &key) {
+  return va("menucache/%08x.dat", ETJump::MenuTokenCache::hash(key));
+}
+
+void Menu_BeginTokenCache(const char *key) {
+  std::string data;
+
+  menuTokenCacheKey = key;
+  menuTokenCacheValid = false;
+  menuTokenCacheDirty = false;
+
+  if (Menu_ReadSourceFile(Menu_TokenCacheFile(menuTokenCacheKey), data) &&
+      menuTokenCache.deserialize(data) &&
+      menuTokenCache.isValid(menuTokenCacheKey, Menu_ReadSourceFile)) {
+    menuTokenCacheValid = true;
+    return;
+  }
+
+  menuTokenCache.reset(menuTokenCacheKey);
+}
+
+int Menu_LoadSource(const char *filename) {
+  // files missing from a valid cache were not requested when it was built,
+  // they are parsed by the engine and added to it
+  if (!menuTokenCache.hasStream(filename)) {
+    const int handle = trap_PC_LoadSource(filename);
+    if (!handle) {
+      return 0;
+    }
+
+    menuTokenCache.addSource(filename, Menu_ReadSourceFile);
+    menuTokenCacheDirty = true;
+
+    pc_token_t token;
+    char file[MAX_QPATH] = "";
+    int line = 0;
+
+    menuTokenCache.beginStream(filename);
+    while (trap_PC_ReadToken(handle, &token)) {
+      trap_PC_SourceFileAndLine(handle, file, &line);
+      menuTokenCache.addToken({token.type, token.subtype, token.intvalue,
+                               token.floatvalue, line, token.string, file});
+    }
+    trap_PC_FreeSource(handle);
+  }
+
+  return menuTokenCache.open(filename);
+}
+
+qboolean Menu_EndTokenCache() {
+  if (menuTokenCacheDirty) {
+    fileHandle_t f;
+    if (trap_FS_FOpenFile(Menu_TokenCacheFile(menuTokenCacheKey).c_str(), &f,
+                          FS_WRITE) >= 0) {
+      const auto data = menuTokenCache.serialize();
+      trap_FS_Write(data.c_str(), static_cast<int>(data.size()), f);
+      trap_FS_FCloseFile(f);
+    }
+    menuTokenCacheDirty = false;
+  }
+
+  // the tokens are only needed while the menus are being parsed
+  const qboolean cached = menuTokenCacheValid ? qtrue : qfalse;
+  menuTokenCache.reset("");
+  menuTokenCacheValid = false;
+  return cached;
+}
+
+qboolean PC_IsCachedSource(int handle) {
+  return ETJump::MenuTokenCache::isHandle(handle) ? qtrue : qfalse;
+}
+
+int PC_FreeCachedSource(int handle) {
+  return menuTokenCache.close(handle) ? 1 : 0;
+}
+
+int PC_ReadCachedToken(int handle, pc_token_t *pc_token) {
+  ETJump::MenuTokenCache::Token token;
+  if (!menuTokenCache.read(handle, token)) {
+    return 0;
+  }
+
+  pc_token->type = token.type;
+  pc_token->subtype = token.subtype;
+  pc_token->intvalue = token.intValue;
+  pc_token->floatvalue = token.floatValue;
+  Q_strncpyz(pc_token->string, token.string, sizeof(pc_token->string));
+  return 1;
+}
+
+int PC_CachedSourceFileAndLine(int handle, char *filename, int *line) {
+  std::string file;
+  if (!menuTokenCache.fileAndLine(handle, file, *line)) {
+    return 0;
+  }
+
+  Q_strncpyz(filename, file.c_str(), MAX_QPATH);
+  return 1;
+}
+
+int PC_UnReadCachedToken(int handle) {
+  return menuTokenCache.unread(handle) ? 1 : 0;
+}
+
 displayContextDef_t *Display_GetContext() { return DC; }
 
 // static float captureX; // TTimo: unused
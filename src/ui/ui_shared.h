@@ -603,6 +603,19 @@ int trap_PC_ReadToken(int handle, pc_token_t *pc_token);
 int trap_PC_SourceFileAndLine(int handle, char *filename, int *line);
 int trap_PC_UnReadToken(int handle);
 
+// menu files are parsed from a cache of their preprocessed tokens,
+// handles returned by Menu_LoadSource work with the regular trap_PC_* calls
+void Menu_BeginTokenCache(const char *key);
+int Menu_LoadSource(const char *filename);
+// writes the cache if it was rebuilt,
+// returns qtrue if the menus were loaded from a valid cache
+qboolean Menu_EndTokenCache();
+qboolean PC_IsCachedSource(int handle);
+int PC_FreeCachedSource(int handle);
+int PC_ReadCachedToken(int handle, pc_token_t *pc_token);
+int PC_CachedSourceFileAndLine(int handle, char *filename, int *line);
+int PC_UnReadCachedToken(int handle);
+
 //
 // panelhandling
 //
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "../src/game/etj_client_command_registry.h"
+
+using namespace ETJump;
+
+class ClientCommandRegistryTests : public testing::Test {
+public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  ClientCommandRegistry registry;
+};
+
+TEST_F(ClientCommandRegistryTests, FindShouldReturnRegisteredCommand) {
+  auto called = false;
+  ASSERT_TRUE(registry.add("load", ClientCommandPhase::NoIntermission,
+                           FloodProtection::None, "",
+                           [&called](gentity_t *) { called = true; }));
+
+  const auto command = registry.find("load");
+  ASSERT_NE(command, nullptr);
+  command->handler(nullptr);
+  ASSERT_TRUE(called);
+}
+
+TEST_F(ClientCommandRegistryTests, FindShouldIgnoreCase) {
+  registry.add("interruptRun", ClientCommandPhase::NoIntermission,
+               FloodProtection::Command, "", [](gentity_t *) {});
+
+  ASSERT_NE(registry.find("interruptrun"), nullptr);
+  ASSERT_NE(registry.find("INTERRUPTRUN"), nullptr);
+  ASSERT_EQ(registry.find("interrupt"), nullptr);
+}
+
+TEST_F(ClientCommandRegistryTests, FindShouldReturnMetadata) {
+  registry.add("say", ClientCommandPhase::Anytime, FloodProtection::Chat, "",
+               [](gentity_t *) {});
+  registry.add("topshots", ClientCommandPhase::NoIntermission,
+               FloodProtection::None, ":^7 Shows BEST player",
+               [](gentity_t *) {});
+
+  const auto say = registry.find("SAY");
+  ASSERT_EQ(say->name, "say");
+  ASSERT_EQ(say->phase, ClientCommandPhase::Anytime);
+  ASSERT_EQ(say->floodProtection, FloodProtection::Chat);
+  ASSERT_TRUE(say->help.empty());
+
+  const auto topshots = registry.find("topshots");
+  ASSERT_EQ(topshots->phase, ClientCommandPhase::NoIntermission);
+  ASSERT_EQ(topshots->help, ":^7 Shows BEST player");
+}
+
+TEST_F(ClientCommandRegistryTests, AddShouldKeepFirstRegistration) {
+  auto first = false;
+  ASSERT_TRUE(registry.add("team", ClientCommandPhase::NoIntermission,
+                           FloodProtection::Command, "",
+                           [&first](gentity_t *) { first = true; }));
+  ASSERT_FALSE(registry.add("Team", ClientCommandPhase::NoIntermission,
+                            FloodProtection::None, " <b|r|s|none>",
+                            [](gentity_t *) {}));
+
+  const auto team = registry.find("team");
+  team->handler(nullptr);
+  ASSERT_TRUE(first);
+  ASSERT_EQ(team->floodProtection, FloodProtection::Command);
+  ASSERT_EQ(registry.size(), 1u);
+}
+
+TEST_F(ClientCommandRegistryTests, AddShouldRejectCommandWithoutHandler) {
+  ASSERT_FALSE(registry.add("+stats", ClientCommandPhase::Anytime,
+                            FloodProtection::None, "", nullptr));
+  ASSERT_EQ(registry.find("+stats"), nullptr);
+}
@@ -19,7 +19,7 @@ public:
 TEST_F(ClientCommandsHandlerTests, SubscribeShouldCreateACallback) {
   auto command = "command";
   auto called = false;
-  handler->subscribe(command, [&called](const std::vector<std::string> &args) {
+  handler->subscribe(command, [&called](const CommandArguments &args) {
     called = true;
   });
   handler->check(command, std::vector<std::string>());
@@ -29,20 +29,25 @@ TEST_F(ClientCommandsHandlerTests, SubscribeShouldCreateACallback) {
 TEST_F(ClientCommandsHandlerTests, UnsubscribeShouldRemoveCallback) {
   auto command = "command";
   auto called = false;
-  handler->subscribe(command, [&called](const std::vector<std::string> &args) {
+  handler->subscribe(command, [&called](const CommandArguments &args) {
     called = true;
   });
   handler->check(command, std::vector<std::string>());
   ASSERT_TRUE(called);
   called = false;
-  handler->unsubscribe(command);
+  ASSERT_TRUE(handler->unsubscribe(command));
+  handler->check(command, std::vector<std::string>());
   ASSERT_FALSE(called);
 }
 
+TEST_F(ClientCommandsHandlerTests, UnsubscribeShouldFailForUnknownCommand) {
+  ASSERT_FALSE(handler->unsubscribe("command"));
+}
+
 TEST_F(ClientCommandsHandlerTests, DifferentCallbackShouldntBeCalled) {
   auto command = "command";
   auto called = false;
-  handler->subscribe(command, [&called](const std::vector<std::string> &args) {
+  handler->subscribe(command, [&called](const CommandArguments &args) {
     called = true;
   });
   handler->check("secondCommand", std::vector<std::string>());
@@ -52,7 +57,7 @@ TEST_F(ClientCommandsHandlerTests, DifferentCallbackShouldntBeCalled) {
 TEST_F(ClientCommandsHandlerTests, HandlerShouldBeCaseInsensitive) {
   auto command = "command";
   auto called = false;
-  handler->subscribe(command, [&called](const std::vector<std::string> &args) {
+  handler->subscribe(command, [&called](const CommandArguments &args) {
     called = true;
   });
   handler->check("ComMand", std::vector<std::string>());
@@ -62,9 +67,25 @@ TEST_F(ClientCommandsHandlerTests, HandlerShouldBeCaseInsensitive) {
 TEST_F(ClientCommandsHandlerTests, SubscribeShouldBeCaseInsensitive) {
   auto command = "ComMand";
   auto called = false;
-  handler->subscribe(command, [&called](const std::vector<std::string> &args) {
+  handler->subscribe(command, [&called](const CommandArguments &args) {
     called = true;
   });
   handler->check("command", std::vector<std::string>());
   ASSERT_TRUE(called);
 }
+
+TEST_F(ClientCommandsHandlerTests, CheckShouldPassArgumentsAsView) {
+  const char *tokens[] = {"first", "second"};
+  std::vector<std::string> received;
+  handler->subscribe("command", [&received](const CommandArguments &args) {
+    received = args.toVector();
+  });
+  handler->check("command", CommandArguments(tokens, 2));
+  ASSERT_EQ(received, std::vector<std::string>({"first", "second"}));
+}
+
+TEST_F(ClientCommandsHandlerTests, SubscribeShouldRejectDuplicateCommand) {
+  handler->subscribe("command", [](const CommandArguments &args) {});
+  ASSERT_FALSE(
+      handler->subscribe("COMMAND", [](const CommandArguments &args) {}));
+}
@@ -0,0 +1,222 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <gtest/gtest.h>
+#include <sqlite3.h>
+#include "../src/game/etj_database_maintenance.h"
+#include "../src/game/etj_log.h"
+#include "../src/game/etj_synchronization_context.h"
+
+using namespace ETJump;
+
+// the log flushes through the printer on the main thread, nothing to
+// print to here
+void Printer::LogPrintln(const std::string &message) {}
+
+static const int NUM_ROWS = 500;
+
+class DatabaseMaintenanceTests : public testing::Test {
+public:
+  void SetUp() override {
+    // one file per test, ctest may run them in parallel
+    database = std::string("database_maintenance_") +
+               testing::UnitTest::GetInstance()->current_test_info()->name() +
+               ".db";
+    removeFiles();
+
+    sqlite3_open(database.c_str(), &db);
+    execute("PRAGMA journal_mode=WAL;");
+    execute("create table runs (id integer primary key, name text);");
+    execute("create index idx_runs_name on runs(name);");
+    for (int i = 0; i < NUM_ROWS; i++) {
+      insertRun(i);
+    }
+  }
+
+  void TearDown() override {
+    maintenance = nullptr;
+    sqlite3_close(db);
+    removeFiles();
+  }
+
+  void removeFiles() const {
+    const std::string backup = DatabaseMaintenance::backupPath(database);
+    for (const auto &file : {database, database + "-wal", database + "-shm",
+                             backup, backup + ".tmp"}) {
+      std::remove(file.c_str());
+    }
+  }
+
+  void execute(const std::string &query) const {
+    ASSERT_EQ(sqlite3_exec(db, query.c_str(), nullptr, nullptr, nullptr),
+              SQLITE_OK);
+  }
+
+  void insertRun(int i) const {
+    execute("insert into runs (name) values ('run number " +
+            std::to_string(i) + " with a long enough name to fill pages');");
+  }
+
+  void createMaintenance(std::vector<DatabaseMaintenance::Target> targets,
+                         DatabaseMaintenance::Options options = {}) {
+    // a few pages per step so a backup takes many frames
+    options.backupPagesPerStep = 2;
+    maintenance = std::make_unique<DatabaseMaintenance>(
+        std::move(targets), options, std::make_unique<Log>("test"),
+        std::make_unique<SynchronizationContext>());
+    maintenance->initialize();
+  }
+
+  // runs frames like the game does until the pass is done, returns the
+  // number of frames it took
+  int runUntilIdle() const {
+    int frames = 0;
+    for (; frames < 10000; frames++) {
+      maintenance->runFrame();
+      if (maintenance->isIdle()) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return frames;
+  }
+
+  static int countRows(const std::string &path) {
+    sqlite3 *copy = nullptr;
+    sqlite3_open_v2(path.c_str(), &copy, SQLITE_OPEN_READONLY, nullptr);
+
+    sqlite3_stmt *stmt = nullptr;
+    int count = -1;
+    if (sqlite3_prepare_v2(copy, "select count(*) from runs;", -1, &stmt,
+                           nullptr) == SQLITE_OK &&
+        sqlite3_step(stmt) == SQLITE_ROW) {
+      count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(copy);
+    return count;
+  }
+
+  static bool fileExists(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file) {
+      fclose(file);
+    }
+    return file != nullptr;
+  }
+
+  std::string database;
+  sqlite3 *db = nullptr;
+  std::unique_ptr<DatabaseMaintenance> maintenance;
+};
+
+TEST_F(DatabaseMaintenanceTests, BackupShouldCopyDatabaseInSmallSteps) {
+  createMaintenance({{"runs", database}});
+
+  ASSERT_TRUE(maintenance->requestBackup());
+  ASSERT_GT(runUntilIdle(), 1);
+
+  const auto backup = DatabaseMaintenance::backupPath(database);
+  ASSERT_EQ(countRows(backup), NUM_ROWS);
+  ASSERT_FALSE(fileExists(backup + ".tmp"));
+  ASSERT_GT(maintenance->lastBackup(), 0);
+}
+
+TEST_F(DatabaseMaintenanceTests, BackupShouldIncludeWritesMadeWhileCopying) {
+  createMaintenance({{"runs", database}});
+  ASSERT_TRUE(maintenance->requestBackup());
+
+  // keep writing from the "game" connection between the first frames
+  for (int i = 0; i < 5; i++) {
+    maintenance->runFrame();
+    insertRun(NUM_ROWS + i);
+  }
+
+  runUntilIdle();
+
+  ASSERT_EQ(countRows(DatabaseMaintenance::backupPath(database)),
+            NUM_ROWS + 5);
+}
+
+TEST_F(DatabaseMaintenanceTests, BackupShouldFinishWhileWritesKeepComing) {
+  createMaintenance({{"runs", database}});
+  ASSERT_TRUE(maintenance->requestBackup());
+
+  // a write before every step restarts the copy each time, until the
+  // backup gives up on small steps and copies the rest at once
+  int inserted = 0;
+  for (; inserted < 1000 && !maintenance->isIdle(); inserted++) {
+    insertRun(NUM_ROWS + inserted);
+    maintenance->runFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  ASSERT_TRUE(maintenance->isIdle());
+
+  const int rows = countRows(DatabaseMaintenance::backupPath(database));
+  ASSERT_GE(rows, NUM_ROWS);
+  ASSERT_LE(rows, NUM_ROWS + inserted);
+  ASSERT_NE(maintenance->status().find("restarted"), std::string::npos);
+}
+
+TEST_F(DatabaseMaintenanceTests, RequestShouldFailIfPassIsAlreadyQueued) {
+  createMaintenance({{"runs", database}});
+
+  ASSERT_TRUE(maintenance->requestBackup());
+  ASSERT_FALSE(maintenance->requestBackup());
+  ASSERT_TRUE(maintenance->requestOptimize());
+  ASSERT_FALSE(maintenance->requestOptimize());
+
+  runUntilIdle();
+
+  ASSERT_TRUE(maintenance->requestBackup());
+}
+
+TEST_F(DatabaseMaintenanceTests, OptimizeShouldAnalyzeDatabase) {
+  createMaintenance({{"runs", database}});
+
+  ASSERT_TRUE(maintenance->requestOptimize());
+  runUntilIdle();
+
+  sqlite3_stmt *stmt = nullptr;
+  ASSERT_EQ(sqlite3_prepare_v2(db, "select count(*) from sqlite_stat1;", -1,
+                               &stmt, nullptr),
+            SQLITE_OK);
+  ASSERT_EQ(sqlite3_step(stmt), SQLITE_ROW);
+  ASSERT_GT(sqlite3_column_int(stmt, 0), 0);
+  sqlite3_finalize(stmt);
+
+  ASSERT_NE(maintenance->status().find("analyzed"), std::string::npos);
+  ASSERT_GT(maintenance->lastOptimize(), 0);
+}
+
+TEST_F(DatabaseMaintenanceTests, MissingDatabaseShouldFailWithoutCreatingIt) {
+  const std::string missing = "database_maintenance_missing.db";
+  createMaintenance({{"missing", missing}});
+
+  ASSERT_TRUE(maintenance->requestOptimize());
+  ASSERT_TRUE(maintenance->requestBackup());
+  runUntilIdle();
+
+  ASSERT_FALSE(fileExists(missing));
+  ASSERT_FALSE(fileExists(DatabaseMaintenance::backupPath(missing)));
+  ASSERT_NE(maintenance->status().find("failed"), std::string::npos);
+}
+
+TEST_F(DatabaseMaintenanceTests, ScheduleShouldOnlyRunDuePasses) {
+  DatabaseMaintenance::Options options;
+  options.optimizeInterval = 60 * 60 * 1000;
+  createMaintenance({{"runs", database}}, options);
+
+  maintenance->runFrame();
+  ASSERT_FALSE(maintenance->isIdle());
+  runUntilIdle();
+
+  ASSERT_GT(maintenance->lastOptimize(), 0);
+  ASSERT_EQ(maintenance->lastBackup(), 0);
+  ASSERT_FALSE(fileExists(DatabaseMaintenance::backupPath(database)));
+
+  // ran just now, the next pass is an hour away
+  maintenance->runFrame();
+  ASSERT_TRUE(maintenance->isIdle());
+}
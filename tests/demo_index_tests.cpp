@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "../src/ui/etj_demo_index.h"
+
+using namespace ETJump;
+
+class DemoIndexTests : public testing::Test {
+public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(DemoIndexTests, parseName_ShouldParseTimerunDemo) {
+  DemoMetadata meta;
+  ASSERT_TRUE(DemoIndex::parseName(
+      "player_oasis_run1_01.23.456[17-10-2026-201530].dm_84", meta));
+  EXPECT_EQ(meta.player, "player");
+  EXPECT_EQ(meta.map, "oasis");
+  EXPECT_EQ(meta.run, "run1");
+  EXPECT_EQ(meta.runTime, 83456);
+  EXPECT_EQ(meta.timestamp, 20261017201530LL);
+}
+
+TEST_F(DemoIndexTests, parseName_ShouldParseManuallySavedDemo) {
+  DemoMetadata meta;
+  ASSERT_TRUE(DemoIndex::parseName(
+      "player_oasis_demo[17-10-2026-201530].dm_84", meta));
+  EXPECT_EQ(meta.player, "player");
+  EXPECT_EQ(meta.map, "oasis");
+  EXPECT_EQ(meta.run, "demo");
+  EXPECT_EQ(meta.runTime, -1);
+}
+
+TEST_F(DemoIndexTests, parseName_ShouldUseKnownMapsToResolveUnderscores) {
+  DemoMetadata meta;
+  ASSERT_TRUE(DemoIndex::parseName(
+      "my_name_pcj_unity_long_run_10.00.001[01-02-2025-000000].dm_84", meta,
+      {"pcj", "pcj_unity"}));
+  EXPECT_EQ(meta.player, "my_name");
+  EXPECT_EQ(meta.map, "pcj_unity");
+  EXPECT_EQ(meta.run, "long_run");
+  EXPECT_EQ(meta.runTime, 600001);
+}
+
+TEST_F(DemoIndexTests, parseName_ShouldRejectNonAutodemoNames) {
+  DemoMetadata meta;
+  EXPECT_FALSE(DemoIndex::parseName("somedemo.dm_84", meta));
+  EXPECT_FALSE(DemoIndex::parseName("somedemo[notadate].dm_84", meta));
+}
+
+TEST_F(DemoIndexTests, update_ShouldOnlyReportChangesWhenListingDiffers) {
+  DemoIndex index;
+  EXPECT_TRUE(index.update("demos", {"a.dm_84", "b.dm_84"}));
+  EXPECT_FALSE(index.update("demos", {"b.dm_84", "a.dm_84"}));
+  EXPECT_TRUE(index.update("demos", {"b.dm_84", "c.dm_84"}));
+
+  index.setView("demos", DemoIndex::SortKey::Name, false, "");
+  ASSERT_EQ(index.size(), 2);
+  EXPECT_EQ(index.get(0)->name, "b.dm_84");
+  EXPECT_EQ(index.get(1)->name, "c.dm_84");
+}
+
+TEST_F(DemoIndexTests, setView_ShouldSortAndFilter) {
+  DemoIndex index;
+  index.update("demos", {"p_oasis_a_00.10.000[01-01-2025-000000].dm_84",
+                         "p_goldrush_b_00.05.000[02-01-2025-000000].dm_84",
+                         "p_oasis_c_00.20.000[03-01-2025-000000].dm_84",
+                         "manual.dm_84"});
+
+  index.setView("demos", DemoIndex::SortKey::Time, false, "");
+  ASSERT_EQ(index.size(), 4);
+  EXPECT_EQ(index.get(0)->metadata.run, "b");
+  EXPECT_EQ(index.get(1)->metadata.run, "a");
+  EXPECT_EQ(index.get(2)->metadata.run, "c");
+  EXPECT_EQ(index.get(3)->name, "manual.dm_84");
+
+  index.setView("demos", DemoIndex::SortKey::Date, true, "map:oasis");
+  ASSERT_EQ(index.size(), 2);
+  EXPECT_EQ(index.get(0)->metadata.run, "c");
+  EXPECT_EQ(index.get(1)->metadata.run, "a");
+}
+
+TEST_F(DemoIndexTests, serialize_ShouldRoundTrip) {
+  DemoIndex index;
+  index.update("demos/sub", {"p_oasis_a_00.10.000[01-01-2025-000000].dm_84"});
+  EXPECT_TRUE(index.isDirty());
+
+  DemoIndex loaded;
+  ASSERT_TRUE(loaded.deserialize(index.serialize()));
+  EXPECT_FALSE(loaded.isDirty());
+  EXPECT_FALSE(loaded.update(
+      "demos/sub", {"p_oasis_a_00.10.000[01-01-2025-000000].dm_84"}));
+
+  loaded.setView("demos/sub", DemoIndex::SortKey::Name, false, "");
+  ASSERT_EQ(loaded.size(), 1);
+  EXPECT_EQ(loaded.get(0)->metadata.map, "oasis");
+  EXPECT_EQ(loaded.get(0)->metadata.runTime, 10000);
+}
+
+TEST_F(DemoIndexTests, deserialize_ShouldRejectUnknownFormat) {
+  DemoIndex index;
+  EXPECT_FALSE(index.deserialize("garbage\n"));
+}
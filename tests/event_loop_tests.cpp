@@ -0,0 +1,170 @@
+#include <functional>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../src/cgame/etj_event_loop.h"
+
+using namespace ETJump;
+
+class EventLoopTests : public testing::Test {
+public:
+  int64_t now = 0;
+  EventLoop loop{[this] { return now; }};
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+};
+
+TEST_F(EventLoopTests, Run_ShouldExecuteTaskOnlyAfterDelay) {
+  int executed = 0;
+  loop.schedule([&] { executed++; }, 100);
+
+  now = 99;
+  loop.run();
+  EXPECT_EQ(executed, 0);
+
+  now = 100;
+  loop.run();
+  EXPECT_EQ(executed, 1);
+
+  now = 500;
+  loop.run();
+  EXPECT_EQ(executed, 1);
+  EXPECT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, Run_ShouldExecuteTasksInDueOrder) {
+  std::string order;
+  loop.schedule([&] { order += "c"; }, 30);
+  loop.schedule([&] { order += "a"; }, 10);
+  loop.schedule([&] { order += "b"; }, 20);
+  loop.schedule([&] { order += "i"; }, 10, TaskPriorities::Immediate);
+
+  now = 100;
+  loop.run();
+  EXPECT_EQ(order, "iabc");
+}
+
+TEST_F(EventLoopTests, Run_ShouldRescheduleDelayZeroPersistentTaskOncePerRun) {
+  int executed = 0;
+  loop.schedulePersistent([&] { executed++; }, 0);
+
+  loop.run();
+  loop.run();
+  EXPECT_EQ(executed, 2);
+  EXPECT_EQ(loop.pendingEventsCount(), 1);
+}
+
+TEST_F(EventLoopTests, Unschedule_ShouldCancelTask) {
+  int executed = 0;
+  const int handle = loop.schedule([&] { executed++; }, 10);
+
+  EXPECT_TRUE(loop.unschedule(handle));
+  EXPECT_FALSE(loop.unschedule(handle));
+
+  now = 100;
+  loop.run();
+  EXPECT_EQ(executed, 0);
+  EXPECT_EQ(loop.pendingEventsCount(), 0);
+}
+
+TEST_F(EventLoopTests, Unschedule_StaleHandleShouldNotCancelReusedSlot) {
+  int executed = 0;
+  const int stale = loop.schedule([] {}, 10);
+  loop.unschedule(stale);
+  loop.schedule([&] { executed++; }, 10);
+
+  EXPECT_FALSE(loop.unschedule(stale));
+  now = 10;
+  loop.run();
+  EXPECT_EQ(executed, 1);
+}
+
+TEST_F(EventLoopTests, Unschedule_StaleHandleShouldNotCancelAfterManyReuses) {
+  const int stale = loop.schedule([] {}, 10);
+  loop.unschedule(stale);
+
+  // reuses the same slot far past what a 15-bit generation could tell apart
+  for (int i = 0; i < 70000; i++) {
+    loop.unschedule(loop.schedule([] {}, 10));
+  }
+
+  int executed = 0;
+  loop.schedule([&] { executed++; }, 10);
+  EXPECT_FALSE(loop.unschedule(stale));
+  now = 10;
+  loop.run();
+  EXPECT_EQ(executed, 1);
+}
+
+TEST_F(EventLoopTests, Unschedule_PersistentTaskCanCancelItself) {
+  int executed = 0;
+  int handle = 0;
+  handle = loop.schedulePersistent(
+      [&] {
+        if (++executed == 3) {
+          loop.unschedule(handle);
+        }
+      },
+      5);
+
+  for (int i = 0; i < 10; i++) {
+    now += 5;
+    loop.run();
+  }
+
+  EXPECT_EQ(executed, 3);
+  EXPECT_FALSE(loop.hasPendingEvents());
+}
+
+TEST_F(EventLoopTests, Run_TasksScheduledDuringRunShouldWaitForNextRun) {
+  int executed = 0;
+  loop.schedule([&] { loop.schedule([&] { executed++; }, 0); }, 0);
+
+  loop.run();
+  EXPECT_EQ(executed, 0);
+  loop.run();
+  EXPECT_EQ(executed, 1);
+}
+
+TEST_F(EventLoopTests, Run_ImmediateTaskReaddingItselfShouldNotStarveOthers) {
+  std::string order;
+  std::function<void()> immediate = [&] {
+    order += "i";
+    loop.schedule(immediate, 0, TaskPriorities::Immediate);
+  };
+  loop.schedule(immediate, 10, TaskPriorities::Immediate);
+  loop.schedule([&] { order += "a"; }, 10);
+  loop.schedule([&] { order += "b"; }, 10);
+
+  now = 10;
+  loop.run();
+  EXPECT_EQ(order, "iab");
+  loop.run();
+  EXPECT_EQ(order, "iabi");
+}
+
+TEST_F(EventLoopTests, Execute_ShouldRunTimeoutOnlyOnce) {
+  int executed = 0;
+  const int handle = loop.schedule([&] { executed++; }, 1000);
+
+  loop.execute(handle);
+  EXPECT_EQ(executed, 1);
+
+  now = 1000;
+  loop.run();
+  EXPECT_EQ(executed, 1);
+}
+
+TEST_F(EventLoopTests, Shutdown_ShouldRunPendingTasksOnce) {
+  std::vector<int> executed;
+  loop.schedule([&] { executed.push_back(1); }, 1000);
+  loop.schedulePersistent([&] { executed.push_back(2); }, 1000);
+  const int cancelled = loop.schedule([&] { executed.push_back(3); }, 1000);
+  loop.unschedule(cancelled);
+
+  loop.shutdown();
+  EXPECT_EQ(executed, (std::vector<int>{1, 2}));
+  EXPECT_FALSE(loop.hasPendingEvents());
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../src/cgame/etj_glyph_run_cache.h"
+
+using namespace ETJump;
+
+class GlyphRunCacheTests : public testing::Test {
+public:
+  fontInfo_t font{};
+
+  void SetUp() override {
+    for (int i = 0; i < GLYPHS_PER_FONT; i++) {
+      auto &glyph = font.glyphs[i];
+      glyph.top = 10;
+      glyph.pitch = 1;
+      glyph.xSkip = 8;
+      glyph.imageWidth = 6;
+      glyph.imageHeight = 12;
+      glyph.glyph = i;
+    }
+    font.glyphScale = 1.0f;
+  }
+
+  void TearDown() override {}
+};
+
+TEST_F(GlyphRunCacheTests, get_ShouldLayOutGlyphs) {
+  GlyphRunCache cache;
+  const auto &run = cache.get("ab", 0.5f, 2.0f, 1.0f, 0, &font);
+
+  ASSERT_EQ(run.quads.size(), 2);
+  EXPECT_FLOAT_EQ(run.quads[0].x, 0.5f);
+  EXPECT_FLOAT_EQ(run.quads[0].y, -20.0f);
+  EXPECT_FLOAT_EQ(run.quads[0].w, 3.0f);
+  EXPECT_FLOAT_EQ(run.quads[0].h, 24.0f);
+  EXPECT_EQ(run.quads[0].shader, 'a');
+  // advance of xSkip * scale + adjust
+  EXPECT_FLOAT_EQ(run.quads[1].x, 0.5f + 4.0f + 1.0f);
+  EXPECT_EQ(run.quads[1].shader, 'b');
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldSplitColorSpans) {
+  GlyphRunCache cache;
+  const auto &run = cache.get("a^1bc^*d", 1, 1, 0, 0, &font);
+
+  ASSERT_EQ(run.quads.size(), 4);
+  ASSERT_EQ(run.spans.size(), 3);
+  EXPECT_EQ(run.spans[0].firstQuad, 0);
+  EXPECT_EQ(run.spans[0].colorIndex, -1);
+  EXPECT_EQ(run.spans[1].firstQuad, 1);
+  EXPECT_EQ(run.spans[1].colorIndex, 1);
+  EXPECT_EQ(run.spans[2].firstQuad, 3);
+  EXPECT_EQ(run.spans[2].colorIndex, -1);
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldMergeConsecutiveColorCodes) {
+  GlyphRunCache cache;
+  const auto &run = cache.get("^1^2a^3", 1, 1, 0, 0, &font);
+
+  ASSERT_EQ(run.quads.size(), 1);
+  ASSERT_EQ(run.spans.size(), 1);
+  EXPECT_EQ(run.spans[0].colorIndex, 2);
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldDrawDoubleCaretLiterally) {
+  GlyphRunCache cache;
+  const auto &run = cache.get("^^1", 1, 1, 0, 0, &font);
+
+  ASSERT_EQ(run.quads.size(), 1);
+  EXPECT_EQ(run.quads[0].shader, '^');
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldApplyLimitToVisibleCharacters) {
+  GlyphRunCache cache;
+  const auto &run = cache.get("^1abcdef", 1, 1, 0, 3, &font);
+
+  // color codes don't count towards the limit
+  EXPECT_EQ(run.quads.size(), 3);
+  EXPECT_EQ(cache.get("abcdef", 1, 1, 0, 3, &font).quads.size(), 3);
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldHitForSameParameters) {
+  GlyphRunCache cache;
+  cache.get("speed", 1, 1, 0, 0, &font);
+  cache.get("speed", 1, 1, 0, 0, &font);
+
+  EXPECT_EQ(cache.missCount(), 1);
+  EXPECT_EQ(cache.hitCount(), 1);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldMissWhenParametersChange) {
+  GlyphRunCache cache;
+  fontInfo_t other = font;
+
+  cache.get("speed", 1, 1, 0, 0, &font);
+  cache.get("speed", 2, 1, 0, 0, &font);
+  cache.get("speed", 1, 2, 0, 0, &font);
+  cache.get("speed", 1, 1, 1, 0, &font);
+  cache.get("speed", 1, 1, 0, 2, &font);
+  cache.get("speed", 1, 1, 0, 0, &other);
+  cache.get("speeds", 1, 1, 0, 0, &font);
+
+  EXPECT_EQ(cache.missCount(), 7);
+  EXPECT_EQ(cache.hitCount(), 0);
+}
+
+TEST_F(GlyphRunCacheTests, get_ShouldEvictLeastRecentlyUsed) {
+  GlyphRunCache cache(2);
+
+  cache.get("a", 1, 1, 0, 0, &font);
+  cache.get("b", 1, 1, 0, 0, &font);
+  cache.get("a", 1, 1, 0, 0, &font);
+  cache.get("c", 1, 1, 0, 0, &font);
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.get("a", 1, 1, 0, 0, &font);
+  EXPECT_EQ(cache.hitCount(), 2);
+
+  const auto &run = cache.get("b", 1, 1, 0, 0, &font);
+  EXPECT_EQ(cache.missCount(), 4);
+  ASSERT_EQ(run.quads.size(), 1);
+  EXPECT_EQ(run.quads[0].shader, 'b');
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <map>
+#include "../src/ui/etj_menu_token_cache.h"
+
+using namespace ETJump;
+
+class MenuTokenCacheTests : public testing::Test {
+public:
+  void SetUp() override {
+    files["ui/menudef.h"] = "#define ITEM_TYPE_TEXT 0\n";
+    files["ui/main.menu"] = "#include \"ui/menudef.h\"\n"
+                            "  # include <ui/macros.h>\n"
+                            "menuDef { name \"main\" }\n";
+    files["ui/macros.h"] = "#define X 1\n";
+
+    readFile = [this](const std::string &path, std::string &data) {
+      const auto it = files.find(path);
+      if (it == files.end()) {
+        return false;
+      }
+      data = it->second;
+      return true;
+    };
+  }
+
+  void TearDown() override {}
+
+  void buildCache(MenuTokenCache &cache) {
+    cache.reset("ui/menus.txt FUI");
+    cache.addSource("ui/main.menu", readFile);
+    cache.beginStream("ui/main.menu");
+    cache.addToken({1, 0, 0, 0.0f, 3, "menuDef", "ui/main.menu"});
+    cache.addToken({5, 0, 0, 0.0f, 3, "{", "ui/main.menu"});
+    cache.addToken({1, 0, 0, 0.0f, 3, "name", "ui/main.menu"});
+    cache.addToken({1, 0, 0, 0.0f, 3, "main", "ui/main.menu"});
+    cache.addToken({5, 0, 0, 0.0f, 3, "}", "ui/main.menu"});
+  }
+
+  std::map<std::string, std::string> files;
+  MenuTokenCache::ReadFile readFile;
+};
+
+TEST_F(MenuTokenCacheTests, findIncludes_ShouldFindQuotedAndAngledIncludes) {
+  const auto includes = MenuTokenCache::findIncludes(files["ui/main.menu"]);
+  ASSERT_EQ(includes,
+            (std::vector<std::string>{"ui/menudef.h", "ui/macros.h"}));
+}
+
+TEST_F(MenuTokenCacheTests, addSource_ShouldRecordIncludedFiles) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  ASSERT_EQ(cache.getSources().size(), 3u);
+  ASSERT_TRUE(cache.isValid("ui/menus.txt FUI", readFile));
+}
+
+TEST_F(MenuTokenCacheTests, isValid_ShouldFailWhenKeyDiffers) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  ASSERT_FALSE(cache.isValid("ui/menus.txt", readFile));
+}
+
+TEST_F(MenuTokenCacheTests, isValid_ShouldFailWhenIncludedFileChanges) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  files["ui/menudef.h"] = "#define ITEM_TYPE_TEXT 1\n";
+  ASSERT_FALSE(cache.isValid("ui/menus.txt FUI", readFile));
+}
+
+TEST_F(MenuTokenCacheTests, isValid_ShouldFailWhenMissingIncludeAppears) {
+  files["ui/main.menu"] += "#include \"ui/missing.h\"\n";
+  MenuTokenCache cache;
+  buildCache(cache);
+  ASSERT_TRUE(cache.isValid("ui/menus.txt FUI", readFile));
+  files["ui/missing.h"] = "";
+  ASSERT_FALSE(cache.isValid("ui/menus.txt FUI", readFile));
+}
+
+TEST_F(MenuTokenCacheTests, read_ShouldReturnTokensInOrder) {
+  MenuTokenCache cache;
+  buildCache(cache);
+
+  const int handle = cache.open("ui/main.menu");
+  ASSERT_TRUE(MenuTokenCache::isHandle(handle));
+
+  MenuTokenCache::Token token;
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_STREQ(token.string, "menuDef");
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_STREQ(token.string, "{");
+  ASSERT_TRUE(cache.unread(handle));
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_STREQ(token.string, "{");
+
+  std::string file;
+  int line;
+  ASSERT_TRUE(cache.fileAndLine(handle, file, line));
+  ASSERT_EQ(file, "ui/main.menu");
+  ASSERT_EQ(line, 3);
+
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_TRUE(cache.read(handle, token));
+  ASSERT_FALSE(cache.read(handle, token));
+  ASSERT_TRUE(cache.close(handle));
+  ASSERT_FALSE(cache.read(handle, token));
+}
+
+TEST_F(MenuTokenCacheTests, fileAndLine_ShouldReportIncludedFile) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  cache.addToken({1, 0, 0, 0.0f, 1, "ITEM_TYPE_TEXT", "ui/menudef.h"});
+
+  MenuTokenCache loaded;
+  ASSERT_TRUE(loaded.deserialize(cache.serialize()));
+  const int handle = loaded.open("ui/main.menu");
+
+  std::string file;
+  int line;
+  MenuTokenCache::Token token;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_TRUE(loaded.read(handle, token));
+  }
+  ASSERT_TRUE(loaded.fileAndLine(handle, file, line));
+  ASSERT_EQ(file, "ui/main.menu");
+
+  ASSERT_TRUE(loaded.read(handle, token));
+  ASSERT_STREQ(token.file, "ui/menudef.h");
+  ASSERT_TRUE(loaded.fileAndLine(handle, file, line));
+  ASSERT_EQ(file, "ui/menudef.h");
+  ASSERT_EQ(line, 1);
+}
+
+TEST_F(MenuTokenCacheTests, open_ShouldFailForUnknownFile) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  ASSERT_EQ(cache.open("ui/unknown.menu"), 0);
+}
+
+TEST_F(MenuTokenCacheTests, deserialize_ShouldRestoreSerializedCache) {
+  MenuTokenCache cache;
+  buildCache(cache);
+
+  MenuTokenCache loaded;
+  ASSERT_TRUE(loaded.deserialize(cache.serialize()));
+  ASSERT_TRUE(loaded.isValid("ui/menus.txt FUI", readFile));
+
+  const int handle = loaded.open("ui/main.menu");
+  MenuTokenCache::Token token;
+  std::vector<std::string> strings;
+  while (loaded.read(handle, token)) {
+    strings.emplace_back(token.string);
+  }
+  ASSERT_EQ(strings, (std::vector<std::string>{"menuDef", "{", "name",
+                                               "main", "}"}));
+}
+
+TEST_F(MenuTokenCacheTests, deserialize_ShouldRejectTruncatedData) {
+  MenuTokenCache cache;
+  buildCache(cache);
+  auto data = cache.serialize();
+  data.resize(data.size() - 3);
+
+  MenuTokenCache loaded;
+  ASSERT_FALSE(loaded.deserialize(data));
+  ASSERT_FALSE(loaded.hasStream("ui/main.menu"));
+}
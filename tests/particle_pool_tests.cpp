@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "../src/cgame/etj_particle_pool.h"
+
+using namespace ETJump;
+
+class ParticlePoolTests : public testing::Test {
+public:
+  ParticlePool pool{8};
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  int spawn(float time, float x, float velX, float alpha, float alphaVel) {
+    const int index = pool.alloc();
+    pool.spawnTime[index] = time;
+    pool.endTime[index] = 0;
+    pool.orgX[index] = x;
+    pool.orgY[index] = 0;
+    pool.orgZ[index] = 0;
+    pool.velX[index] = velX;
+    pool.velY[index] = 0;
+    pool.velZ[index] = 0;
+    pool.accelX[index] = 0;
+    pool.accelY[index] = 0;
+    pool.accelZ[index] = 0;
+    pool.alpha[index] = alpha;
+    pool.alphaVel[index] = alphaVel;
+    pool.expires[index] = 0;
+    return index;
+  }
+};
+
+TEST_F(ParticlePoolTests, alloc_ShouldReturnDenseIndices) {
+  for (int i = 0; i < pool.getCapacity(); i++) {
+    EXPECT_EQ(pool.alloc(), i);
+  }
+  EXPECT_EQ(pool.size(), pool.getCapacity());
+}
+
+TEST_F(ParticlePoolTests, alloc_ShouldFailWhenFull) {
+  for (int i = 0; i < pool.getCapacity(); i++) {
+    pool.alloc();
+  }
+  EXPECT_EQ(pool.alloc(), -1);
+}
+
+TEST_F(ParticlePoolTests, remove_ShouldMoveLastIntoRemovedSlot) {
+  spawn(0, 1, 0, 1, 0);
+  spawn(0, 2, 0, 1, 0);
+  spawn(0, 3, 0, 1, 0);
+
+  EXPECT_EQ(pool.remove(0), 2);
+  EXPECT_EQ(pool.size(), 2);
+  EXPECT_FLOAT_EQ(pool.orgX[0], 3);
+  EXPECT_FLOAT_EQ(pool.orgX[1], 2);
+}
+
+TEST_F(ParticlePoolTests, remove_ShouldMoveEveryField) {
+  for (int i = 0; i < 3; i++) {
+    pool.alloc();
+  }
+  pool.forEachArray([](auto &array) {
+    array[0] = 1;
+    array[2] = 7;
+  });
+
+  pool.remove(0);
+  pool.forEachArray([](auto &array) { EXPECT_EQ(array[0], 7); });
+}
+
+TEST_F(ParticlePoolTests, remove_ShouldNotMoveWhenRemovingLast) {
+  spawn(0, 1, 0, 1, 0);
+  spawn(0, 2, 0, 1, 0);
+
+  EXPECT_EQ(pool.remove(1), 1);
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_FLOAT_EQ(pool.orgX[0], 1);
+}
+
+TEST_F(ParticlePoolTests, remove_ShouldAllowReusingSlot) {
+  spawn(0, 1, 0, 1, 0);
+  pool.remove(0);
+  EXPECT_EQ(pool.alloc(), 0);
+}
+
+TEST_F(ParticlePoolTests, integrate_ShouldComputePositionFromSpawnState) {
+  const int index = spawn(1000, 10, 100, 1, 0);
+  pool.accelZ[index] = -20;
+
+  pool.integrate(1500);
+
+  EXPECT_FLOAT_EQ(pool.posX[index], 10 + 100 * 0.5f);
+  EXPECT_FLOAT_EQ(pool.posZ[index], -20 * 0.25f);
+}
+
+TEST_F(ParticlePoolTests, integrate_ShouldClampAlpha) {
+  const int index = spawn(0, 0, 0, 2, 0);
+  pool.integrate(100);
+  EXPECT_FLOAT_EQ(pool.currentAlpha[index], 1);
+  EXPECT_FALSE(pool.dead[index]);
+}
+
+TEST_F(ParticlePoolTests, integrate_ShouldKillFadedParticles) {
+  const int index = spawn(0, 0, 0, 1, -1);
+
+  pool.integrate(500);
+  EXPECT_FALSE(pool.dead[index]);
+
+  pool.integrate(1000);
+  EXPECT_TRUE(pool.dead[index]);
+}
+
+TEST_F(ParticlePoolTests, integrate_ShouldOnlyExpireWhenFlagged) {
+  const int timed = spawn(0, 0, 0, 1, 0);
+  const int untimed = spawn(0, 0, 0, 1, 0);
+  pool.endTime[timed] = 100;
+  pool.expires[timed] = 1;
+  pool.endTime[untimed] = 100;
+
+  pool.integrate(100);
+  EXPECT_FALSE(pool.dead[timed]);
+
+  pool.integrate(101);
+  EXPECT_TRUE(pool.dead[timed]);
+  EXPECT_FALSE(pool.dead[untimed]);
+}
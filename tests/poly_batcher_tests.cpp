@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+#include "../src/cgame/etj_poly_batcher.h"
+
+using namespace ETJump;
+
+class PolyBatcherTests : public testing::Test {
+public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  static polyVert_t vert(float x) {
+    polyVert_t v{};
+    v.xyz[0] = x;
+    return v;
+  }
+};
+
+TEST_F(PolyBatcherTests, flush_ShouldGroupPolysByShaderAndVertCount) {
+  PolyBatcher batcher;
+  const polyVert_t quad[4] = {vert(1), vert(1), vert(1), vert(1)};
+  const polyVert_t tri[3] = {vert(2), vert(2), vert(2)};
+  const polyVert_t other[4] = {vert(3), vert(3), vert(3), vert(3)};
+
+  batcher.add(1, 4, quad);
+  batcher.add(2, 4, other);
+  batcher.add(1, 3, tri);
+  batcher.add(1, 4, quad);
+
+  std::vector<std::tuple<qhandle_t, int, int>> runs;
+  batcher.flush([&](qhandle_t shader, int numVerts, const polyVert_t *verts,
+                    int numPolys) {
+    runs.emplace_back(shader, numVerts, numPolys);
+    for (int i = 0; i < numVerts * numPolys; i++) {
+      EXPECT_FLOAT_EQ(verts[i].xyz[0], verts[0].xyz[0]);
+    }
+  });
+
+  ASSERT_EQ(runs.size(), 3);
+  EXPECT_EQ(runs[0], std::make_tuple(1, 3, 1));
+  EXPECT_EQ(runs[1], std::make_tuple(1, 4, 2));
+  EXPECT_EQ(runs[2], std::make_tuple(2, 4, 1));
+  EXPECT_EQ(batcher.size(), 0);
+}
+
+TEST_F(PolyBatcherTests, flush_ShouldSplitLongRuns) {
+  PolyBatcher batcher(2);
+  const polyVert_t quad[4] = {vert(1), vert(1), vert(1), vert(1)};
+
+  for (int i = 0; i < 5; i++) {
+    batcher.add(1, 4, quad);
+  }
+
+  std::vector<int> runSizes;
+  batcher.flush([&](qhandle_t, int, const polyVert_t *, int numPolys) {
+    runSizes.push_back(numPolys);
+  });
+
+  EXPECT_EQ(runSizes, std::vector<int>({2, 2, 1}));
+}
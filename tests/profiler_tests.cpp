@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "../src/cgame/etj_profiler.h"
+
+using namespace ETJump;
+
+class ProfilerTests : public testing::Test {
+public:
+  Profiler profiler{4};
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  void recordFrame(int section, int64_t microseconds) {
+    profiler.beginFrame(true);
+    profiler.add(section, microseconds);
+    profiler.endFrame();
+  }
+};
+
+TEST_F(ProfilerTests, AddSection_ShouldReturnIdsAfterBuiltinStages) {
+  EXPECT_EQ(profiler.addSection("a"), Profiler::NumStages);
+  EXPECT_EQ(profiler.addSection("b"), Profiler::NumStages + 1);
+  EXPECT_EQ(profiler.sectionCount(), Profiler::NumStages + 2);
+}
+
+TEST_F(ProfilerTests, Add_ShouldBeIgnoredWhileDisabled) {
+  profiler.beginFrame(false);
+  profiler.add(Profiler::Frame, 100);
+  profiler.endFrame();
+
+  EXPECT_FALSE(profiler.isActive());
+  EXPECT_EQ(profiler.frameCount(), 0);
+}
+
+TEST_F(ProfilerTests, Scope_ShouldNotRecordWhileDisabled) {
+  profiler.beginFrame(false);
+  { Profiler::Scope scope(&profiler, Profiler::Frame); }
+  profiler.beginFrame(true);
+  profiler.endFrame();
+
+  EXPECT_EQ(profiler.getStats()[Profiler::Frame].max, 0);
+}
+
+TEST_F(ProfilerTests, Scope_ShouldAcceptNullProfiler) {
+  Profiler::Scope scope(nullptr, Profiler::Frame);
+}
+
+TEST_F(ProfilerTests, GetStats_ShouldAccumulateWithinFrame) {
+  profiler.beginFrame(true);
+  profiler.add(Profiler::Draw2D, 100);
+  profiler.add(Profiler::Draw2D, 50);
+  profiler.endFrame();
+
+  const auto stats = profiler.getStats();
+  EXPECT_EQ(stats[Profiler::Draw2D].last, 150);
+  EXPECT_EQ(stats[Profiler::Draw2D].max, 150);
+  EXPECT_DOUBLE_EQ(stats[Profiler::Draw2D].average, 150.0);
+}
+
+TEST_F(ProfilerTests, GetStats_ShouldAverageOverPartialHistory) {
+  recordFrame(Profiler::Frame, 100);
+  recordFrame(Profiler::Frame, 300);
+
+  const auto stats = profiler.getStats();
+  EXPECT_EQ(profiler.frameCount(), 2);
+  EXPECT_DOUBLE_EQ(stats[Profiler::Frame].average, 200.0);
+  EXPECT_EQ(stats[Profiler::Frame].max, 300);
+  EXPECT_EQ(stats[Profiler::Frame].last, 300);
+}
+
+TEST_F(ProfilerTests, GetStats_ShouldOnlyKeepLatestFrames) {
+  recordFrame(Profiler::Frame, 1000);
+  for (int i = 0; i < 4; i++) {
+    recordFrame(Profiler::Frame, 10 * (i + 1));
+  }
+
+  const auto stats = profiler.getStats();
+  EXPECT_EQ(profiler.frameCount(), 4);
+  EXPECT_EQ(stats[Profiler::Frame].max, 40);
+  EXPECT_EQ(stats[Profiler::Frame].last, 40);
+  EXPECT_DOUBLE_EQ(stats[Profiler::Frame].average, 25.0);
+}
+
+TEST_F(ProfilerTests, BeginFrame_ShouldClearHistoryWhenReenabled) {
+  recordFrame(Profiler::Frame, 100);
+  profiler.beginFrame(false);
+  profiler.endFrame();
+  recordFrame(Profiler::Frame, 20);
+
+  const auto stats = profiler.getStats();
+  EXPECT_EQ(profiler.frameCount(), 1);
+  EXPECT_EQ(stats[Profiler::Frame].max, 20);
+}
+
+TEST_F(ProfilerTests, AddSection_ShouldKeepExistingSamples) {
+  recordFrame(Profiler::Frame, 100);
+  const int section = profiler.addSection("late");
+  recordFrame(section, 30);
+
+  const auto stats = profiler.getStats();
+  EXPECT_EQ(stats[Profiler::Frame].max, 100);
+  EXPECT_EQ(stats[section].last, 30);
+  EXPECT_EQ(stats[section].name, "late");
+}
+
+TEST_F(ProfilerTests, Count_ShouldAccumulateEventsPerFrame) {
+  const int counter = profiler.addCounter("draw calls");
+
+  profiler.beginFrame(true);
+  profiler.count(counter);
+  profiler.count(counter, 4);
+  profiler.endFrame();
+
+  profiler.beginFrame(true);
+  profiler.count(counter, 3);
+  profiler.endFrame();
+
+  const auto stats = profiler.getStats();
+  EXPECT_TRUE(stats[counter].counter);
+  EXPECT_FALSE(stats[Profiler::Frame].counter);
+  EXPECT_DOUBLE_EQ(stats[counter].average, 4.0);
+  EXPECT_EQ(stats[counter].max, 5);
+  EXPECT_EQ(stats[counter].last, 3);
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../src/ui/etj_server_sort_keys.h"
+
+using namespace ETJump;
+
+class ServerSortKeysTests : public testing::Test {
+public:
+  void SetUp() override {
+    keys.set(0, "ETJump #1", "oasis", 12, 4, 40);
+    keys.set(1, "another server", "pcj_unity", 0, 4, 120);
+    keys.set(2, "Zzz", "Goldrush", 12, 2, 15);
+  }
+
+  void TearDown() override {}
+
+  ServerSortKeys keys;
+};
+
+TEST_F(ServerSortKeysTests, toColumn_ShouldOnlyAcceptCachedColumns) {
+  ServerSortKeys::Column column;
+  ASSERT_TRUE(ServerSortKeys::toColumn(0, column));
+  ASSERT_EQ(column, ServerSortKeys::Column::Host);
+  ASSERT_TRUE(ServerSortKeys::toColumn(4, column));
+  ASSERT_EQ(column, ServerSortKeys::Column::Ping);
+  ASSERT_FALSE(ServerSortKeys::toColumn(5, column));
+  ASSERT_FALSE(ServerSortKeys::toColumn(-1, column));
+}
+
+TEST_F(ServerSortKeysTests, compare_ShouldIgnoreCase) {
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Host, false, 1, 0), -1);
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Map, false, 2, 0), -1);
+}
+
+TEST_F(ServerSortKeysTests, compare_ShouldFlipWhenDescending) {
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Ping, false, 0, 1), -1);
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Ping, true, 0, 1), 1);
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Clients, true, 0, 2), 0);
+}
+
+TEST_F(ServerSortKeysTests, sort_ShouldKeepOrderOfEqualServers) {
+  std::vector<int> servers{2, 1, 0};
+  keys.sort(servers.data(), static_cast<int>(servers.size()),
+            ServerSortKeys::Column::Clients, true);
+  ASSERT_EQ(servers, (std::vector<int>{2, 0, 1}));
+}
+
+TEST_F(ServerSortKeysTests, sort_ShouldSortByPing) {
+  std::vector<int> servers{0, 1, 2};
+  keys.sort(servers.data(), static_cast<int>(servers.size()),
+            ServerSortKeys::Column::Ping, false);
+  ASSERT_EQ(servers, (std::vector<int>{2, 0, 1}));
+}
+
+TEST_F(ServerSortKeysTests, insertionPoint_ShouldKeepListOrdered) {
+  std::vector<int> servers;
+  for (int server = 0; server < 3; server++) {
+    const int pos = keys.insertionPoint(servers.data(),
+                                        static_cast<int>(servers.size()),
+                                        server, ServerSortKeys::Column::Game,
+                                        false);
+    servers.insert(servers.begin() + pos, server);
+  }
+  ASSERT_EQ(servers, (std::vector<int>{2, 0, 1}));
+}
+
+TEST_F(ServerSortKeysTests, set_ShouldRefreshChangedServer) {
+  keys.set(1, "another server", "pcj_unity", 0, 4, 5);
+  ASSERT_EQ(keys.compare(ServerSortKeys::Column::Ping, false, 1, 2), -1);
+}
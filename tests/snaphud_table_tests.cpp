@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../src/cgame/etj_snaphud_table.h"
+
+using namespace ETJump;
+
+class SnapTableTests : public testing::Test {
+public:
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  static void expectEqualTables(const SnapTable &lhs, const SnapTable &rhs) {
+    EXPECT_EQ(lhs.a, rhs.a);
+    EXPECT_EQ(lhs.maxAccel, rhs.maxAccel);
+    EXPECT_EQ(lhs.zones, rhs.zones);
+    EXPECT_EQ(lhs.xAccel, rhs.xAccel);
+    EXPECT_EQ(lhs.yAccel, rhs.yAccel);
+    EXPECT_EQ(lhs.absAccel, rhs.absAccel);
+    EXPECT_EQ(lhs.minAbsAccel, rhs.minAbsAccel);
+    EXPECT_EQ(lhs.maxAbsAccel, rhs.maxAbsAccel);
+  }
+};
+
+TEST_F(SnapTableTests, Build_ShouldProduceSortedZonesForQuadrant) {
+  SnapTable table;
+  // 352 wishspeed, ground accel 10, 8ms frametime
+  table.build(10.0f * 352.0f * 0.008f);
+
+  ASSERT_EQ(table.zones.size(), 2 * table.maxAccel + 1);
+  for (size_t i = 1; i < table.zones.size(); i++) {
+    EXPECT_LE(table.zones[i - 1], table.zones[i]);
+  }
+  EXPECT_EQ(table.zones.back(), table.zones.front() + 16384);
+}
+
+TEST_F(SnapTableTests, Build_ShouldMatchWhenReusingStorage) {
+  SnapTable fresh;
+  fresh.build(3.5f);
+
+  SnapTable reused;
+  reused.build(28.16f);
+  reused.build(3.5f);
+
+  expectEqualTables(fresh, reused);
+}
+
+TEST_F(SnapTableTests, Get_ShouldReturnSameTableAsBuild) {
+  SnapTableCache cache(4);
+  SnapTable expected;
+  expected.build(28.16f);
+
+  expectEqualTables(*cache.get(28.16f), expected);
+}
+
+TEST_F(SnapTableTests, Get_ShouldHitForRepeatedAccel) {
+  SnapTableCache cache(4);
+  cache.get(2.816f);
+  cache.get(28.16f);
+  cache.get(2.816f);
+  cache.get(28.16f);
+
+  EXPECT_EQ(cache.misses(), 2);
+  EXPECT_EQ(cache.hits(), 2);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(SnapTableTests, Get_ShouldEvictLeastRecentlyUsed) {
+  SnapTableCache cache(2);
+  cache.get(1.0f);
+  cache.get(2.0f);
+  cache.get(1.0f);
+  // evicts 2.0
+  cache.get(3.0f);
+  cache.get(1.0f);
+  EXPECT_EQ(cache.misses(), 3);
+
+  cache.get(2.0f);
+  EXPECT_EQ(cache.misses(), 4);
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(SnapTableTests, Get_HeldTableShouldSurviveEviction) {
+  SnapTableCache cache(1);
+  const auto held = cache.get(28.16f);
+  SnapTable expected;
+  expected.build(28.16f);
+
+  // evicts the held table, which must not be rebuilt under the holder
+  const auto other = cache.get(2.816f);
+  EXPECT_EQ(held->a, 28.16f);
+  expectEqualTables(*held, expected);
+  EXPECT_EQ(other->a, 2.816f);
+}
@@ -146,3 +146,50 @@ TEST_F(StringUtilitiesTests, iEqual_ShouldWorkCorrectly) {
   EXPECT_EQ(StringUtil::iEqual("FoO", "foO"), true);
   EXPECT_EQ(StringUtil::iEqual("FoO", "BaR"), false);
 }
+
+TEST_F(StringUtilitiesTests, sanitize_ShouldStripColorCodesAndControlChars) {
+  EXPECT_EQ(sanitize("^1e^7t^1j^7u^1m^7p"), "etjump");
+  EXPECT_EQ(sanitize("^^1caret"), "1caret");
+  EXPECT_EQ(sanitize("\x1b" "1escaped"), "escaped");
+  EXPECT_EQ(sanitize("tab\tand\nnewline"), "tabandnewline");
+  EXPECT_EQ(sanitize("trailing^"), "trailing");
+  EXPECT_EQ(sanitize("^3MiXeD", true), "mixed");
+  EXPECT_EQ(sanitize(""), "");
+}
+
+TEST_F(StringUtilitiesTests, sanitizeInto_ShouldFoldWhitespace) {
+  const std::string input = "  ^1some   ^2spaced  text  ";
+  char out[32];
+  SanitizeOptions options;
+  options.foldWhitespace = true;
+
+  const auto len = sanitizeInto(input.data(), input.size(), out, options);
+  EXPECT_EQ(std::string(out, len), "some spaced text");
+}
+
+TEST_F(StringUtilitiesTests, sanitizeInto_ShouldWorkInPlace) {
+  char buffer[] = "^1In ^2Place";
+  SanitizeOptions options;
+  options.toLower = true;
+
+  const auto len = sanitizeInto(buffer, sizeof(buffer) - 1, buffer, options);
+  EXPECT_EQ(std::string(buffer, len), "in place");
+}
+
+TEST_F(StringUtilitiesTests, sanitizeInto_ShouldStopAtNullByte) {
+  const std::string input("^1first\0second", 14);
+  char out[16];
+
+  const auto len = sanitizeInto(input.data(), input.size(), out);
+  EXPECT_EQ(std::string(out, len), "first");
+}
+
+TEST_F(StringUtilitiesTests, sanitizeInto_ShouldFollowEngineColorRules) {
+  const std::string input = "^^1^2caret\x7f^";
+  char out[16];
+  SanitizeOptions options;
+  options.engineColorRules = true;
+
+  const auto len = sanitizeInto(input.data(), input.size(), out, options);
+  EXPECT_EQ(std::string(out, len), "^caret^");
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sqlite3.h>
+#include "../src/game/etj_timerun_repository.h"
+#include "../src/game/q_shared.h"
+
+using namespace ETJump;
+
+static const char *const MAP = "oasis";
+static const char *const RUN = "main run";
+
+// Printer::LogPrintln is stubbed in database_maintenance_tests.cpp, the
+// database logger only flushes through it
+class TimerunRepositoryTests : public testing::Test {
+public:
+  void SetUp() override {
+    auto db = std::make_unique<DatabaseV2>("timerun", ":memory:");
+    database = db.get();
+    repository = std::make_unique<TimerunRepository>(
+        std::move(db), std::make_unique<DatabaseV2>("old", ":memory:"));
+    repository->initialize();
+
+    // the migration adds the default season as id 1
+    for (int i = 2; i <= 3; i++) {
+      Timerun::AddSeasonParams params{};
+      params.name = "season " + std::to_string(i);
+      params.startTime = Time::fromString("2024-01-01 00:00:00");
+      repository->addSeason(params);
+    }
+  }
+
+  void TearDown() override {
+    repository->shutdown();
+    database = nullptr;
+  }
+
+  void insertRecord(int seasonId, int userId, int time,
+                    const std::string &map = MAP,
+                    const std::string &run = RUN) const {
+    Timerun::Record record;
+    record.seasonId = seasonId;
+    record.map = map;
+    record.run = run;
+    record.userId = userId;
+    record.time = time;
+    record.checkpoints = std::vector<int>(MAX_TIMERUN_CHECKPOINTS, -1);
+    record.recordDate = Time::fromString("2024-02-01 12:00:00");
+    record.playerName = "player" + std::to_string(userId);
+    repository->insertRecord(record);
+  }
+
+  // (season, user, time) of each record, sorted so query order doesn't
+  // matter where the query doesn't define one
+  static std::vector<std::vector<int>>
+  summarize(const std::vector<Timerun::Record> &records, bool sort = true) {
+    std::vector<std::vector<int>> result;
+    for (const auto &record : records) {
+      result.push_back({record.seasonId, record.userId, record.time});
+    }
+    if (sort) {
+      std::sort(result.begin(), result.end());
+    }
+    return result;
+  }
+
+  int totalChanges() const {
+    return sqlite3_total_changes(database->sql.connection().get());
+  }
+
+  int preparedStatements() const {
+    const auto connection = database->sql.connection().get();
+    int count = 0;
+    for (auto stmt = sqlite3_next_stmt(connection, nullptr); stmt;
+         stmt = sqlite3_next_stmt(connection, stmt)) {
+      count++;
+    }
+    return count;
+  }
+
+  DatabaseV2 *database = nullptr;
+  std::unique_ptr<TimerunRepository> repository;
+};
+
+TEST_F(TimerunRepositoryTests, getTopRecords_ShouldReturnBestTimePerSeason) {
+  insertRecord(1, 1, 100000);
+  insertRecord(1, 2, 90000);
+  insertRecord(1, 3, 95000);
+  insertRecord(2, 1, 80000);
+  insertRecord(2, 2, 85000);
+  // other runs and maps with better times don't count
+  insertRecord(1, 4, 1000, MAP, "other run");
+  insertRecord(2, 4, 1000, "other map", RUN);
+
+  const std::vector<std::vector<int>> expected{{1, 2, 90000},
+                                               {2, 1, 80000}};
+  EXPECT_EQ(summarize(repository->getTopRecords({1, 2, 3}, MAP, RUN)),
+            expected);
+}
+
+TEST_F(TimerunRepositoryTests, getTopRecords_ShouldReturnEveryTiedRecord) {
+  insertRecord(1, 1, 90000);
+  insertRecord(1, 2, 90000);
+  insertRecord(1, 3, 95000);
+  insertRecord(2, 1, 70000);
+  insertRecord(2, 2, 70000);
+  insertRecord(2, 3, 70000);
+
+  const std::vector<std::vector<int>> expected{
+      {1, 1, 90000}, {1, 2, 90000}, {2, 1, 70000}, {2, 2, 70000},
+      {2, 3, 70000}};
+  EXPECT_EQ(summarize(repository->getTopRecords({1, 2}, MAP, RUN)), expected);
+}
+
+TEST_F(TimerunRepositoryTests, getTopRecords_ShouldFollowChangedSeasonList) {
+  insertRecord(1, 1, 90000);
+  insertRecord(2, 2, 80000);
+  insertRecord(3, 3, 70000);
+
+  const std::vector<std::vector<int>> second{{2, 2, 80000}};
+  const std::vector<std::vector<int>> firstAndThird{{1, 1, 90000},
+                                                    {3, 3, 70000}};
+  EXPECT_EQ(summarize(repository->getTopRecords({2}, MAP, RUN)), second);
+  EXPECT_EQ(summarize(repository->getTopRecords({1, 3}, MAP, RUN)),
+            firstAndThird);
+  EXPECT_EQ(summarize(repository->getTopRecords({2}, MAP, RUN)), second);
+  EXPECT_TRUE(repository->getTopRecords({}, MAP, RUN).empty());
+}
+
+TEST_F(TimerunRepositoryTests, getTopRecords_ShouldNotRebindSameSeasons) {
+  insertRecord(1, 1, 90000);
+  insertRecord(2, 2, 80000);
+
+  repository->getTopRecords({1, 2}, MAP, RUN);
+  const int changes = totalChanges();
+
+  // the same list is already in temp.bound_season_ids
+  repository->getTopRecords({1, 2}, MAP, RUN);
+  repository->getRecordsForPlayer({1, 2}, MAP, RUN, 1);
+  EXPECT_EQ(totalChanges(), changes);
+
+  // a different one replaces it
+  const std::vector<std::vector<int>> expected{{1, 1, 90000}};
+  EXPECT_EQ(summarize(repository->getTopRecords({1}, MAP, RUN)), expected);
+  EXPECT_GT(totalChanges(), changes);
+}
+
+TEST_F(TimerunRepositoryTests, getRecords_ShouldReturnEachRecordOnce) {
+  insertRecord(2, 1, 90000);
+  insertRecord(2, 2, 80000);
+  insertRecord(3, 1, 70000);
+  insertRecord(3, 1, 60000, MAP, "other run");
+  insertRecord(1, 3, 50000);
+
+  Timerun::PrintRecordsParams params{};
+  params.season = opt<std::string>("season");
+  params.map = MAP;
+  params.exactMap = true;
+
+  // seasons 2 and 3 match, ordered by season, run and time
+  const std::vector<std::vector<int>> allRuns{
+      {2, 2, 80000}, {2, 1, 90000}, {3, 1, 70000}, {3, 1, 60000}};
+  EXPECT_EQ(summarize(repository->getRecords(params), false), allRuns);
+
+  params.run = opt<std::string>(RUN);
+  const std::vector<std::vector<int>> mainRun{
+      {2, 2, 80000}, {2, 1, 90000}, {3, 1, 70000}};
+  EXPECT_EQ(summarize(repository->getRecords(params), false), mainRun);
+}
+
+TEST_F(TimerunRepositoryTests, getRecords_ShouldThrowIfNoSeasonMatches) {
+  Timerun::PrintRecordsParams params{};
+  params.season = opt<std::string>("summer");
+  params.map = MAP;
+
+  EXPECT_THROW(repository->getRecords(params), std::runtime_error);
+}
+
+TEST_F(TimerunRepositoryTests, Statements_ShouldBePreparedOnce) {
+  insertRecord(1, 1, 90000);
+  insertRecord(2, 1, 80000);
+
+  const auto finishRun = [this](int time) {
+    repository->getTopRecords({1, 2}, MAP, RUN);
+    for (const auto &record :
+         repository->getRecordsForPlayer({1, 2}, MAP, RUN, 1)) {
+      auto improved = record;
+      improved.time = time;
+      repository->updateRecord(improved);
+    }
+  };
+
+  finishRun(70000);
+  const int prepared = preparedStatements();
+
+  for (int i = 0; i < 10; i++) {
+    finishRun(60000 - i);
+    // queries built with stringFormat stay off the cache
+    repository->getMapsForName(MAP, i % 2 == 0);
+    repository->getRunsForName(MAP, RUN, i % 2 == 0, true);
+  }
+
+  EXPECT_EQ(preparedStatements(), prepared);
+  const std::vector<std::vector<int>> expected{{1, 1, 59991},
+                                               {2, 1, 59991}};
+  EXPECT_EQ(summarize(repository->getTopRecords({1, 2}, MAP, RUN)), expected);
+}
+
+TEST_F(TimerunRepositoryTests, statement_ShouldRebindOnEveryUse) {
+  insertRecord(1, 1, 90000);
+  insertRecord(1, 2, 80000);
+
+  const std::string query = "select time from record where user_id=?;";
+  auto &first = database->statement(query);
+  EXPECT_EQ(&database->statement(query), &first);
+
+  for (int userId : {1, 2, 1}) {
+    int time = 0;
+    database->statement(query) << userId >> time;
+    EXPECT_EQ(time, userId == 1 ? 90000 : 80000);
+  }
+}
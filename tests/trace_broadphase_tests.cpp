@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../src/cgame/etj_trace_broadphase.h"
+
+using namespace ETJump;
+
+class TraceBroadphaseTests : public testing::Test {
+public:
+  struct Box {
+    vec3_t mins;
+    vec3_t maxs;
+  };
+
+  struct TraceResult {
+    float fraction;
+    int entityNum;
+    bool startsolid;
+  };
+
+  TraceBroadphase broadphase;
+  std::vector<Box> boxes;
+  std::mt19937 rng{1337};
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  Box randomBox(float worldSize, float maxSize) {
+    std::uniform_real_distribution<float> pos(-worldSize, worldSize);
+    std::uniform_real_distribution<float> size(1.0f, maxSize);
+    Box box{};
+    for (int i = 0; i < 3; i++) {
+      box.mins[i] = pos(rng);
+      box.maxs[i] = box.mins[i] + size(rng);
+    }
+    return box;
+  }
+
+  void addRandomBoxes(int count, float worldSize, float maxSize) {
+    for (int i = 0; i < count; i++) {
+      boxes.push_back(randomBox(worldSize, maxSize));
+      broadphase.add(boxes.back().mins, boxes.back().maxs);
+    }
+  }
+
+  std::vector<int> linearQuery(const vec3_t mins, const vec3_t maxs) const {
+    std::vector<int> result;
+    for (int i = 0; i < static_cast<int>(boxes.size()); i++) {
+      bool overlap = true;
+      for (int j = 0; j < 3; j++) {
+        if (boxes[i].mins[j] > maxs[j] || boxes[i].maxs[j] < mins[j]) {
+          overlap = false;
+        }
+      }
+      if (overlap) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  // swept box against box, stands in for the collision model traces
+  static float sweep(const vec3_t start, const vec3_t end, const vec3_t mins,
+                     const vec3_t maxs, const Box &box) {
+    float enter = 0.0f;
+    float exit = 1.0f;
+
+    for (int i = 0; i < 3; i++) {
+      const float lo = box.mins[i] - maxs[i];
+      const float hi = box.maxs[i] - mins[i];
+      const float delta = end[i] - start[i];
+
+      if (delta == 0.0f) {
+        if (start[i] < lo || start[i] > hi) {
+          return 1.0f;
+        }
+        continue;
+      }
+
+      float t0 = (lo - start[i]) / delta;
+      float t1 = (hi - start[i]) / delta;
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+      enter = std::max(enter, t0);
+      exit = std::min(exit, t1);
+      if (enter > exit) {
+        return 1.0f;
+      }
+    }
+
+    return enter;
+  }
+
+  // same accumulation CG_ClipMoveToEntities does
+  TraceResult trace(const vec3_t start, const vec3_t end, const vec3_t mins,
+                    const vec3_t maxs, const std::vector<int> &entities) const {
+    TraceResult result{1.0f, -1, false};
+    for (const int index : entities) {
+      const float fraction = sweep(start, end, mins, maxs, boxes[index]);
+      if (fraction < result.fraction) {
+        result.fraction = fraction;
+        result.entityNum = index;
+      } else if (fraction == 0.0f) {
+        result.startsolid = true;
+      }
+    }
+    return result;
+  }
+
+  std::vector<int> allEntities() const {
+    std::vector<int> result(boxes.size());
+    for (int i = 0; i < static_cast<int>(result.size()); i++) {
+      result[i] = i;
+    }
+    return result;
+  }
+};
+
+TEST_F(TraceBroadphaseTests, Query_ShouldMatchLinearScan) {
+  addRandomBoxes(500, 8192.0f, 512.0f);
+  std::vector<int> result;
+
+  for (int i = 0; i < 200; i++) {
+    const Box query = randomBox(8192.0f, 1024.0f);
+    broadphase.query(query.mins, query.maxs, result);
+    EXPECT_EQ(result, linearQuery(query.mins, query.maxs));
+  }
+}
+
+TEST_F(TraceBroadphaseTests, Query_ShouldMatchLinearScanForHugeQueries) {
+  addRandomBoxes(200, 8192.0f, 512.0f);
+  std::vector<int> result;
+
+  const vec3_t mins{-65536.0f, -65536.0f, -65536.0f};
+  const vec3_t maxs{65536.0f, 65536.0f, 65536.0f};
+  broadphase.query(mins, maxs, result);
+  EXPECT_EQ(result, allEntities());
+}
+
+TEST_F(TraceBroadphaseTests, Query_ShouldReturnHugeEntries) {
+  addRandomBoxes(50, 8192.0f, 256.0f);
+  boxes.push_back(
+      {{-60000.0f, -60000.0f, -10.0f}, {60000.0f, 60000.0f, 10.0f}});
+  broadphase.add(boxes.back().mins, boxes.back().maxs);
+  std::vector<int> result;
+
+  const vec3_t mins{0.0f, 0.0f, 0.0f};
+  const vec3_t maxs{1.0f, 1.0f, 1.0f};
+  broadphase.query(mins, maxs, result);
+  EXPECT_EQ(result, linearQuery(mins, maxs));
+  EXPECT_EQ(result.back(), 50);
+}
+
+TEST_F(TraceBroadphaseTests, Query_ShouldAlwaysReturnUnboundedEntries) {
+  const vec3_t boxMins{1000.0f, 1000.0f, 0.0f};
+  const vec3_t boxMaxs{1010.0f, 1010.0f, 10.0f};
+  broadphase.add(boxMins, boxMaxs);
+  broadphase.addUnbounded();
+  broadphase.add(boxMins, boxMaxs);
+  std::vector<int> result;
+
+  const vec3_t mins{0.0f, 0.0f, 0.0f};
+  const vec3_t maxs{1.0f, 1.0f, 1.0f};
+  broadphase.query(mins, maxs, result);
+  EXPECT_EQ(result, std::vector<int>{1});
+}
+
+TEST_F(TraceBroadphaseTests, Update_ShouldMoveEntryBetweenCells) {
+  addRandomBoxes(100, 4096.0f, 128.0f);
+  std::uniform_real_distribution<float> offset(-2048.0f, 2048.0f);
+  std::vector<int> result;
+
+  for (int step = 0; step < 50; step++) {
+    for (int i = 0; i < static_cast<int>(boxes.size()); i += 3) {
+      const float dx = offset(rng);
+      const float dy = offset(rng);
+      boxes[i].mins[0] += dx;
+      boxes[i].maxs[0] += dx;
+      boxes[i].mins[1] += dy;
+      boxes[i].maxs[1] += dy;
+      broadphase.update(i, boxes[i].mins, boxes[i].maxs);
+    }
+
+    const Box query = randomBox(4096.0f, 1024.0f);
+    broadphase.query(query.mins, query.maxs, result);
+    EXPECT_EQ(result, linearQuery(query.mins, query.maxs));
+  }
+}
+
+TEST_F(TraceBroadphaseTests, Clear_ShouldRemoveAllEntries) {
+  addRandomBoxes(100, 1024.0f, 128.0f);
+  broadphase.clear();
+  boxes.clear();
+  EXPECT_EQ(broadphase.size(), 0);
+
+  addRandomBoxes(10, 1024.0f, 128.0f);
+  std::vector<int> result;
+  const vec3_t mins{-2048.0f, -2048.0f, -2048.0f};
+  const vec3_t maxs{2048.0f, 2048.0f, 2048.0f};
+  broadphase.query(mins, maxs, result);
+  EXPECT_EQ(result, allEntities());
+}
+
+TEST_F(TraceBroadphaseTests, Trace_ShouldMatchLinearPath) {
+  addRandomBoxes(400, 4096.0f, 384.0f);
+  std::uniform_real_distribution<float> pos(-4096.0f, 4096.0f);
+  std::uniform_real_distribution<float> move(-512.0f, 512.0f);
+  const vec3_t mins{-15.0f, -15.0f, -24.0f};
+  const vec3_t maxs{15.0f, 15.0f, 48.0f};
+  std::vector<int> candidates;
+
+  for (int i = 0; i < 1000; i++) {
+    vec3_t start, end, boundsMins, boundsMaxs;
+    for (int j = 0; j < 3; j++) {
+      start[j] = pos(rng);
+      end[j] = start[j] + move(rng);
+      boundsMins[j] = std::min(start[j], end[j]) + mins[j] - 1.0f;
+      boundsMaxs[j] = std::max(start[j], end[j]) + maxs[j] + 1.0f;
+    }
+
+    broadphase.query(boundsMins, boundsMaxs, candidates);
+    const TraceResult linear = trace(start, end, mins, maxs, allEntities());
+    const TraceResult culled = trace(start, end, mins, maxs, candidates);
+
+    EXPECT_EQ(culled.fraction, linear.fraction);
+    EXPECT_EQ(culled.entityNum, linear.entityNum);
+    EXPECT_EQ(culled.startsolid, linear.startsolid);
+  }
+}
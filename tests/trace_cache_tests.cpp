@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../src/cgame/etj_trace_cache.h"
+
+using namespace ETJump;
+
+class TraceCacheTests : public testing::Test {
+public:
+  static constexpr float DISTANCE = 1000.0f;
+  static constexpr float EPSILON = 0.01f;
+
+  // flat ground at z = 0 everywhere
+  float groundHeight = 0;
+  int traces = 0;
+  TraceCache cache{[this](trace_t *result, const vec3_t start,
+                          const vec3_t end, int, int) {
+    traces++;
+    *result = trace_t{};
+    VectorCopy(end, result->endpos);
+    result->fraction = 1.0f;
+
+    if (end[2] < groundHeight && start[2] >= groundHeight) {
+      result->fraction = (start[2] - groundHeight) / (start[2] - end[2]);
+      result->endpos[2] = groundHeight;
+    }
+  }};
+
+  void SetUp() override {}
+
+  void TearDown() override {}
+
+  void groundTrace(trace_t *result, float x, float y, float z,
+                   int skipNumber = 0) {
+    const vec3_t start{x, y, z};
+    cache.groundTrace(result, start, DISTANCE, EPSILON, skipNumber,
+                      CONTENTS_SOLID);
+  }
+};
+
+TEST_F(TraceCacheTests, Trace_ShouldHitForSameTrace) {
+  const vec3_t start{0, 0, 100};
+  const vec3_t end{0, 0, -100};
+  trace_t first, second;
+
+  cache.trace(&first, start, end, 0, CONTENTS_SOLID);
+  cache.trace(&second, start, end, 0, CONTENTS_SOLID);
+
+  EXPECT_EQ(traces, 1);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_FLOAT_EQ(second.fraction, first.fraction);
+}
+
+TEST_F(TraceCacheTests, Trace_ShouldMissForDifferentParameters) {
+  const vec3_t start{0, 0, 100};
+  const vec3_t end{0, 0, -100};
+  const vec3_t otherEnd{0, 0, -200};
+  trace_t result;
+
+  cache.trace(&result, start, end, 0, CONTENTS_SOLID);
+  cache.trace(&result, start, otherEnd, 0, CONTENTS_SOLID);
+  cache.trace(&result, start, end, 1, CONTENTS_SOLID);
+  cache.trace(&result, start, end, 0, CONTENTS_PLAYERCLIP);
+
+  EXPECT_EQ(traces, 4);
+  EXPECT_EQ(cache.hits(), 0);
+}
+
+TEST_F(TraceCacheTests, Clear_ShouldDropCachedTraces) {
+  const vec3_t start{0, 0, 100};
+  const vec3_t end{0, 0, -100};
+  trace_t result;
+
+  cache.trace(&result, start, end, 0, CONTENTS_SOLID);
+  // a new map
+  groundHeight = 50;
+  cache.clear();
+  cache.trace(&result, start, end, 0, CONTENTS_SOLID);
+
+  EXPECT_EQ(traces, 2);
+  EXPECT_FLOAT_EQ(result.endpos[2], 50);
+}
+
+TEST_F(TraceCacheTests, Trace_ShouldEvictOldestEntry) {
+  const vec3_t end{0, 0, -100};
+  trace_t result;
+
+  for (int i = 0; i <= TraceCache::MAX_TRACES; i++) {
+    const vec3_t start{static_cast<float>(i), 0, 100};
+    cache.trace(&result, start, end, 0, CONTENTS_SOLID);
+  }
+
+  const vec3_t first{0, 0, 100};
+  cache.trace(&result, first, end, 0, CONTENTS_SOLID);
+  EXPECT_EQ(cache.hits(), 0);
+}
+
+TEST_F(TraceCacheTests, GroundTrace_ShouldReuseGroundBelowCachedStart) {
+  trace_t first, lower;
+
+  groundTrace(&first, 0, 0, 100);
+  groundTrace(&lower, 0.005f, 0, 40);
+
+  EXPECT_EQ(traces, 1);
+  EXPECT_FLOAT_EQ(lower.endpos[0], 0.005f);
+  EXPECT_FLOAT_EQ(lower.endpos[2], 0);
+  EXPECT_FLOAT_EQ(lower.fraction, 40 / DISTANCE);
+}
+
+TEST_F(TraceCacheTests, GroundTrace_ShouldNotReuseOutsideTracedSegment) {
+  trace_t result;
+
+  groundTrace(&result, 0, 0, 100);
+  // above the cached start, something could be in between
+  groundTrace(&result, 0, 0, 150);
+  // moved sideways
+  groundTrace(&result, 1, 0, 100);
+  // different player
+  groundTrace(&result, 0, 0, 100, 1);
+
+  EXPECT_EQ(traces, 4);
+}
+
+TEST_F(TraceCacheTests, GroundTrace_ShouldReuseWorldHitOnNextFrames) {
+  trace_t result;
+
+  // standing still, then falling straight down, one trace per frame
+  for (float z : {100.0f, 100.0f, 100.0f, 80.0f, 50.0f, 10.0f}) {
+    groundTrace(&result, 0, 0, z);
+    EXPECT_FLOAT_EQ(result.endpos[2], 0);
+    EXPECT_FLOAT_EQ(result.fraction, z / DISTANCE);
+  }
+
+  EXPECT_EQ(traces, 1);
+  EXPECT_EQ(cache.hits(), 5);
+}